@@ -0,0 +1,203 @@
+#include <iostream>
+#include <stdlib.h>
+#include <time.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_WORK_ID 1
+#define BENCH_URGENT_ID 2
+#define BENCH_STOP_ID 3
+
+#define BENCH_WORK_NS 2000
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+class CLUrgentMsg : public CLMessage
+{
+public:
+	CLUrgentMsg(int nPriority) : CLMessage(BENCH_URGENT_ID, nPriority)
+	{
+		m_PostTime = GetTimeInSeconds();
+	}
+
+	double m_PostTime;
+};
+
+//۲Ϣѭһɾⲿ
+struct SLBoundedQueueResult
+{
+	unsigned long nProcessed;
+	double UrgentLatency;
+	SLMessageQueueStatistics Statistics;
+	bool bHasStatistics;
+};
+
+//ߣÿϢæBENCH_WORK_NS
+class CLSlowConsumerObserver : public CLMessageObserver
+{
+public:
+	CLSlowConsumerObserver(SLBoundedQueueResult *pResult)
+	{
+		m_pResult = pResult;
+		m_pResult->nProcessed = 0;
+		m_pResult->UrgentLatency = 0;
+		m_pResult->bHasStatistics = false;
+		m_pMessageLoop = 0;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		m_pMessageLoop = pMessageLoop;
+
+		pMessageLoop->Register(BENCH_WORK_ID, (CallBackForMessageLoop)(&CLSlowConsumerObserver::On_Work));
+		pMessageLoop->Register(BENCH_URGENT_ID, (CallBackForMessageLoop)(&CLSlowConsumerObserver::On_Urgent));
+		pMessageLoop->Register(BENCH_STOP_ID, (CallBackForMessageLoop)(&CLSlowConsumerObserver::On_Stop));
+
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Work(CLMessage *pm)
+	{
+		double end = GetTimeInSeconds() + BENCH_WORK_NS / 1e9;
+		while(GetTimeInSeconds() < end)
+			;
+
+		m_pResult->nProcessed++;
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Urgent(CLMessage *pm)
+	{
+		m_pResult->UrgentLatency = GetTimeInSeconds() - ((CLUrgentMsg *)pm)->m_PostTime;
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Stop(CLMessage *pm)
+	{
+		m_pResult->bHasStatistics = m_pMessageLoop->GetQueueStatistics(&m_pResult->Statistics).IsSuccess();
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+
+	SLBoundedQueueResult *m_pResult;
+	CLMessageLoopManager *m_pMessageLoop;
+};
+
+static void PrintStatistics(SLBoundedQueueResult *pResult)
+{
+	if(!pResult->bHasStatistics)
+	{
+		cout << " statistics=error" << endl;
+		return;
+	}
+
+	SLMessageQueueStatistics *p = &pResult->Statistics;
+	cout << " processed=" << pResult->nProcessed;
+	cout << " max_depth=" << p->nMaxDepth;
+	cout << " pushed=" << p->nPushed;
+	cout << " dropped=" << p->nDropped;
+	cout << " rejected=" << p->nRejected;
+	cout << " blocked=" << p->nBlocked << endl;
+}
+
+//߲ٵͶnMessagesϢ۲µĶ붪
+static void RunOverflowBench(const char *pstrPolicyName, unsigned long nCapacity, int OverflowPolicy, unsigned long nMessages)
+{
+	const char *pstrExecutiveName = "bench_bounded_queue_executive";
+
+	SLBoundedQueueResult result;
+	CLThreadForMsgLoop *pThread = new CLThreadForMsgLoop(new CLSlowConsumerObserver(&result), pstrExecutiveName, true, EXECUTIVE_IN_PROCESS_USE_STL_QUEUE, nCapacity, OverflowPolicy);
+
+	if(!pThread->Run(0).IsSuccess())
+	{
+		cout << "Run error" << endl;
+		return;
+	}
+
+	CLExecutiveHandle handle(pstrExecutiveName);
+
+	unsigned long nAccepted = 0;
+	double begin = GetTimeInSeconds();
+
+	for(unsigned long i = 0; i < nMessages; i++)
+	{
+		if(handle.PostExecutiveMessage(new CLMessage(BENCH_WORK_ID)).IsSuccess())
+			nAccepted++;
+	}
+
+	double produced = GetTimeInSeconds() - begin;
+
+	//ʱֹͣϢҲֱܱܾɹ
+	while(!handle.PostExecutiveMessage(new CLMessage(BENCH_STOP_ID)).IsSuccess())
+	{
+		struct timespec ts = {0, 1000000};
+		nanosleep(&ts, 0);
+	}
+
+	delete pThread;
+
+	cout << "mode=" << pstrPolicyName << " capacity=" << nCapacity << " messages=" << nMessages;
+	cout << " accepted=" << nAccepted;
+	cout << " producer_us_per_msg=" << produced * 1e6 / nMessages;
+	cout << " elapsed_s=" << GetTimeInSeconds() - begin;
+	PrintStatistics(&result);
+}
+
+//ѹnBacklogͨϢͶһϢǰȴʱ
+static void RunPriorityBench(const char *pstrPriorityName, int nPriority, unsigned long nBacklog)
+{
+	const char *pstrExecutiveName = "bench_bounded_queue_executive";
+
+	SLBoundedQueueResult result;
+	CLThreadForMsgLoop *pThread = new CLThreadForMsgLoop(new CLSlowConsumerObserver(&result), pstrExecutiveName, true);
+
+	if(!pThread->Run(0).IsSuccess())
+	{
+		cout << "Run error" << endl;
+		return;
+	}
+
+	CLExecutiveHandle handle(pstrExecutiveName);
+
+	for(unsigned long i = 0; i < nBacklog; i++)
+		handle.PostExecutiveMessage(new CLMessage(BENCH_WORK_ID));
+
+	handle.PostExecutiveMessage(new CLUrgentMsg(nPriority));
+	handle.PostExecutiveMessage(new CLMessage(BENCH_STOP_ID));
+
+	delete pThread;
+
+	cout << "mode=urgent_" << pstrPriorityName << " backlog=" << nBacklog;
+	cout << " urgent_latency_us=" << result.UrgentLatency * 1e6;
+	PrintStatistics(&result);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nMessages = (argc > 1) ? strtoul(argv[1], 0, 10) : 200000;
+	unsigned long nCapacity = (argc > 2) ? strtoul(argv[2], 0, 10) : 1024;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	RunOverflowBench("unbounded", MESSAGE_QUEUE_UNBOUNDED, MESSAGE_QUEUE_OVERFLOW_BLOCK, nMessages);
+	RunOverflowBench("block", nCapacity, MESSAGE_QUEUE_OVERFLOW_BLOCK, nMessages);
+	RunOverflowBench("fail", nCapacity, MESSAGE_QUEUE_OVERFLOW_FAIL, nMessages);
+	RunOverflowBench("drop_oldest", nCapacity, MESSAGE_QUEUE_OVERFLOW_DROP_OLDEST, nMessages);
+
+	RunPriorityBench("normal", MESSAGE_PRIORITY_NORMAL, nMessages / 10);
+	RunPriorityBench("high", MESSAGE_PRIORITY_HIGH, nMessages / 10);
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
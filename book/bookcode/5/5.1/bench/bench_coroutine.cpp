@@ -0,0 +1,452 @@
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_PING_ID 100
+#define BENCH_PONG_ID 101
+#define BENCH_ECHO_REQUEST_ID 102
+#define BENCH_STOP_ID 103
+#define BENCH_START_ID 104
+
+#define BENCH_SCHEDULER_NAME "bench_coroutine_scheduler"
+#define BENCH_ECHO_SERVER_NAME "bench_coroutine_echo_server"
+#define BENCH_PING_THREAD_NAME "bench_coroutine_ping_thread"
+#define BENCH_PONG_THREAD_NAME "bench_coroutine_pong_thread"
+
+#define BENCH_PONG_COROUTINE_ID 0xffffffffUL
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static unsigned long GetResidentKB()
+{
+	unsigned long nSize = 0, nResident = 0;
+
+	FILE *fp = fopen("/proc/self/statm", "r");
+	if(fp == 0)
+		return 0;
+
+	if(fscanf(fp, "%lu %lu", &nSize, &nResident) != 2)
+		nResident = 0;
+
+	fclose(fp);
+
+	return nResident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+//ֻɵ߳޸ģ߳pFinishedúȡ
+struct SLBenchResult
+{
+	unsigned long nTarget;
+	unsigned long nFinished;
+	unsigned long nErrors;
+	CLEvent *pFinished;
+};
+
+static void Finish(SLBenchResult *pResult)
+{
+	if(++pResult->nFinished == pResult->nTarget)
+		pResult->pFinished->Set();
+}
+
+class CLEchoRequest : public CLRequestMessage
+{
+public:
+	CLEchoRequest(unsigned long nValue) : CLRequestMessage(BENCH_ECHO_REQUEST_ID)
+	{
+		m_nValue = nValue;
+	}
+
+	unsigned long m_nValue;
+};
+
+class CLEchoResponse : public CLResponseMessage
+{
+public:
+	CLEchoResponse(unsigned long nValue)
+	{
+		m_nValue = nValue;
+	}
+
+	unsigned long m_nValue;
+};
+
+class CLEchoServer : public CLMessageObserver
+{
+public:
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_ECHO_REQUEST_ID, (CallBackForMessageLoop)(&CLEchoServer::On_Echo));
+		pMessageLoop->Register(BENCH_STOP_ID, (CallBackForMessageLoop)(&CLEchoServer::On_Stop));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Echo(CLMessage *pm)
+	{
+		CLEchoRequest *pRequest = (CLEchoRequest *)pm;
+		pRequest->Reply(new CLEchoResponse(pRequest->m_nValue));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Stop(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+};
+
+//ȴnRoundsPING
+class CLPingReceiver : public CLCoroutineExecutive
+{
+public:
+	CLPingReceiver(unsigned long nRounds) : CLCoroutineExecutive(16 * 1024)
+	{
+		m_nRounds = nRounds;
+	}
+
+	virtual CLStatus RunExecutiveFunction(void *pContext)
+	{
+		for(unsigned long i = 0; i < m_nRounds; i++)
+		{
+			if(WaitForMessage(BENCH_PING_ID) == 0)
+				((SLBenchResult *)pContext)->nErrors++;
+		}
+
+		Finish((SLBenchResult *)pContext);
+		return CLStatus(0, 0);
+	}
+
+	unsigned long m_nRounds;
+};
+
+//ͬһЭִ֮һһ
+class CLPonger : public CLCoroutineExecutive
+{
+public:
+	virtual CLStatus RunExecutiveFunction(void *pContext)
+	{
+		while(true)
+		{
+			CLMessage *pMsg = WaitForAnyMessage();
+			if(pMsg->m_clMsgID == BENCH_STOP_ID)
+				break;
+
+			CLCoroutineScheduler::PostCoroutineMessage(BENCH_SCHEDULER_NAME, ((CLPingMessage *)pMsg)->m_nFrom, new CLMessage(BENCH_PONG_ID));
+		}
+
+		return CLStatus(0, 0);
+	}
+
+	class CLPingMessage : public CLMessage
+	{
+	public:
+		CLPingMessage(unsigned long nFrom) : CLMessage(BENCH_PING_ID)
+		{
+			m_nFrom = nFrom;
+		}
+
+		unsigned long m_nFrom;
+	};
+};
+
+class CLPinger : public CLCoroutineExecutive
+{
+public:
+	CLPinger(unsigned long nRounds)
+	{
+		m_nRounds = nRounds;
+	}
+
+	virtual CLStatus RunExecutiveFunction(void *pContext)
+	{
+		for(unsigned long i = 0; i < m_nRounds; i++)
+		{
+			CLCoroutineScheduler::PostCoroutineMessage(BENCH_SCHEDULER_NAME, BENCH_PONG_COROUTINE_ID, new CLPonger::CLPingMessage(GetCoroutineID()));
+			WaitForMessage(BENCH_PONG_ID);
+		}
+
+		CLCoroutineScheduler::PostCoroutineMessage(BENCH_SCHEDULER_NAME, BENCH_PONG_COROUTINE_ID, new CLMessage(BENCH_STOP_ID));
+
+		Finish((SLBenchResult *)pContext);
+		return CLStatus(0, 0);
+	}
+
+	unsigned long m_nRounds;
+};
+
+//˳һ߳еִ巢󲢵ȴӦ
+class CLRequester : public CLCoroutineExecutive
+{
+public:
+	CLRequester(unsigned long nRequests, unsigned long lTimeoutMs)
+	{
+		m_nRequests = nRequests;
+		m_lTimeoutMs = lTimeoutMs;
+	}
+
+	virtual CLStatus RunExecutiveFunction(void *pContext)
+	{
+		SLBenchResult *pResult = (SLBenchResult *)pContext;
+
+		for(unsigned long i = 0; i < m_nRequests; i++)
+		{
+			CLEchoResponse *pResponse = (CLEchoResponse *)SendRequestAndWait(BENCH_ECHO_SERVER_NAME, new CLEchoRequest(i), m_lTimeoutMs);
+			if((pResponse == 0) || (pResponse->m_nValue != i))
+				pResult->nErrors++;
+		}
+
+		Finish(pResult);
+		return CLStatus(0, 0);
+	}
+
+	unsigned long m_nRequests;
+	unsigned long m_lTimeoutMs;
+};
+
+class CLSleeper : public CLCoroutineExecutive
+{
+public:
+	CLSleeper(unsigned long lMs) : CLCoroutineExecutive(16 * 1024)
+	{
+		m_lMs = lMs;
+	}
+
+	virtual CLStatus RunExecutiveFunction(void *pContext)
+	{
+		if(!Sleep(m_lMs).IsSuccess())
+			((SLBenchResult *)pContext)->nErrors++;
+
+		//ûϢʱӦʱ0
+		if(WaitForMessage(BENCH_PING_ID, m_lMs) != 0)
+			((SLBenchResult *)pContext)->nErrors++;
+
+		Finish((SLBenchResult *)pContext);
+		return CLStatus(0, 0);
+	}
+
+	unsigned long m_lMs;
+};
+
+//Ϊգִ֮߳ͨϢһһ
+class CLThreadPinger : public CLMessageObserver
+{
+public:
+	CLThreadPinger(unsigned long nRounds, SLBenchResult *pResult)
+	{
+		m_nRounds = nRounds;
+		m_nSent = 0;
+		m_pResult = pResult;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_START_ID, (CallBackForMessageLoop)(&CLThreadPinger::On_Pong));
+		pMessageLoop->Register(BENCH_PONG_ID, (CallBackForMessageLoop)(&CLThreadPinger::On_Pong));
+		pMessageLoop->Register(BENCH_STOP_ID, (CallBackForMessageLoop)(&CLThreadPinger::On_Stop));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Pong(CLMessage *pm)
+	{
+		if(m_nSent++ < m_nRounds)
+			CLExecutiveNameServer::PostExecutiveMessage(BENCH_PONG_THREAD_NAME, new CLMessage(BENCH_PING_ID));
+		else
+			Finish(m_pResult);
+
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Stop(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+
+	unsigned long m_nRounds;
+	unsigned long m_nSent;
+	SLBenchResult *m_pResult;
+};
+
+class CLThreadPonger : public CLMessageObserver
+{
+public:
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_PING_ID, (CallBackForMessageLoop)(&CLThreadPonger::On_Ping));
+		pMessageLoop->Register(BENCH_STOP_ID, (CallBackForMessageLoop)(&CLThreadPonger::On_Stop));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Ping(CLMessage *pm)
+	{
+		CLExecutiveNameServer::PostExecutiveMessage(BENCH_PING_THREAD_NAME, new CLMessage(BENCH_PONG_ID));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Stop(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+};
+
+static void RunManyCoroutines(unsigned long nCoroutines, unsigned long nRounds)
+{
+	CLEvent finished;
+	SLBenchResult result = {nCoroutines, 0, 0, &finished};
+
+	unsigned long nBeforeKB = GetResidentKB();
+	double begin = GetTimeInSeconds();
+
+	for(unsigned long i = 0; i < nCoroutines; i++)
+		CLCoroutineScheduler::Spawn(BENCH_SCHEDULER_NAME, i, new CLPingReceiver(nRounds), &result);
+
+	//ͶһPINGΪͬ㣬ʱЭִ嶼ڵȴ
+	CLCoroutineScheduler::PostCoroutineMessage(BENCH_SCHEDULER_NAME, 0, new CLMessage(BENCH_PING_ID));
+
+	double spawned = GetTimeInSeconds();
+	unsigned long nAfterKB = GetResidentKB();
+
+	for(unsigned long r = 0; r < nRounds; r++)
+	{
+		for(unsigned long i = 0; i < nCoroutines; i++)
+		{
+			if((r == 0) && (i == 0))
+				continue;
+
+			CLCoroutineScheduler::PostCoroutineMessage(BENCH_SCHEDULER_NAME, i, new CLMessage(BENCH_PING_ID));
+		}
+	}
+
+	finished.Wait();
+	double elapsed = GetTimeInSeconds() - spawned;
+
+	cout << "mode=many_coroutines coroutines=" << nCoroutines << " rounds=" << nRounds;
+	cout << " spawn_us_per_coroutine=" << (spawned - begin) * 1e6 / nCoroutines;
+	cout << " rss_kb_per_coroutine=" << (double)(nAfterKB - nBeforeKB) / nCoroutines;
+	cout << " ns_per_delivery=" << elapsed * 1e9 / (nCoroutines * nRounds);
+	cout << " errors=" << result.nErrors << endl;
+}
+
+static void RunPingPong(unsigned long nRounds)
+{
+	CLEvent finished;
+	SLBenchResult result = {1, 0, 0, &finished};
+
+	CLCoroutineScheduler::Spawn(BENCH_SCHEDULER_NAME, BENCH_PONG_COROUTINE_ID, new CLPonger);
+
+	double begin = GetTimeInSeconds();
+	CLCoroutineScheduler::Spawn(BENCH_SCHEDULER_NAME, 1, new CLPinger(nRounds), &result);
+	finished.Wait();
+	double elapsed = GetTimeInSeconds() - begin;
+
+	cout << "mode=coroutine_ping_pong rounds=" << nRounds;
+	cout << " ns_per_round_trip=" << elapsed * 1e9 / nRounds << endl;
+}
+
+static void RunThreadPingPong(unsigned long nRounds)
+{
+	CLEvent finished;
+	SLBenchResult result = {1, 0, 0, &finished};
+
+	CLThreadForMsgLoop *pPinger = new CLThreadForMsgLoop(new CLThreadPinger(nRounds, &result), BENCH_PING_THREAD_NAME, true);
+	CLThreadForMsgLoop *pPonger = new CLThreadForMsgLoop(new CLThreadPonger, BENCH_PONG_THREAD_NAME, true);
+
+	if((!pPinger->Run(0).IsSuccess()) || (!pPonger->Run(0).IsSuccess()))
+	{
+		cout << "Run error" << endl;
+		return;
+	}
+
+	double begin = GetTimeInSeconds();
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_PING_THREAD_NAME, new CLMessage(BENCH_START_ID));
+	finished.Wait();
+	double elapsed = GetTimeInSeconds() - begin;
+
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_PING_THREAD_NAME, new CLMessage(BENCH_STOP_ID));
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_PONG_THREAD_NAME, new CLMessage(BENCH_STOP_ID));
+	delete pPinger;
+	delete pPonger;
+
+	cout << "mode=thread_ping_pong rounds=" << nRounds;
+	cout << " ns_per_round_trip=" << elapsed * 1e9 / nRounds << endl;
+}
+
+static void RunRequests(unsigned long nCoroutines, unsigned long nRequests, unsigned long lTimeoutMs)
+{
+	CLEvent finished;
+	SLBenchResult result = {nCoroutines, 0, 0, &finished};
+
+	double begin = GetTimeInSeconds();
+	for(unsigned long i = 0; i < nCoroutines; i++)
+		CLCoroutineScheduler::Spawn(BENCH_SCHEDULER_NAME, i, new CLRequester(nRequests, lTimeoutMs), &result);
+
+	finished.Wait();
+	double elapsed = GetTimeInSeconds() - begin;
+
+	cout << "mode=await_request coroutines=" << nCoroutines << " requests=" << nCoroutines * nRequests;
+	cout << " timeout_ms=" << lTimeoutMs;
+	cout << " req_per_sec=" << (unsigned long)(nCoroutines * nRequests / elapsed);
+	cout << " errors=" << result.nErrors << endl;
+}
+
+static void RunSleepers(unsigned long nCoroutines, unsigned long lMs)
+{
+	CLEvent finished;
+	SLBenchResult result = {nCoroutines, 0, 0, &finished};
+
+	double begin = GetTimeInSeconds();
+	for(unsigned long i = 0; i < nCoroutines; i++)
+		CLCoroutineScheduler::Spawn(BENCH_SCHEDULER_NAME, i, new CLSleeper(lMs), &result);
+
+	finished.Wait();
+	double elapsed = GetTimeInSeconds() - begin;
+
+	cout << "mode=sleep_then_timeout coroutines=" << nCoroutines << " sleep_ms=" << lMs << " timeout_ms=" << lMs;
+	cout << " elapsed_ms=" << elapsed * 1000;
+	cout << " errors=" << result.nErrors << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nCoroutines = (argc > 1) ? strtoul(argv[1], 0, 10) : 10000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	CLThreadForMsgLoop *pScheduler = new CLThreadForMsgLoop(new CLCoroutineScheduler, BENCH_SCHEDULER_NAME, true);
+	CLThreadForMsgLoop *pServer = new CLThreadForMsgLoop(new CLEchoServer, BENCH_ECHO_SERVER_NAME, true);
+
+	if((!pScheduler->Run(0).IsSuccess()) || (!pServer->Run(0).IsSuccess()))
+	{
+		cout << "Run error" << endl;
+		return 0;
+	}
+
+	RunManyCoroutines(nCoroutines, 20);
+	RunPingPong(200000);
+	RunThreadPingPong(200000);
+	RunRequests(1, 100000, 0);
+	RunRequests(64, 2000, 0);
+	RunRequests(64, 2000, 1000);
+	RunSleepers(1000, 20);
+
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_SCHEDULER_NAME, new CLMessage(COROUTINE_SCHEDULER_QUIT_ID));
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_ECHO_SERVER_NAME, new CLMessage(BENCH_STOP_ID));
+	delete pScheduler;
+	delete pServer;
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
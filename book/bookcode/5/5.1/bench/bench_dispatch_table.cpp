@@ -0,0 +1,112 @@
+#include <iostream>
+#include <map>
+#include <vector>
+#include <stdlib.h>
+#include <time.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+class CLBenchDispatchObserver : public CLMessageObserver
+{
+public:
+	CLBenchDispatchObserver()
+	{
+		m_nCalls = 0;
+	}
+
+	virtual ~CLBenchDispatchObserver()
+	{
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Message(CLMessage *pm)
+	{
+		m_nCalls++;
+		return CLStatus(0, 0);
+	}
+
+public:
+	unsigned long m_nCalls;
+};
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void GenerateIDs(vector<unsigned long>& IDs, unsigned int nCount, bool bSparse)
+{
+	for(unsigned int i = 0; i < nCount; i++)
+	{
+		if(bSparse)
+			IDs.push_back(100000 + (unsigned long)i * 7919);
+		else
+			IDs.push_back(i + 1);
+	}
+}
+
+static void RunBench(unsigned int nCount, bool bSparse, unsigned long nLookups)
+{
+	vector<unsigned long> IDs;
+	GenerateIDs(IDs, nCount, bSparse);
+
+	vector<unsigned long> Sequence;
+	srand(nCount);
+	for(unsigned int i = 0; i < 4096; i++)
+		Sequence.push_back(IDs[rand() % nCount]);
+
+	CallBackForMessageLoop pFunction = (CallBackForMessageLoop)(&CLBenchDispatchObserver::On_Message);
+	CLBenchDispatchObserver observer;
+	CLMessageObserver *pObserver = &observer;
+
+	map<unsigned long, CallBackForMessageLoop> MapTable;
+	CLMessageIDTable<CallBackForMessageLoop> IDTable;
+	for(unsigned int i = 0; i < nCount; i++)
+	{
+		MapTable[IDs[i]] = pFunction;
+		IDTable.Set(IDs[i], pFunction);
+	}
+
+	double begin = GetTimeInSeconds();
+	for(unsigned long i = 0; i < nLookups; i++)
+	{
+		map<unsigned long, CallBackForMessageLoop>::iterator it = MapTable.find(Sequence[i & 4095]);
+		if(it != MapTable.end())
+			(pObserver->*(it->second))(0);
+	}
+	double map_ns = (GetTimeInSeconds() - begin) * 1e9 / nLookups;
+
+	begin = GetTimeInSeconds();
+	for(unsigned long i = 0; i < nLookups; i++)
+	{
+		CallBackForMessageLoop *ppFunction = IDTable.Find(Sequence[i & 4095]);
+		if(ppFunction != 0)
+			(pObserver->*(*ppFunction))(0);
+	}
+	double table_ns = (GetTimeInSeconds() - begin) * 1e9 / nLookups;
+
+	cout << "ids=" << nCount << " layout=" << (bSparse ? "sparse" : "dense");
+	cout << " std_map_ns_per_msg=" << map_ns << " id_table_ns_per_msg=" << table_ns;
+	cout << " calls=" << observer.m_nCalls << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nLookups = (argc > 1) ? strtoul(argv[1], 0, 10) : 10000000;
+
+	unsigned int Counts[] = {10, 100, 1000};
+	for(unsigned int i = 0; i < sizeof(Counts) / sizeof(Counts[0]); i++)
+	{
+		RunBench(Counts[i], false, nLookups);
+		RunBench(Counts[i], true, nLookups);
+	}
+
+	return 0;
+}
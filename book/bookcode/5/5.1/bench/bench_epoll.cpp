@@ -0,0 +1,241 @@
+#include <iostream>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_MESSAGE_ID 1
+#define BENCH_SOCKET_DATA_ID 2
+
+#define BENCH_QUIT_BYTE 'q'
+
+#define BENCH_EPOLL_SOCKET 0
+#define BENCH_EPOLL_MESSAGE 1
+#define BENCH_IO_THREAD_SOCKET 2
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+class CLSocketDataMsg : public CLMessage
+{
+public:
+	CLSocketDataMsg(char Data) : CLMessage(BENCH_SOCKET_DATA_ID)
+	{
+		m_Data = Data;
+	}
+
+	char m_Data;
+};
+
+//ֱִepollд׽֣յһֽڼдյϢʱҲдһֽ
+class CLEpollObserver : public CLMessageObserver
+{
+public:
+	CLEpollObserver(int fd)
+	{
+		m_fd = fd;
+		m_nExpirations = 0;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		CLMsgLoopManagerForEpoll *pLoop = (CLMsgLoopManagerForEpoll *)pMessageLoop;
+
+		pLoop->Register(BENCH_MESSAGE_ID, (CallBackForMessageLoop)(&CLEpollObserver::On_Message));
+
+		if(pLoop->CreateTimer(1, 1, (CallBackForTimer)(&CLEpollObserver::On_Timer)) == -1)
+			return CLStatus(-1, 0);
+
+		return pLoop->RegisterFileDescriptor(m_fd, EPOLLIN, (CallBackForFileDescriptor)(&CLEpollObserver::On_Socket));
+	}
+
+	CLStatus On_Socket(int fd, unsigned int nEvents)
+	{
+		char c;
+		if(read(fd, &c, 1) != 1)
+			return CLStatus(QUIT_MESSAGE_LOOP, 0);
+
+		if(c == BENCH_QUIT_BYTE)
+			return CLStatus(QUIT_MESSAGE_LOOP, 0);
+
+		write(fd, &c, 1);
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Message(CLMessage *pm)
+	{
+		char c = 'm';
+		write(m_fd, &c, 1);
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Timer(int nTimerID, unsigned long nExpirations)
+	{
+		m_nExpirations += nExpirations;
+		return CLStatus(0, 0);
+	}
+
+	int m_fd;
+	unsigned long m_nExpirations;
+};
+
+//ԭI/O߳׽֣Ϣתִ崦
+class CLHandoffObserver : public CLMessageObserver
+{
+public:
+	CLHandoffObserver(int fd)
+	{
+		m_fd = fd;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_SOCKET_DATA_ID, (CallBackForMessageLoop)(&CLHandoffObserver::On_SocketData));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_SocketData(CLMessage *pm)
+	{
+		CLSocketDataMsg *p = (CLSocketDataMsg *)pm;
+		if(p->m_Data == BENCH_QUIT_BYTE)
+			return CLStatus(QUIT_MESSAGE_LOOP, 0);
+
+		write(m_fd, &p->m_Data, 1);
+		return CLStatus(0, 0);
+	}
+
+	int m_fd;
+};
+
+struct SLIOThreadContext
+{
+	int fd;
+	const char *pstrExecutiveName;
+};
+
+static void *IOThread(void *pContext)
+{
+	SLIOThreadContext *p = (SLIOThreadContext *)pContext;
+
+	char c;
+	while(read(p->fd, &c, 1) == 1)
+	{
+		CLExecutiveNameServer::PostExecutiveMessage(p->pstrExecutiveName, new CLSocketDataMsg(c));
+		if(c == BENCH_QUIT_BYTE)
+			break;
+	}
+
+	return 0;
+}
+
+static void RunBench(const char *pstrMode, int nMode, unsigned long nRoundTrips)
+{
+	const char *pstrExecutiveName = "bench_epoll_executive";
+
+	int fds[2];
+	if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1)
+	{
+		cout << "socketpair error" << endl;
+		return;
+	}
+
+	CLEpollObserver *pEpollObserver = 0;
+	CLThreadForMsgLoop *pThread = 0;
+	pthread_t IOThreadID;
+	SLIOThreadContext context;
+
+	if(nMode == BENCH_IO_THREAD_SOCKET)
+	{
+		pThread = new CLThreadForMsgLoop(new CLHandoffObserver(fds[1]), pstrExecutiveName, true, EXECUTIVE_IN_PROCESS_USE_STL_QUEUE);
+
+		context.fd = fds[1];
+		context.pstrExecutiveName = pstrExecutiveName;
+	}
+	else
+	{
+		pEpollObserver = new CLEpollObserver(fds[1]);
+		pThread = new CLThreadForMsgLoop(pEpollObserver, pstrExecutiveName, true, EXECUTIVE_IN_PROCESS_USE_EPOLL);
+	}
+
+	if(!pThread->Run(0).IsSuccess())
+	{
+		cout << "Run error" << endl;
+		return;
+	}
+
+	if(nMode == BENCH_IO_THREAD_SOCKET)
+		pthread_create(&IOThreadID, 0, IOThread, &context);
+
+	CLExecutiveHandle handle(pstrExecutiveName);
+
+	unsigned long nCorrect = 0;
+	double begin = GetTimeInSeconds();
+
+	for(unsigned long i = 0; i < nRoundTrips; i++)
+	{
+		char c = 'a' + (i % 16);
+
+		if(nMode == BENCH_EPOLL_MESSAGE)
+		{
+			handle.PostExecutiveMessage(new CLMessage(BENCH_MESSAGE_ID));
+			c = 'm';
+		}
+		else
+			write(fds[0], &c, 1);
+
+		char r;
+		if((read(fds[0], &r, 1) == 1) && (r == c))
+			nCorrect++;
+	}
+
+	double elapsed = GetTimeInSeconds() - begin;
+
+	char q = BENCH_QUIT_BYTE;
+	write(fds[0], &q, 1);
+
+	unsigned long nExpirations = 0;
+	if(pEpollObserver != 0)
+		nExpirations = pEpollObserver->m_nExpirations;
+
+	delete pThread;
+
+	if(nMode == BENCH_IO_THREAD_SOCKET)
+		pthread_join(IOThreadID, 0);
+
+	cout << "mode=" << pstrMode << " round_trips=" << nRoundTrips;
+	cout << " us_per_round_trip=" << elapsed * 1e6 / nRoundTrips;
+	cout << " round_trips_per_sec=" << (unsigned long)(nRoundTrips / elapsed);
+	if(nMode != BENCH_IO_THREAD_SOCKET)
+		cout << " timer_expirations=" << nExpirations;
+	cout << " echoed=" << ((nCorrect == nRoundTrips) ? "ok" : "error") << endl;
+
+	close(fds[0]);
+	close(fds[1]);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nRoundTrips = (argc > 1) ? strtoul(argv[1], 0, 10) : 200000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	RunBench("io_thread_handoff", BENCH_IO_THREAD_SOCKET, nRoundTrips);
+	RunBench("epoll_socket", BENCH_EPOLL_SOCKET, nRoundTrips);
+	RunBench("epoll_message", BENCH_EPOLL_MESSAGE, nRoundTrips);
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
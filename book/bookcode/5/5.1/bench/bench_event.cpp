@@ -0,0 +1,208 @@
+#include <iostream>
+#include <string>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "LibExecutive.h"
+#include "CLSharedEventImpl.h"
+
+using namespace std;
+
+static long GetTimeInNanoseconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+//Ϊfutexʵ֮ǰCLEventSetWaitҪȡSetǻ
+class CLMutexCondEvent
+{
+public:
+	CLMutexCondEvent()
+	{
+		m_pEventInfo = new SLEventInfo;
+		m_pEventInfo->Flag = 0;
+		m_pEventInfo->bSemaphore = 0;
+		m_pMutex = new CLMutex;
+		m_pCond = new CLConditionVariable;
+		m_strName = "";
+	}
+
+	explicit CLMutexCondEvent(const char *pstrName)
+	{
+		m_pEventInfo = CLSharedEventAllocator::Get(pstrName);
+		m_pMutex = new CLMutex(pstrName, MUTEX_USE_SHARED_PTHREAD);
+		m_pCond = new CLConditionVariable(pstrName);
+		m_strName = pstrName;
+	}
+
+	~CLMutexCondEvent()
+	{
+		delete m_pCond;
+		delete m_pMutex;
+
+		if(m_strName.empty())
+			delete m_pEventInfo;
+		else
+			CLSharedEventAllocator::Release(m_strName.c_str());
+	}
+
+	CLStatus Set()
+	{
+		{
+			CLCriticalSection cs(m_pMutex);
+			m_pEventInfo->Flag = m_pEventInfo->Flag + 1;
+		}
+
+		return m_pCond->Wakeup();
+	}
+
+	CLStatus Wait()
+	{
+		CLCriticalSection cs(m_pMutex);
+
+		while(m_pEventInfo->Flag == 0)
+			m_pCond->Wait(m_pMutex);
+
+		m_pEventInfo->Flag = 0;
+
+		return CLStatus(0, 0);
+	}
+
+private:
+	SLEventInfo *m_pEventInfo;
+	CLMutex *m_pMutex;
+	CLConditionVariable *m_pCond;
+	string m_strName;
+};
+
+template<typename TEvent>
+struct SLPingPong
+{
+	TEvent *pPing;
+	TEvent *pPong;
+	unsigned long nRounds;
+};
+
+template<typename TEvent>
+static void* PongThread(void *pContext)
+{
+	SLPingPong<TEvent> *p = (SLPingPong<TEvent> *)pContext;
+
+	for(unsigned long i = 0; i < p->nRounds; i++)
+	{
+		p->pPing->Wait();
+		p->pPong->Set();
+	}
+
+	return 0;
+}
+
+template<typename TEvent>
+static void RunPingPong(const char *pstrImpl, TEvent *pPing, TEvent *pPong, unsigned long nRounds, bool bBetweenProcess)
+{
+	SLPingPong<TEvent> pp;
+	pp.pPing = pPing;
+	pp.pPong = pPong;
+	pp.nRounds = nRounds;
+
+	pthread_t tid;
+	pid_t pid = -1;
+
+	if(bBetweenProcess)
+	{
+		pid = fork();
+		if(pid == 0)
+		{
+			PongThread<TEvent>(&pp);
+			_exit(0);
+		}
+	}
+	else
+		pthread_create(&tid, 0, PongThread<TEvent>, &pp);
+
+	long begin = GetTimeInNanoseconds();
+
+	for(unsigned long i = 0; i < nRounds; i++)
+	{
+		pPing->Set();
+		pPong->Wait();
+	}
+
+	long elapsed = GetTimeInNanoseconds() - begin;
+
+	if(bBetweenProcess)
+		waitpid(pid, 0, 0);
+	else
+		pthread_join(tid, 0);
+
+	cout << "mode=ping_pong impl=" << pstrImpl << " scope=" << (bBetweenProcess ? "process" : "thread") << " rounds=" << nRounds;
+	cout << " round_trip_ns=" << elapsed / nRounds << endl;
+}
+
+//޾ʱһSetһWaitĿ
+template<typename TEvent>
+static void RunUncontended(const char *pstrImpl, TEvent *pEvent, unsigned long nRounds)
+{
+	long begin = GetTimeInNanoseconds();
+
+	for(unsigned long i = 0; i < nRounds; i++)
+	{
+		pEvent->Set();
+		pEvent->Wait();
+	}
+
+	long elapsed = GetTimeInNanoseconds() - begin;
+
+	cout << "mode=uncontended impl=" << pstrImpl << " rounds=" << nRounds << " set_wait_ns=" << elapsed / nRounds << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nRounds = (argc > 1) ? strtoul(argv[1], 0, 10) : 100000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	{
+		CLMutexCondEvent e;
+		RunUncontended("mutex_cond", &e, nRounds * 10);
+	}
+
+	{
+		CLEvent e;
+		RunUncontended("futex", &e, nRounds * 10);
+	}
+
+	{
+		CLMutexCondEvent ping, pong;
+		RunPingPong("mutex_cond", &ping, &pong, nRounds, false);
+	}
+
+	{
+		CLEvent ping, pong;
+		RunPingPong("futex", &ping, &pong, nRounds, false);
+	}
+
+	{
+		CLMutexCondEvent ping("bench_event_old_ping"), pong("bench_event_old_pong");
+		RunPingPong("mutex_cond", &ping, &pong, nRounds, true);
+	}
+
+	{
+		CLEvent ping("bench_event_ping"), pong("bench_event_pong");
+		RunPingPong("futex", &ping, &pong, nRounds, true);
+	}
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
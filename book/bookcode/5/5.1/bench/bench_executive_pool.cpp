@@ -0,0 +1,190 @@
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+#include <time.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define WORK_MESSAGE_ID 1
+#define QUIT_MESSAGE_ID 2
+
+#define NUMBER_OF_AFFINITY_KEYS 64
+
+static long GetTimeInNanoseconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+class CLWorkMsg : public CLMessage
+{
+public:
+	CLWorkMsg(unsigned long nIterations, unsigned long lKey, unsigned long nSequence) : CLMessage(WORK_MESSAGE_ID)
+	{
+		m_nIterations = nIterations;
+		m_lKey = lKey;
+		m_nSequence = nSequence;
+	}
+
+public:
+	unsigned long m_nIterations;
+	unsigned long m_lKey;
+	unsigned long m_nSequence;
+};
+
+class CLQuitMsg : public CLMessage
+{
+public:
+	CLQuitMsg() : CLMessage(QUIT_MESSAGE_ID)
+	{
+	}
+};
+
+struct SLBenchState
+{
+	unsigned long nTotal;
+	volatile unsigned long nProcessed;
+	volatile unsigned long nOrderErrors;
+	volatile unsigned long Checksum;
+	unsigned long LastSequence[NUMBER_OF_AFFINITY_KEYS];
+	CLEvent *pDone;
+};
+
+class CLWorkObserver : public CLMessageObserver
+{
+public:
+	CLWorkObserver(SLBenchState *pState)
+	{
+		m_pState = pState;
+	}
+
+	virtual ~CLWorkObserver()
+	{
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(WORK_MESSAGE_ID, (CallBackForMessageLoop)(&CLWorkObserver::On_Work));
+		pMessageLoop->Register(QUIT_MESSAGE_ID, (CallBackForMessageLoop)(&CLWorkObserver::On_Quit));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Work(CLMessage *pm)
+	{
+		CLWorkMsg *p = (CLWorkMsg *)pm;
+
+		unsigned long x = p->m_nSequence;
+		for(unsigned long i = 0; i < p->m_nIterations; i++)
+			x = x * 6364136223846793005UL + 1442695040888963407UL;
+
+		__sync_fetch_and_add(&(m_pState->Checksum), x);
+
+		//ͬһ׺ͼϢֻһ̴߳ͬ
+		if(p->m_lKey != (unsigned long)-1)
+		{
+			unsigned long k = p->m_lKey % NUMBER_OF_AFFINITY_KEYS;
+			if(p->m_nSequence <= m_pState->LastSequence[k])
+				__sync_fetch_and_add(&(m_pState->nOrderErrors), 1);
+
+			m_pState->LastSequence[k] = p->m_nSequence;
+		}
+
+		if(__sync_add_and_fetch(&(m_pState->nProcessed), 1) == m_pState->nTotal)
+			m_pState->pDone->Set();
+
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Quit(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+
+private:
+	SLBenchState *m_pState;
+};
+
+/*
+bSkewedΪtrueʱÿ64ϢһļϢ64ڹ۲ȡЧ
+bAffinityΪtrueʱϢ׺ͼͬһ׺ͼϢǷ
+*/
+static void RunBench(const char *pstrMode, unsigned int nWorkers, unsigned long nMessages, bool bSkewed, bool bAffinity)
+{
+	CLEvent done;
+
+	SLBenchState state;
+	state.nTotal = nMessages;
+	state.nProcessed = 0;
+	state.nOrderErrors = 0;
+	state.Checksum = 0;
+	for(int i = 0; i < NUMBER_OF_AFFINITY_KEYS; i++)
+		state.LastSequence[i] = 0;
+	state.pDone = &done;
+
+	long begin = 0;
+	{
+		vector<CLMessageObserver*> Observers;
+		for(unsigned int i = 0; i < nWorkers; i++)
+			Observers.push_back(new CLWorkObserver(&state));
+
+		CLExecutivePool pool(Observers, "bench_executive_pool", true);
+		if(!pool.Run(0).IsSuccess())
+		{
+			cout << "pool Run error" << endl;
+			return;
+		}
+
+		begin = GetTimeInNanoseconds();
+
+		for(unsigned long i = 1; i <= nMessages; i++)
+		{
+			unsigned long nIterations = 2000;
+			if((bSkewed) && (i % 64 == 0))
+				nIterations *= 64;
+
+			if(bAffinity)
+			{
+				unsigned long lKey = i % NUMBER_OF_AFFINITY_KEYS;
+				CLExecutivePool::PostExecutiveMessage("bench_executive_pool", new CLWorkMsg(nIterations, lKey, i), lKey);
+			}
+			else
+				CLExecutiveNameServer::PostExecutiveMessage("bench_executive_pool", new CLWorkMsg(nIterations, (unsigned long)-1, i));
+		}
+
+		done.Wait();
+
+		CLExecutiveNameServer::PostExecutiveMessage("bench_executive_pool", new CLQuitMsg);
+	}
+
+	double elapsed = (GetTimeInNanoseconds() - begin) / 1e9;
+
+	cout << "mode=" << pstrMode << " workers=" << nWorkers << " skewed=" << bSkewed << " messages=" << nMessages;
+	cout << " elapsed_ms=" << elapsed * 1000 << " msgs_per_sec=" << (unsigned long)(nMessages / elapsed);
+	cout << " processed=" << state.nProcessed << " order_errors=" << state.nOrderErrors << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nMessages = (argc > 1) ? strtoul(argv[1], 0, 10) : 20000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	unsigned int Workers[] = {1, 2, 4, 8};
+	for(unsigned int i = 0; i < sizeof(Workers) / sizeof(Workers[0]); i++)
+	{
+		RunBench("balanced", Workers[i], nMessages, false, false);
+		RunBench("balanced", Workers[i], nMessages, true, false);
+		RunBench("affinity", Workers[i], nMessages, false, true);
+	}
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_MODE_MUTEX 0
+#define BENCH_MODE_ASYNC_BLOCK 1
+#define BENCH_MODE_ASYNC_DROP 2
+
+static long GetTimeInNanoseconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+static unsigned long g_nLogsPerThread = 0;
+
+static void* LogWorker(void *pContext)
+{
+	for(unsigned long i = 0; i < g_nLogsPerThread; i++)
+		CLLogger::WriteLogMsg("In LogWorker(), bench_logger error storm", (long)i);
+
+	return 0;
+}
+
+static long GetLogFileSize()
+{
+	struct stat st;
+	if(stat("logger", &st) == -1)
+		return 0;
+
+	return st.st_size;
+}
+
+//ÿģʽڵӽУΪCLLibExecutiveInitializerֻܳʼһ
+static void RunBench(int Mode, int nThreads, unsigned long nLogsPerThread)
+{
+	unlink("logger");
+
+	pid_t pid = fork();
+	if(pid == -1)
+	{
+		cout << "fork error" << endl;
+		exit(0);
+	}
+
+	if(pid != 0)
+	{
+		waitpid(pid, 0, 0);
+		return;
+	}
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		_exit(0);
+	}
+
+	const char *pstrMode = "mutex";
+	if(Mode == BENCH_MODE_ASYNC_BLOCK)
+	{
+		pstrMode = "async_block";
+		CLLogger::EnableAsyncMode(DEFAULT_SIZE_OF_LOGGER_THREAD_BUFFER, LOGGER_OVERFLOW_BLOCK);
+	}
+	else if(Mode == BENCH_MODE_ASYNC_DROP)
+	{
+		pstrMode = "async_drop";
+		CLLogger::EnableAsyncMode(DEFAULT_SIZE_OF_LOGGER_THREAD_BUFFER, LOGGER_OVERFLOW_DROP);
+	}
+
+	g_nLogsPerThread = nLogsPerThread;
+
+	pthread_t *pThreads = new pthread_t[nThreads];
+
+	long begin = GetTimeInNanoseconds();
+
+	for(int i = 0; i < nThreads; i++)
+		pthread_create(&pThreads[i], 0, LogWorker, 0);
+
+	for(int i = 0; i < nThreads; i++)
+		pthread_join(pThreads[i], 0);
+
+	//첽ģʽĺʱDestroyʱһдfile_bytesȷ־ûжʧ
+	double elapsed = (GetTimeInNanoseconds() - begin) / 1e9;
+
+	delete [] pThreads;
+
+	unsigned long nDropped = CLLogger::GetNumberOfDroppedLogs();
+
+	CLLibExecutiveInitializer::Destroy();
+
+	unsigned long nTotal = nThreads * nLogsPerThread;
+
+	cout << "mode=" << pstrMode << " threads=" << nThreads << " logs=" << nTotal;
+	cout << " elapsed_ms=" << elapsed * 1000 << " logs_per_sec=" << (unsigned long)(nTotal / elapsed);
+	cout << " dropped=" << nDropped << " file_bytes=" << GetLogFileSize() << endl;
+
+	_exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nLogs = (argc > 1) ? strtoul(argv[1], 0, 10) : 320000;
+
+	int Threads[] = {1, 2, 4, 8, 16, 32};
+	for(unsigned int i = 0; i < sizeof(Threads) / sizeof(Threads[0]); i++)
+	{
+		RunBench(BENCH_MODE_MUTEX, Threads[i], nLogs / Threads[i]);
+		RunBench(BENCH_MODE_ASYNC_BLOCK, Threads[i], nLogs / Threads[i]);
+		RunBench(BENCH_MODE_ASYNC_DROP, Threads[i], nLogs / Threads[i]);
+	}
+
+	unlink("logger");
+
+	return 0;
+}
@@ -0,0 +1,243 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define SIZE_OF_CORPUS_FILE (256UL * 1024 * 1024)
+#define NUMBER_OF_CORPUS_WORDS 100000
+#define MAX_WORD_LENGTH 256
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//5.3еĵʼͬĸΪһʣתΪСд
+class CLWordCountMapper : public CLMapReduceMapper
+{
+public:
+	CLWordCountMapper()
+	{
+		for(int i = 0; i < 256; i++)
+			m_Lower[i] = isalpha(i) ? (char)tolower(i) : 0;
+	}
+
+	virtual CLStatus Map(const char *pData, unsigned long nLength, CLMapReduceEmitter *pEmitter)
+	{
+		char word[MAX_WORD_LENGTH];
+		unsigned long i = 0;
+
+		while(i < nLength)
+		{
+			while((i < nLength) && (m_Lower[(unsigned char)pData[i]] == 0))
+				i++;
+
+			unsigned int n = 0;
+			string strLongWord;
+
+			while((i < nLength) && (m_Lower[(unsigned char)pData[i]] != 0))
+			{
+				if(n < MAX_WORD_LENGTH)
+					word[n] = m_Lower[(unsigned char)pData[i]];
+				else
+				{
+					if(n == MAX_WORD_LENGTH)
+						strLongWord.assign(word, MAX_WORD_LENGTH);
+
+					strLongWord += m_Lower[(unsigned char)pData[i]];
+				}
+
+				n++;
+				i++;
+			}
+
+			if(n == 0)
+				break;
+
+			if(n <= MAX_WORD_LENGTH)
+				pEmitter->Emit(word, n, 1);
+			else
+				pEmitter->Emit(strLongWord.data(), n, 1);
+		}
+
+		return CLStatus(0, 0);
+	}
+
+private:
+	char m_Lower[256];
+};
+
+//Zipfֲϣĸдÿ12ʣѴҴСֱͬӸ
+static unsigned long long GenerateCorpus(const string& strDir, unsigned long nMB)
+{
+	string strCountFile = strDir + "/.words";
+
+	FILE *fp = fopen(strCountFile.c_str(), "r");
+	if(fp != 0)
+	{
+		unsigned long nOldMB = 0;
+		unsigned long long nWords = 0;
+		int r = fscanf(fp, "%lu %llu", &nOldMB, &nWords);
+		fclose(fp);
+
+		if((r == 2) && (nOldMB == nMB))
+			return nWords;
+	}
+
+	mkdir(strDir.c_str(), 0755);
+
+	unsigned int seed = 1;
+	vector<string> Vocabulary;
+	for(int i = 0; i < NUMBER_OF_CORPUS_WORDS; i++)
+	{
+		int n = 3 + rand_r(&seed) % 10;
+		string word;
+		for(int j = 0; j < n; j++)
+			word += (char)('a' + rand_r(&seed) % 26);
+
+		Vocabulary.push_back(word);
+	}
+
+	vector<double> Cumulative;
+	double sum = 0;
+	for(int i = 0; i < NUMBER_OF_CORPUS_WORDS; i++)
+	{
+		sum += 1.0 / (i + 1);
+		Cumulative.push_back(sum);
+	}
+
+	unsigned long long nTotalBytes = (unsigned long long)nMB * 1024 * 1024;
+	unsigned long long nWritten = 0;
+	unsigned long long nWords = 0;
+
+	for(unsigned int nFile = 0; nWritten < nTotalBytes; nFile++)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "/part_%03u", nFile);
+
+		FILE *out = fopen((strDir + name).c_str(), "w");
+		if(out == 0)
+		{
+			cout << "fopen error " << strDir << name << endl;
+			exit(-1);
+		}
+
+		unsigned long long nFileBytes = 0;
+		string line;
+
+		while((nFileBytes < SIZE_OF_CORPUS_FILE) && (nWritten + nFileBytes < nTotalBytes))
+		{
+			line.clear();
+			for(int k = 0; k < 12; k++)
+			{
+				double x = (rand_r(&seed) / (RAND_MAX + 1.0)) * sum;
+				int index = lower_bound(Cumulative.begin(), Cumulative.end(), x) - Cumulative.begin();
+				if(index >= NUMBER_OF_CORPUS_WORDS)
+					index = NUMBER_OF_CORPUS_WORDS - 1;
+
+				size_t begin = line.size();
+				line += Vocabulary[index];
+				if(rand_r(&seed) % 8 == 0)
+					line[begin] = toupper(line[begin]);
+
+				line += (k == 11) ? ".\n" : " ";
+				nWords++;
+			}
+
+			fwrite(line.data(), 1, line.size(), out);
+			nFileBytes += line.size();
+		}
+
+		fclose(out);
+		nWritten += nFileBytes;
+	}
+
+	fp = fopen(strCountFile.c_str(), "w");
+	if(fp != 0)
+	{
+		fprintf(fp, "%lu %llu\n", nMB, nWords);
+		fclose(fp);
+	}
+
+	return nWords;
+}
+
+static unsigned long long SumOfCounts(const char *pstrResult)
+{
+	FILE *fp = fopen(pstrResult, "r");
+	if(fp == 0)
+		return 0;
+
+	unsigned long long nSum = 0;
+	char line[4096];
+	while(fgets(line, sizeof(line), fp) != 0)
+	{
+		char *p = strchr(line, '\t');
+		if(p != 0)
+			nSum += strtoull(p + 1, 0, 10);
+	}
+
+	fclose(fp);
+	return nSum;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nMB = (argc > 1) ? strtoul(argv[1], 0, 10) : 2048;
+	unsigned int nMappers = (argc > 2) ? strtoul(argv[2], 0, 10) : 4;
+	unsigned int nReducers = (argc > 3) ? strtoul(argv[3], 0, 10) : 4;
+	string strDir = (argc > 4) ? argv[4] : "/tmp/bench_map_reduce";
+	const char *pstrResult = "bench_map_reduce.result";
+
+	double begin = GetTimeInSeconds();
+	unsigned long long nWords = GenerateCorpus(strDir, nMB);
+	cout << "corpus=" << strDir << " mb=" << nMB << " words=" << nWords << " generate_s=" << GetTimeInSeconds() - begin << endl;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	{
+		vector<CLMapReduceMapper*> Mappers;
+		for(unsigned int i = 0; i < nMappers; i++)
+			Mappers.push_back(new CLWordCountMapper);
+
+		CLMapReduceJob job(Mappers, nReducers, "bench_map_reduce");
+
+		begin = GetTimeInSeconds();
+		if(!job.AddInputDirectory(strDir.c_str()).IsSuccess())
+			cout << "AddInputDirectory error" << endl;
+
+		if(!job.Run(pstrResult).IsSuccess())
+			cout << "Run error" << endl;
+
+		double elapsed = GetTimeInSeconds() - begin;
+
+		unsigned long long nSum = SumOfCounts(pstrResult);
+
+		cout << "mappers=" << nMappers << " reducers=" << nReducers;
+		cout << " input_mb=" << job.GetInputLength() / (1024 * 1024);
+		cout << " s=" << elapsed;
+		cout << " mb_per_s=" << job.GetInputLength() / (1024 * 1024) / elapsed;
+		cout << " keys=" << job.GetNumberOfKeys();
+		cout << " batches=" << job.GetNumberOfBatches();
+		cout << " counted=" << nSum << ((nSum == nWords) ? " ok" : " MISMATCH") << endl;
+	}
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
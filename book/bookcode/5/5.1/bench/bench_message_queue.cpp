@@ -0,0 +1,198 @@
+#include <iostream>
+#include <stdlib.h>
+#include <sched.h>
+#include <time.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_MESSAGE_ID 1
+
+class CLBenchMsg : public CLMessage
+{
+public:
+	CLBenchMsg() : CLMessage(BENCH_MESSAGE_ID)
+	{
+	}
+
+	virtual ~CLBenchMsg()
+	{
+	}
+};
+
+class CLBenchPooledMsg : public CLPooledMessage
+{
+public:
+	CLBenchPooledMsg() : CLPooledMessage(BENCH_MESSAGE_ID)
+	{
+	}
+
+	virtual ~CLBenchPooledMsg()
+	{
+	}
+};
+
+class CLBenchObserver : public CLMessageObserver
+{
+public:
+	CLBenchObserver(unsigned long nTotal, unsigned int nBatchSize)
+	{
+		m_nTotal = nTotal;
+		m_nReceived = 0;
+		m_nBatchSize = nBatchSize;
+	}
+
+	virtual ~CLBenchObserver()
+	{
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_MESSAGE_ID, (CallBackForMessageLoop)(&CLBenchObserver::On_Bench));
+		return pMessageLoop->SetBatchSize(m_nBatchSize);
+	}
+
+	CLStatus On_Bench(CLMessage *pm)
+	{
+		m_nReceived++;
+		if(m_nReceived == m_nTotal)
+			return CLStatus(QUIT_MESSAGE_LOOP, 0);
+
+		return CLStatus(0, 0);
+	}
+
+private:
+	unsigned long m_nTotal;
+	unsigned long m_nReceived;
+	unsigned int m_nBatchSize;
+};
+
+struct SLProducerContext
+{
+	const char *pstrExecutiveName;
+	unsigned long nMessages;
+	unsigned long nRetries;
+	bool bPooled;
+};
+
+static CLMessage* NewBenchMessage(bool bPooled)
+{
+	if(bPooled)
+		return new CLBenchPooledMsg;
+
+	return new CLBenchMsg;
+}
+
+class CLProducer : public CLExecutiveFunctionProvider
+{
+public:
+	virtual CLStatus RunExecutiveFunction(void* pContext)
+	{
+		SLProducerContext *p = (SLProducerContext *)pContext;
+
+		CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+		CLExecutiveCommunication *pComm = pNameServer->GetCommunicationPtr(p->pstrExecutiveName);
+		if(pComm == 0)
+			return CLStatus(-1, 0);
+
+		for(unsigned long i = 0; i < p->nMessages; i++)
+		{
+			while(!pComm->PostExecutiveMessage(NewBenchMessage(p->bPooled)).IsSuccess())
+			{
+				p->nRetries++;
+				sched_yield();
+			}
+		}
+
+		pNameServer->ReleaseCommunicationPtr(p->pstrExecutiveName);
+		return CLStatus(0, 0);
+	}
+};
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void RunBench(const char *pstrQueueName, int ExecutiveType, unsigned int nBatchSize, bool bPooled, int nProducers, unsigned long nMessages)
+{
+	const char *pstrExecutiveName = "bench_message_queue";
+	unsigned long nTotal = nProducers * nMessages;
+
+	SLProducerContext *pContexts = new SLProducerContext[nProducers];
+	CLExecutive **ppProducers = new CLExecutive*[nProducers];
+
+	double begin = 0;
+	{
+		CLThreadForMsgLoop consumer(new CLBenchObserver(nTotal, nBatchSize), pstrExecutiveName, true, ExecutiveType);
+		if(!consumer.Run(0).IsSuccess())
+		{
+			cout << "consumer Run error" << endl;
+			return;
+		}
+
+		begin = GetTimeInSeconds();
+
+		for(int i = 0; i < nProducers; i++)
+		{
+			pContexts[i].pstrExecutiveName = pstrExecutiveName;
+			pContexts[i].nMessages = nMessages;
+			pContexts[i].nRetries = 0;
+			pContexts[i].bPooled = bPooled;
+
+			ppProducers[i] = new CLThread(new CLProducer, true);
+			ppProducers[i]->Run(&pContexts[i]);
+		}
+
+		for(int i = 0; i < nProducers; i++)
+			ppProducers[i]->WaitForDeath();
+	}
+	double elapsed = GetTimeInSeconds() - begin;
+
+	unsigned long nRetries = 0;
+	for(int i = 0; i < nProducers; i++)
+		nRetries += pContexts[i].nRetries;
+
+	cout << "queue=" << pstrQueueName << " batch=" << nBatchSize << " alloc=" << (bPooled ? "pool" : "heap") << " producers=" << nProducers << " messages=" << nTotal;
+	cout << " elapsed_ms=" << elapsed * 1000 << " msgs_per_sec=" << (unsigned long)(nTotal / elapsed);
+	cout << " full_retries=" << nRetries << endl;
+
+	delete [] ppProducers;
+	delete [] pContexts;
+}
+
+int main(int argc, char *argv[])
+{
+	int nMaxProducers = (argc > 1) ? atoi(argv[1]) : 8;
+	unsigned long nMessages = (argc > 2) ? strtoul(argv[2], 0, 10) : 1000000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	for(int n = 1; n <= nMaxProducers; n *= 2)
+	{
+		RunBench("stl_queue", EXECUTIVE_IN_PROCESS_USE_STL_QUEUE, 1, false, n, nMessages);
+		RunBench("stl_queue", EXECUTIVE_IN_PROCESS_USE_STL_QUEUE, 64, false, n, nMessages);
+		RunBench("lock_free_ring", EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING, 1, false, n, nMessages);
+		RunBench("lock_free_ring", EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING, 64, false, n, nMessages);
+		RunBench("lock_free_ring", EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING, 64, true, n, nMessages);
+	}
+
+	SLMessagePoolStatistics Statistics;
+	if(CLMessagePool::GetStatistics(&Statistics).IsSuccess())
+	{
+		cout << "pool allocations=" << Statistics.nAllocations << " frees=" << Statistics.nFrees;
+		cout << " remote_frees=" << Statistics.nRemoteFrees << " slabs=" << Statistics.nSlabAllocations;
+		cout << " large=" << Statistics.nLargeAllocations << " thread_caches=" << Statistics.nThreadCaches << endl;
+	}
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
@@ -0,0 +1,229 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <stdlib.h>
+#include <time.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_WORK_ID 1
+#define BENCH_SYNC_ID 2
+#define BENCH_STOP_ID 3
+
+#define BENCH_METRICS_FILE "/tmp/bench_metrics.txt"
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+class CLSyncMsg : public CLMessage
+{
+public:
+	CLSyncMsg(CLEvent *pEvent) : CLMessage(BENCH_SYNC_ID)
+	{
+		m_pEvent = pEvent;
+	}
+
+	CLEvent *m_pEvent;
+};
+
+class CLCounterObserver : public CLMessageObserver
+{
+public:
+	CLCounterObserver()
+	{
+		m_nCount = 0;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_WORK_ID, (CallBackForMessageLoop)(&CLCounterObserver::On_Work));
+		pMessageLoop->Register(BENCH_SYNC_ID, (CallBackForMessageLoop)(&CLCounterObserver::On_Sync));
+		pMessageLoop->Register(BENCH_STOP_ID, (CallBackForMessageLoop)(&CLCounterObserver::On_Stop));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Work(CLMessage *pm)
+	{
+		m_nCount++;
+		return CLStatus(0, 0);
+	}
+
+	//Ϣѭ֮ǰϢ֪̣ͨ߳ʱУԻȡͳƿ
+	CLStatus On_Sync(CLMessage *pm)
+	{
+		((CLSyncMsg *)pm)->m_pEvent->Set();
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Stop(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+
+	unsigned long m_nCount;
+};
+
+static void PrintSnapshot(const char *pstrExecutiveName)
+{
+	SLExecutiveMetricsSnapshot *p = new SLExecutiveMetricsSnapshot;
+
+	if(!CLExecutiveMetrics::GetSnapshot(pstrExecutiveName, p).IsSuccess())
+	{
+		cout << "  snapshot error" << endl;
+		delete p;
+		return;
+	}
+
+	cout << "  snapshot dispatched=" << p->nDispatched;
+	cout << " queue_ns_p50=" << p->QueueLatency.GetValueAtPercentile(50);
+	cout << " queue_ns_p99=" << p->QueueLatency.GetValueAtPercentile(99);
+	cout << " queue_ns_max=" << p->QueueLatency.GetMax();
+	cout << " handler_ns_p50=" << p->HandlerTime.GetValueAtPercentile(50);
+	cout << " handler_ns_p99=" << p->HandlerTime.GetValueAtPercentile(99);
+	cout << " message_ids=" << p->MessageIDs.size();
+	if(p->bHasQueueStatistics)
+		cout << " depth=" << p->QueueStatistics.nDepth[MESSAGE_PRIORITY_NORMAL];
+	cout << endl;
+
+	delete p;
+}
+
+//ͶnMessagesϢӿʼͶݵȫ
+static double RunThroughputBench(const char *pstrQueueName, int ExecutiveType, unsigned long nMessages, bool bMetrics)
+{
+	const char *pstrExecutiveName = "bench_metrics_executive";
+
+	CLExecutiveMetrics::Enable(bMetrics);
+
+	CLThreadForMsgLoop *pThread = new CLThreadForMsgLoop(new CLCounterObserver, pstrExecutiveName, true, ExecutiveType);
+	if(!pThread->Run(0).IsSuccess())
+	{
+		cout << "Run error" << endl;
+		return 0;
+	}
+
+	CLExecutiveHandle handle(pstrExecutiveName);
+	CLEvent event;
+
+	unsigned long nFailed = 0;
+	double begin = GetTimeInSeconds();
+
+	for(unsigned long i = 0; i < nMessages; i++)
+	{
+		//ζʱ
+		while(!handle.PostExecutiveMessage(new CLMessage(BENCH_WORK_ID)).IsSuccess())
+			nFailed++;
+	}
+
+	handle.PostExecutiveMessage(new CLSyncMsg(&event));
+	event.Wait();
+
+	double elapsed = GetTimeInSeconds() - begin;
+
+	cout << "mode=" << (bMetrics ? "metrics_on" : "metrics_off") << " queue=" << pstrQueueName;
+	cout << " messages=" << nMessages;
+	cout << " ns_per_msg=" << elapsed * 1e9 / nMessages;
+	cout << " msgs_per_sec=" << (unsigned long)(nMessages / elapsed);
+	cout << " full_retries=" << nFailed << endl;
+
+	if(bMetrics)
+		PrintSnapshot(pstrExecutiveName);
+
+	handle.PostExecutiveMessage(new CLMessage(BENCH_STOP_ID));
+	delete pThread;
+
+	CLExecutiveMetrics::Enable(false);
+
+	return elapsed;
+}
+
+static void RunRecordBench(unsigned long nRecords)
+{
+	CLLatencyHistogram *pHistogram = new CLLatencyHistogram;
+
+	double begin = GetTimeInSeconds();
+	for(unsigned long i = 0; i < nRecords; i++)
+		pHistogram->Record(CLExecutiveMetrics::GetCurrentTime() & 0xfffff);
+	double elapsed = GetTimeInSeconds() - begin;
+
+	cout << "mode=clock_and_record records=" << nRecords;
+	cout << " ns_per_record=" << elapsed * 1e9 / nRecords;
+	cout << " p50=" << pHistogram->GetValueAtPercentile(50);
+	cout << " mean=" << (unsigned long)pHistogram->GetMean() << endl;
+
+	delete pHistogram;
+}
+
+static void RunExporterBench(unsigned long nMessages)
+{
+	remove(BENCH_METRICS_FILE);
+
+	CLExecutiveMetrics::Enable(true);
+
+	CLThreadForMsgLoop *pExporter = new CLThreadForMsgLoop(new CLMetricsExporter(BENCH_METRICS_FILE, 20), "bench_metrics_exporter", true);
+	CLThreadForMsgLoop *pThread = new CLThreadForMsgLoop(new CLCounterObserver, "bench_metrics_exported", true);
+
+	if((!pExporter->Run(0).IsSuccess()) || (!pThread->Run(0).IsSuccess()))
+	{
+		cout << "Run error" << endl;
+		return;
+	}
+
+	for(unsigned long i = 0; i < nMessages; i++)
+		CLExecutiveNameServer::PostExecutiveMessage("bench_metrics_exported", new CLMessage(BENCH_WORK_ID));
+
+	struct timespec ts = {0, 100000000};
+	nanosleep(&ts, 0);
+
+	CLExecutiveNameServer::PostExecutiveMessage("bench_metrics_exporter", new CLMessage(METRICS_EXPORTER_QUIT_ID));
+	delete pExporter;
+
+	CLExecutiveNameServer::PostExecutiveMessage("bench_metrics_exported", new CLMessage(BENCH_STOP_ID));
+	delete pThread;
+
+	CLExecutiveMetrics::Enable(false);
+
+	ifstream in(BENCH_METRICS_FILE);
+	string line;
+	unsigned int nLines = 0;
+	while(getline(in, line))
+	{
+		if(nLines++ < 4)
+			cout << "  " << line << endl;
+	}
+
+	cout << "mode=exporter file=" << BENCH_METRICS_FILE << " lines=" << nLines << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nMessages = (argc > 1) ? strtoul(argv[1], 0, 10) : 2000000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	RunRecordBench(nMessages);
+
+	double off = RunThroughputBench("stl_queue", EXECUTIVE_IN_PROCESS_USE_STL_QUEUE, nMessages, false);
+	double on = RunThroughputBench("stl_queue", EXECUTIVE_IN_PROCESS_USE_STL_QUEUE, nMessages, true);
+	cout << "overhead queue=stl_queue percent=" << (on - off) * 100 / off << endl;
+
+	off = RunThroughputBench("lock_free_ring", EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING, nMessages, false);
+	on = RunThroughputBench("lock_free_ring", EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING, nMessages, true);
+	cout << "overhead queue=lock_free_ring percent=" << (on - off) * 100 / off << endl;
+
+	RunExporterBench(nMessages / 100);
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
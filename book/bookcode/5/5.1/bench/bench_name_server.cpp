@@ -0,0 +1,140 @@
+#include <iostream>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_MESSAGE_ID 1
+
+#define BENCH_BY_NAME 0
+#define BENCH_BY_HANDLE 1
+#define BENCH_LOOKUP_ONLY 2
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//ֻϢʹֻӳַĿ
+class CLBenchNullCommunication : public CLExecutiveCommunication
+{
+public:
+	CLBenchNullCommunication()
+	{
+		m_nMessages = 0;
+	}
+
+	virtual CLStatus PostExecutiveMessage(CLMessage *pMessage)
+	{
+		__sync_fetch_and_add(&m_nMessages, 1);
+		return CLStatus(0, 0);
+	}
+
+	volatile unsigned long m_nMessages;
+};
+
+struct SLSenderContext
+{
+	int nMode;
+	const char *pstrExecutiveName;
+	unsigned long nMessages;
+	CLMessage *pMessage;
+};
+
+static void *SenderThread(void *pContext)
+{
+	SLSenderContext *p = (SLSenderContext *)pContext;
+
+	if(p->nMode == BENCH_BY_NAME)
+	{
+		for(unsigned long i = 0; i < p->nMessages; i++)
+			CLExecutiveNameServer::PostExecutiveMessage(p->pstrExecutiveName, p->pMessage);
+	}
+	else if(p->nMode == BENCH_BY_HANDLE)
+	{
+		CLExecutiveHandle handle(p->pstrExecutiveName);
+
+		for(unsigned long i = 0; i < p->nMessages; i++)
+			handle.PostExecutiveMessage(p->pMessage);
+	}
+	else
+	{
+		CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+
+		for(unsigned long i = 0; i < p->nMessages; i++)
+		{
+			pNameServer->GetCommunicationPtr(p->pstrExecutiveName);
+			pNameServer->ReleaseCommunicationPtr(p->pstrExecutiveName);
+		}
+	}
+
+	return 0;
+}
+
+static void RunBench(const char *pstrMode, int nMode, int nThreads, unsigned long nMessages)
+{
+	const char *pstrExecutiveName = "bench_name_server_target";
+
+	CLBenchNullCommunication *pComm = new CLBenchNullCommunication;
+	CLExecutiveNameServer::GetInstance()->Register(pstrExecutiveName, pComm);
+
+	CLMessage msg(BENCH_MESSAGE_ID);
+
+	SLSenderContext context;
+	context.nMode = nMode;
+	context.pstrExecutiveName = pstrExecutiveName;
+	context.nMessages = nMessages;
+	context.pMessage = &msg;
+
+	pthread_t *pThreads = new pthread_t[nThreads];
+
+	double begin = GetTimeInSeconds();
+
+	for(int i = 0; i < nThreads; i++)
+		pthread_create(&pThreads[i], 0, SenderThread, &context);
+
+	for(int i = 0; i < nThreads; i++)
+		pthread_join(pThreads[i], 0);
+
+	double elapsed = GetTimeInSeconds() - begin;
+
+	unsigned long nTotal = nThreads * nMessages;
+	bool bCorrect = (nMode == BENCH_LOOKUP_ONLY) || (pComm->m_nMessages == nTotal);
+
+	cout << "mode=" << pstrMode << " threads=" << nThreads << " messages=" << nTotal;
+	cout << " ns_per_op=" << elapsed * 1e9 / nTotal;
+	cout << " ops_per_sec=" << (unsigned long)(nTotal / elapsed);
+	cout << " delivered=" << (bCorrect ? "ok" : "error") << endl;
+
+	delete [] pThreads;
+
+	CLExecutiveNameServer::GetInstance()->ReleaseCommunicationPtr(pstrExecutiveName);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nMessages = (argc > 1) ? strtoul(argv[1], 0, 10) : 2000000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	int Threads[] = {1, 4};
+	for(unsigned int i = 0; i < sizeof(Threads) / sizeof(Threads[0]); i++)
+	{
+		RunBench("lookup", BENCH_LOOKUP_ONLY, Threads[i], nMessages);
+		RunBench("post_by_name", BENCH_BY_NAME, Threads[i], nMessages);
+		RunBench("post_by_handle", BENCH_BY_HANDLE, Threads[i], nMessages);
+	}
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
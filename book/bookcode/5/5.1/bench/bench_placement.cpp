@@ -0,0 +1,230 @@
+#include <iostream>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_START_ID 1
+#define BENCH_PING_ID 2
+#define BENCH_PONG_ID 3
+#define BENCH_STOP_ID 4
+
+#define BENCH_PING_NAME "bench_placement_ping"
+#define BENCH_PONG_NAME "bench_placement_pong"
+
+#define SIZE_OF_STACK_TOUCHED (4 * 1024 * 1024)
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+class CLPinger : public CLMessageObserver
+{
+public:
+	CLPinger(unsigned long nRounds, CLEvent *pFinished)
+	{
+		m_nRounds = nRounds;
+		m_nSent = 0;
+		m_pFinished = pFinished;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_START_ID, (CallBackForMessageLoop)(&CLPinger::On_Pong));
+		pMessageLoop->Register(BENCH_PONG_ID, (CallBackForMessageLoop)(&CLPinger::On_Pong));
+		pMessageLoop->Register(BENCH_STOP_ID, (CallBackForMessageLoop)(&CLPinger::On_Stop));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Pong(CLMessage *pm)
+	{
+		if(m_nSent++ < m_nRounds)
+			CLExecutiveNameServer::PostExecutiveMessage(BENCH_PONG_NAME, new CLMessage(BENCH_PING_ID));
+		else
+			m_pFinished->Set();
+
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Stop(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+
+	unsigned long m_nRounds;
+	unsigned long m_nSent;
+	CLEvent *m_pFinished;
+};
+
+class CLPonger : public CLMessageObserver
+{
+public:
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_PING_ID, (CallBackForMessageLoop)(&CLPonger::On_Ping));
+		pMessageLoop->Register(BENCH_STOP_ID, (CallBackForMessageLoop)(&CLPonger::On_Stop));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Ping(CLMessage *pm)
+	{
+		CLExecutiveNameServer::PostExecutiveMessage(BENCH_PING_NAME, new CLMessage(BENCH_PONG_ID));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Stop(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+};
+
+//ֱִpPingPlacementpPongPlacementϣһһnRoundsΣͶӳȡʱһ
+static void RunPingPong(const char *pstrMode, const CLThreadPlacement *pPingPlacement, const CLThreadPlacement *pPongPlacement, unsigned long nRounds)
+{
+	CLEvent finished;
+
+	CLThreadForMsgLoop *pPing = new CLThreadForMsgLoop(new CLPinger(nRounds, &finished), BENCH_PING_NAME, true, EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING, MESSAGE_QUEUE_UNBOUNDED, MESSAGE_QUEUE_OVERFLOW_BLOCK, pPingPlacement);
+	CLThreadForMsgLoop *pPong = new CLThreadForMsgLoop(new CLPonger, BENCH_PONG_NAME, true, EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING, MESSAGE_QUEUE_UNBOUNDED, MESSAGE_QUEUE_OVERFLOW_BLOCK, pPongPlacement);
+
+	if((!pPing->Run(0).IsSuccess()) || (!pPong->Run(0).IsSuccess()))
+	{
+		cout << "Run error" << endl;
+		return;
+	}
+
+	double begin = GetTimeInSeconds();
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_PING_NAME, new CLMessage(BENCH_START_ID));
+	finished.Wait();
+	double elapsed = GetTimeInSeconds() - begin;
+
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_PING_NAME, new CLMessage(BENCH_STOP_ID));
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_PONG_NAME, new CLMessage(BENCH_STOP_ID));
+	delete pPing;
+	delete pPong;
+
+	cout << "mode=" << pstrMode << " rounds=" << nRounds;
+	cout << " ns_per_round_trip=" << elapsed * 1e9 / nRounds;
+	cout << " ns_per_post=" << elapsed * 1e9 / nRounds / 2 << endl;
+}
+
+class CLStackToucher : public CLExecutiveFunctionProvider
+{
+public:
+	CLStackToucher()
+	{
+		m_bDone = false;
+	}
+
+	virtual CLStatus RunExecutiveFunction(void *pContext)
+	{
+		volatile char buffer[SIZE_OF_STACK_TOUCHED];
+		memset((char *)buffer, 1, sizeof(buffer));
+
+		m_bDone = (buffer[SIZE_OF_STACK_TOUCHED - 1] == 1);
+		return CLStatus(0, 0);
+	}
+
+	bool m_bDone;
+};
+
+static void RunHugePageStack()
+{
+	CLThreadPlacement placement;
+	placement.SetStackSize(2 * SIZE_OF_STACK_TOUCHED);
+	placement.UseHugePageStack(true);
+
+	//CLThreadWaitForDeathеCLExecutiveFunctionProviderҲ֮ͷţ˽ȱھֲ
+	CLStackToucher *pToucher = new CLStackToucher;
+	CLThread *pThread = new CLThread(pToucher, true, &placement);
+
+	double begin = GetTimeInSeconds();
+	if(!pThread->Run(0).IsSuccess())
+	{
+		cout << "mode=huge_page_stack result=run_error" << endl;
+		return;
+	}
+
+	while(!pToucher->m_bDone)
+		sched_yield();
+
+	double elapsed = GetTimeInSeconds() - begin;
+	pThread->WaitForDeath();
+
+	cout << "mode=huge_page_stack stack_bytes=" << 2 * SIZE_OF_STACK_TOUCHED << " touched_bytes=" << SIZE_OF_STACK_TOUCHED;
+	cout << " elapsed_us=" << elapsed * 1e6 << " result=ok" << endl;
+}
+
+static int GetCPU(const cpu_set_t *pCPUSet, int nIndex)
+{
+	for(int i = 0; i < CPU_SETSIZE; i++)
+	{
+		if(CPU_ISSET(i, pCPUSet) && (nIndex-- == 0))
+			return i;
+	}
+
+	return -1;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nRounds = (argc > 1) ? strtoul(argv[1], 0, 10) : 200000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	int nNodes = CLThreadPlacement::GetNumberOfNUMANodes();
+
+	cpu_set_t Node0CPUs;
+	CLThreadPlacement::GetCPUsOfNUMANode(0, &Node0CPUs);
+
+	cout << "numa_nodes=" << nNodes << " node0_cpus=" << CPU_COUNT(&Node0CPUs) << endl;
+
+	RunPingPong("unplaced", 0, 0, nRounds);
+
+	CLThreadPlacement SameCPU;
+	SameCPU.AddCPU(GetCPU(&Node0CPUs, 0));
+	SameCPU.SetNUMANode(0);
+	RunPingPong("same_cpu", &SameCPU, &SameCPU, nRounds);
+
+	if(CPU_COUNT(&Node0CPUs) >= 2)
+	{
+		CLThreadPlacement Ping, Pong;
+		Ping.AddCPU(GetCPU(&Node0CPUs, 0));
+		Ping.SetNUMANode(0);
+		Pong.AddCPU(GetCPU(&Node0CPUs, 1));
+		Pong.SetNUMANode(0);
+		RunPingPong("same_node", &Ping, &Pong, nRounds);
+	}
+	else
+		cout << "mode=same_node skipped=node0_has_one_cpu" << endl;
+
+	if(nNodes >= 2)
+	{
+		cpu_set_t Node1CPUs;
+		CLThreadPlacement::GetCPUsOfNUMANode(1, &Node1CPUs);
+
+		CLThreadPlacement Ping, Pong;
+		Ping.AddCPU(GetCPU(&Node0CPUs, 0));
+		Ping.SetNUMANode(0);
+		Pong.AddCPU(GetCPU(&Node1CPUs, 0));
+		Pong.SetNUMANode(1);
+		RunPingPong("cross_node", &Ping, &Pong, nRounds);
+	}
+	else
+		cout << "mode=cross_node skipped=single_numa_node" << endl;
+
+	RunHugePageStack();
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
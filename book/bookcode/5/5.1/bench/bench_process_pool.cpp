@@ -0,0 +1,300 @@
+#include <iostream>
+#include <map>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_JOB_ID 1
+#define BENCH_DONE_ID 2
+
+#define BENCH_POOL_NAME "bench_process_pool"
+#define BENCH_MASTER_NAME "bench_process_pool_master"
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//ҵϢֻţϢ빤̵Ľ̺
+class CLBenchJobMsg : public CLMessage
+{
+public:
+	CLBenchJobMsg(unsigned long lMsgID, long nIndex, long nProcessID) : CLMessage(lMsgID)
+	{
+		m_nIndex = nIndex;
+		m_nProcessID = nProcessID;
+	}
+
+	long m_nIndex;
+	long m_nProcessID;
+};
+
+class CLBenchJobMsgSerializer : public CLZeroCopyMessageSerializer
+{
+public:
+	virtual unsigned int GetSerializedLength(CLMessage *pMsg)
+	{
+		return 3 * sizeof(long);
+	}
+
+	virtual CLStatus Serialize(CLMessage *pMsg, CLSerializeCursor *pCursor)
+	{
+		CLBenchJobMsg *p = (CLBenchJobMsg *)pMsg;
+
+		long Buf[3];
+		Buf[0] = p->m_clMsgID;
+		Buf[1] = p->m_nIndex;
+		Buf[2] = p->m_nProcessID;
+
+		return pCursor->Write(Buf, sizeof(Buf));
+	}
+};
+
+class CLBenchJobMsgDeserializer : public CLZeroCopyMessageDeserializer
+{
+public:
+	virtual CLMessage *Deserialize(const char *pBuffer, unsigned int nLength)
+	{
+		if(nLength < 3 * sizeof(long))
+			return 0;
+
+		const long *p = (const long *)pBuffer;
+		return new CLBenchJobMsg(p[0], p[1], p[2]);
+	}
+};
+
+class CLWorkerObserver : public CLMessageObserver
+{
+public:
+	CLWorkerObserver()
+	{
+		m_pMaster = 0;
+	}
+
+	virtual ~CLWorkerObserver()
+	{
+		delete m_pMaster;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		m_pMaster = new CLSharedExecutiveCommunicationByShmRing(BENCH_MASTER_NAME);
+		m_pMaster->RegisterSerializer(BENCH_DONE_ID, new CLBenchJobMsgSerializer);
+
+		pMessageLoop->Register(BENCH_JOB_ID, (CallBackForMessageLoop)(&CLWorkerObserver::On_Job));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Job(CLMessage *pm)
+	{
+		CLBenchJobMsg *p = (CLBenchJobMsg *)pm;
+
+		//̵Ķʱȴڳռ
+		while(!m_pMaster->PostExecutiveMessage(new CLBenchJobMsg(BENCH_DONE_ID, p->m_nIndex, getpid())).IsSuccess())
+			sched_yield();
+
+		return CLStatus(0, 0);
+	}
+
+private:
+	CLSharedExecutiveCommunicationByShmRing *m_pMaster;
+};
+
+class CLMasterObserver : public CLMessageObserver
+{
+public:
+	CLMasterObserver(unsigned long nJobs, CLEvent *pEvent)
+	{
+		m_nJobs = nJobs;
+		m_nDone = 0;
+		m_pEvent = pEvent;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_DONE_ID, (CallBackForMessageLoop)(&CLMasterObserver::On_Done));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Done(CLMessage *pm)
+	{
+		CLBenchJobMsg *p = (CLBenchJobMsg *)pm;
+		m_JobsPerWorker[p->m_nProcessID]++;
+
+		if(++m_nDone < m_nJobs)
+			return CLStatus(0, 0);
+
+		m_pEvent->Set();
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+
+	map<long, unsigned long> m_JobsPerWorker;
+
+private:
+	unsigned long m_nJobs;
+	unsigned long m_nDone;
+	CLEvent *m_pEvent;
+};
+
+//תCLProcessFunctionForExecCLProcessʶ𲻳exec̣vfork·
+class CLForwardingFunctionForExec : public CLExecutiveFunctionProvider
+{
+public:
+	virtual CLStatus RunExecutiveFunction(void* pCmdLine)
+	{
+		return m_Exec.RunExecutiveFunction(pCmdLine);
+	}
+
+private:
+	CLProcessFunctionForExec m_Exec;
+};
+
+//ÿҵһexec̲ȴʹý̳֮ǰ
+static void RunOneShotBench(const char *pstrMode, unsigned int nLaunches, const char *pstrCmdLine)
+{
+	double begin = GetTimeInSeconds();
+
+	unsigned int nFailed = 0;
+	for(unsigned int i = 0; i < nLaunches; i++)
+	{
+		CLExecutiveFunctionProvider *pProvider;
+		if(strcmp(pstrMode, "posix_spawn") == 0)
+			pProvider = new CLProcessFunctionForExec;
+		else
+			pProvider = new CLForwardingFunctionForExec;
+
+		CLProcess *pProcess = new CLProcess(pProvider, true);
+		if((!pProcess->Run((void *)pstrCmdLine).IsSuccess()) || (!pProcess->WaitForDeath().IsSuccess()))
+			nFailed++;
+	}
+
+	double elapsed = GetTimeInSeconds() - begin;
+
+	cout << "mode=" << pstrMode << " launches=" << nLaunches;
+	cout << " us_per_launch=" << elapsed * 1e6 / nLaunches;
+	cout << " launches_per_sec=" << (unsigned long)(nLaunches / elapsed);
+	cout << " failed=" << nFailed << endl;
+}
+
+static void RunPoolBench(unsigned int nWorkers, unsigned long nJobs, unsigned int nRounds)
+{
+	vector<CLMessageObserver*> Observers;
+	for(unsigned int i = 0; i < nWorkers; i++)
+		Observers.push_back(new CLWorkerObserver);
+
+	double begin = GetTimeInSeconds();
+
+	CLProcessPool *pPool = new CLProcessPool(Observers, BENCH_POOL_NAME);
+	pPool->RegisterSerializer(BENCH_JOB_ID, new CLBenchJobMsgSerializer);
+	pPool->RegisterDeserializer(BENCH_JOB_ID, new CLBenchJobMsgDeserializer);
+
+	if(!pPool->Run(0).IsSuccess())
+	{
+		cout << "Run error" << endl;
+		delete pPool;
+		return;
+	}
+
+	double started = GetTimeInSeconds() - begin;
+	cout << "mode=pool_start workers=" << nWorkers << " ms=" << started * 1e3 << endl;
+
+	//ָͬһ鹤̣ҵٸ̵Ĵ
+	for(unsigned int r = 0; r < nRounds; r++)
+	{
+		CLEvent event;
+		CLMasterObserver *pMaster = new CLMasterObserver(nJobs, &event);
+
+		CLThreadForMsgLoop *pThread = new CLThreadForMsgLoop(pMaster, BENCH_MASTER_NAME, true, EXECUTIVE_BETWEEN_PROCESS_USE_SHM_QUEUE);
+		pThread->RegisterDeserializer(BENCH_DONE_ID, new CLBenchJobMsgDeserializer);
+		if(!pThread->Run(0).IsSuccess())
+		{
+			cout << "Run error" << endl;
+			break;
+		}
+
+		unsigned long nRetries = 0;
+		begin = GetTimeInSeconds();
+
+		for(unsigned long i = 0; i < nJobs; i++)
+		{
+			while(!CLExecutiveNameServer::PostExecutiveMessage(BENCH_POOL_NAME, new CLBenchJobMsg(BENCH_JOB_ID, i, 0)).IsSuccess())
+			{
+				nRetries++;
+				sched_yield();
+			}
+		}
+
+		event.Wait();
+
+		double elapsed = GetTimeInSeconds() - begin;
+
+		unsigned long nMin = ~0UL, nMax = 0;
+		map<long, unsigned long>::iterator it;
+		for(it = pMaster->m_JobsPerWorker.begin(); it != pMaster->m_JobsPerWorker.end(); it++)
+		{
+			nMin = (it->second < nMin) ? it->second : nMin;
+			nMax = (it->second > nMax) ? it->second : nMax;
+		}
+
+		cout << "mode=pool round=" << r << " workers=" << nWorkers << " jobs=" << nJobs;
+		cout << " us_per_job=" << elapsed * 1e6 / nJobs;
+		cout << " jobs_per_sec=" << (unsigned long)(nJobs / elapsed);
+		cout << " workers_used=" << pMaster->m_JobsPerWorker.size();
+		cout << " min_jobs=" << nMin << " max_jobs=" << nMax;
+		cout << " full_retries=" << nRetries << endl;
+
+		delete pThread;
+	}
+
+	begin = GetTimeInSeconds();
+	delete pPool;
+	cout << "mode=pool_shutdown workers=" << nWorkers << " ms=" << (GetTimeInSeconds() - begin) * 1e3 << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int nLaunches = (argc > 1) ? strtoul(argv[1], 0, 10) : 500;
+	unsigned int nOpenFiles = (argc > 2) ? strtoul(argv[2], 0, 10) : 1000;
+	unsigned int nWorkers = (argc > 3) ? strtoul(argv[3], 0, 10) : 8;
+	unsigned long nJobs = (argc > 4) ? strtoul(argv[4], 0, 10) : 200000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	//̴򿪵ļԽ࣬ӽҪرյҲԽ
+	vector<int> Files;
+	for(unsigned int i = 0; i < nOpenFiles; i++)
+	{
+		int fd = open("/dev/null", O_RDONLY);
+		if(fd == -1)
+			break;
+
+		Files.push_back(fd);
+	}
+
+	cout << "open_files=" << Files.size() << endl;
+
+	RunOneShotBench("posix_spawn", nLaunches, "/bin/true");
+	RunOneShotBench("vfork_exec", nLaunches, "/bin/true");
+
+	for(unsigned int i = 0; i < Files.size(); i++)
+		close(Files[i]);
+
+	RunPoolBench(nWorkers, nJobs, 2);
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
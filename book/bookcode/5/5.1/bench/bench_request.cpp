@@ -0,0 +1,227 @@
+#include <iostream>
+#include <stdlib.h>
+#include <time.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_ECHO_REQUEST_ID 1
+#define BENCH_START_ID 2
+#define BENCH_STOP_ID 3
+
+#define BENCH_SERVER_NAME "bench_request_server"
+#define BENCH_SILENT_SERVER_NAME "bench_request_silent_server"
+#define BENCH_CLIENT_NAME "bench_request_client"
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+class CLEchoRequest : public CLRequestMessage
+{
+public:
+	CLEchoRequest(unsigned long nValue) : CLRequestMessage(BENCH_ECHO_REQUEST_ID)
+	{
+		m_nValue = nValue;
+	}
+
+	unsigned long m_nValue;
+};
+
+class CLEchoResponse : public CLResponseMessage
+{
+public:
+	CLEchoResponse(unsigned long nValue)
+	{
+		m_nValue = nValue;
+	}
+
+	unsigned long m_nValue;
+};
+
+class CLEchoServer : public CLMessageObserver
+{
+public:
+	CLEchoServer(bool bReply)
+	{
+		m_bReply = bReply;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_ECHO_REQUEST_ID, (CallBackForMessageLoop)(&CLEchoServer::On_Echo));
+		pMessageLoop->Register(BENCH_STOP_ID, (CallBackForMessageLoop)(&CLEchoServer::On_Stop));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Echo(CLMessage *pm)
+	{
+		CLEchoRequest *pRequest = (CLEchoRequest *)pm;
+
+		if(m_bReply)
+			pRequest->Reply(new CLEchoResponse(pRequest->m_nValue));
+
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Stop(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+
+	bool m_bReply;
+};
+
+struct SLClientResult
+{
+	unsigned long nCompleted;
+	unsigned long nTimeouts;
+	unsigned long nMismatches;
+	double dElapsed;
+	CLEvent *pFinished;
+};
+
+//ͻ˱nWindowδɵյһӦһnWindowΪ1ʱΪһһ
+class CLEchoClient : public CLMessageObserver
+{
+public:
+	CLEchoClient(const char *pstrServerName, unsigned long nRequests, unsigned int nWindow, unsigned long lTimeoutMs, SLClientResult *pResult)
+	{
+		m_pstrServerName = pstrServerName;
+		m_nRequests = nRequests;
+		m_nWindow = nWindow;
+		m_lTimeoutMs = lTimeoutMs;
+		m_pResult = pResult;
+		m_nSent = 0;
+		m_pMessageLoop = 0;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		m_pMessageLoop = pMessageLoop;
+		pMessageLoop->Register(BENCH_START_ID, (CallBackForMessageLoop)(&CLEchoClient::On_Start));
+		pMessageLoop->Register(BENCH_STOP_ID, (CallBackForMessageLoop)(&CLEchoClient::On_Stop));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Start(CLMessage *pm)
+	{
+		m_dBegin = GetTimeInSeconds();
+
+		for(unsigned int i = 0; (i < m_nWindow) && (m_nSent < m_nRequests); i++)
+			Send();
+
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Response(CLResponseMessage *pResponse, void *pContext)
+	{
+		if(pResponse == 0)
+			m_pResult->nTimeouts++;
+		else
+		{
+			if(((CLEchoResponse *)pResponse)->m_nValue != (unsigned long)pContext)
+				m_pResult->nMismatches++;
+
+			m_pResult->nCompleted++;
+		}
+
+		if(m_nSent < m_nRequests)
+			Send();
+		else if(m_pResult->nCompleted + m_pResult->nTimeouts == m_nRequests)
+		{
+			m_pResult->dElapsed = GetTimeInSeconds() - m_dBegin;
+			m_pResult->pFinished->Set();
+		}
+
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Stop(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+
+private:
+	void Send()
+	{
+		unsigned long nValue = m_nSent++;
+		m_pMessageLoop->SendRequest(m_pstrServerName, new CLEchoRequest(nValue), (CallBackForResponse)(&CLEchoClient::On_Response), m_lTimeoutMs, (void *)nValue);
+	}
+
+private:
+	const char *m_pstrServerName;
+	unsigned long m_nRequests;
+	unsigned int m_nWindow;
+	unsigned long m_lTimeoutMs;
+	SLClientResult *m_pResult;
+	unsigned long m_nSent;
+	double m_dBegin;
+	CLMessageLoopManager *m_pMessageLoop;
+};
+
+static void RunClient(const char *pstrMode, const char *pstrServerName, unsigned long nRequests, unsigned int nWindow, unsigned long lTimeoutMs)
+{
+	CLEvent finished;
+	SLClientResult result = {0, 0, 0, 0, &finished};
+
+	CLThreadForMsgLoop *pClient = new CLThreadForMsgLoop(new CLEchoClient(pstrServerName, nRequests, nWindow, lTimeoutMs, &result), BENCH_CLIENT_NAME, true);
+	if(!pClient->Run(0).IsSuccess())
+	{
+		cout << "Run error" << endl;
+		return;
+	}
+
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_CLIENT_NAME, new CLMessage(BENCH_START_ID));
+	finished.Wait();
+
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_CLIENT_NAME, new CLMessage(BENCH_STOP_ID));
+	delete pClient;
+
+	cout << "mode=" << pstrMode << " window=" << nWindow << " requests=" << nRequests;
+	cout << " completed=" << result.nCompleted << " timeouts=" << result.nTimeouts << " mismatches=" << result.nMismatches;
+	cout << " elapsed_ms=" << result.dElapsed * 1000;
+	cout << " us_per_req=" << result.dElapsed * 1e6 / nRequests;
+	cout << " req_per_sec=" << (unsigned long)(nRequests / result.dElapsed) << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nRequests = (argc > 1) ? strtoul(argv[1], 0, 10) : 200000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	CLThreadForMsgLoop *pServer = new CLThreadForMsgLoop(new CLEchoServer(true), BENCH_SERVER_NAME, true);
+	CLThreadForMsgLoop *pSilentServer = new CLThreadForMsgLoop(new CLEchoServer(false), BENCH_SILENT_SERVER_NAME, true);
+
+	if((!pServer->Run(0).IsSuccess()) || (!pSilentServer->Run(0).IsSuccess()))
+	{
+		cout << "Run error" << endl;
+		return 0;
+	}
+
+	RunClient("lock_step", BENCH_SERVER_NAME, nRequests, 1, 0);
+	RunClient("pipelined", BENCH_SERVER_NAME, nRequests, 16, 0);
+	RunClient("pipelined", BENCH_SERVER_NAME, nRequests, 64, 0);
+	RunClient("pipelined_with_timeout", BENCH_SERVER_NAME, nRequests, 64, 1000);
+
+	//ԷӲӦȫӦԼ20msԳʱ
+	RunClient("timeout", BENCH_SILENT_SERVER_NAME, 1000, 1000, 20);
+
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_SERVER_NAME, new CLMessage(BENCH_STOP_ID));
+	CLExecutiveNameServer::PostExecutiveMessage(BENCH_SILENT_SERVER_NAME, new CLMessage(BENCH_STOP_ID));
+	delete pServer;
+	delete pSilentServer;
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
@@ -0,0 +1,202 @@
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_REGION_SIZE (64UL * 1024 * 1024)
+#define BENCH_PAGE_SIZE 4096
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static const char *GetTypeName(int nType, int nFlags)
+{
+	if(nType == SHARED_MEMORY_USE_SYSV)
+		return "sysv";
+
+	if(nType == SHARED_MEMORY_USE_FILE)
+		return "file";
+
+	if(nFlags == SHARED_MEMORY_FLAG_POPULATE)
+		return "posix_populate";
+
+	if(nFlags == SHARED_MEMORY_FLAG_HUGE_PAGE)
+		return "posix_huge_page";
+
+	if(nFlags == (SHARED_MEMORY_FLAG_HUGE_PAGE | SHARED_MEMORY_FLAG_POPULATE))
+		return "posix_huge_page_populate";
+
+	return "posix";
+}
+
+static void RunAttach(int nType, unsigned long nIterations)
+{
+	//һӣʹĹֻѴڵĹڴ
+	CLSharedMemory *pOwner = new CLSharedMemory("bench_shared_memory_attach", BENCH_PAGE_SIZE, nType);
+
+	double begin = GetTimeInSeconds();
+	for(unsigned long i = 0; i < nIterations; i++)
+	{
+		CLSharedMemory *p = new CLSharedMemory("bench_shared_memory_attach", 0, nType);
+		delete p;
+	}
+	double elapsed = GetTimeInSeconds() - begin;
+
+	delete pOwner;
+
+	cout << "mode=attach_detach type=" << GetTypeName(nType, 0) << " iterations=" << nIterations;
+	cout << " us_per_attach=" << elapsed * 1e6 / nIterations << endl;
+}
+
+//һ˳дһ飬ԤȷҳʱȱҳĴתƵ
+static void RunTouch(int nType, int nFlags)
+{
+	double begin = GetTimeInSeconds();
+	CLSharedMemory *pMemory = new CLSharedMemory("bench_shared_memory_touch", BENCH_REGION_SIZE, nType, nFlags);
+	double created = GetTimeInSeconds();
+
+	char *p = (char *)pMemory->GetAddress();
+	for(unsigned long i = 0; i < BENCH_REGION_SIZE; i += BENCH_PAGE_SIZE)
+		p[i] = 1;
+
+	double touched = GetTimeInSeconds();
+
+	unsigned long nSum = 0, nIndex = 12345;
+	for(unsigned long i = 0; i < 4000000; i++)
+	{
+		nIndex = nIndex * 6364136223846793005UL + 1442695040888963407UL;
+		nSum += p[(nIndex >> 20) % BENCH_REGION_SIZE];
+	}
+
+	double read = GetTimeInSeconds();
+
+	delete pMemory;
+
+	cout << "mode=touch type=" << GetTypeName(nType, nFlags) << " size_mb=" << BENCH_REGION_SIZE / 1024 / 1024;
+	cout << " create_ms=" << (created - begin) * 1000;
+	cout << " first_write_ms=" << (touched - created) * 1000;
+	cout << " random_read_ns=" << (read - touched) * 1e9 / 4000000;
+	cout << " sum=" << nSum << endl;
+}
+
+//ڴ沢ĩβд룬ӽRefreshȡӽ̶ȡʱ̿Ѿٴ
+static void RunResize(int nFlags)
+{
+	CLSharedMemory *pMemory = new CLSharedMemory("bench_shared_memory_resize", BENCH_PAGE_SIZE, SHARED_MEMORY_USE_POSIX, nFlags);
+
+	int fds[2];
+	if(pipe(fds) == -1)
+		return;
+
+	pid_t pid = fork();
+	if(pid == 0)
+	{
+		close(fds[1]);
+
+		CLSharedMemory *pChild = new CLSharedMemory("bench_shared_memory_resize", 0, SHARED_MEMORY_USE_POSIX, nFlags);
+
+		unsigned long nErrors = 0, nSize;
+		while(read(fds[0], &nSize, sizeof(nSize)) == sizeof(nSize))
+		{
+			if(!pChild->Refresh().IsSuccess() || (pChild->GetSize() < nSize))
+				nErrors++;
+			else if(((char *)pChild->GetAddress())[nSize - 1] != (char)(nSize >> 12))
+				nErrors++;
+		}
+
+		delete pChild;
+		_exit(nErrors == 0 ? 0 : 1);
+	}
+
+	close(fds[0]);
+
+	unsigned int nSteps = 0;
+	double begin = GetTimeInSeconds();
+
+	for(unsigned long nSize = 2 * BENCH_PAGE_SIZE; nSize <= BENCH_REGION_SIZE; nSize *= 2, nSteps++)
+	{
+		if(!pMemory->Resize(nSize).IsSuccess())
+		{
+			cout << "Resize error" << endl;
+			break;
+		}
+
+		((char *)pMemory->GetAddress())[nSize - 1] = (char)(nSize >> 12);
+
+		if(write(fds[1], &nSize, sizeof(nSize)) != sizeof(nSize))
+			break;
+	}
+
+	double elapsed = GetTimeInSeconds() - begin;
+	close(fds[1]);
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	cout << "mode=resize type=" << GetTypeName(SHARED_MEMORY_USE_POSIX, nFlags) << " steps=" << nSteps;
+	cout << " final_mb=" << pMemory->GetSize() / 1024 / 1024;
+	cout << " us_per_resize=" << elapsed * 1e6 / nSteps;
+	cout << " child_result=" << ((WIFEXITED(status) && (WEXITSTATUS(status) == 0)) ? "ok" : "error") << endl;
+
+	delete pMemory;
+}
+
+static void RunPersistence()
+{
+	CLSharedMemory *pMemory = new CLSharedMemory("bench_shared_memory_file", BENCH_PAGE_SIZE, SHARED_MEMORY_USE_FILE);
+	strcpy((char *)pMemory->GetAddress(), "persisted");
+	delete pMemory;
+
+	pMemory = new CLSharedMemory("bench_shared_memory_file", 0, SHARED_MEMORY_USE_FILE);
+	bool bOK = (strcmp((char *)pMemory->GetAddress(), "persisted") == 0);
+	delete pMemory;
+
+	unlink("/tmp/bench_shared_memory_file.shm");
+
+	cout << "mode=persistence type=file result=" << (bOK ? "ok" : "error") << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	try
+	{
+		RunAttach(SHARED_MEMORY_USE_SYSV, 2000);
+		RunAttach(SHARED_MEMORY_USE_POSIX, 2000);
+
+		RunTouch(SHARED_MEMORY_USE_SYSV, 0);
+		RunTouch(SHARED_MEMORY_USE_POSIX, 0);
+		RunTouch(SHARED_MEMORY_USE_POSIX, SHARED_MEMORY_FLAG_POPULATE);
+		RunTouch(SHARED_MEMORY_USE_POSIX, SHARED_MEMORY_FLAG_HUGE_PAGE);
+		RunTouch(SHARED_MEMORY_USE_POSIX, SHARED_MEMORY_FLAG_HUGE_PAGE | SHARED_MEMORY_FLAG_POPULATE);
+
+		RunResize(0);
+		RunResize(SHARED_MEMORY_FLAG_POPULATE);
+
+		RunPersistence();
+	}
+	catch(const char *pstr)
+	{
+		cout << pstr << endl;
+	}
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "LibExecutive.h"
+#include "CLSharedEventImpl.h"
+
+using namespace std;
+
+static long GetTimeInNanoseconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+//δٴλȡͷnObjects¼ͳÿβƽʱ
+static void RunBench(unsigned long nObjects, unsigned long nRounds)
+{
+	vector<string> Names;
+	for(unsigned long i = 0; i < nObjects; i++)
+	{
+		char strName[64];
+		snprintf(strName, sizeof(strName), "bench_shared_objects_%lu", i);
+		Names.push_back(strName);
+	}
+
+	long lCreate = 0, lLookup = 0, lRelease = 0;
+	unsigned long nFailures = 0;
+
+	for(unsigned long r = 0; r < nRounds; r++)
+	{
+		long begin = GetTimeInNanoseconds();
+		for(unsigned long i = 0; i < nObjects; i++)
+		{
+			if(CLSharedEventAllocator::Get(Names[i].c_str()) == 0)
+				nFailures++;
+		}
+
+		long middle = GetTimeInNanoseconds();
+		for(unsigned long i = 0; i < nObjects; i++)
+		{
+			if(CLSharedEventAllocator::Get(Names[i].c_str()) == 0)
+				nFailures++;
+		}
+
+		long end = GetTimeInNanoseconds();
+		for(unsigned long i = 0; i < nObjects; i++)
+		{
+			CLSharedEventAllocator::Release(Names[i].c_str());
+			CLSharedEventAllocator::Release(Names[i].c_str());
+		}
+
+		lCreate += middle - begin;
+		lLookup += end - middle;
+		lRelease += GetTimeInNanoseconds() - end;
+	}
+
+	unsigned long nOperations = nObjects * nRounds;
+
+	cout << "objects=" << nObjects << " rounds=" << nRounds;
+	cout << " create_ns=" << lCreate / nOperations;
+	cout << " lookup_ns=" << lLookup / nOperations;
+	cout << " release_ns=" << lRelease / nOperations / 2;
+	cout << " failures=" << nFailures << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	RunBench(100, 100);
+	RunBench(1000, 10);
+	RunBench(4000, 5);
+	RunBench(16000, 2);
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
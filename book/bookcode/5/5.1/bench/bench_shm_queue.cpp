@@ -0,0 +1,312 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_MESSAGE_ID 1
+
+static long GetTimeInNanoseconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+class CLBenchIPCMsg : public CLMessage
+{
+public:
+	CLBenchIPCMsg(unsigned int nPayloadLength) : CLMessage(BENCH_MESSAGE_ID)
+	{
+		m_lSendTime = 0;
+		m_nPayloadLength = nPayloadLength;
+		m_pPayload = new char[nPayloadLength];
+	}
+
+	virtual ~CLBenchIPCMsg()
+	{
+		delete [] m_pPayload;
+	}
+
+public:
+	long m_lSendTime;
+	unsigned int m_nPayloadLength;
+	char *m_pPayload;
+};
+
+class CLBenchIPCMsgSerializer : public CLMessageSerializer
+{
+public:
+	virtual char *Serialize(CLMessage *pMsg, unsigned int *pFullLength, unsigned int HeadLength)
+	{
+		CLBenchIPCMsg *p = dynamic_cast<CLBenchIPCMsg *>(pMsg);
+		if(p == 0)
+			return 0;
+
+		*pFullLength = HeadLength + 8 + 8 + 8 + p->m_nPayloadLength;
+		char *pBuf = new char[*pFullLength];
+
+		*((long *)(pBuf + HeadLength)) = p->m_clMsgID;
+		*((long *)(pBuf + HeadLength + 8)) = p->m_lSendTime;
+		*((long *)(pBuf + HeadLength + 16)) = p->m_nPayloadLength;
+		memcpy(pBuf + HeadLength + 24, p->m_pPayload, p->m_nPayloadLength);
+
+		return pBuf;
+	}
+};
+
+class CLBenchIPCMsgDeserializer : public CLMessageDeserializer
+{
+public:
+	virtual CLMessage *Deserialize(char *pBuffer)
+	{
+		unsigned int nPayloadLength = *((long *)(pBuffer + 16));
+
+		CLBenchIPCMsg *p = new CLBenchIPCMsg(nPayloadLength);
+		p->m_lSendTime = *((long *)(pBuffer + 8));
+		memcpy(p->m_pPayload, pBuffer + 24, nPayloadLength);
+
+		return p;
+	}
+};
+
+//ݲƣֱд뻷еļ¼ͨwritevֱдܵ
+class CLBenchIPCMsgZeroCopySerializer : public CLZeroCopyMessageSerializer
+{
+public:
+	virtual unsigned int GetSerializedLength(CLMessage *pMsg)
+	{
+		CLBenchIPCMsg *p = dynamic_cast<CLBenchIPCMsg *>(pMsg);
+		if(p == 0)
+			return 0;
+
+		return 8 + 8 + 8 + p->m_nPayloadLength;
+	}
+
+	virtual CLStatus Serialize(CLMessage *pMsg, CLSerializeCursor *pCursor)
+	{
+		CLBenchIPCMsg *p = (CLBenchIPCMsg *)pMsg;
+
+		long Head[3];
+		Head[0] = p->m_clMsgID;
+		Head[1] = p->m_lSendTime;
+		Head[2] = p->m_nPayloadLength;
+
+		CLStatus s = pCursor->Write(Head, sizeof(Head));
+		if(!s.IsSuccess())
+			return s;
+
+		return pCursor->WriteReference(p->m_pPayload, p->m_nPayloadLength);
+	}
+};
+
+class CLBenchIPCMsgZeroCopyDeserializer : public CLZeroCopyMessageDeserializer
+{
+public:
+	virtual CLMessage *Deserialize(const char *pBuffer, unsigned int nLength)
+	{
+		if(nLength < 24)
+			return 0;
+
+		unsigned int nPayloadLength = *((long *)(pBuffer + 16));
+		if(nLength - 24 < nPayloadLength)
+			return 0;
+
+		CLBenchIPCMsg *p = new CLBenchIPCMsg(nPayloadLength);
+		p->m_lSendTime = *((long *)(pBuffer + 8));
+		memcpy(p->m_pPayload, pBuffer + 24, nPayloadLength);
+
+		return p;
+	}
+};
+
+class CLBenchObserver : public CLMessageObserver
+{
+public:
+	CLBenchObserver(unsigned long nTotal, vector<long> *pLatencies)
+	{
+		m_nTotal = nTotal;
+		m_nReceived = 0;
+		m_pLatencies = pLatencies;
+	}
+
+	virtual ~CLBenchObserver()
+	{
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		return pMessageLoop->Register(BENCH_MESSAGE_ID, (CallBackForMessageLoop)(&CLBenchObserver::On_Bench));
+	}
+
+	CLStatus On_Bench(CLMessage *pm)
+	{
+		CLBenchIPCMsg *p = (CLBenchIPCMsg *)pm;
+		m_pLatencies->push_back(GetTimeInNanoseconds() - p->m_lSendTime);
+
+		m_nReceived++;
+		if(m_nReceived == m_nTotal)
+			return CLStatus(QUIT_MESSAGE_LOOP, 0);
+
+		return CLStatus(0, 0);
+	}
+
+private:
+	unsigned long m_nTotal;
+	unsigned long m_nReceived;
+	vector<long> *m_pLatencies;
+};
+
+template<typename TSender>
+static void RegisterBenchSerializer(TSender *pSender, bool bZeroCopy)
+{
+	if(bZeroCopy)
+		pSender->RegisterSerializer(BENCH_MESSAGE_ID, new CLBenchIPCMsgZeroCopySerializer);
+	else
+		pSender->RegisterSerializer(BENCH_MESSAGE_ID, new CLBenchIPCMsgSerializer);
+}
+
+static CLExecutiveCommunication *CreateSender(int ExecutiveType, const char *pstrExecutiveName, bool bZeroCopy)
+{
+	if(ExecutiveType == EXECUTIVE_BETWEEN_PROCESS_USE_PIPE_QUEUE)
+	{
+		CLSharedExecutiveCommunicationByNamedPipe *pSender = new CLSharedExecutiveCommunicationByNamedPipe(pstrExecutiveName);
+		RegisterBenchSerializer(pSender, bZeroCopy);
+		return pSender;
+	}
+
+	CLSharedExecutiveCommunicationByShmRing *pSender = new CLSharedExecutiveCommunicationByShmRing(pstrExecutiveName);
+	RegisterBenchSerializer(pSender, bZeroCopy);
+	return pSender;
+}
+
+static void RunProducer(int ExecutiveType, bool bZeroCopy, const char *pstrExecutiveName, unsigned int nPayloadLength, unsigned long nMessages, long lIntervalNs)
+{
+	CLExecutiveCommunication *pSender = CreateSender(ExecutiveType, pstrExecutiveName, bZeroCopy);
+
+	unsigned long nRetries = 0;
+	long lNextSendTime = GetTimeInNanoseconds();
+
+	for(unsigned long i = 0; i < nMessages; i++)
+	{
+		if(lIntervalNs > 0)
+		{
+			while(GetTimeInNanoseconds() < lNextSendTime)
+				;
+
+			lNextSendTime += lIntervalNs;
+		}
+
+		while(true)
+		{
+			CLBenchIPCMsg *pMsg = new CLBenchIPCMsg(nPayloadLength);
+			pMsg->m_lSendTime = GetTimeInNanoseconds();
+
+			if(pSender->PostExecutiveMessage(pMsg).IsSuccess())
+				break;
+
+			nRetries++;
+			sched_yield();
+		}
+	}
+
+	delete pSender;
+
+	if(nRetries != 0)
+		cerr << "producer full_retries=" << nRetries << endl;
+}
+
+static void RunBench(const char *pstrMode, int ExecutiveType, bool bZeroCopy, unsigned int nPayloadLength, unsigned long nMessages, long lIntervalNs)
+{
+	const char *pstrExecutiveName = "bench_shm_queue";
+
+	vector<long> Latencies;
+	Latencies.reserve(nMessages);
+
+	long begin = 0;
+	pid_t pid = -1;
+	{
+		CLThreadForMsgLoop consumer(new CLBenchObserver(nMessages, &Latencies), pstrExecutiveName, true, ExecutiveType);
+		if(bZeroCopy)
+			consumer.RegisterDeserializer(BENCH_MESSAGE_ID, new CLBenchIPCMsgZeroCopyDeserializer);
+		else
+			consumer.RegisterDeserializer(BENCH_MESSAGE_ID, new CLBenchIPCMsgDeserializer);
+
+		if(!consumer.Run(0).IsSuccess())
+		{
+			cout << "consumer Run error" << endl;
+			return;
+		}
+
+		begin = GetTimeInNanoseconds();
+
+		pid = fork();
+		if(pid == -1)
+		{
+			cout << "fork error" << endl;
+			exit(0);
+		}
+
+		if(pid == 0)
+		{
+			RunProducer(ExecutiveType, bZeroCopy, pstrExecutiveName, nPayloadLength, nMessages, lIntervalNs);
+			_exit(0);
+		}
+	}
+	double elapsed = (GetTimeInNanoseconds() - begin) / 1e9;
+
+	waitpid(pid, 0, 0);
+
+	sort(Latencies.begin(), Latencies.end());
+
+	cout << "mode=" << pstrMode << " serializer=" << (bZeroCopy ? "zero_copy" : "legacy") << " payload=" << nPayloadLength << " messages=" << nMessages;
+	if(lIntervalNs == 0)
+		cout << " elapsed_ms=" << elapsed * 1000 << " msgs_per_sec=" << (unsigned long)(nMessages / elapsed);
+	else
+		cout << " interval_us=" << lIntervalNs / 1000;
+
+	cout << " latency_p50_us=" << Latencies[Latencies.size() / 2] / 1000.0;
+	cout << " latency_p99_us=" << Latencies[Latencies.size() * 99 / 100] / 1000.0 << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nMessages = (argc > 1) ? strtoul(argv[1], 0, 10) : 200000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	unsigned int Payloads[] = {64, 1024};
+	for(unsigned int i = 0; i < sizeof(Payloads) / sizeof(Payloads[0]); i++)
+	{
+		for(int j = 0; j < 2; j++)
+		{
+			bool bZeroCopy = (j == 1);
+
+			RunBench("named_pipe", EXECUTIVE_BETWEEN_PROCESS_USE_PIPE_QUEUE, bZeroCopy, Payloads[i], nMessages, 0);
+			RunBench("shm_ring", EXECUTIVE_BETWEEN_PROCESS_USE_SHM_QUEUE, bZeroCopy, Payloads[i], nMessages, 0);
+			RunBench("named_pipe", EXECUTIVE_BETWEEN_PROCESS_USE_PIPE_QUEUE, bZeroCopy, Payloads[i], nMessages / 10, 20000);
+			RunBench("shm_ring", EXECUTIVE_BETWEEN_PROCESS_USE_SHM_QUEUE, bZeroCopy, Payloads[i], nMessages / 10, 20000);
+		}
+	}
+
+	//PIPE_BUFϢֻͨ洢
+	RunBench("shm_ring", EXECUTIVE_BETWEEN_PROCESS_USE_SHM_QUEUE, false, 1 << 20, 200, 0);
+	RunBench("shm_ring", EXECUTIVE_BETWEEN_PROCESS_USE_SHM_QUEUE, true, 1 << 20, 200, 0);
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
@@ -0,0 +1,1255 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/utsname.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+/*
+LibExecutiveĻ׼ԼÿڵӽУ̶ϢظΣ
+JSONʽÿеλСֵֵȫ
+÷bench_suite [-o ļ] [-r ظ] [-w Ԥȴ] [-s ģϵ] [-p ] [-f Ӵ]
+*/
+
+#define SUITE_MESSAGE_ID 1
+#define SUITE_TIMED_MESSAGE_ID 2
+#define SUITE_PING_ID 3
+#define SUITE_PONG_ID 4
+#define SUITE_QUIT_ID 5
+
+#define SUITE_DEFAULT_REPEATS 5
+#define SUITE_DEFAULT_WARMUPS 1
+#define SUITE_DEFAULT_MAX_PRODUCERS 4
+
+struct SLSuiteConfig
+{
+	int nRepeats;
+	int nWarmups;
+	double dScale;
+	int nMaxProducers;
+	const char *pstrFilter;
+	const char *pstrOutput;
+};
+
+//ӽͨùܵÿдظ̣ʽΪ"\t\tָ\tλ\tֵ\n"
+static int g_nResultFd = -1;
+
+static unsigned long long GetTimeInNanoseconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static unsigned long Scaled(const SLSuiteConfig *pConfig, unsigned long nCount)
+{
+	unsigned long n = (unsigned long)(nCount * pConfig->dScale);
+	return (n == 0) ? 1 : n;
+}
+
+//ճΪJSON"params"
+class CLSuiteParams
+{
+public:
+	CLSuiteParams &Add(const char *pstrKey, const char *pstrValue)
+	{
+		Separate();
+		m_str << "\"" << pstrKey << "\":\"" << pstrValue << "\"";
+		return *this;
+	}
+
+	CLSuiteParams &Add(const char *pstrKey, long lValue)
+	{
+		Separate();
+		m_str << "\"" << pstrKey << "\":" << lValue;
+		return *this;
+	}
+
+	string ToString() const
+	{
+		return m_str.str();
+	}
+
+private:
+	void Separate()
+	{
+		if(!m_str.str().empty())
+			m_str << ",";
+	}
+
+private:
+	ostringstream m_str;
+};
+
+static void Report(const char *pstrName, const CLSuiteParams &Params, const char *pstrMetric, const char *pstrUnit, double dValue)
+{
+	char buf[64];
+	snprintf(buf, sizeof(buf), "%.3f", dValue);
+
+	string strLine = string(pstrName) + "\t" + Params.ToString() + "\t" + pstrMetric + "\t" + pstrUnit + "\t" + buf + "\n";
+
+	//ԶСPIPE_BUFдԭӵ
+	if(write(g_nResultFd, strLine.c_str(), strLine.length()) != (ssize_t)strLine.length())
+		cerr << "bench_suite: write result error" << endl;
+}
+
+static void ReportLatency(const char *pstrName, const CLSuiteParams &Params, CLLatencyHistogram *pHistogram)
+{
+	Report(pstrName, Params, "p50", "ns", (double)pHistogram->GetValueAtPercentile(50));
+	Report(pstrName, Params, "p99", "ns", (double)pHistogram->GetValueAtPercentile(99));
+	Report(pstrName, Params, "p999", "ns", (double)pHistogram->GetValueAtPercentile(99.9));
+	Report(pstrName, Params, "max", "ns", (double)pHistogram->GetMax());
+	Report(pstrName, Params, "mean", "ns", pHistogram->GetMean());
+}
+
+static const char *GetQueueName(int ExecutiveType)
+{
+	switch(ExecutiveType)
+	{
+	case EXECUTIVE_IN_PROCESS_USE_STL_QUEUE:
+		return "stl_queue";
+	case EXECUTIVE_IN_PROCESS_USE_PIPE_QUEUE:
+		return "private_pipe";
+	case EXECUTIVE_BETWEEN_PROCESS_USE_PIPE_QUEUE:
+		return "named_pipe";
+	case EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING:
+		return "lock_free_ring";
+	case EXECUTIVE_BETWEEN_PROCESS_USE_SHM_QUEUE:
+		return "shm_ring";
+	default:
+		return "unknown";
+	}
+}
+
+static int g_InProcessTypes[] = {EXECUTIVE_IN_PROCESS_USE_STL_QUEUE, EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING, EXECUTIVE_IN_PROCESS_USE_PIPE_QUEUE};
+
+//1, 2, 4 ... ֱnMaxProducersnMaxProducers2ʱҲ
+static vector<int> GetProducerCounts(const SLSuiteConfig *pConfig)
+{
+	vector<int> Counts;
+	for(int n = 1; n < pConfig->nMaxProducers; n *= 2)
+		Counts.push_back(n);
+
+	Counts.push_back(pConfig->nMaxProducers);
+	return Counts;
+}
+
+//ͶʧܣζʱϢѱͷţҪ·
+static void PostUntilSuccess(CLExecutiveCommunication *pComm, unsigned long lMsgID)
+{
+	while(!pComm->PostExecutiveMessage(new CLMessage(lMsgID)).IsSuccess())
+		sched_yield();
+}
+
+/************************************************************************/
+/* postdispatch                                          */
+/************************************************************************/
+
+class CLSuiteCountingObserver : public CLMessageObserver
+{
+public:
+	CLSuiteCountingObserver(unsigned long nTotal, unsigned long long *pEndTime)
+	{
+		m_nTotal = nTotal;
+		m_nReceived = 0;
+		m_pEndTime = pEndTime;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		return pMessageLoop->Register(SUITE_MESSAGE_ID, (CallBackForMessageLoop)(&CLSuiteCountingObserver::On_Message));
+	}
+
+	CLStatus On_Message(CLMessage *pm)
+	{
+		m_nReceived++;
+		if(m_nReceived < m_nTotal)
+			return CLStatus(0, 0);
+
+		*m_pEndTime = GetTimeInNanoseconds();
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+
+private:
+	unsigned long m_nTotal;
+	unsigned long m_nReceived;
+	unsigned long long *m_pEndTime;
+};
+
+struct SLSuiteProducerContext
+{
+	const char *pstrExecutiveName;
+	unsigned long nMessages;
+	CLEvent *pStartGate;
+};
+
+static void *ProducerThread(void *pContext)
+{
+	SLSuiteProducerContext *p = (SLSuiteProducerContext *)pContext;
+
+	CLExecutiveHandle handle(p->pstrExecutiveName);
+
+	p->pStartGate->Wait();
+
+	for(unsigned long i = 0; i < p->nMessages; i++)
+		PostUntilSuccess(&handle, SUITE_MESSAGE_ID);
+
+	return 0;
+}
+
+static void BenchPostDispatchThroughput(const SLSuiteConfig *pConfig)
+{
+	const char *pstrExecutiveName = "bench_suite_throughput";
+	unsigned long nMessagesPerProducer = Scaled(pConfig, 200000);
+	vector<int> Producers = GetProducerCounts(pConfig);
+
+	for(unsigned int t = 0; t < sizeof(g_InProcessTypes) / sizeof(g_InProcessTypes[0]); t++)
+	{
+		for(unsigned int k = 0; k < Producers.size(); k++)
+		{
+			int nProducers = Producers[k];
+			unsigned long nTotal = nMessagesPerProducer * nProducers;
+			unsigned long long begin = 0, end = 0;
+
+			{
+				CLThreadForMsgLoop consumer(new CLSuiteCountingObserver(nTotal, &end), pstrExecutiveName, true, g_InProcessTypes[t]);
+				if(!consumer.Run(0).IsSuccess())
+				{
+					cerr << "bench_suite: consumer Run error" << endl;
+					return;
+				}
+
+				CLEvent StartGate(true);
+				SLSuiteProducerContext context;
+				context.pstrExecutiveName = pstrExecutiveName;
+				context.nMessages = nMessagesPerProducer;
+				context.pStartGate = &StartGate;
+
+				vector<pthread_t> Threads(nProducers);
+				for(int i = 0; i < nProducers; i++)
+					pthread_create(&Threads[i], 0, ProducerThread, &context);
+
+				begin = GetTimeInNanoseconds();
+				for(int i = 0; i < nProducers; i++)
+					StartGate.Set();
+
+				for(int i = 0; i < nProducers; i++)
+					pthread_join(Threads[i], 0);
+			}
+
+			CLSuiteParams Params;
+			Params.Add("queue", GetQueueName(g_InProcessTypes[t])).Add("producers", nProducers).Add("messages", nTotal);
+			Report("post_dispatch_throughput", Params, "throughput", "msgs/s", nTotal * 1e9 / (end - begin));
+		}
+	}
+}
+
+/************************************************************************/
+/* postdispatchĵӳ٣ÿֻһϢ;                 */
+/************************************************************************/
+
+class CLSuiteTimedMessage : public CLMessage
+{
+public:
+	CLSuiteTimedMessage() : CLMessage(SUITE_TIMED_MESSAGE_ID)
+	{
+		m_nSendTime = GetTimeInNanoseconds();
+	}
+
+	unsigned long long m_nSendTime;
+};
+
+class CLSuiteLatencyObserver : public CLMessageObserver
+{
+public:
+	CLSuiteLatencyObserver(unsigned long nWarmup, unsigned long nTotal, CLLatencyHistogram *pHistogram, CLEvent *pDone)
+	{
+		m_nWarmup = nWarmup;
+		m_nTotal = nTotal;
+		m_nReceived = 0;
+		m_pHistogram = pHistogram;
+		m_pDone = pDone;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		return pMessageLoop->Register(SUITE_TIMED_MESSAGE_ID, (CallBackForMessageLoop)(&CLSuiteLatencyObserver::On_Timed));
+	}
+
+	CLStatus On_Timed(CLMessage *pm)
+	{
+		unsigned long long nLatency = GetTimeInNanoseconds() - ((CLSuiteTimedMessage *)pm)->m_nSendTime;
+
+		m_nReceived++;
+		if(m_nReceived > m_nWarmup)
+			m_pHistogram->Record(nLatency);
+
+		m_pDone->Set();
+
+		if(m_nReceived == m_nTotal)
+			return CLStatus(QUIT_MESSAGE_LOOP, 0);
+
+		return CLStatus(0, 0);
+	}
+
+private:
+	unsigned long m_nWarmup;
+	unsigned long m_nTotal;
+	unsigned long m_nReceived;
+	CLLatencyHistogram *m_pHistogram;
+	CLEvent *m_pDone;
+};
+
+static void BenchPostDispatchLatency(const SLSuiteConfig *pConfig)
+{
+	const char *pstrExecutiveName = "bench_suite_latency";
+	unsigned long nRounds = Scaled(pConfig, 20000);
+	unsigned long nWarmup = nRounds / 10;
+
+	for(unsigned int t = 0; t < sizeof(g_InProcessTypes) / sizeof(g_InProcessTypes[0]); t++)
+	{
+		CLLatencyHistogram Histogram;
+		CLEvent Done;
+
+		{
+			CLThreadForMsgLoop consumer(new CLSuiteLatencyObserver(nWarmup, nWarmup + nRounds, &Histogram, &Done), pstrExecutiveName, true, g_InProcessTypes[t]);
+			if(!consumer.Run(0).IsSuccess())
+			{
+				cerr << "bench_suite: consumer Run error" << endl;
+				return;
+			}
+
+			CLExecutiveHandle handle(pstrExecutiveName);
+
+			for(unsigned long i = 0; i < nWarmup + nRounds; i++)
+			{
+				while(!handle.PostExecutiveMessage(new CLSuiteTimedMessage).IsSuccess())
+					sched_yield();
+
+				Done.Wait();
+			}
+		}
+
+		CLSuiteParams Params;
+		Params.Add("queue", GetQueueName(g_InProcessTypes[t])).Add("rounds", nRounds);
+		ReportLatency("post_dispatch_latency", Params, &Histogram);
+	}
+}
+
+/************************************************************************/
+/* ̵ִ̼巢PINGӽ̵ִӦPONG           */
+/************************************************************************/
+
+template<typename TCommunication>
+static CLExecutiveCommunication *CreateIDSender(const char *pstrExecutiveName, unsigned long lMsgID1, unsigned long lMsgID2)
+{
+	TCommunication *pSender = new TCommunication(pstrExecutiveName);
+	pSender->RegisterSerializer(lMsgID1, new CLMessageIDSerializer);
+	pSender->RegisterSerializer(lMsgID2, new CLMessageIDSerializer);
+	return pSender;
+}
+
+static CLExecutiveCommunication *CreateIDSender(int ExecutiveType, const char *pstrExecutiveName, unsigned long lMsgID1, unsigned long lMsgID2)
+{
+	if(ExecutiveType == EXECUTIVE_BETWEEN_PROCESS_USE_PIPE_QUEUE)
+		return CreateIDSender<CLSharedExecutiveCommunicationByNamedPipe>(pstrExecutiveName, lMsgID1, lMsgID2);
+
+	return CreateIDSender<CLSharedExecutiveCommunicationByShmRing>(pstrExecutiveName, lMsgID1, lMsgID2);
+}
+
+struct SLSuiteEchoContext
+{
+	int ExecutiveType;
+	int nReadyFd;
+};
+
+//ӽеĻӦ״յPINGʱӷ𷽣ʱ𷽵ִȻѾ
+class CLSuiteEchoObserver : public CLMessageObserver
+{
+public:
+	CLSuiteEchoObserver(const char *pstrPingerName)
+	{
+		m_pstrPingerName = pstrPingerName;
+		m_ExecutiveType = 0;
+		m_pPinger = 0;
+	}
+
+	virtual ~CLSuiteEchoObserver()
+	{
+		delete m_pPinger;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		SLSuiteEchoContext *p = (SLSuiteEchoContext *)pContext;
+		m_ExecutiveType = p->ExecutiveType;
+
+		pMessageLoop->Register(SUITE_PING_ID, (CallBackForMessageLoop)(&CLSuiteEchoObserver::On_Ping));
+		pMessageLoop->Register(SUITE_QUIT_ID, (CallBackForMessageLoop)(&CLSuiteEchoObserver::On_Quit));
+
+		char c = 0;
+		if(write(p->nReadyFd, &c, 1) != 1)
+			return CLStatus(-1, 0);
+
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Ping(CLMessage *pm)
+	{
+		if(m_pPinger == 0)
+			m_pPinger = CreateIDSender(m_ExecutiveType, m_pstrPingerName, SUITE_PONG_ID, SUITE_QUIT_ID);
+
+		PostUntilSuccess(m_pPinger, SUITE_PONG_ID);
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Quit(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+
+private:
+	const char *m_pstrPingerName;
+	int m_ExecutiveType;
+	CLExecutiveCommunication *m_pPinger;
+};
+
+class CLSuitePingObserver : public CLMessageObserver
+{
+public:
+	CLSuitePingObserver(CLExecutiveCommunication *pEcho, unsigned long nWarmup, unsigned long nTotal, CLLatencyHistogram *pHistogram, unsigned long long *pSendTime)
+	{
+		m_pEcho = pEcho;
+		m_nWarmup = nWarmup;
+		m_nTotal = nTotal;
+		m_nReceived = 0;
+		m_pHistogram = pHistogram;
+		m_pSendTime = pSendTime;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		return pMessageLoop->Register(SUITE_PONG_ID, (CallBackForMessageLoop)(&CLSuitePingObserver::On_Pong));
+	}
+
+	CLStatus On_Pong(CLMessage *pm)
+	{
+		unsigned long long nNow = GetTimeInNanoseconds();
+
+		m_nReceived++;
+		if(m_nReceived > m_nWarmup)
+			m_pHistogram->Record(nNow - *m_pSendTime);
+
+		if(m_nReceived == m_nTotal)
+		{
+			PostUntilSuccess(m_pEcho, SUITE_QUIT_ID);
+			return CLStatus(QUIT_MESSAGE_LOOP, 0);
+		}
+
+		*m_pSendTime = GetTimeInNanoseconds();
+		PostUntilSuccess(m_pEcho, SUITE_PING_ID);
+
+		return CLStatus(0, 0);
+	}
+
+private:
+	CLExecutiveCommunication *m_pEcho;
+	unsigned long m_nWarmup;
+	unsigned long m_nTotal;
+	unsigned long m_nReceived;
+	CLLatencyHistogram *m_pHistogram;
+	unsigned long long *m_pSendTime;
+};
+
+static void RunRoundTrip(int ExecutiveType, unsigned long nWarmup, unsigned long nRounds)
+{
+	const char *pstrPingerName = "bench_suite_pinger";
+	const char *pstrEchoName = "bench_suite_echo";
+
+	int fds[2];
+	if(pipe(fds) == -1)
+	{
+		cerr << "bench_suite: pipe error" << endl;
+		return;
+	}
+
+	//̸ԳʼӦ̳з𷽵κִ
+	pid_t pid = fork();
+	if(pid == -1)
+	{
+		cerr << "bench_suite: fork error" << endl;
+		return;
+	}
+
+	if(pid == 0)
+	{
+		close(fds[0]);
+
+		if(CLLibExecutiveInitializer::Initialize().IsSuccess())
+		{
+			SLSuiteEchoContext context;
+			context.ExecutiveType = ExecutiveType;
+			context.nReadyFd = fds[1];
+
+			CLNonThreadForMsgLoop echo(new CLSuiteEchoObserver(pstrPingerName), pstrEchoName, ExecutiveType);
+			echo.RegisterDeserializer(SUITE_PING_ID, new CLMessageIDDeserializer);
+			echo.RegisterDeserializer(SUITE_QUIT_ID, new CLMessageIDDeserializer);
+			echo.Run(&context);
+
+			CLLibExecutiveInitializer::Destroy();
+		}
+
+		_exit(0);
+	}
+
+	close(fds[1]);
+
+	char c;
+	bool bReady = (read(fds[0], &c, 1) == 1);
+	close(fds[0]);
+
+	if((!bReady) || (!CLLibExecutiveInitializer::Initialize().IsSuccess()))
+	{
+		cerr << "bench_suite: echo executive error" << endl;
+		kill(pid, SIGKILL);
+		waitpid(pid, 0, 0);
+		return;
+	}
+
+	CLLatencyHistogram Histogram;
+	unsigned long long nSendTime = 0;
+	CLExecutiveCommunication *pEcho = CreateIDSender(ExecutiveType, pstrEchoName, SUITE_PING_ID, SUITE_QUIT_ID);
+
+	{
+		CLThreadForMsgLoop pinger(new CLSuitePingObserver(pEcho, nWarmup, nWarmup + nRounds, &Histogram, &nSendTime), pstrPingerName, true, ExecutiveType);
+		pinger.RegisterDeserializer(SUITE_PONG_ID, new CLMessageIDDeserializer);
+
+		if(!pinger.Run(0).IsSuccess())
+		{
+			cerr << "bench_suite: pinger Run error" << endl;
+			kill(pid, SIGKILL);
+			waitpid(pid, 0, 0);
+			delete pEcho;
+			CLLibExecutiveInitializer::Destroy();
+			return;
+		}
+
+		//ֻ֮pinger߳ʹpEcho
+		nSendTime = GetTimeInNanoseconds();
+		PostUntilSuccess(pEcho, SUITE_PING_ID);
+	}
+
+	waitpid(pid, 0, 0);
+	delete pEcho;
+
+	CLLibExecutiveInitializer::Destroy();
+
+	CLSuiteParams Params;
+	Params.Add("transport", GetQueueName(ExecutiveType)).Add("rounds", nRounds);
+	ReportLatency("ipc_round_trip", Params, &Histogram);
+}
+
+static void BenchIPCRoundTrip(const SLSuiteConfig *pConfig)
+{
+	unsigned long nRounds = Scaled(pConfig, 20000);
+	int Types[] = {EXECUTIVE_BETWEEN_PROCESS_USE_PIPE_QUEUE, EXECUTIVE_BETWEEN_PROCESS_USE_SHM_QUEUE};
+
+	//CLLibExecutiveInitializerֻܳʼһΣÿִ䷽ʽڵӽн
+	for(unsigned int t = 0; t < sizeof(Types) / sizeof(Types[0]); t++)
+	{
+		pid_t pid = fork();
+		if(pid == -1)
+		{
+			cerr << "bench_suite: fork error" << endl;
+			return;
+		}
+
+		if(pid == 0)
+		{
+			RunRoundTrip(Types[t], nRounds / 10, nRounds);
+			_exit(0);
+		}
+
+		waitpid(pid, 0, 0);
+	}
+}
+
+/************************************************************************/
+/* CLExecutiveNameServerҡͶݡͶ                  */
+/************************************************************************/
+
+#define SUITE_NAME_LOOKUP 0
+#define SUITE_NAME_POST_BY_NAME 1
+#define SUITE_NAME_POST_BY_HANDLE 2
+
+//ֻϢʹֻӳַĿ
+class CLSuiteNullCommunication : public CLExecutiveCommunication
+{
+public:
+	virtual CLStatus PostExecutiveMessage(CLMessage *pMessage)
+	{
+		return CLStatus(0, 0);
+	}
+};
+
+struct SLSuiteNameContext
+{
+	int nMode;
+	const char *pstrExecutiveName;
+	unsigned long nOperations;
+	CLMessage *pMessage;
+};
+
+static void *NameServerThread(void *pContext)
+{
+	SLSuiteNameContext *p = (SLSuiteNameContext *)pContext;
+
+	if(p->nMode == SUITE_NAME_LOOKUP)
+	{
+		CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+
+		for(unsigned long i = 0; i < p->nOperations; i++)
+		{
+			pNameServer->GetCommunicationPtr(p->pstrExecutiveName);
+			pNameServer->ReleaseCommunicationPtr(p->pstrExecutiveName);
+		}
+	}
+	else if(p->nMode == SUITE_NAME_POST_BY_NAME)
+	{
+		for(unsigned long i = 0; i < p->nOperations; i++)
+			CLExecutiveNameServer::PostExecutiveMessage(p->pstrExecutiveName, p->pMessage);
+	}
+	else
+	{
+		CLExecutiveHandle handle(p->pstrExecutiveName);
+
+		for(unsigned long i = 0; i < p->nOperations; i++)
+			handle.PostExecutiveMessage(p->pMessage);
+	}
+
+	return 0;
+}
+
+static void BenchNameServer(const SLSuiteConfig *pConfig)
+{
+	const char *pstrExecutiveName = "bench_suite_null";
+	const char *Modes[] = {"lookup", "post_by_name", "post_by_handle"};
+	unsigned long nOperations = Scaled(pConfig, 1000000);
+
+	CLExecutiveNameServer::GetInstance()->Register(pstrExecutiveName, new CLSuiteNullCommunication);
+
+	CLMessage msg(SUITE_MESSAGE_ID);
+
+	int Threads[] = {1, pConfig->nMaxProducers};
+	int nThreadCounts = (pConfig->nMaxProducers > 1) ? 2 : 1;
+
+	for(int m = 0; m < 3; m++)
+	{
+		for(int k = 0; k < nThreadCounts; k++)
+		{
+			SLSuiteNameContext context;
+			context.nMode = m;
+			context.pstrExecutiveName = pstrExecutiveName;
+			context.nOperations = nOperations;
+			context.pMessage = &msg;
+
+			vector<pthread_t> ThreadIDs(Threads[k]);
+
+			unsigned long long begin = GetTimeInNanoseconds();
+
+			for(int i = 0; i < Threads[k]; i++)
+				pthread_create(&ThreadIDs[i], 0, NameServerThread, &context);
+
+			for(int i = 0; i < Threads[k]; i++)
+				pthread_join(ThreadIDs[i], 0);
+
+			unsigned long long elapsed = GetTimeInNanoseconds() - begin;
+			unsigned long nTotal = nOperations * Threads[k];
+
+			CLSuiteParams Params;
+			Params.Add("mode", Modes[m]).Add("threads", Threads[k]).Add("operations", nTotal);
+			Report("name_server", Params, "ns_per_op", "ns", (double)elapsed / nTotal);
+		}
+	}
+
+	CLExecutiveNameServer::GetInstance()->ReleaseCommunicationPtr(pstrExecutiveName);
+}
+
+/************************************************************************/
+/* CLEvent޾Set+Wait̼̼߳ƹ                  */
+/************************************************************************/
+
+struct SLSuitePingPong
+{
+	CLEvent *pPing;
+	CLEvent *pPong;
+	unsigned long nRounds;
+};
+
+static void *PongThread(void *pContext)
+{
+	SLSuitePingPong *p = (SLSuitePingPong *)pContext;
+
+	for(unsigned long i = 0; i < p->nRounds; i++)
+	{
+		p->pPing->Wait();
+		p->pPong->Set();
+	}
+
+	return 0;
+}
+
+static void RunPingPong(CLEvent *pPing, CLEvent *pPong, unsigned long nRounds, bool bBetweenProcess)
+{
+	SLSuitePingPong pp;
+	pp.pPing = pPing;
+	pp.pPong = pPong;
+	pp.nRounds = nRounds;
+
+	pthread_t tid;
+	pid_t pid = -1;
+
+	if(bBetweenProcess)
+	{
+		pid = fork();
+		if(pid == 0)
+		{
+			PongThread(&pp);
+			_exit(0);
+		}
+	}
+	else
+		pthread_create(&tid, 0, PongThread, &pp);
+
+	unsigned long long begin = GetTimeInNanoseconds();
+
+	for(unsigned long i = 0; i < nRounds; i++)
+	{
+		pPing->Set();
+		pPong->Wait();
+	}
+
+	unsigned long long elapsed = GetTimeInNanoseconds() - begin;
+
+	if(bBetweenProcess)
+		waitpid(pid, 0, 0);
+	else
+		pthread_join(tid, 0);
+
+	CLSuiteParams Params;
+	Params.Add("scope", bBetweenProcess ? "process" : "thread").Add("rounds", nRounds);
+	Report("event_ping_pong", Params, "round_trip", "ns", (double)elapsed / nRounds);
+}
+
+static void BenchEvent(const SLSuiteConfig *pConfig)
+{
+	unsigned long nRounds = Scaled(pConfig, 50000);
+
+	{
+		CLEvent e;
+		unsigned long nUncontended = nRounds * 10;
+
+		unsigned long long begin = GetTimeInNanoseconds();
+
+		for(unsigned long i = 0; i < nUncontended; i++)
+		{
+			e.Set();
+			e.Wait();
+		}
+
+		unsigned long long elapsed = GetTimeInNanoseconds() - begin;
+
+		CLSuiteParams Params;
+		Params.Add("scope", "uncontended").Add("rounds", nUncontended);
+		Report("event_set_wait", Params, "set_wait", "ns", (double)elapsed / nUncontended);
+	}
+
+	{
+		CLEvent ping, pong;
+		RunPingPong(&ping, &pong, nRounds, false);
+	}
+
+	{
+		CLEvent ping("bench_suite_ping"), pong("bench_suite_pong");
+		RunPingPong(&ping, &pong, nRounds, true);
+	}
+}
+
+/************************************************************************/
+/* CLLoggerͬ첽ģʽÿģʽڵӽгʼ         */
+/************************************************************************/
+
+#define SUITE_LOGGER_SYNC 0
+#define SUITE_LOGGER_ASYNC_BLOCK 1
+#define SUITE_LOGGER_ASYNC_DROP 2
+
+static void *LoggerThread(void *pContext)
+{
+	unsigned long nLogs = *((unsigned long *)pContext);
+
+	for(unsigned long i = 0; i < nLogs; i++)
+		CLLogger::WriteLogMsg("In LoggerThread(), bench_suite error storm", (long)i);
+
+	return 0;
+}
+
+static void RunLogger(int Mode, int nThreads, unsigned long nLogsPerThread)
+{
+	const char *Modes[] = {"mutex", "async_block", "async_drop"};
+
+	unlink("logger");
+
+	pid_t pid = fork();
+	if(pid == -1)
+	{
+		cerr << "bench_suite: fork error" << endl;
+		return;
+	}
+
+	if(pid != 0)
+	{
+		waitpid(pid, 0, 0);
+		unlink("logger");
+		return;
+	}
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+		_exit(0);
+
+	if(Mode == SUITE_LOGGER_ASYNC_BLOCK)
+		CLLogger::EnableAsyncMode(DEFAULT_SIZE_OF_LOGGER_THREAD_BUFFER, LOGGER_OVERFLOW_BLOCK);
+	else if(Mode == SUITE_LOGGER_ASYNC_DROP)
+		CLLogger::EnableAsyncMode(DEFAULT_SIZE_OF_LOGGER_THREAD_BUFFER, LOGGER_OVERFLOW_DROP);
+
+	vector<pthread_t> Threads(nThreads);
+
+	unsigned long long begin = GetTimeInNanoseconds();
+
+	for(int i = 0; i < nThreads; i++)
+		pthread_create(&Threads[i], 0, LoggerThread, &nLogsPerThread);
+
+	for(int i = 0; i < nThreads; i++)
+		pthread_join(Threads[i], 0);
+
+	//bench_loggerͬ첽ģʽĺʱDestroyʱһд
+	unsigned long long elapsed = GetTimeInNanoseconds() - begin;
+	unsigned long nDropped = CLLogger::GetNumberOfDroppedLogs();
+
+	CLLibExecutiveInitializer::Destroy();
+
+	unsigned long nTotal = nLogsPerThread * nThreads;
+
+	CLSuiteParams Params;
+	Params.Add("mode", Modes[Mode]).Add("threads", nThreads).Add("logs", nTotal);
+	Report("logger", Params, "throughput", "logs/s", nTotal * 1e9 / elapsed);
+	Report("logger", Params, "dropped", "logs", (double)nDropped);
+
+	_exit(0);
+}
+
+static void BenchLogger(const SLSuiteConfig *pConfig)
+{
+	unsigned long nLogs = Scaled(pConfig, 100000);
+
+	int Threads[] = {1, pConfig->nMaxProducers};
+	int nThreadCounts = (pConfig->nMaxProducers > 1) ? 2 : 1;
+
+	for(int m = SUITE_LOGGER_SYNC; m <= SUITE_LOGGER_ASYNC_DROP; m++)
+	{
+		for(int k = 0; k < nThreadCounts; k++)
+			RunLogger(m, Threads[k], nLogs / Threads[k]);
+	}
+}
+
+/************************************************************************/
+/* ִ˳CLThread::Runͨ¼߳             */
+/************************************************************************/
+
+class CLSuiteNullFunction : public CLExecutiveFunctionProvider
+{
+public:
+	virtual CLStatus RunExecutiveFunction(void* pContext)
+	{
+		return CLStatus(0, 0);
+	}
+};
+
+class CLSuiteQuitObserver : public CLMessageObserver
+{
+public:
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		return pMessageLoop->Register(SUITE_QUIT_ID, (CallBackForMessageLoop)(&CLSuiteQuitObserver::On_Quit));
+	}
+
+	CLStatus On_Quit(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+};
+
+static void *NullThread(void *pContext)
+{
+	return 0;
+}
+
+static void BenchStartStop(const SLSuiteConfig *pConfig)
+{
+	const char *pstrExecutiveName = "bench_suite_start_stop";
+	unsigned long nRounds = Scaled(pConfig, 2000);
+
+	//ܵ
+	{
+		unsigned long long begin = GetTimeInNanoseconds();
+
+		for(unsigned long i = 0; i < nRounds; i++)
+		{
+			pthread_t tid;
+			pthread_create(&tid, 0, NullThread, 0);
+			pthread_join(tid, 0);
+		}
+
+		CLSuiteParams Params;
+		Params.Add("executive", "pthread").Add("rounds", nRounds);
+		Report("executive_start_stop", Params, "start_stop", "ns", (double)(GetTimeInNanoseconds() - begin) / nRounds);
+	}
+
+	{
+		unsigned long long nRunTime = 0;
+		unsigned long long begin = GetTimeInNanoseconds();
+
+		for(unsigned long i = 0; i < nRounds; i++)
+		{
+			CLThread *pThread = new CLThread(new CLSuiteNullFunction, true);
+
+			unsigned long long nBeforeRun = GetTimeInNanoseconds();
+			if(!pThread->Run(0).IsSuccess())
+			{
+				cerr << "bench_suite: CLThread Run error" << endl;
+				return;
+			}
+			nRunTime += GetTimeInNanoseconds() - nBeforeRun;
+
+			pThread->WaitForDeath();
+		}
+
+		CLSuiteParams Params;
+		Params.Add("executive", "thread").Add("rounds", nRounds);
+		Report("executive_start_stop", Params, "start_stop", "ns", (double)(GetTimeInNanoseconds() - begin) / nRounds);
+		Report("executive_start_stop", Params, "run", "ns", (double)nRunTime / nRounds);
+	}
+
+	int Types[] = {EXECUTIVE_IN_PROCESS_USE_STL_QUEUE, EXECUTIVE_IN_PROCESS_USE_PIPE_QUEUE};
+	for(unsigned int t = 0; t < sizeof(Types) / sizeof(Types[0]); t++)
+	{
+		unsigned long long nRunTime = 0;
+		unsigned long long begin = GetTimeInNanoseconds();
+
+		for(unsigned long i = 0; i < nRounds; i++)
+		{
+			//ȴ߳˳ִ֮עһֿ
+			CLThreadForMsgLoop loop(new CLSuiteQuitObserver, pstrExecutiveName, true, Types[t]);
+
+			unsigned long long nBeforeRun = GetTimeInNanoseconds();
+			if(!loop.Run(0).IsSuccess())
+			{
+				cerr << "bench_suite: CLThreadForMsgLoop Run error" << endl;
+				return;
+			}
+			nRunTime += GetTimeInNanoseconds() - nBeforeRun;
+
+			CLExecutiveNameServer::PostExecutiveMessage(pstrExecutiveName, new CLMessage(SUITE_QUIT_ID, MESSAGE_PRIORITY_HIGH));
+		}
+
+		CLSuiteParams Params;
+		Params.Add("executive", "msg_loop_thread").Add("queue", GetQueueName(Types[t])).Add("rounds", nRounds);
+		Report("executive_start_stop", Params, "start_stop", "ns", (double)(GetTimeInNanoseconds() - begin) / nRounds);
+		Report("executive_start_stop", Params, "run", "ns", (double)nRunTime / nRounds);
+	}
+}
+
+/************************************************************************/
+/*                                                             */
+/************************************************************************/
+
+struct SLSuiteScenario
+{
+	const char *pstrName;
+	void (*pBench)(const SLSuiteConfig *);
+	//ΪfalseʱԼӽгʼҪͬ־ģʽĶԶ˽
+	bool bInitialize;
+};
+
+static SLSuiteScenario g_Scenarios[] =
+{
+	{"post_dispatch_throughput", BenchPostDispatchThroughput, true},
+	{"post_dispatch_latency", BenchPostDispatchLatency, true},
+	{"ipc_round_trip", BenchIPCRoundTrip, false},
+	{"name_server", BenchNameServer, true},
+	{"event", BenchEvent, true},
+	{"logger", BenchLogger, false},
+	{"executive_start_stop", BenchStartStop, true},
+};
+
+struct SLSuiteResult
+{
+	string strName;
+	string strParams;
+	string strMetric;
+	string strUnit;
+	vector<double> Samples;
+};
+
+//ӽһγռȫ
+static bool RunScenario(const SLSuiteScenario *pScenario, const SLSuiteConfig *pConfig, vector<string> *pLines)
+{
+	int fds[2];
+	if(pipe(fds) == -1)
+		return false;
+
+	pid_t pid = fork();
+	if(pid == -1)
+	{
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if(pid == 0)
+	{
+		close(fds[0]);
+		g_nResultFd = fds[1];
+
+		if(pScenario->bInitialize)
+		{
+			if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+				_exit(1);
+
+			pScenario->pBench(pConfig);
+
+			if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+				_exit(1);
+		}
+		else
+			pScenario->pBench(pConfig);
+
+		_exit(0);
+	}
+
+	close(fds[1]);
+
+	string strOutput;
+	char buf[4096];
+	ssize_t n;
+	while((n = read(fds[0], buf, sizeof(buf))) > 0)
+		strOutput.append(buf, n);
+
+	close(fds[0]);
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	istringstream in(strOutput);
+	string strLine;
+	while(getline(in, strLine))
+		pLines->push_back(strLine);
+
+	return WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+}
+
+static void Collect(const vector<string> &Lines, vector<SLSuiteResult> *pResults, map<string, unsigned int> *pIndex)
+{
+	for(unsigned int i = 0; i < Lines.size(); i++)
+	{
+		vector<string> Fields;
+		string::size_type nStart = 0, nTab;
+		while((nTab = Lines[i].find('\t', nStart)) != string::npos)
+		{
+			Fields.push_back(Lines[i].substr(nStart, nTab - nStart));
+			nStart = nTab + 1;
+		}
+		Fields.push_back(Lines[i].substr(nStart));
+
+		if(Fields.size() != 5)
+			continue;
+
+		string strKey = Fields[0] + "\t" + Fields[1] + "\t" + Fields[2];
+		map<string, unsigned int>::iterator it = pIndex->find(strKey);
+		if(it == pIndex->end())
+		{
+			SLSuiteResult r;
+			r.strName = Fields[0];
+			r.strParams = Fields[1];
+			r.strMetric = Fields[2];
+			r.strUnit = Fields[3];
+			pResults->push_back(r);
+
+			it = pIndex->insert(make_pair(strKey, (unsigned int)(pResults->size() - 1))).first;
+		}
+
+		(*pResults)[it->second].Samples.push_back(strtod(Fields[4].c_str(), 0));
+	}
+}
+
+static double GetMedian(vector<double> Samples)
+{
+	sort(Samples.begin(), Samples.end());
+
+	unsigned int n = Samples.size();
+	if(n % 2 == 1)
+		return Samples[n / 2];
+
+	return (Samples[n / 2 - 1] + Samples[n / 2]) / 2;
+}
+
+static void WriteJSON(ostream &out, const SLSuiteConfig *pConfig, const vector<SLSuiteResult> &Results, const vector<string> &Failures)
+{
+	struct utsname u;
+	memset(&u, 0, sizeof(u));
+	uname(&u);
+
+	out << "{" << endl;
+	out << "  \"suite\": \"libexecutive\"," << endl;
+	out << "  \"host\": {\"cpus\": " << sysconf(_SC_NPROCESSORS_ONLN) << ", \"sysname\": \"" << u.sysname << "\", \"release\": \"" << u.release;
+	out << "\", \"machine\": \"" << u.machine << "\", \"compiler\": \"" << __VERSION__ << "\"}," << endl;
+	out << "  \"config\": {\"repeats\": " << pConfig->nRepeats << ", \"warmups\": " << pConfig->nWarmups << ", \"scale\": " << pConfig->dScale;
+	out << ", \"max_producers\": " << pConfig->nMaxProducers << "}," << endl;
+
+	out << "  \"failures\": [";
+	for(unsigned int i = 0; i < Failures.size(); i++)
+		out << (i == 0 ? "" : ", ") << "\"" << Failures[i] << "\"";
+	out << "]," << endl;
+
+	out << "  \"results\": [" << endl;
+	for(unsigned int i = 0; i < Results.size(); i++)
+	{
+		const SLSuiteResult &r = Results[i];
+		char buf[256];
+
+		out << "    {\"name\": \"" << r.strName << "\", \"params\": {" << r.strParams << "}, \"metric\": \"" << r.strMetric;
+		out << "\", \"unit\": \"" << r.strUnit << "\", ";
+
+		snprintf(buf, sizeof(buf), "\"median\": %.3f, \"min\": %.3f, \"max\": %.3f, \"samples\": [", GetMedian(r.Samples),
+			*min_element(r.Samples.begin(), r.Samples.end()), *max_element(r.Samples.begin(), r.Samples.end()));
+		out << buf;
+
+		for(unsigned int j = 0; j < r.Samples.size(); j++)
+		{
+			snprintf(buf, sizeof(buf), "%s%.3f", (j == 0) ? "" : ", ", r.Samples[j]);
+			out << buf;
+		}
+
+		out << "]}" << ((i + 1 < Results.size()) ? "," : "") << endl;
+	}
+	out << "  ]" << endl;
+	out << "}" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	SLSuiteConfig config;
+	config.nRepeats = SUITE_DEFAULT_REPEATS;
+	config.nWarmups = SUITE_DEFAULT_WARMUPS;
+	config.dScale = 1.0;
+	config.nMaxProducers = SUITE_DEFAULT_MAX_PRODUCERS;
+	config.pstrFilter = 0;
+	config.pstrOutput = 0;
+
+	int c;
+	while((c = getopt(argc, argv, "o:r:w:s:p:f:")) != -1)
+	{
+		switch(c)
+		{
+		case 'o':
+			config.pstrOutput = optarg;
+			break;
+		case 'r':
+			config.nRepeats = atoi(optarg);
+			break;
+		case 'w':
+			config.nWarmups = atoi(optarg);
+			break;
+		case 's':
+			config.dScale = atof(optarg);
+			break;
+		case 'p':
+			config.nMaxProducers = atoi(optarg);
+			break;
+		case 'f':
+			config.pstrFilter = optarg;
+			break;
+		default:
+			cerr << "usage: " << argv[0] << " [-o file] [-r repeats] [-w warmups] [-s scale] [-p max_producers] [-f filter]" << endl;
+			return 1;
+		}
+	}
+
+	if((config.nRepeats <= 0) || (config.nWarmups < 0) || (config.dScale <= 0) || (config.nMaxProducers <= 0))
+	{
+		cerr << "bench_suite: invalid argument" << endl;
+		return 1;
+	}
+
+	vector<SLSuiteResult> Results;
+	map<string, unsigned int> Index;
+	vector<string> Failures;
+
+	for(unsigned int i = 0; i < sizeof(g_Scenarios) / sizeof(g_Scenarios[0]); i++)
+	{
+		const SLSuiteScenario *pScenario = &g_Scenarios[i];
+		if((config.pstrFilter != 0) && (strstr(pScenario->pstrName, config.pstrFilter) == 0))
+			continue;
+
+		cerr << "bench_suite: " << pScenario->pstrName << flush;
+
+		bool bFailed = false;
+		for(int r = 0; r < config.nWarmups + config.nRepeats; r++)
+		{
+			vector<string> Lines;
+			if(!RunScenario(pScenario, &config, &Lines))
+				bFailed = true;
+
+			//ԤȵĽ
+			if(r >= config.nWarmups)
+				Collect(Lines, &Results, &Index);
+
+			cerr << "." << flush;
+		}
+
+		if(bFailed)
+			Failures.push_back(pScenario->pstrName);
+
+		cerr << (bFailed ? " failed" : " done") << endl;
+	}
+
+	if(config.pstrOutput == 0)
+		WriteJSON(cout, &config, Results, Failures);
+	else
+	{
+		ofstream out(config.pstrOutput);
+		if(!out)
+		{
+			cerr << "bench_suite: open " << config.pstrOutput << " error" << endl;
+			return 1;
+		}
+
+		WriteJSON(out, &config, Results, Failures);
+	}
+
+	return Failures.empty() ? 0 : 1;
+}
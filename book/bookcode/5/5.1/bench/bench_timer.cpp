@@ -0,0 +1,303 @@
+#include <iostream>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define BENCH_TIMER_ID 1
+#define BENCH_PERIODIC_TIMER_ID 2
+#define BENCH_STOP_TIMER_ID 3
+
+#define MAX_DELAY_OF_BENCH_TIMER 1000
+
+static double GetTimeInSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//۲Ϣѭһɾⲿ
+struct SLTimeoutResult
+{
+	unsigned long nFired;
+	unsigned long nExpected;
+	unsigned long long TotalLateness;
+	unsigned long long MaxLateness;
+	double SetAndKillSeconds;
+	bool bUnexpected;
+};
+
+//nTimersӳٵʱȡһ룬ͳඨʱĴӳ
+class CLTimeoutObserver : public CLMessageObserver
+{
+public:
+	CLTimeoutObserver(unsigned long nTimers, SLTimeoutResult *pResult)
+	{
+		m_nTimers = nTimers;
+		m_pDeadlines = new unsigned long long[nTimers];
+		m_pResult = pResult;
+
+		m_pResult->nFired = 0;
+		m_pResult->nExpected = 0;
+		m_pResult->TotalLateness = 0;
+		m_pResult->MaxLateness = 0;
+		m_pResult->SetAndKillSeconds = 0;
+		m_pResult->bUnexpected = false;
+	}
+
+	virtual ~CLTimeoutObserver()
+	{
+		delete [] m_pDeadlines;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_TIMER_ID, (CallBackForMessageLoop)(&CLTimeoutObserver::On_Timeout));
+
+		unsigned long *pTimerIDs = new unsigned long[m_nTimers];
+
+		double begin = GetTimeInSeconds();
+
+		for(unsigned long i = 0; i < m_nTimers; i++)
+		{
+			unsigned long lDelayMs = 1 + rand() % MAX_DELAY_OF_BENCH_TIMER;
+			m_pDeadlines[i] = CLTimingWheel::GetCurrentTime() + lDelayMs;
+
+			pTimerIDs[i] = pMessageLoop->SetTimer(BENCH_TIMER_ID, lDelayMs, 0, (void *)i);
+			if(pTimerIDs[i] == 0)
+			{
+				delete [] pTimerIDs;
+				return CLStatus(-1, 0);
+			}
+		}
+
+		//󲿷ڳʱǰ
+		for(unsigned long i = 0; i < m_nTimers; i += 2)
+		{
+			pMessageLoop->KillTimer(pTimerIDs[i]);
+			m_pDeadlines[i] = 0;
+		}
+
+		m_pResult->SetAndKillSeconds = GetTimeInSeconds() - begin;
+		m_pResult->nExpected = m_nTimers / 2;
+
+		delete [] pTimerIDs;
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Timeout(CLMessage *pm)
+	{
+		CLTimerMessage *p = (CLTimerMessage *)pm;
+		unsigned long i = (unsigned long)p->m_pContext;
+
+		unsigned long long nNow = CLTimingWheel::GetCurrentTime();
+		if((m_pDeadlines[i] == 0) || (nNow < m_pDeadlines[i]))
+			m_pResult->bUnexpected = true;
+		else
+		{
+			unsigned long long lateness = nNow - m_pDeadlines[i];
+			m_pResult->TotalLateness += lateness;
+			if(lateness > m_pResult->MaxLateness)
+				m_pResult->MaxLateness = lateness;
+		}
+
+		m_pResult->nFired++;
+		if(m_pResult->nFired == m_pResult->nExpected)
+			return CLStatus(QUIT_MESSAGE_LOOP, 0);
+
+		return CLStatus(0, 0);
+	}
+
+	unsigned long m_nTimers;
+	unsigned long long *m_pDeadlines;
+	SLTimeoutResult *m_pResult;
+};
+
+//ڶʱͶݸһִ
+class CLPeriodicSourceObserver : public CLMessageObserver
+{
+public:
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_STOP_TIMER_ID, (CallBackForMessageLoop)(&CLPeriodicSourceObserver::On_Stop));
+
+		if(pMessageLoop->SetTimer(BENCH_PERIODIC_TIMER_ID, 10, 10, 0, "bench_timer_target") == 0)
+			return CLStatus(-1, 0);
+
+		if(pMessageLoop->SetTimer(BENCH_STOP_TIMER_ID, 205) == 0)
+			return CLStatus(-1, 0);
+
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Stop(CLMessage *pm)
+	{
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+};
+
+class CLPeriodicTargetObserver : public CLMessageObserver
+{
+public:
+	CLPeriodicTargetObserver(unsigned long *pnExpirations)
+	{
+		m_pnExpirations = pnExpirations;
+		*m_pnExpirations = 0;
+	}
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext)
+	{
+		pMessageLoop->Register(BENCH_PERIODIC_TIMER_ID, (CallBackForMessageLoop)(&CLPeriodicTargetObserver::On_Periodic));
+		return CLStatus(0, 0);
+	}
+
+	CLStatus On_Periodic(CLMessage *pm)
+	{
+		*m_pnExpirations += ((CLTimerMessage *)pm)->m_nExpirations;
+		if(*m_pnExpirations >= 20)
+			return CLStatus(QUIT_MESSAGE_LOOP, 0);
+
+		return CLStatus(0, 0);
+	}
+
+	unsigned long *m_pnExpirations;
+};
+
+static void RunTimingWheelBench(const char *pstrQueueName, int ExecutiveType, unsigned long nTimers)
+{
+	SLTimeoutResult result;
+	CLThreadForMsgLoop *pThread = new CLThreadForMsgLoop(new CLTimeoutObserver(nTimers, &result), "bench_timer_executive", true, ExecutiveType);
+
+	double begin = GetTimeInSeconds();
+
+	if(!pThread->Run(0).IsSuccess())
+	{
+		cout << "Run error" << endl;
+		return;
+	}
+
+	delete pThread;
+
+	double elapsed = GetTimeInSeconds() - begin;
+
+	cout << "mode=timing_wheel queue=" << pstrQueueName << " timers=" << nTimers;
+	cout << " set_kill_ns_per_op=" << result.SetAndKillSeconds * 1e9 / (nTimers + nTimers / 2);
+	cout << " fired=" << result.nFired << "/" << result.nExpected;
+	cout << " avg_late_ms=" << (double)result.TotalLateness / (result.nFired ? result.nFired : 1);
+	cout << " max_late_ms=" << result.MaxLateness;
+	cout << " elapsed_s=" << elapsed;
+	cout << " correct=" << (result.bUnexpected ? "error" : "ok") << endl;
+}
+
+static void RunPeriodicBench()
+{
+	unsigned long nExpirations = 0;
+	CLThreadForMsgLoop *pTargetThread = new CLThreadForMsgLoop(new CLPeriodicTargetObserver(&nExpirations), "bench_timer_target", true);
+	CLThreadForMsgLoop *pSourceThread = new CLThreadForMsgLoop(new CLPeriodicSourceObserver, "bench_timer_source", true);
+
+	double begin = GetTimeInSeconds();
+
+	if((!pTargetThread->Run(0).IsSuccess()) || (!pSourceThread->Run(0).IsSuccess()))
+	{
+		cout << "Run error" << endl;
+		return;
+	}
+
+	delete pTargetThread;
+	delete pSourceThread;
+
+	cout << "mode=periodic_to_named_executive expirations=" << nExpirations;
+	cout << " elapsed_ms=" << (GetTimeInSeconds() - begin) * 1e3 << endl;
+}
+
+//ԭÿĳʱռһ˯߳
+struct SLSleeperContext
+{
+	unsigned long lDelayMs;
+	unsigned long long nDeadline;
+	unsigned long long nLateness;
+};
+
+static void *SleeperThread(void *pContext)
+{
+	SLSleeperContext *p = (SLSleeperContext *)pContext;
+
+	struct timespec ts;
+	ts.tv_sec = p->lDelayMs / 1000;
+	ts.tv_nsec = (p->lDelayMs % 1000) * 1000000;
+	nanosleep(&ts, 0);
+
+	p->nLateness = CLTimingWheel::GetCurrentTime() - p->nDeadline;
+	return 0;
+}
+
+static void RunSleeperThreadBench(unsigned long nTimers)
+{
+	SLSleeperContext *pContexts = new SLSleeperContext[nTimers];
+	pthread_t *pThreads = new pthread_t[nTimers];
+
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, 64 * 1024);
+
+	unsigned long nCreated = 0;
+	double begin = GetTimeInSeconds();
+
+	for(unsigned long i = 0; i < nTimers; i++)
+	{
+		pContexts[i].lDelayMs = 1 + rand() % MAX_DELAY_OF_BENCH_TIMER;
+		pContexts[i].nDeadline = CLTimingWheel::GetCurrentTime() + pContexts[i].lDelayMs;
+
+		if(pthread_create(&pThreads[i], &attr, SleeperThread, &pContexts[i]) != 0)
+			break;
+
+		nCreated++;
+	}
+
+	double created = GetTimeInSeconds() - begin;
+
+	unsigned long long total = 0;
+	unsigned long long max = 0;
+	for(unsigned long i = 0; i < nCreated; i++)
+	{
+		pthread_join(pThreads[i], 0);
+
+		total += pContexts[i].nLateness;
+		if(pContexts[i].nLateness > max)
+			max = pContexts[i].nLateness;
+	}
+
+	cout << "mode=sleeper_threads timers=" << nTimers << " created=" << nCreated;
+	cout << " set_ns_per_op=" << created * 1e9 / (nCreated ? nCreated : 1);
+	cout << " avg_late_ms=" << (double)total / (nCreated ? nCreated : 1);
+	cout << " max_late_ms=" << max << endl;
+
+	pthread_attr_destroy(&attr);
+	delete [] pThreads;
+	delete [] pContexts;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long nTimers = (argc > 1) ? strtoul(argv[1], 0, 10) : 400000;
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	RunSleeperThreadBench(2000);
+	RunTimingWheelBench("stl_queue", EXECUTIVE_IN_PROCESS_USE_STL_QUEUE, nTimers);
+	RunTimingWheelBench("lock_free_ring", EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING, nTimers);
+	RunTimingWheelBench("epoll", EXECUTIVE_IN_PROCESS_USE_EPOLL, nTimers);
+	RunPeriodicBench();
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
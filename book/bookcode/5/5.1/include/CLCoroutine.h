@@ -0,0 +1,50 @@
+#ifndef CLCoroutine_H
+#define CLCoroutine_H
+
+#include <ucontext.h>
+#include "CLStatus.h"
+
+/*
+ucontextķǶԳЭ̣ӵжջջһɷʵıҳջʱδ
+ջmmap䣬ֻʵõҳռڴ
+ResumeֻЭ֮ĴãYieldֻЭãЭ̲̰߳ȫģӦʼͬһ߳л
+*/
+class CLCoroutine
+{
+public:
+	/*
+	nStackSizeᱻȡҳСʧʱ׳ַ쳣
+	*/
+	explicit CLCoroutine(unsigned long nStackSize);
+	virtual ~CLCoroutine();
+
+	/*
+	лЭִУֱЭ̵YieldRunCoroutine
+	*/
+	CLStatus Resume();
+	void Yield();
+
+	bool IsFinished();
+
+protected:
+	virtual void RunCoroutine() = 0;
+
+private:
+	static void EntryPoint(unsigned int nHigh, unsigned int nLow);
+
+private:
+	CLCoroutine(const CLCoroutine&);
+	CLCoroutine& operator=(const CLCoroutine&);
+
+private:
+	ucontext_t m_Context;
+	ucontext_t m_CallerContext;
+
+	void *m_pStack;
+	unsigned long m_nMappedSize;
+
+	bool m_bRunning;
+	bool m_bFinished;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef CLCoroutineExecutive_H
+#define CLCoroutineExecutive_H
+
+#include <deque>
+#include "CLCoroutine.h"
+#include "CLStatus.h"
+
+class CLMessage;
+class CLRequestMessage;
+class CLResponseMessage;
+class CLCoroutineScheduler;
+
+#define DEFAULT_STACK_SIZE_OF_COROUTINE_EXECUTIVE (64 * 1024)
+
+/*
+CLCoroutineSchedulerеִ壬ûӸʵRunExecutiveFunction
+ಽĽ˳дRunExecutiveFunctionУȴڼֻЭ̣ͬһеЭִճ
+RunExecutiveFunctionغ󣬵ͷŸö󣻶ӦӶз䣬CLCoroutineScheduler::Spawn󲻱delete
+µȴֻRunExecutiveFunctionеãصϢһεȴRunExecutiveFunction֮ǰЧdelete
+*/
+class CLCoroutineExecutive : public CLCoroutine
+{
+	friend class CLCoroutineScheduler;
+
+public:
+	explicit CLCoroutineExecutive(unsigned long nStackSize = DEFAULT_STACK_SIZE_OF_COROUTINE_EXECUTIVE);
+	virtual ~CLCoroutineExecutive();
+
+	unsigned long GetCoroutineID();
+
+protected:
+	virtual CLStatus RunExecutiveFunction(void *pContext) = 0;
+
+	/*
+	ȴϢIDΪlMsgIDϢϢ˳֮ĵȴȡ
+	lTimeoutMsΪ-1ʱʱΪ0ʱֻѵϢʱ0
+	*/
+	CLMessage *WaitForMessage(unsigned long lMsgID, long lTimeoutMs = -1);
+	CLMessage *WaitForAnyMessage(long lTimeoutMs = -1);
+
+	/*
+	CLMessageLoopManager::SendRequestʱʧʱ0
+	*/
+	CLResponseMessage *SendRequestAndWait(const char *pstrExecutiveName, CLRequestMessage *pRequest, unsigned long lTimeoutMs = 0);
+
+	CLStatus Sleep(unsigned long lMs);
+
+private:
+	virtual void RunCoroutine();
+
+private:
+	CLCoroutineExecutive(const CLCoroutineExecutive&);
+	CLCoroutineExecutive& operator=(const CLCoroutineExecutive&);
+
+private:
+	CLCoroutineScheduler *m_pScheduler;
+	unsigned long m_nCoroutineID;
+	void *m_pContext;
+
+	//³Աɵά
+	int m_nWaitFor;
+	unsigned long m_lWaitMsgID;
+	unsigned long m_nTimerID;
+	CLMessage *m_pResult;
+	CLMessage *m_pCurrentMessage;
+	std::deque<CLMessage*> m_Mailbox;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef CLCoroutineMessage_H
+#define CLCoroutineMessage_H
+
+#include "CLMessage.h"
+
+class CLCoroutineExecutive;
+
+#define COROUTINE_SCHEDULER_SPAWN_ID 1
+#define COROUTINE_SCHEDULER_DELIVER_ID 2
+#define COROUTINE_SCHEDULER_TIMER_ID 3
+#define COROUTINE_SCHEDULER_QUIT_ID 4
+
+/*
+ͶݸCLCoroutineSchedulerϢڴЭִm_pMessageתIDΪm_nCoroutineIDЭִ
+CLCoroutineScheduler::SpawnCLCoroutineScheduler::PostCoroutineMessage죬δȡߵm_pMessagem_pCoroutineʱͷ
+*/
+class CLCoroutineMessage : public CLMessage
+{
+public:
+	CLCoroutineMessage(unsigned long nCoroutineID, CLMessage *pMessage);
+	CLCoroutineMessage(unsigned long nCoroutineID, CLCoroutineExecutive *pCoroutine, void *pContext);
+	virtual ~CLCoroutineMessage();
+
+public:
+	unsigned long m_nCoroutineID;
+	CLMessage *m_pMessage;
+	CLCoroutineExecutive *m_pCoroutine;
+	void *m_pContext;
+
+private:
+	CLCoroutineMessage(const CLCoroutineMessage&);
+	CLCoroutineMessage& operator=(const CLCoroutineMessage&);
+};
+
+#endif
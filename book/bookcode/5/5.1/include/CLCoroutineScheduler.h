@@ -0,0 +1,68 @@
+#ifndef CLCoroutineScheduler_H
+#define CLCoroutineScheduler_H
+
+#include <map>
+#include "CLMessageObserver.h"
+#include "CLCoroutineMessage.h"
+
+class CLMessage;
+class CLMessageLoopManager;
+class CLRequestMessage;
+class CLResponseMessage;
+class CLCoroutineExecutive;
+
+/*
+һϢѭеЭִ壬ÿЭִֻռԼջռһ߳
+Ӧֶ֧ʱϢѭУɷֱڲͬ߳У磺
+new CLThreadForMsgLoop(new CLCoroutineScheduler, "coroutine_scheduler", true)
+Эִԡִ+ЭIDѰַЭIDɴָͬһвظ
+ִͶϢIDΪCOROUTINE_SCHEDULER_QUIT_IDϢ˳ϢѭδЭִ屻ֱͷţջϵĶ󲻻ᱻ
+*/
+class CLCoroutineScheduler : public CLMessageObserver
+{
+	friend class CLCoroutineExecutive;
+
+public:
+	CLCoroutineScheduler();
+	virtual ~CLCoroutineScheduler();
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext);
+
+	/*
+	߳еãpCoroutineӦӶз䣬۳ɹ񶼲delete
+	ЭִڵյϢʼУpContextΪRunExecutiveFunctionĲ
+	*/
+	static CLStatus Spawn(const char *pstrSchedulerName, unsigned long nCoroutineID, CLCoroutineExecutive *pCoroutine, void *pContext = 0);
+
+	/*
+	߳еãpMessageӦӶз䣬۳ɹ񶼲delete
+	*/
+	static CLStatus PostCoroutineMessage(const char *pstrSchedulerName, unsigned long nCoroutineID, CLMessage *pMessage);
+
+	unsigned int GetNumberOfCoroutines();
+
+	CLStatus On_Spawn(CLMessage *pm);
+	CLStatus On_Deliver(CLMessage *pm);
+	CLStatus On_Timer(CLMessage *pm);
+	CLStatus On_Quit(CLMessage *pm);
+	CLStatus On_Response(CLResponseMessage *pResponse, void *pContext);
+
+private:
+	CLMessage *WaitForMessage(CLCoroutineExecutive *pCoroutine, bool bMatchID, unsigned long lMsgID, long lTimeoutMs);
+	CLResponseMessage *SendRequestAndWait(CLCoroutineExecutive *pCoroutine, const char *pstrExecutiveName, CLRequestMessage *pRequest, unsigned long lTimeoutMs);
+	CLStatus Sleep(CLCoroutineExecutive *pCoroutine, unsigned long lMs);
+
+	CLMessage *Suspend(CLCoroutineExecutive *pCoroutine, int nWaitFor, long lTimeoutMs);
+	void Resume(CLCoroutineExecutive *pCoroutine, CLMessage *pResult);
+	CLCoroutineExecutive *FindCoroutine(unsigned long nCoroutineID);
+
+private:
+	CLCoroutineScheduler(const CLCoroutineScheduler&);
+	CLCoroutineScheduler& operator=(const CLCoroutineScheduler&);
+
+private:
+	CLMessageLoopManager *m_pMessageLoop;
+	std::map<unsigned long, CLCoroutineExecutive*> m_Coroutines;
+};
+
+#endif
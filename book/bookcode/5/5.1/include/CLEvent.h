@@ -3,16 +3,17 @@
 
 #include <string>
 #include "CLStatus.h"
-#include "CLMutex.h"
-#include "CLConditionVariable.h"
 
 using namespace std;
 
 struct SLEventInfo;
+struct timespec;
 
 /*
 Ĭ£һʼźţԶźŵ¼ڻһȴ̣߳
 ڹ캯УbSemaphoreΪtrueüSetɻѼλ߳
+futexʵ֣źѴʱWaitûеȴʱSetں
+¼λڹ洢Уʹý̼乲futex
 */
 class CLEvent
 {
@@ -27,14 +28,27 @@ public:
 	CLStatus Set();
 	CLStatus Wait();
 
+	/*
+	ȴlTimeoutMs룬lTimeoutMsС0ʱWaitͬʱصCLStatusĴΪETIMEDOUT
+	*/
+	CLStatus TimedWait(long lTimeoutMs);
+
+	/*
+	lMaxCountźţʵĵĸplCount
+	*/
+	CLStatus TryWait(long lMaxCount, long *plCount);
+
 private:
 	CLEvent(const CLEvent&);
 	CLEvent& operator=(const CLEvent&);
 
 private:
-	CLMutex m_Mutex;
-	CLConditionVariable m_Cond;
+	CLStatus WaitForSignal(const struct timespec *pTimeout);
+	CLStatus WakeupWaiter();
+
+private:
 	SLEventInfo *m_pEventInfo;
+	int m_nFutexFlag;
 	bool m_bNeededDestroy;
 	string m_strEventName;
 };
@@ -16,7 +16,11 @@ public:
 	virtual CLStatus PostExecutiveMessage(CLMessage *pMessage);
 
 protected:
-	virtual char *GetMsgBuf(CLMessage *pMsg, unsigned int *pLength) = 0;
+	/*
+	ĬͨGetMsgBufõϢĻдܵɸıдķʽ
+	*/
+	virtual CLStatus WriteMsgToPipe(CLMessage *pMsg);
+	virtual char *GetMsgBuf(CLMessage *pMsg, unsigned int *pLength);
 
 private:
 	CLExecutiveCommunicationByNamedPipe(const CLExecutiveCommunicationByNamedPipe&);
@@ -24,11 +28,11 @@ private:
 
 protected:
 	string m_strExecutiveName;
+	int m_Fd;
+	long m_lPipeBufSize;
 
 private:
-	int m_Fd;
 	CLEvent m_Event;
-	long m_lPipeBufSize;
 	bool m_bDeleteMsg;
 };
 
@@ -0,0 +1,53 @@
+#ifndef CLExecutiveCommunicationByProcessPool_H
+#define CLExecutiveCommunicationByProcessPool_H
+
+#include <vector>
+#include <string>
+#include "CLExecutiveCommunication.h"
+#include "CLMessageIDTable.h"
+
+class CLMessage;
+class CLMessageSerializer;
+class CLZeroCopyMessageSerializer;
+class CLSharedExecutiveCommunicationByShmRing;
+
+/*
+CLProcessPoolͶϢעַеĽ̳ƶӦ
+ÿԼĹ洢ϢУжйͬһл
+*/
+class CLExecutiveCommunicationByProcessPool : public CLExecutiveCommunication
+{
+public:
+	explicit CLExecutiveCommunicationByProcessPool(const std::vector<std::string>& WorkerNames);
+	virtual ~CLExecutiveCommunicationByProcessPool();
+
+	CLStatus RegisterSerializer(unsigned long lMsgID, CLMessageSerializer *pSerializer);
+	CLStatus RegisterSerializer(unsigned long lMsgID, CLZeroCopyMessageSerializer *pSerializer);
+
+	/*
+	ѡȡ̣ͶݸϢлѹٵһ
+	*/
+	virtual CLStatus PostExecutiveMessage(CLMessage *pMessage);
+
+	/*
+	׺ͼͬϢͬһ̰Ͷ˳i̴׺ͼģΪiϢ
+	*/
+	CLStatus PostExecutiveMessage(CLMessage *pMessage, unsigned long lAffinityKey);
+
+	unsigned int GetNumberOfWorkers();
+
+private:
+	CLStatus PostToWorker(unsigned int nIndex, CLMessage *pMessage);
+
+private:
+	CLExecutiveCommunicationByProcessPool(const CLExecutiveCommunicationByProcessPool&);
+	CLExecutiveCommunicationByProcessPool& operator=(const CLExecutiveCommunicationByProcessPool&);
+
+private:
+	std::vector<CLSharedExecutiveCommunicationByShmRing*> m_Workers;
+	CLMessageIDTable<CLZeroCopyMessageSerializer*> m_SerializerTable;
+
+	volatile unsigned long m_nNextChoice;
+};
+
+#endif
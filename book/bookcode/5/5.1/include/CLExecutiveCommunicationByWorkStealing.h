@@ -0,0 +1,37 @@
+#ifndef CLExecutiveCommunicationByWorkStealing_H
+#define CLExecutiveCommunicationByWorkStealing_H
+
+#include "CLExecutiveCommunication.h"
+#include "CLStatus.h"
+
+class CLMessage;
+class CLMessageQueueByWorkStealing;
+
+/*
+CLExecutivePoolͶϢעַеִƶӦ
+*/
+class CLExecutiveCommunicationByWorkStealing : public CLExecutiveCommunication
+{
+public:
+	explicit CLExecutiveCommunicationByWorkStealing(CLMessageQueueByWorkStealing *pMsgQueue);
+	virtual ~CLExecutiveCommunicationByWorkStealing();
+
+	/*
+	Ϣڹ֮߳为ؾ
+	*/
+	virtual CLStatus PostExecutiveMessage(CLMessage *pMessage);
+
+	/*
+	׺ͼͬϢͬһ̰߳Ͷ˳
+	*/
+	CLStatus PostExecutiveMessage(CLMessage *pMessage, unsigned long lAffinityKey);
+
+private:
+	CLExecutiveCommunicationByWorkStealing(const CLExecutiveCommunicationByWorkStealing&);
+	CLExecutiveCommunicationByWorkStealing& operator=(const CLExecutiveCommunicationByWorkStealing&);
+
+private:
+	CLMessageQueueByWorkStealing *m_pMsgQueue;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef CLExecutiveHandle_H
+#define CLExecutiveHandle_H
+
+#include "CLExecutiveCommunication.h"
+#include "CLStatus.h"
+
+class CLMessage;
+struct SLExecutiveCommunicationPtrCount;
+
+/*
+ʱͨCLExecutiveNameServerһִƲͨŶãʱͷ
+֮ÿͶϢٲ֣ʺƵͬһִ巢Ϣĳ
+ִ˳ͨŶо֮ǰȻЧͶݵϢٱ
+*/
+class CLExecutiveHandle : public CLExecutiveCommunication
+{
+public:
+	/*
+	δעʱ׳쳣
+	*/
+	explicit CLExecutiveHandle(const char *pstrExecutiveName);
+	virtual ~CLExecutiveHandle();
+
+	virtual CLStatus PostExecutiveMessage(CLMessage *pMessage);
+
+	CLExecutiveCommunication *GetCommunicationPtr();
+
+private:
+	CLExecutiveHandle(const CLExecutiveHandle&);
+	CLExecutiveHandle& operator=(const CLExecutiveHandle&);
+
+private:
+	SLExecutiveCommunicationPtrCount *m_pPtrCount;
+};
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef CLExecutiveMetrics_H
+#define CLExecutiveMetrics_H
+
+#include <pthread.h>
+#include <vector>
+#include <string>
+#include "CLStatus.h"
+#include "CLMutex.h"
+#include "CLMessageIDTable.h"
+#include "CLLatencyHistogram.h"
+#include "CLMessageQueueBySTLqueue.h"
+
+class CLMessage;
+class CLMessageLoopManager;
+
+struct SLMessageIDMetrics
+{
+	unsigned long lMsgID;
+	unsigned long nCount;
+	unsigned long long nTotalTime;
+	unsigned long long nMaxTime;
+};
+
+/*
+ͬĶϢѭ繤ȡ̳߳еĸ̣߳ͳƻᱻϲʱ䵥λΪ
+QueueLatencyΪϢͶݵʼʱ䣬ֻͳƽڵĶУSTLСζСȡУ
+HandlerTimeΪϢִʱ
+*/
+struct SLExecutiveMetricsSnapshot
+{
+	unsigned int nMessageLoops;
+	unsigned long nDispatched;
+	unsigned long nFailed;
+
+	bool bHasQueueStatistics;
+	SLMessageQueueStatistics QueueStatistics;
+
+	CLLatencyHistogram QueueLatency;
+	CLLatencyHistogram HandlerTime;
+
+	std::vector<SLMessageIDMetrics> MessageIDs;
+};
+
+/*
+ÿϢѭһCLMessageLoopManagerֻϢѭڵ̼߳¼
+CLRelaxedAtomic.hеķʽд¼ʱҪǰ׺ԭӲȡյ̶߳ȡʱҲݾ
+ϢѭڼöǼȫֱУִ߳̿ͨƻȡջ򵼳ļ
+ͳĬϹرգʱEnableرգرʱÿϢֻһα־ж
+*/
+class CLExecutiveMetrics
+{
+public:
+	CLExecutiveMetrics(const char *pstrExecutiveName, CLMessageLoopManager *pMessageLoop);
+	virtual ~CLExecutiveMetrics();
+
+	/*
+	ϢѭʼϺǼǣ˳Ϣѭǰעע̲߳ٷʸö
+	*/
+	CLStatus Register();
+	CLStatus Unregister();
+
+	void RecordDispatch(CLMessage *pMessage, unsigned long long nBegin, unsigned long long nEnd, const CLStatus& s);
+
+public:
+	static void Enable(bool bEnabled);
+	static bool IsEnabled();
+
+	static unsigned long long GetCurrentTime();
+
+	/*
+	ϢPushMessageеãͳʱ¼Ͷʱ
+	*/
+	static void StampEnqueueTime(CLMessage *pMessage);
+
+	static CLStatus GetSnapshot(const char *pstrExecutiveName, SLExecutiveMetricsSnapshot *pSnapshot);
+	static void GetExecutiveNames(std::vector<std::string>& Names);
+
+	/*
+	ıʽдִͳƣÿִһУÿϢIDһ
+	pstrPathͨļÿθǣܵܵûжʱʧܣΪENXIO
+	*/
+	static CLStatus Dump(int fd);
+	static CLStatus DumpToFile(const char *pstrPath);
+
+private:
+	SLMessageIDMetrics *GetMessageIDMetrics(unsigned long lMsgID);
+	void AddToSnapshot(SLExecutiveMetricsSnapshot *pSnapshot);
+
+private:
+	CLExecutiveMetrics(const CLExecutiveMetrics&);
+	CLExecutiveMetrics& operator=(const CLExecutiveMetrics&);
+
+private:
+	std::string m_strExecutiveName;
+	CLMessageLoopManager *m_pMessageLoop;
+
+	unsigned long m_nDispatched;
+	unsigned long m_nFailed;
+
+	CLLatencyHistogram m_QueueLatency;
+	CLLatencyHistogram m_HandlerTime;
+
+	//ϢIDĲɱ߳ɣȡյ߳m_MessageIDMetrics
+	CLMessageIDTable<SLMessageIDMetrics*> m_MessageIDTable;
+	std::vector<SLMessageIDMetrics*> m_MessageIDMetrics;
+	CLMutex m_MutexForMessageIDs;
+
+	bool m_bRegistered;
+
+private:
+	static volatile bool m_bEnabled;
+
+	static pthread_mutex_t m_MutexForRegistry;
+	static std::vector<CLExecutiveMetrics*> m_Registry;
+};
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef CLExecutiveNameServer_H
 #define CLExecutiveNameServer_H
 
-#include <map>
+#include <vector>
 #include <string>
 #include <pthread.h>
 #include "CLStatus.h"
@@ -9,25 +9,75 @@
 class CLExecutiveCommunication;
 class CLMessage;
 
+#define MIN_CAPACITY_OF_EXECUTIVE_NAME_TABLE 16
+
 struct SLExecutiveCommunicationPtrCount
 {
 	CLExecutiveCommunication *pExecutiveCommunication;
-	unsigned int nCount;
+	volatile unsigned int nCount;
+	std::string strExecutiveName;
+};
+
+struct SLExecutiveNameTableEntry
+{
+	unsigned int Hash;
+	SLExecutiveCommunicationPtrCount *pPtrCount;
 };
 
+/*
+ֱ޸ģRegisterüΪ0ʱƳ±滻ʱ
+*/
+struct SLExecutiveNameTable
+{
+	unsigned int nCapacity;
+	unsigned int nNames;
+	SLExecutiveNameTableEntry *pEntries;
+};
+
+struct SLExecutiveNameServerRetired
+{
+	unsigned long nEpoch;
+	SLExecutiveNameTable *pNameTable;
+	SLExecutiveCommunicationPtrCount *pPtrCount;
+};
+
+struct SLExecutiveNameServerReader;
+
+/*
+߳ڶٽм¼ʱȫּԪ滻ֱɾı¼滻ʱļԪ
+ֻдڶٽ̵߳ļԪڸüԪ󣬲֮дͷ
+*/
 class CLExecutiveNameServer
 {
 public:
 	static CLExecutiveNameServer* GetInstance();
 	static CLStatus PostExecutiveMessage(const char* pstrExecutiveName, CLMessage *pMessage);
-	
+
 	friend class CLLibExecutiveInitializer;
+	friend class CLExecutiveHandle;
 
 public:
 	CLStatus Register(const char* strExecutiveName, CLExecutiveCommunication *pExecutiveCommunication);
 	CLExecutiveCommunication* GetCommunicationPtr(const char* strExecutiveName);
 	CLStatus ReleaseCommunicationPtr(const char* strExecutiveName);
 
+private:
+	SLExecutiveCommunicationPtrCount* AcquirePtrCount(const char* strExecutiveName);
+	CLStatus ReleasePtrCount(SLExecutiveCommunicationPtrCount *pPtrCount);
+
+	void PublishNameTable(SLExecutiveNameTable *pNameTable, SLExecutiveCommunicationPtrCount *pRemoved);
+	void ReclaimRetired();
+
+	static SLExecutiveNameTable* CreateNameTable(unsigned int nNames);
+	static void InsertNameTable(SLExecutiveNameTable *pNameTable, unsigned int Hash, SLExecutiveCommunicationPtrCount *pPtrCount);
+	static SLExecutiveCommunicationPtrCount* FindNameTable(SLExecutiveNameTable *pNameTable, const char* strExecutiveName);
+	static void DeleteNameTable(SLExecutiveNameTable *pNameTable);
+	static unsigned int HashName(const char* strExecutiveName);
+
+	static SLExecutiveNameServerReader* GetReader();
+	static void CreateKey();
+	static void OnThreadExit(void *pReader);
+
 private:
 	static CLStatus Create();
 	static CLStatus Destroy();
@@ -42,9 +92,19 @@ private:
 private:
 	static CLExecutiveNameServer *m_pNameServer;
 	static pthread_mutex_t m_Mutex;
-	
+
+	static volatile unsigned long m_nEpoch;
+
+	static pthread_once_t m_OnceForKey;
+	static pthread_key_t m_KeyForReader;
+	static pthread_mutex_t m_MutexForReaders;
+	static SLExecutiveNameServerReader *m_pReaders;
+
 private:
-	std::map<std::string, SLExecutiveCommunicationPtrCount*> m_NameTable;
+	SLExecutiveNameTable * volatile m_pNameTable;
+
+	//ֻڳm_Mutexʱ
+	std::vector<SLExecutiveNameServerRetired> m_Retired;
 };
 
 #endif
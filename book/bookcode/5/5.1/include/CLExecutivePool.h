@@ -0,0 +1,53 @@
+#ifndef CLExecutivePool_H
+#define CLExecutivePool_H
+
+#include <vector>
+#include <string>
+#include "CLStatus.h"
+
+class CLMessage;
+class CLMessageObserver;
+class CLThread;
+class CLMessageQueueByWorkStealing;
+
+/*
+ִأ̹߳ͬһƣͨCLExecutiveNameServerͶݸƵϢڹ֮߳为ؾ
+ÿ߳ԼϢ۲ߣ۲֮乲״̬ʹ֤̰߱߳ȫ
+ϢĴҪ˳򣬿ͨ׺ͼPostExecutiveMessageͶݣ׺ͼͬϢͬһ̰߳
+һ̵߳ϢQUIT_MESSAGE_LOOPʱй̶߳˳Ϣѭ
+CLExecutivePoolķͷ⣬ʹ߸
+*/
+class CLExecutivePool
+{
+public:
+	/*
+	ObserversеĶӦӶз䣬Ҳصdelete̵߳ĸObserversĸ
+	pstrPoolNameƱΨһ
+	bWaitForDeathΪtrueʱеȴй߳
+	*/
+	CLExecutivePool(const std::vector<CLMessageObserver*>& Observers, const char *pstrPoolName, bool bWaitForDeath = false);
+	virtual ~CLExecutivePool();
+
+	/*
+	й̵߳ϢѭʼϺŷأ۷ȷֻɵһ
+	һ̳߳ʼʧʱĹ߳̽˳
+	*/
+	CLStatus Run(void *pContext);
+
+	static CLStatus PostExecutiveMessage(const char *pstrPoolName, CLMessage *pMessage, unsigned long lAffinityKey);
+
+private:
+	CLExecutivePool(const CLExecutivePool&);
+	CLExecutivePool& operator=(const CLExecutivePool&);
+
+private:
+	std::vector<CLThread*> m_Threads;
+	unsigned int m_nStartedThreads;
+	bool m_bWaitForDeath;
+	bool m_bRunCalled;
+
+	std::string m_strPoolName;
+	CLMessageQueueByWorkStealing *m_pMsgQueue;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef CLLatencyHistogram_H
+#define CLLatencyHistogram_H
+
+#define BITS_OF_HISTOGRAM_SUB_BUCKETS 4
+#define NUMBER_OF_HISTOGRAM_SUB_BUCKETS (1 << BITS_OF_HISTOGRAM_SUB_BUCKETS)
+#define NUMBER_OF_HISTOGRAM_BUCKETS ((64 - BITS_OF_HISTOGRAM_SUB_BUCKETS + 1) * NUMBER_OF_HISTOGRAM_SUB_BUCKETS)
+
+/*
+ֱͼHDRֱͼƣÿ2پΪ16Ͱ1/16
+RecordΪO(1)Ҳڴ棬ɸunsigned long longȫȡֵ
+ֻӦһ̼߳¼Recordԭӷʽд߳̿ͬʱͨAddȡĸ֮вһ
+ຯֻڲٱ¼ֱͼAddõĸ
+*/
+class CLLatencyHistogram
+{
+public:
+	CLLatencyHistogram();
+	virtual ~CLLatencyHistogram();
+
+	void Record(unsigned long long nValue);
+
+	/*
+	һֱͼļۼӵֱͼУںϲִͬͳƣpHistogramڱ̼߳¼
+	*/
+	void Add(const CLLatencyHistogram *pHistogram);
+	void Reset();
+
+	unsigned long long GetCount();
+	unsigned long long GetMin();
+	unsigned long long GetMax();
+	double GetMean();
+
+	/*
+	زСdPercentile%ļ¼ֵͰϽ磨ֵûм¼ʱ0
+	*/
+	unsigned long long GetValueAtPercentile(double dPercentile);
+
+private:
+	static int GetBucketIndex(unsigned long long nValue);
+	static unsigned long long GetBucketUpperBound(int nIndex);
+
+private:
+	CLLatencyHistogram(const CLLatencyHistogram&);
+	CLLatencyHistogram& operator=(const CLLatencyHistogram&);
+
+private:
+	unsigned long long m_Counts[NUMBER_OF_HISTOGRAM_BUCKETS];
+	unsigned long long m_nCount;
+	unsigned long long m_nSum;
+	unsigned long long m_nMin;
+	unsigned long long m_nMax;
+};
+
+#endif
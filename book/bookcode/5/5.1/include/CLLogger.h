@@ -2,10 +2,23 @@
 #define CLLogger_H
 
 #include <pthread.h>
+#include <semaphore.h>
+#include <vector>
+#include <sys/uio.h>
 #include "CLStatus.h"
 
+#define LOGGER_OVERFLOW_DROP 0
+#define LOGGER_OVERFLOW_BLOCK 1
+
+#define DEFAULT_SIZE_OF_LOGGER_THREAD_BUFFER (64 * 1024)
+#define LOGGER_ASYNC_FLUSH_INTERVAL_MS 100
+
+struct SLLoggerThreadBuffer;
+
 /*
 ļLOG_FILE_NAMEУ¼־Ϣ
+Ĭÿд־ҪȡȫֻEnableAsyncMode󣬸̰߳־дԼĻ
+ɺ̨߳ͨwritevдļͬһ߳д־ԭ˳
 */
 class CLLogger
 {
@@ -17,6 +30,13 @@ public:
 	CLStatus WriteLog(const char *pstrMsg, long lErrorCode);
 	CLStatus Flush();
 
+	/*
+	CLLibExecutiveInitializer::Initialize֮ãnBufferSizeΪÿ̻߳ĴС
+	ʱLOGGER_OVERFLOW_DROP־LOGGER_OVERFLOW_BLOCKȴ̨߳д
+	*/
+	static CLStatus EnableAsyncMode(unsigned int nBufferSize, int nOverflowPolicy);
+	static unsigned long GetNumberOfDroppedLogs();
+
 	friend class CLLibExecutiveInitializer;
 
 private:
@@ -25,6 +45,19 @@ private:
 
 	static int WriteOfProcessSafety(int fd, const void *buff, size_t nbytes);
 	static CLStatus WriteMsgAndErrcodeToFile(int fd, const char *pstrMsg, const char *pstrErrcode);
+	static int WritevOfProcessSafety(int fd, const struct iovec *iov, int iovcnt);
+
+	CLStatus WriteLogToThreadBuffer(SLLoggerThreadBuffer *pBuffer, const char *pstrMsg, unsigned int nMsgLength, const char *pstrErrcode, unsigned int nErrcodeLength);
+	void CopyToThreadBuffer(SLLoggerThreadBuffer *pBuffer, unsigned long nPosition, const char *pData, unsigned int nLength);
+	void WakeupFlusher();
+	CLStatus DisableAsyncMode();
+	CLStatus DrainThreadBuffers();
+
+	static void* FlusherThread(void *pContext);
+
+	static SLLoggerThreadBuffer* GetThreadBuffer();
+	static void CreateKey();
+	static void OnThreadExit(void *pBuffer);
 
 private:
 	CLLogger(const CLLogger&);
@@ -39,10 +72,34 @@ private:
 	//һ߳ڵDestroyһ߳ͼд־
 	static pthread_mutex_t m_Mutex;
 
+	static pthread_once_t m_OnceForKey;
+	static pthread_key_t m_KeyForThreadBuffer;
+
+	//m_pThreadBuffers̻߳ڽ̽ǰͷ
+	static pthread_mutex_t m_MutexForThreadBuffers;
+	static SLLoggerThreadBuffer *m_pThreadBuffers;
+
+	//첽ģʽд־̲߳ȡm_Mutexܷڶ
+	static volatile int m_bAsyncMode;
+	static unsigned int m_nSizeOfThreadBuffer;
+
 private:
 	int m_Fd;
 	char *m_pLogBuffer;
 	unsigned int m_nUsedBytesForBuffer;
+
+	int m_nOverflowPolicy;
+
+	pthread_t m_FlusherThreadID;
+	sem_t m_SemaphoreForFlusher;
+	volatile int m_bFlusherSleeping;
+	volatile int m_bStopFlusher;
+
+	//̨߳Flushд̻߳Ҫ
+	pthread_mutex_t m_MutexForDrain;
+	std::vector<struct iovec> m_DrainIovecs;
+	std::vector<SLLoggerThreadBuffer*> m_DrainBuffers;
+	std::vector<unsigned long> m_DrainTails;
 };
 
 #endif
\ No newline at end of file
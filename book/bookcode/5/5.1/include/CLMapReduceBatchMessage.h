@@ -0,0 +1,35 @@
+#ifndef CLMapReduceBatchMessage_H
+#define CLMapReduceBatchMessage_H
+
+#include "CLMessage.h"
+
+class CLMapReduceHashTable;
+
+/*
+ӳִ巢ԼִһֲϢIDΪMAP_REDUCE_BATCH_ID
+ʱѱеļֵƵһڴУÿΪɢֵֵͼ8ֽڶ
+*/
+class CLMapReduceBatchMessage : public CLMessage
+{
+public:
+	explicit CLMapReduceBatchMessage(CLMapReduceHashTable *pTable);
+	virtual ~CLMapReduceBatchMessage();
+
+	/*
+	һֵӵpTableУɢֵ¼
+	*/
+	void AddTo(CLMapReduceHashTable *pTable);
+
+	unsigned int GetNumberOfEntries();
+
+private:
+	CLMapReduceBatchMessage(const CLMapReduceBatchMessage&);
+	CLMapReduceBatchMessage& operator=(const CLMapReduceBatchMessage&);
+
+private:
+	char *m_pBuffer;
+	unsigned long m_nLength;
+	unsigned int m_nEntries;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef CLMapReduceEmitter_H
+#define CLMapReduceEmitter_H
+
+#include <vector>
+#include <string>
+#include "CLStatus.h"
+
+class CLMapReduceHashTable;
+
+#define MAX_KEYS_OF_MAP_REDUCE_COMBINER 524288
+
+/*
+ӳִıغϲEmitļֵȰڱرкϲĳļﵽnMaxKeys / ʱ
+ŰѸ÷ΪһCLMapReduceBatchMessageӦĹԼִ壻Flushзʣļֵ
+nMaxKeys˱رڴ棬಻ʱÿֻFlushʱһ
+ReducerNames[i]ΪiĹԼִƣֻһӳִʹã̰߳ȫ
+*/
+class CLMapReduceEmitter
+{
+public:
+	CLMapReduceEmitter(const std::vector<std::string>& ReducerNames, unsigned int nMaxKeys = MAX_KEYS_OF_MAP_REDUCE_COMBINER);
+	virtual ~CLMapReduceEmitter();
+
+	void Emit(const char *pKey, unsigned int nKeyLength, unsigned long long nValue);
+
+	/*
+	֮ǰκһʧʱʧ
+	*/
+	CLStatus Flush();
+
+	unsigned long long GetNumberOfBatches();
+
+private:
+	void FlushPartition(unsigned int nPartition);
+
+private:
+	CLMapReduceEmitter(const CLMapReduceEmitter&);
+	CLMapReduceEmitter& operator=(const CLMapReduceEmitter&);
+
+private:
+	std::vector<std::string> m_ReducerNames;
+	std::vector<CLMapReduceHashTable *> m_Tables;
+	unsigned int m_nMaxKeysPerPartition;
+
+	unsigned long long m_nBatches;
+	unsigned long long m_nFailedBatches;
+};
+
+#endif
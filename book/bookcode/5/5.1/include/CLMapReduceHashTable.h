@@ -0,0 +1,75 @@
+#ifndef CLMapReduceHashTable_H
+#define CLMapReduceHashTable_H
+
+#include <vector>
+
+#define INITIAL_CAPACITY_OF_MAP_REDUCE_HASH_TABLE 1024
+#define SIZE_OF_MAP_REDUCE_ARENA_BLOCK (1024 * 1024)
+
+struct SLMapReduceEntry
+{
+	const char *pKey;
+	unsigned int nKeyLength;
+	unsigned int nHash;
+	unsigned long long nValue;
+};
+
+/*
+ӳԼõļֵѰַݸƵڴУֵͬ
+ֽУҪ'\0'β
+಻̰߳ȫ
+*/
+class CLMapReduceHashTable
+{
+public:
+	explicit CLMapReduceHashTable(unsigned int nInitialCapacity = INITIAL_CAPACITY_OF_MAP_REDUCE_HASH_TABLE);
+	virtual ~CLMapReduceHashTable();
+
+	/*
+	nHashӦΪHash(pKey, nKeyLength)Ľ
+	*/
+	void Add(const char *pKey, unsigned int nKeyLength, unsigned int nHash, unsigned long long nValue);
+
+	/*
+	мֵѷıһڴ棬һ
+	*/
+	void Clear();
+
+	/*
+	мֵƵǰGetSize()ֻ֮ͨGetEntriesȡAdd
+	*/
+	void CompactAndSort();
+
+	unsigned int GetSize();
+	SLMapReduceEntry *GetEntries();
+
+	static unsigned int Hash(const char *pKey, unsigned int nKeyLength);
+
+	/*
+	ɢֵĸλڵλʹõλ߻
+	*/
+	static unsigned int GetPartition(unsigned int nHash, unsigned int nPartitions);
+
+	static bool IsKeyLess(const SLMapReduceEntry& e1, const SLMapReduceEntry& e2);
+
+private:
+	void Grow();
+	const char *CopyKey(const char *pKey, unsigned int nKeyLength);
+
+private:
+	CLMapReduceHashTable(const CLMapReduceHashTable&);
+	CLMapReduceHashTable& operator=(const CLMapReduceHashTable&);
+
+private:
+	SLMapReduceEntry *m_pEntries;
+	unsigned int m_nCapacity;
+	unsigned int m_nSize;
+	bool m_bSorted;
+
+	std::vector<char *> m_ArenaBlocks;
+	std::vector<char *> m_LargeKeys;
+	char *m_pArenaCurrent;
+	unsigned long m_nArenaLeft;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef CLMapReduceJob_H
+#define CLMapReduceJob_H
+
+#include <vector>
+#include <string>
+#include "CLStatus.h"
+
+class CLMapReduceMapper;
+class CLMapReduceHashTable;
+class CLThreadForMsgLoop;
+
+#define DEFAULT_SIZE_OF_MAP_REDUCE_SPLIT (64UL * 1024 * 1024)
+#define CAPACITY_OF_MAP_REDUCE_REDUCER_QUEUE 64
+
+struct SLMapReduceSplit
+{
+	const char *pData;
+	unsigned long nLength;
+};
+
+struct SLMapReduceInputFile
+{
+	void *pAddress;
+	unsigned long nLength;
+};
+
+/*
+ִmap/reduceҵΪֽУֵΪunsigned long longֵͬ
+ļֻʽmmapnSplitSizeгɶΣ߽CLMapReduceMapper::FindSplitEndɸӳִ嶯̬ȡ
+ӳִڱغϲͬļCLMapReduceEmitterطɢֵĹԼִ
+ԼִΪ"pstrJobName_reduce_i"ʹнSTLУʱڱ߳Runϲ
+CLMapReduceJobķͷ⣬ʹ߸
+*/
+class CLMapReduceJob
+{
+public:
+	/*
+	MappersеĶӦӶз䣬ҲصdeleteӳִĸMappersĸ
+	pstrJobNameƱΨһ
+	*/
+	CLMapReduceJob(const std::vector<CLMapReduceMapper*>& Mappers, unsigned int nReducers, const char *pstrJobName, unsigned long nSplitSize = DEFAULT_SIZE_OF_MAP_REDUCE_SPLIT);
+	virtual ~CLMapReduceJob();
+
+	/*
+	Run֮ǰãAddInputDirectoryֻĿ¼µͨļĿ¼ļ
+	*/
+	CLStatus AddInputFile(const char *pstrFileName);
+	CLStatus AddInputDirectory(const char *pstrDirName);
+
+	/*
+	ִҵֽÿΪ"\tֵ"дpstrOutputFilepstrOutputFileΪ0ʱ
+	ֻɵһΣִ嶼ŷ
+	*/
+	CLStatus Run(const char *pstrOutputFile);
+
+	unsigned long long GetInputLength();
+	unsigned long long GetNumberOfKeys();
+	unsigned long long GetNumberOfBatches();
+
+	friend class CLMapReduceMapperFunction;
+
+private:
+	SLMapReduceSplit *GetNextSplit();
+	void OnMapperFinished(unsigned long long nBatches, bool bSuccess);
+
+	CLStatus StartReducers();
+	void StopReducers();
+	CLStatus RunMappers();
+	CLStatus WriteOutput(const char *pstrOutputFile);
+
+private:
+	CLMapReduceJob(const CLMapReduceJob&);
+	CLMapReduceJob& operator=(const CLMapReduceJob&);
+
+private:
+	std::vector<CLMapReduceMapper*> m_Mappers;
+	std::string m_strJobName;
+	unsigned long m_nSplitSize;
+	bool m_bRunCalled;
+
+	std::vector<SLMapReduceInputFile> m_InputFiles;
+	std::vector<SLMapReduceSplit> m_Splits;
+	volatile unsigned long m_nNextSplit;
+	unsigned long long m_nInputLength;
+
+	std::vector<std::string> m_ReducerNames;
+	std::vector<CLMapReduceHashTable*> m_Tables;
+	std::vector<CLThreadForMsgLoop*> m_Reducers;
+
+	volatile unsigned long long m_nBatches;
+	volatile unsigned int m_nFailedMappers;
+	unsigned long long m_nKeys;
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef CLMapReduceMapper_H
+#define CLMapReduceMapper_H
+
+#include "CLStatus.h"
+
+class CLMapReduceEmitter;
+
+/*
+ûӸʵӳ亯ÿӳִʹһCLMapReduceMapperԱԼ״̬ؼ
+*/
+class CLMapReduceMapper
+{
+public:
+	CLMapReduceMapper();
+	virtual ~CLMapReduceMapper();
+
+	/*
+	ļһΣеÿpEmitter->EmitpDataָmmapӳļݣֻ
+	εı߽FindSplitEndһ¼ᱻе
+	*/
+	virtual CLStatus Map(const char *pData, unsigned long nLength, CLMapReduceEmitter *pEmitter) = 0;
+
+	/*
+	زСnOffsetĵһ¼߽磬nLengthΪļĳȣĬԻΪ߽磬ػ֮λ
+	*/
+	virtual unsigned long FindSplitEnd(const char *pData, unsigned long nLength, unsigned long nOffset);
+
+private:
+	CLMapReduceMapper(const CLMapReduceMapper&);
+	CLMapReduceMapper& operator=(const CLMapReduceMapper&);
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef CLMapReduceMapperFunction_H
+#define CLMapReduceMapperFunction_H
+
+#include "CLExecutiveFunctionProvider.h"
+
+class CLMapReduceJob;
+class CLMapReduceMapper;
+class CLMapReduceEmitter;
+
+/*
+CLMapReduceJobӳִ壺ϴҵȡһ뽻pMapperȫʣľֲ
+pEmitterӦӶз䣬ɱͷţpMapperҵͷ
+*/
+class CLMapReduceMapperFunction : public CLExecutiveFunctionProvider
+{
+public:
+	CLMapReduceMapperFunction(CLMapReduceJob *pJob, CLMapReduceMapper *pMapper, CLMapReduceEmitter *pEmitter);
+	virtual ~CLMapReduceMapperFunction();
+
+	virtual CLStatus RunExecutiveFunction(void* pContext);
+
+private:
+	CLMapReduceMapperFunction(const CLMapReduceMapperFunction&);
+	CLMapReduceMapperFunction& operator=(const CLMapReduceMapperFunction&);
+
+private:
+	CLMapReduceJob *m_pJob;
+	CLMapReduceMapper *m_pMapper;
+	CLMapReduceEmitter *m_pEmitter;
+};
+
+#endif
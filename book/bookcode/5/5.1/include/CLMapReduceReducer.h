@@ -0,0 +1,37 @@
+#ifndef CLMapReduceReducer_H
+#define CLMapReduceReducer_H
+
+#include "CLMessageObserver.h"
+
+class CLMessage;
+class CLMapReduceHashTable;
+
+#define MAP_REDUCE_BATCH_ID 1
+#define MAP_REDUCE_FINISH_ID 2
+
+/*
+CLMapReduceJobĹԼִ壬ɢֵڱм
+յCLMapReduceBatchMessageʱеļֵϲpTableУյϢIDΪMAP_REDUCE_FINISH_IDϢʱ
+ڱ߳нpTableΪʽCLMapReduceHashTable::CompactAndSortȻ˳Ϣѭ
+pTableʹ߷ͷţϢѭ˳ȻЧ
+*/
+class CLMapReduceReducer : public CLMessageObserver
+{
+public:
+	explicit CLMapReduceReducer(CLMapReduceHashTable *pTable);
+	virtual ~CLMapReduceReducer();
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext);
+
+	CLStatus On_Batch(CLMessage *pm);
+	CLStatus On_Finish(CLMessage *pm);
+
+private:
+	CLMapReduceReducer(const CLMapReduceReducer&);
+	CLMapReduceReducer& operator=(const CLMapReduceReducer&);
+
+private:
+	CLMapReduceHashTable *m_pTable;
+};
+
+#endif
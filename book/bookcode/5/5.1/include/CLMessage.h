@@ -1,18 +1,27 @@
 #ifndef CLMessage_H
 #define CLMessage_H
 
+#define MESSAGE_PRIORITY_HIGH 0
+#define MESSAGE_PRIORITY_NORMAL 1
+#define NUMBER_OF_MESSAGE_PRIORITIES 2
+
 /*
 ûɶԼϢӸ
 CLMessageӦӶз䣬Ϣغ󣬸ϢᱻԶɾصdelete
+˳ȿϢʹMESSAGE_PRIORITY_HIGHSTLͨϢҲܶƣкȼ
 */
 class CLMessage
 {
 public:
-	CLMessage(unsigned long lMsgID);
+	CLMessage(unsigned long lMsgID, int nPriority = MESSAGE_PRIORITY_NORMAL);
 	virtual ~CLMessage();
 
 public:
 	const unsigned long& m_clMsgID;
+	const int& m_clPriority;
+
+	//ڵϢͶʱ¼ʱ䣨룩CLExecutiveMetricsͳŶʱ䣬δͳʱΪ0
+	unsigned long long m_nEnqueueTime;
 
 private:
 	CLMessage(const CLMessage&);
@@ -20,6 +29,7 @@ private:
 
 protected:
 	unsigned long m_lMsgID;
+	int m_nPriority;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,22 @@
+#ifndef CLMessageIDDeserializer_H
+#define CLMessageIDDeserializer_H
+
+#include "CLZeroCopyMessageDeserializer.h"
+
+/*
+CLMessageIDSerializerӦԼ¼еϢIDCLMessage
+*/
+class CLMessageIDDeserializer : public CLZeroCopyMessageDeserializer
+{
+public:
+	CLMessageIDDeserializer();
+	virtual ~CLMessageIDDeserializer();
+
+	virtual CLMessage *Deserialize(const char *pBuffer, unsigned int nLength);
+
+private:
+	CLMessageIDDeserializer(const CLMessageIDDeserializer&);
+	CLMessageIDDeserializer& operator=(const CLMessageIDDeserializer&);
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef CLMessageIDSerializer_H
+#define CLMessageIDSerializer_H
+
+#include "CLZeroCopyMessageSerializer.h"
+
+/*
+ֻϢIDݵϢ˳֪ͨлΪһunsigned long
+*/
+class CLMessageIDSerializer : public CLZeroCopyMessageSerializer
+{
+public:
+	CLMessageIDSerializer();
+	virtual ~CLMessageIDSerializer();
+
+	virtual unsigned int GetSerializedLength(CLMessage *pMsg);
+	virtual CLStatus Serialize(CLMessage *pMsg, CLSerializeCursor *pCursor);
+
+private:
+	CLMessageIDSerializer(const CLMessageIDSerializer&);
+	CLMessageIDSerializer& operator=(const CLMessageIDSerializer&);
+};
+
+#endif
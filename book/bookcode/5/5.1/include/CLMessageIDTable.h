@@ -0,0 +1,203 @@
+#ifndef CLMessageIDTable_H
+#define CLMessageIDTable_H
+
+#include <vector>
+
+#define MAX_SIZE_OF_DENSE_MESSAGE_ID_TABLE 4096
+#define MIN_SIZE_OF_DENSE_MESSAGE_ID_TABLE 16
+#define MIN_CAPACITY_OF_SPARSE_MESSAGE_ID_TABLE 16
+
+/*
+ϢIDΪĲұϢлͷл
+ϢIDСMAX_SIZE_OF_DENSE_MESSAGE_ID_TABLEʱֱϢIDΪ±У
+ϢIDڿŶַ̽⣩Ĺϣ
+ñֲֻ֧ң֧ɾ̰߳ȫ
+*/
+template<typename T>
+class CLMessageIDTable
+{
+private:
+	struct SLDenseSlot
+	{
+		bool bUsed;
+		T Value;
+	};
+
+	struct SLSparseSlot
+	{
+		bool bUsed;
+		unsigned long lMsgID;
+		T Value;
+	};
+
+public:
+	CLMessageIDTable()
+	{
+		m_pDenseSlots = 0;
+		m_nDenseSize = 0;
+
+		m_pSparseSlots = 0;
+		m_nSparseCapacity = 0;
+		m_nSparseCount = 0;
+
+		m_nCount = 0;
+	}
+
+	virtual ~CLMessageIDTable()
+	{
+		delete [] m_pDenseSlots;
+		delete [] m_pSparseSlots;
+	}
+
+	/*
+	lMsgIDѴڣ򸲸ԭеֵ
+	*/
+	void Set(unsigned long lMsgID, const T& Value)
+	{
+		if(lMsgID < MAX_SIZE_OF_DENSE_MESSAGE_ID_TABLE)
+		{
+			if(lMsgID >= m_nDenseSize)
+				GrowDenseSlots(lMsgID + 1);
+
+			if(!m_pDenseSlots[lMsgID].bUsed)
+				m_nCount++;
+
+			m_pDenseSlots[lMsgID].bUsed = true;
+			m_pDenseSlots[lMsgID].Value = Value;
+			return;
+		}
+
+		if((m_nSparseCount + 1) * 2 > m_nSparseCapacity)
+			GrowSparseSlots();
+
+		SLSparseSlot *pSlot = FindSparseSlot(m_pSparseSlots, m_nSparseCapacity, lMsgID);
+		if(!pSlot->bUsed)
+		{
+			m_nSparseCount++;
+			m_nCount++;
+		}
+
+		pSlot->bUsed = true;
+		pSlot->lMsgID = lMsgID;
+		pSlot->Value = Value;
+	}
+
+	/*
+	δҵʱ0
+	*/
+	T* Find(unsigned long lMsgID)
+	{
+		if(lMsgID < m_nDenseSize)
+		{
+			if(m_pDenseSlots[lMsgID].bUsed)
+				return &(m_pDenseSlots[lMsgID].Value);
+
+			return 0;
+		}
+
+		if(m_nSparseCount == 0)
+			return 0;
+
+		SLSparseSlot *pSlot = FindSparseSlot(m_pSparseSlots, m_nSparseCapacity, lMsgID);
+		if(pSlot->bUsed)
+			return &(pSlot->Value);
+
+		return 0;
+	}
+
+	unsigned int GetCount()
+	{
+		return m_nCount;
+	}
+
+	void GetAllValues(std::vector<T>& Values)
+	{
+		for(unsigned long i = 0; i < m_nDenseSize; i++)
+		{
+			if(m_pDenseSlots[i].bUsed)
+				Values.push_back(m_pDenseSlots[i].Value);
+		}
+
+		for(unsigned long i = 0; i < m_nSparseCapacity; i++)
+		{
+			if(m_pSparseSlots[i].bUsed)
+				Values.push_back(m_pSparseSlots[i].Value);
+		}
+	}
+
+private:
+	static unsigned long Hash(unsigned long lMsgID)
+	{
+		unsigned long long h = (unsigned long long)lMsgID * 0x9E3779B97F4A7C15ULL;
+		return (unsigned long)(h ^ (h >> 32));
+	}
+
+	static SLSparseSlot *FindSparseSlot(SLSparseSlot *pSlots, unsigned long nCapacity, unsigned long lMsgID)
+	{
+		unsigned long mask = nCapacity - 1;
+		unsigned long i = Hash(lMsgID) & mask;
+
+		while(pSlots[i].bUsed && (pSlots[i].lMsgID != lMsgID))
+			i = (i + 1) & mask;
+
+		return &pSlots[i];
+	}
+
+	void GrowDenseSlots(unsigned long nMinSize)
+	{
+		unsigned long nSize = (m_nDenseSize == 0) ? MIN_SIZE_OF_DENSE_MESSAGE_ID_TABLE : m_nDenseSize;
+		while(nSize < nMinSize)
+			nSize *= 2;
+
+		if(nSize > MAX_SIZE_OF_DENSE_MESSAGE_ID_TABLE)
+			nSize = MAX_SIZE_OF_DENSE_MESSAGE_ID_TABLE;
+
+		SLDenseSlot *pSlots = new SLDenseSlot[nSize];
+		for(unsigned long i = 0; i < nSize; i++)
+		{
+			if(i < m_nDenseSize)
+				pSlots[i] = m_pDenseSlots[i];
+			else
+				pSlots[i].bUsed = false;
+		}
+
+		delete [] m_pDenseSlots;
+		m_pDenseSlots = pSlots;
+		m_nDenseSize = nSize;
+	}
+
+	void GrowSparseSlots()
+	{
+		unsigned long nCapacity = (m_nSparseCapacity == 0) ? MIN_CAPACITY_OF_SPARSE_MESSAGE_ID_TABLE : m_nSparseCapacity * 2;
+
+		SLSparseSlot *pSlots = new SLSparseSlot[nCapacity];
+		for(unsigned long i = 0; i < nCapacity; i++)
+			pSlots[i].bUsed = false;
+
+		for(unsigned long i = 0; i < m_nSparseCapacity; i++)
+		{
+			if(m_pSparseSlots[i].bUsed)
+				*FindSparseSlot(pSlots, nCapacity, m_pSparseSlots[i].lMsgID) = m_pSparseSlots[i];
+		}
+
+		delete [] m_pSparseSlots;
+		m_pSparseSlots = pSlots;
+		m_nSparseCapacity = nCapacity;
+	}
+
+private:
+	CLMessageIDTable(const CLMessageIDTable&);
+	CLMessageIDTable& operator=(const CLMessageIDTable&);
+
+private:
+	SLDenseSlot *m_pDenseSlots;
+	unsigned long m_nDenseSize;
+
+	SLSparseSlot *m_pSparseSlots;
+	unsigned long m_nSparseCapacity;
+	unsigned long m_nSparseCount;
+
+	unsigned int m_nCount;
+};
+
+#endif
@@ -1,17 +1,32 @@
 #ifndef CLMessageLoopManager_H
 #define CLMessageLoopManager_H
 
-#include <map>
+#include <vector>
+#include <string>
 #include "CLStatus.h"
+#include "CLMessageIDTable.h"
 
 class CLMessageObserver;
 class CLMessage;
 class CLExecutiveInitialFinishedNotifier;
+class CLTimingWheel;
+class CLExecutiveMetrics;
+class CLRequestMessage;
+class CLResponseMessage;
+class CLPendingRequestTable;
+struct SLMessageQueueStatistics;
 
 typedef CLStatus (CLMessageObserver::*CallBackForMessageLoop)(CLMessage *);
 
+/*
+pResponseΪ0ʾʱpResponseϢѭͷţصӦdelete
+*/
+typedef CLStatus (CLMessageObserver::*CallBackForResponse)(CLResponseMessage *pResponse, void *pContext);
+
 #define QUIT_MESSAGE_LOOP 1
 
+#define MAX_SIZE_OF_MESSAGE_BATCH 4096
+
 struct SLExecutiveInitialParameter
 {
 	void *pContext;
@@ -27,8 +42,10 @@ class CLMessageLoopManager
 public:
 	/*
 	pMessageObserverӦӶз䣬Ҳõdelete
+	pstrExecutiveNameΪ0ʱϢѭڼԸƵǼʱͳƣCLExecutiveMetrics
+	bSharedNameΪtrueʾɶϢѭãCLExecutivePoolḶ́߳ʱʹSendRequest
 	*/
-	CLMessageLoopManager(CLMessageObserver *pMessageObserver);
+	CLMessageLoopManager(CLMessageObserver *pMessageObserver, const char *pstrExecutiveName = 0, bool bSharedName = false);
 	virtual ~CLMessageLoopManager();
 
 	virtual CLStatus EnterMessageLoop(void *pContext);
@@ -39,6 +56,39 @@ public:
 	*/
 	virtual CLStatus Register(unsigned long lMsgID, CallBackForMessageLoop pMsgProcessFunction);
 
+	/*
+	MessageObserverڳʼʱô˺ʹϢѭÿαѺһȡnBatchSizeϢ
+	ĬnBatchSizeΪ1ÿֻһϢʱMessageObserverOnBatchBeginOnBatchEnd
+	*/
+	CLStatus SetBatchSize(unsigned int nBatchSize);
+
+	/*
+	öʱʱΪpstrExecutiveNameִͶϢIDΪlMsgIDCLTimerMessage
+	pstrExecutiveNameΪ0ʱʱڵϢϢУֱɱϢѭַ
+	lIntervalMsΪ0ʱΪһԶʱضʱIDʧʱ0
+	ʱϢѭڵȴϢʱһȴҪֶֻ̣֧߳ʱȴϢѭSTLСζСepoll
+	SetTimerKillTimerֻϢѭڵ߳еãϢ
+	*/
+	unsigned long SetTimer(unsigned long lMsgID, unsigned long lDelayMs, unsigned long lIntervalMs = 0, void *pContext = 0, const char *pstrExecutiveName = 0);
+	CLStatus KillTimer(unsigned long nTimerID);
+
+	/*
+	ΪpstrExecutiveNameִ巢Ӧʱ֪ͨɱϢѭpFunctionIDʧʱ0
+	ͬһʱ̿δɵӦ𵽴˳򲻱뷢˳һ
+	lTimeoutMsΪ0ʱʱҪϢѭֶ֧ʱȴʱȡ֮ŵӦ𽫱
+	ϢѭִƣԱԷӦpRequestӦӶз䣬۳ɹ񶼲delete
+	ƱõϢѭCLExecutivePoolḶ́߳ϵýʧܲ0ӦͶݸأ
+	ܱһ߳ȡIDֻڸԵϢѭΨһӦ𽫱򽻸Ļص
+	SendRequestCancelRequestֻϢѭڵ߳е
+	*/
+	unsigned long SendRequest(const char *pstrExecutiveName, CLRequestMessage *pRequest, CallBackForResponse pFunction, unsigned long lTimeoutMs = 0, void *pContext = 0);
+	CLStatus CancelRequest(unsigned long nRequestID);
+
+	/*
+	ȡϢеȡܾͳƣSTL֧ȫֶΣζepollֻṩȡܾ෵ʧ
+	*/
+	virtual CLStatus GetQueueStatistics(SLMessageQueueStatistics *pStatistics);
+
 protected:
 	/*
 	ʼ뷴ʼϢѭҪ֤ϢѾ
@@ -49,13 +99,43 @@ protected:
 	virtual CLMessage* WaitForMessage() = 0;
 	virtual CLStatus DispatchMessage(CLMessage *pMessage);
 
+	/*
+	ֱһϢȡϢĬʵÿֻȡһϢ
+	*/
+	virtual unsigned int WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount);
+
+	/*
+	ֱһϢȴlTimeoutMs룬lTimeoutMsΪ-1ʱʱȡϢ
+	0ʱϢѭ¼鶨ʱǰ
+	ֻIsTimedWaitSupportedtrueʱŻᱻ
+	*/
+	virtual bool IsTimedWaitSupported();
+	virtual unsigned int TimedWaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount, long lTimeoutMs);
+
+private:
+	void EnterBatchedMessageLoop();
+	unsigned int GetMessages(CLMessage **ppMessages, unsigned int nMaxCount, bool *pbQuit);
+	CLStatus ProcessExpiredTimers();
+	CLStatus DispatchResponse(CLMessage *pMessage);
+
 private:
 	CLMessageLoopManager(const CLMessageLoopManager&);
 	CLMessageLoopManager& operator=(const CLMessageLoopManager&);
 
 protected:
 	CLMessageObserver *m_pMessageObserver;
-	std::map<unsigned long, CallBackForMessageLoop> m_MsgMappingTable;
+	CLMessageIDTable<CallBackForMessageLoop> m_MsgMappingTable;
+	unsigned int m_nBatchSize;
+
+private:
+	CLTimingWheel *m_pTimingWheel;
+	std::vector<std::string> m_TimerTargets;
+
+	CLExecutiveMetrics *m_pMetrics;
+
+	std::string m_strExecutiveName;
+	bool m_bSharedName;
+	CLPendingRequestTable *m_pPendingRequests;
 };
 
 #endif
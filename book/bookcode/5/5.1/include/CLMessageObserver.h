@@ -16,6 +16,14 @@ public:
 	*/
 	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext) = 0;
 
+	/*
+	ֻϢѭʽʱCLMessageLoopManager::SetBatchSizeŻᱻ
+	ֱһϢ֮ǰ֮ãnMessagesΪϢĸ
+	дڷ̯ˢύܽȹ
+	*/
+	virtual CLStatus OnBatchBegin(unsigned int nMessages);
+	virtual CLStatus OnBatchEnd(unsigned int nMessages);
+
 private:
 	CLMessageObserver(const CLMessageObserver&);
 	CLMessageObserver& operator=(const CLMessageObserver&);
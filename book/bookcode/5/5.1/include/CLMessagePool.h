@@ -0,0 +1,66 @@
+#ifndef CLMessagePool_H
+#define CLMessagePool_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include "CLStatus.h"
+
+#define NUMBER_OF_MESSAGE_POOL_SIZE_CLASSES 6
+#define MIN_SIZE_OF_MESSAGE_POOL_BLOCK 32
+#define MAX_SIZE_OF_MESSAGE_POOL_BLOCK (MIN_SIZE_OF_MESSAGE_POOL_BLOCK << (NUMBER_OF_MESSAGE_POOL_SIZE_CLASSES - 1))
+#define NUMBER_OF_BLOCKS_PER_MESSAGE_POOL_SLAB 64
+
+struct SLMessagePoolThreadCache;
+
+struct SLMessagePoolStatistics
+{
+	unsigned long nAllocations;
+	unsigned long nFrees;
+	unsigned long nRemoteFrees;
+	unsigned long nSlabAllocations;
+	unsigned long nLargeAllocations;
+	unsigned long nThreadCaches;
+};
+
+/*
+CLPooledMessageʹõڴأСΪNUMBER_OF_MESSAGE_POOL_SIZE_CLASSESСȼ
+ÿ߳ӵԼĿ뱾߳ͷŶ
+̣߳ͨϢѭ̣߳ͷŵĿ飬ͨ黹ỵ̈߳´ηʱ
+MAX_SIZE_OF_MESSAGE_POOL_BLOCKĶֱʹmalloc/free
+߳˳֮󴴽߳̽ӹܣеڴ治黹ϵͳ
+*/
+class CLMessagePool
+{
+public:
+	static void* Allocate(size_t nSize);
+	static void Free(void *p);
+
+	/*
+	ͳ̵߳ļʹãɸ߳£ȡǽֵ
+	*/
+	static CLStatus GetStatistics(SLMessagePoolStatistics *pStatistics);
+
+private:
+	static SLMessagePoolThreadCache* GetThreadCache();
+	static void CreateKey();
+	static void OnThreadExit(void *pCache);
+	static unsigned int GetSizeClass(size_t nSize);
+	static bool AllocateSlab(SLMessagePoolThreadCache *pCache, unsigned int nSizeClass);
+
+private:
+	CLMessagePool(const CLMessagePool&);
+	CLMessagePool& operator=(const CLMessagePool&);
+
+	CLMessagePool();
+	~CLMessagePool();
+
+private:
+	static pthread_once_t m_OnceForKey;
+	static pthread_key_t m_KeyForThreadCache;
+
+	//m_pThreadCaches̵ֻ߳һη߳˳ʱʹ
+	static pthread_mutex_t m_MutexForThreadCaches;
+	static SLMessagePoolThreadCache *m_pThreadCaches;
+};
+
+#endif
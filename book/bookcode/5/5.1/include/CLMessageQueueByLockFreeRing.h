@@ -0,0 +1,97 @@
+#ifndef CLMessageQueueByLockFreeRing_H
+#define CLMessageQueueByLockFreeRing_H
+
+#include "CLStatus.h"
+
+class CLMessage;
+
+#define DEFAULT_CAPACITY_OF_LOCK_FREE_RING 65536
+#define SIZE_OF_CACHE_LINE 64
+
+struct SLLockFreeRingCell
+{
+	volatile unsigned long Sequence;
+	CLMessage *pMessage;
+};
+
+/*
+нλֶ֧ߡ
+PushMessageɱ̵߳ãGetMessageֻܱϢѭڵ̵߳
+ʱPushMessageʧܣɾϢ¼־ֻۼӾܾ
+ֻеʱ߲Żͨeventfd
+ҪCLMsgLoopManagerForLockFreeRingʹãҪӶз䣬Ҳصdelete
+*/
+class CLMessageQueueByLockFreeRing
+{
+public:
+	/*
+	nCapacity2
+	*/
+	explicit CLMessageQueueByLockFreeRing(unsigned long nCapacity = DEFAULT_CAPACITY_OF_LOCK_FREE_RING);
+	virtual ~CLMessageQueueByLockFreeRing();
+
+public:
+	CLStatus PushMessage(CLMessage * pMessage);
+	CLMessage* GetMessage();
+
+	/*
+	ֱһϢȻһȡnMaxCountϢȡϢ
+	*/
+	unsigned int GetMessages(CLMessage **ppMessages, unsigned int nMaxCount);
+
+	/*
+	ĺͬȴlTimeoutMs룬ʱ0lTimeoutMsΪ-1ʱʱ
+	*/
+	unsigned int GetMessages(CLMessage **ppMessages, unsigned int nMaxCount, long lTimeoutMs);
+
+	/*
+	ºepollȶ·еȴeventfdʹãֻܱϢѭڵ̵߳
+	TryGetMessagesûϢʱ0
+	PrepareToSleepǰãfalseʾϢӦ
+	غӦFinishSleepingeventfdɶʱ贫true
+	*/
+	int GetEventFd();
+	unsigned int TryGetMessages(CLMessage **ppMessages, unsigned int nMaxCount);
+	bool PrepareToSleep();
+	void FinishSleeping(bool bEventFdReadable);
+
+	/*
+	ɱ̵߳ãصϢΪֵ
+	*/
+	unsigned long GetDepth();
+	unsigned long GetCapacity();
+	unsigned long GetRejectedCount();
+
+	/*
+	λǨƵnNodeϣӦ߳Ͷݿʼ֮ǰ
+	*/
+	CLStatus BindToNUMANode(int nNode);
+
+private:
+	bool Push(CLMessage * pMessage);
+	CLMessage* Pop();
+	bool IsEmpty();
+	CLStatus WakeupConsumer();
+
+private:
+	CLMessageQueueByLockFreeRing(const CLMessageQueueByLockFreeRing&);
+	CLMessageQueueByLockFreeRing& operator=(const CLMessageQueueByLockFreeRing&);
+
+private:
+	SLLockFreeRingCell *m_pCells;
+	unsigned long m_nMask;
+	int m_EventFd;
+
+	char m_Padding1[SIZE_OF_CACHE_LINE];
+	volatile unsigned long m_nTail;
+	volatile unsigned long m_nRejected;
+
+	char m_Padding2[SIZE_OF_CACHE_LINE];
+	unsigned long m_nHead;
+
+	char m_Padding3[SIZE_OF_CACHE_LINE];
+	volatile int m_bConsumerSleeping;
+	char m_Padding4[SIZE_OF_CACHE_LINE];
+};
+
+#endif
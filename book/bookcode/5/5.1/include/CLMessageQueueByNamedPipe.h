@@ -16,6 +16,11 @@ public:
 
 	CLMessage *GetMessage();
 
+	/*
+	ֱһϢȻһζnMaxCountϢضϢ
+	*/
+	unsigned int GetMessages(CLMessage **ppMessages, unsigned int nMaxCount);
+
 protected:
 	virtual CLMessage *ReadMsgFromPipe(int fd) = 0;
 
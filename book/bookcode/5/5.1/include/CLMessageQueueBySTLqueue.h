@@ -5,35 +5,92 @@
 #include "CLStatus.h"
 #include "CLMutex.h"
 #include "CLEvent.h"
+#include "CLConditionVariable.h"
+#include "CLMessage.h"
 
-class CLMessage;
+#define MESSAGE_QUEUE_UNBOUNDED 0
+
+//ʱֱȡϢ
+#define MESSAGE_QUEUE_OVERFLOW_BLOCK 0
+//ʱPushMessageʧܣɾϢ
+#define MESSAGE_QUEUE_OVERFLOW_FAIL 1
+//ʱɾͨϢٷϢ
+#define MESSAGE_QUEUE_OVERFLOW_DROP_OLDEST 2
+
+struct SLMessageQueueStatistics
+{
+	unsigned long nDepth[NUMBER_OF_MESSAGE_PRIORITIES];
+	unsigned long nMaxDepth;
+	unsigned long nCapacity;
+	unsigned long nPushed;
+	unsigned long nDropped;
+	unsigned long nRejected;
+	unsigned long nBlocked;
+};
 
 /*
 ̰߳ȫ
 ҪCLMsgLoopManagerForMsgQueue ʹãҪӶз䣬Ҳõdelete
+ÿȼһУȼϢȱȡnCapacityֻͨϢĸΪ0ʱ
 */
 class CLMessageQueueBySTLqueue
 {
 public:
-	CLMessageQueueBySTLqueue();
+	explicit CLMessageQueueBySTLqueue(unsigned long nCapacity = MESSAGE_QUEUE_UNBOUNDED, int OverflowPolicy = MESSAGE_QUEUE_OVERFLOW_BLOCK);
 	virtual ~CLMessageQueueBySTLqueue();
 
 public:
+	/*
+	ΪMESSAGE_QUEUE_OVERFLOW_FAILѹرʱʧܲɾϢ
+	ֻܾͳƵnRejectedÿֻڵһξܾʱ¼־
+	*/
 	CLStatus PushMessage(CLMessage * pMessage);
 	CLMessage* GetMessage();
 
+	/*
+	ֱһϢȻһȡnMaxCountϢȡϢ
+	*/
+	unsigned int GetMessages(CLMessage **ppMessages, unsigned int nMaxCount);
+
+	/*
+	ĺͬȴlTimeoutMs룬ʱ0lTimeoutMsΪ-1ʱʱ
+	*/
+	unsigned int GetMessages(CLMessage **ppMessages, unsigned int nMaxCount, long lTimeoutMs);
+
+	/*
+	Ϣѭ˳ʱã˺PushMessageʧܣ߱Ѳʧ
+	*/
+	void Close();
+
+	CLStatus GetStatistics(SLMessageQueueStatistics *pStatistics);
+
 private:
-	CLStatus Push(CLMessage * pMessage);
+	CLStatus Push(CLMessage * pMessage, CLMessage **ppDropped);
+	void CountRejection();
 	CLMessage* Pop();
+	unsigned int Pop(CLMessage **ppMessages, unsigned int nCount);
 
 private:
 	CLMessageQueueBySTLqueue(const CLMessageQueueBySTLqueue&);
 	CLMessageQueueBySTLqueue& operator=(const CLMessageQueueBySTLqueue&);
 
 private:
-	std::queue<CLMessage*> m_MessageQueue;
+	std::queue<CLMessage*> m_MessageQueue[NUMBER_OF_MESSAGE_PRIORITIES];
 	CLMutex m_Mutex;
 	CLEvent m_Event;
+
+	unsigned long m_nCapacity;
+	int m_OverflowPolicy;
+	bool m_bClosed;
+
+	CLConditionVariable m_CondForNotFull;
+	unsigned long m_nBlockedProducers;
+
+	unsigned long m_nMaxDepth;
+	unsigned long m_nPushed;
+	unsigned long m_nDropped;
+	unsigned long m_nRejected;
+	unsigned long m_nBlocked;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef CLMessageQueueByWorkStealing_H
+#define CLMessageQueueByWorkStealing_H
+
+#include <deque>
+#include <queue>
+#include "CLStatus.h"
+#include "CLMutex.h"
+
+class CLMessage;
+
+#define SIZE_OF_WORK_STEALING_CACHE_LINE 64
+
+struct SLWorkStealingWorker
+{
+	CLMutex Mutex;
+
+	//ɱ߳ȡϢ̴߳ͷȡȡߴβȡ
+	std::deque<CLMessage*> Messages;
+
+	//׺ͼϢֻɱ̰߳˳
+	std::queue<CLMessage*> PinnedMessages;
+
+	int EventFd;
+
+	char Padding1[SIZE_OF_WORK_STEALING_CACHE_LINE];
+	volatile unsigned long nMessages;
+	volatile unsigned long nStealable;
+	volatile int bSleeping;
+	char Padding2[SIZE_OF_WORK_STEALING_CACHE_LINE];
+};
+
+/*
+CLExecutivePoolĶ̹߳ϢУÿ߳ӵԼ˫˶
+߳ȴԼеϢʱ̵߳ĶȡһϢ
+׺ͼϢɱִصĹ߳Ͷݣ߳ԼĶУ
+׺ͼϢǷlAffinityKey % nWorkersŹ̵߳ĶУҲᱻȡͬ׺ͼϢ˳
+üһReleaseͷŸöδϢ
+*/
+class CLMessageQueueByWorkStealing
+{
+public:
+	explicit CLMessageQueueByWorkStealing(unsigned int nWorkers);
+
+	void AddReference();
+	void Release();
+
+public:
+	CLStatus PushMessage(CLMessage *pMessage);
+	CLStatus PushMessage(CLMessage *pMessage, unsigned long lAffinityKey);
+
+	/*
+	ºֻɵnWorkerŹ̵߳ãQuit֮󷵻0
+	*/
+	CLMessage* GetMessage(unsigned int nWorker);
+	unsigned int GetMessages(unsigned int nWorker, CLMessage **ppMessages, unsigned int nMaxCount);
+
+	/*
+	߳ڽϢѭǰãʹ߳ͶݵϢȷԼĶ
+	*/
+	void BindCurrentThread(unsigned int nWorker);
+
+	/*
+	ʹй߳˳ϢѭʣϢٴ
+	*/
+	void Quit();
+	bool IsQuitting();
+
+	unsigned int GetNumberOfWorkers();
+
+	/*
+	ʹøöеִΪ0߸ַע
+	*/
+	void EnterExecutive();
+	unsigned int LeaveExecutive();
+
+private:
+	virtual ~CLMessageQueueByWorkStealing();
+
+	CLMessage* PopLocal(unsigned int nWorker);
+	CLMessage* Steal(unsigned int nWorker);
+	bool HasMessages(unsigned int nWorker);
+	CLStatus Push(unsigned int nWorker, CLMessage *pMessage, bool bPinned);
+	void WakeupWorker(unsigned int nWorker);
+	bool WakeupSleepingWorker(unsigned int nBegin);
+
+private:
+	CLMessageQueueByWorkStealing(const CLMessageQueueByWorkStealing&);
+	CLMessageQueueByWorkStealing& operator=(const CLMessageQueueByWorkStealing&);
+
+private:
+	SLWorkStealingWorker **m_ppWorkers;
+	unsigned int m_nWorkers;
+
+	volatile unsigned long m_nReferences;
+	volatile unsigned int m_nExecutives;
+	volatile int m_bQuit;
+
+	char m_Padding1[SIZE_OF_WORK_STEALING_CACHE_LINE];
+	volatile unsigned long m_nNextWorker;
+	char m_Padding2[SIZE_OF_WORK_STEALING_CACHE_LINE];
+	volatile unsigned int m_nSleepingWorkers;
+	char m_Padding3[SIZE_OF_WORK_STEALING_CACHE_LINE];
+};
+
+#endif
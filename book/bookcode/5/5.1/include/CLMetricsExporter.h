@@ -0,0 +1,38 @@
+#ifndef CLMetricsExporter_H
+#define CLMetricsExporter_H
+
+#include <string>
+#include "CLMessageObserver.h"
+
+class CLMessage;
+
+#define METRICS_EXPORTER_TIMER_ID 1
+#define METRICS_EXPORTER_QUIT_ID 2
+
+/*
+ڽִʱͳдļܵCLExecutiveMetrics::DumpToFile
+Ӧֶ֧ʱϢѭУ磺
+new CLThreadForMsgLoop(new CLMetricsExporter("/tmp/metrics", 1000), "metrics_exporter", true)
+ִͶϢIDΪMETRICS_EXPORTER_QUIT_IDϢٵһκ˳Ϣѭ
+*/
+class CLMetricsExporter : public CLMessageObserver
+{
+public:
+	CLMetricsExporter(const char *pstrPath, unsigned long lIntervalMs);
+	virtual ~CLMetricsExporter();
+
+	virtual CLStatus Initialize(CLMessageLoopManager *pMessageLoop, void* pContext);
+
+	CLStatus On_Timer(CLMessage *pm);
+	CLStatus On_Quit(CLMessage *pm);
+
+private:
+	CLMetricsExporter(const CLMetricsExporter&);
+	CLMetricsExporter& operator=(const CLMetricsExporter&);
+
+private:
+	std::string m_strPath;
+	unsigned long m_lIntervalMs;
+};
+
+#endif
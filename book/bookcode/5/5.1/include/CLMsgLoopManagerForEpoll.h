@@ -0,0 +1,97 @@
+#ifndef CLMsgLoopManagerForEpoll_H
+#define CLMsgLoopManagerForEpoll_H
+
+#include <vector>
+#include <string>
+#include <sys/epoll.h>
+#include "CLMessageLoopManager.h"
+
+class CLMessageQueueByLockFreeRing;
+
+typedef CLStatus (CLMessageObserver::*CallBackForFileDescriptor)(int fd, unsigned int nEvents);
+typedef CLStatus (CLMessageObserver::*CallBackForTimer)(int nTimerID, unsigned long nExpirations);
+
+#define MAX_NUMBER_OF_EPOLL_EVENTS 64
+
+//ôϢ󣬲ؼһļϢʱļò
+#define MAX_NUMBER_OF_MESSAGES_BETWEEN_EPOLL_WAIT 64
+
+#define EPOLL_HANDLER_NONE 0
+#define EPOLL_HANDLER_MESSAGE_QUEUE 1
+#define EPOLL_HANDLER_FILE_DESCRIPTOR 2
+#define EPOLL_HANDLER_TIMER 3
+
+struct SLEpollHandler
+{
+	int Type;
+	CallBackForFileDescriptor pFileDescriptorFunction;
+	CallBackForTimer pTimerFunction;
+};
+
+/*
+Ϣͨeventfd֪ͨeventfdûעļʱtimerfdλͬһepoll
+ִֻ߳epoll_waitϣͬʱ׽ֵļľ¼ʱִͶݵϢ
+MessageObserverInitializeнpMessageLoopתΪCLMsgLoopManagerForEpollעļ붨ʱ
+ļ붨ʱĻصQUIT_MESSAGE_LOOPʱͬ˳Ϣѭ
+עắֻϢѭڵ߳е
+*/
+class CLMsgLoopManagerForEpoll : public CLMessageLoopManager
+{
+public:
+	/*
+	pMsgObserverӦӶз䣬Ҳʾdelete
+	*/
+	CLMsgLoopManagerForEpoll(CLMessageObserver *pMsgObserver, const char* pstrThreadName);
+	virtual ~CLMsgLoopManagerForEpoll();
+
+	virtual CLStatus GetQueueStatistics(SLMessageQueueStatistics *pStatistics);
+
+	/*
+	nEventsΪEPOLLINEPOLLOUTepoll¼ϣfdʹ߸رգرǰӦע
+	*/
+	CLStatus RegisterFileDescriptor(int fd, unsigned int nEvents, CallBackForFileDescriptor pFunction);
+	CLStatus ModifyFileDescriptor(int fd, unsigned int nEvents);
+	CLStatus UnregisterFileDescriptor(int fd);
+
+	/*
+	lIntervalMsΪ0ʱΪһԶʱضʱIDʱ-1
+	ʱ󲻻Զ٣DestroyTimerϢѭ˳ʱʣĶʱ
+	*/
+	int CreateTimer(unsigned long lInitialMs, unsigned long lIntervalMs, CallBackForTimer pFunction);
+	CLStatus DestroyTimer(int nTimerID);
+
+protected:
+	virtual CLStatus Initialize();
+	virtual CLStatus Uninitialize();
+
+	virtual CLMessage* WaitForMessage();
+	virtual unsigned int WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount);
+	virtual bool IsTimedWaitSupported();
+	virtual unsigned int TimedWaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount, long lTimeoutMs);
+	virtual CLStatus DispatchMessage(CLMessage *pMessage);
+
+private:
+	bool WaitForEvents(int nTimeout);
+	SLEpollHandler *GetHandler(int fd);
+	CLStatus AddHandler(int fd, unsigned int nEvents, int Type);
+	CLStatus RemoveHandler(int fd);
+	CLMessage* CreateQuitMessage();
+
+private:
+	CLMsgLoopManagerForEpoll(const CLMsgLoopManagerForEpoll&);
+	CLMsgLoopManagerForEpoll& operator=(const CLMsgLoopManagerForEpoll&);
+
+private:
+	CLMessageQueueByLockFreeRing *m_pMsgQueue;
+	std::string m_strThreadName;
+
+	int m_EpollFd;
+	std::vector<SLEpollHandler> m_Handlers;
+	struct epoll_event m_Events[MAX_NUMBER_OF_EPOLL_EVENTS];
+
+	unsigned int m_nMessagesSinceWait;
+	bool m_bQuit;
+	CLMessage *m_pQuitMessage;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef CLMsgLoopManagerForLockFreeRing_H
+#define CLMsgLoopManagerForLockFreeRing_H
+
+#include <string>
+#include "CLMessageLoopManager.h"
+
+class CLMessageQueueByLockFreeRing;
+
+class CLMsgLoopManagerForLockFreeRing : public CLMessageLoopManager
+{
+public:
+	/*
+	pMsgObserverӦӶз䣬Ҳʾdelete
+	*/
+	CLMsgLoopManagerForLockFreeRing(CLMessageObserver *pMsgObserver, const char* pstrThreadName);
+	virtual ~CLMsgLoopManagerForLockFreeRing();
+
+	virtual CLStatus GetQueueStatistics(SLMessageQueueStatistics *pStatistics);
+
+protected:
+	virtual CLStatus Initialize();
+	virtual CLStatus Uninitialize();
+
+	virtual CLMessage* WaitForMessage();
+	virtual unsigned int WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount);
+
+	virtual bool IsTimedWaitSupported();
+	virtual unsigned int TimedWaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount, long lTimeoutMs);
+
+private:
+	CLMsgLoopManagerForLockFreeRing(const CLMsgLoopManagerForLockFreeRing&);
+	CLMsgLoopManagerForLockFreeRing& operator=(const CLMsgLoopManagerForLockFreeRing&);
+
+private:
+	CLMessageQueueByLockFreeRing *m_pMsgQueue;
+	std::string m_strThreadName;
+};
+
+#endif
@@ -8,6 +8,7 @@ using namespace std;
 
 class CLMessageQueueByNamedPipe;
 class CLMessageDeserializer;
+class CLZeroCopyMessageDeserializer;
 
 #define PIPE_QUEUE_BETWEEN_PROCESS 0
 #define PIPE_QUEUE_IN_PROCESS 1
@@ -22,12 +23,14 @@ public:
 	virtual ~CLMsgLoopManagerForPipeQueue();
 
 	CLStatus RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer);
+	CLStatus RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer);
 
 protected:
 	virtual CLStatus Initialize();
 	virtual CLStatus Uninitialize();
 
 	virtual CLMessage* WaitForMessage();
+	virtual unsigned int WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount);
 
 private:
 	CLMsgLoopManagerForPipeQueue(const CLMsgLoopManagerForPipeQueue&);
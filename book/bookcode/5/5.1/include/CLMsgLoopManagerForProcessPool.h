@@ -0,0 +1,28 @@
+#ifndef CLMsgLoopManagerForProcessPool_H
+#define CLMsgLoopManagerForProcessPool_H
+
+#include "CLMsgLoopManagerForShmQueue.h"
+
+#define PROCESS_POOL_QUIT_ID 0xfffffffcUL
+
+/*
+CLProcessPoolеϢѭյPROCESS_POOL_QUIT_IDʱֱ˳Ϣ۲ߴ
+*/
+class CLMsgLoopManagerForProcessPool : public CLMsgLoopManagerForShmQueue
+{
+public:
+	/*
+	pMsgObserverӦӶз䣬Ҳʾdelete
+	*/
+	CLMsgLoopManagerForProcessPool(CLMessageObserver *pMsgObserver, const char* pstrWorkerName);
+	virtual ~CLMsgLoopManagerForProcessPool();
+
+protected:
+	virtual CLStatus DispatchMessage(CLMessage *pMessage);
+
+private:
+	CLMsgLoopManagerForProcessPool(const CLMsgLoopManagerForProcessPool&);
+	CLMsgLoopManagerForProcessPool& operator=(const CLMsgLoopManagerForProcessPool&);
+};
+
+#endif
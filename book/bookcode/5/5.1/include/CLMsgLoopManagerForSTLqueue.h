@@ -3,23 +3,29 @@
 
 #include <string>
 #include "CLMessageLoopManager.h"
-
-class CLMessageQueueBySTLqueue;
+#include "CLMessageQueueBySTLqueue.h"
 
 class CLMsgLoopManagerForSTLqueue : public CLMessageLoopManager
 {
 public:
 	/*
 	pMsgObserverӦӶз䣬Ҳʾdelete
+	nCapacityOverflowPolicyCLMessageQueueBySTLqueue
 	*/
-	CLMsgLoopManagerForSTLqueue(CLMessageObserver *pMsgObserver, const char* pstrThreadName);
+	CLMsgLoopManagerForSTLqueue(CLMessageObserver *pMsgObserver, const char* pstrThreadName, unsigned long nCapacity = MESSAGE_QUEUE_UNBOUNDED, int OverflowPolicy = MESSAGE_QUEUE_OVERFLOW_BLOCK);
 	virtual ~CLMsgLoopManagerForSTLqueue();
 
+	virtual CLStatus GetQueueStatistics(SLMessageQueueStatistics *pStatistics);
+
 protected:
 	virtual CLStatus Initialize();
 	virtual CLStatus Uninitialize();
 	
 	virtual CLMessage* WaitForMessage();
+	virtual unsigned int WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount);
+
+	virtual bool IsTimedWaitSupported();
+	virtual unsigned int TimedWaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount, long lTimeoutMs);
 
 private:
 	CLMsgLoopManagerForSTLqueue(const CLMsgLoopManagerForSTLqueue&);
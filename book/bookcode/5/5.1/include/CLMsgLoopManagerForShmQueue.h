@@ -0,0 +1,40 @@
+#ifndef CLMsgLoopManagerForShmQueue_H
+#define CLMsgLoopManagerForShmQueue_H
+
+#include "CLMessageLoopManager.h"
+
+class CLSharedMsgQueueByShmRing;
+class CLMessageDeserializer;
+class CLZeroCopyMessageDeserializer;
+
+/*
+ͨCLSharedExecutiveCommunicationByShmRingϢѭϢ
+*/
+class CLMsgLoopManagerForShmQueue : public CLMessageLoopManager
+{
+public:
+	/*
+	pMsgObserverӦӶз䣬Ҳʾdelete
+	*/
+	CLMsgLoopManagerForShmQueue(CLMessageObserver *pMsgObserver, const char* pstrThreadName);
+	virtual ~CLMsgLoopManagerForShmQueue();
+
+	CLStatus RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer);
+	CLStatus RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer);
+
+protected:
+	virtual CLStatus Initialize();
+	virtual CLStatus Uninitialize();
+
+	virtual CLMessage* WaitForMessage();
+	virtual unsigned int WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount);
+
+private:
+	CLMsgLoopManagerForShmQueue(const CLMsgLoopManagerForShmQueue&);
+	CLMsgLoopManagerForShmQueue& operator=(const CLMsgLoopManagerForShmQueue&);
+
+private:
+	CLSharedMsgQueueByShmRing *m_pMsgQueue;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef CLMsgLoopManagerForWorkStealing_H
+#define CLMsgLoopManagerForWorkStealing_H
+
+#include <string>
+#include "CLMessageLoopManager.h"
+
+class CLMessageQueueByWorkStealing;
+
+/*
+CLExecutivePoolһ̵߳Ϣѭ
+һ̵߳ϢQUIT_MESSAGE_LOOPʱִصй̶߳˳Ϣѭ
+*/
+class CLMsgLoopManagerForWorkStealing : public CLMessageLoopManager
+{
+public:
+	/*
+	pMsgObserverӦӶз䣬Ҳʾdelete
+	*/
+	CLMsgLoopManagerForWorkStealing(CLMessageObserver *pMsgObserver, const char* pstrPoolName, CLMessageQueueByWorkStealing *pMsgQueue, unsigned int nWorker);
+	virtual ~CLMsgLoopManagerForWorkStealing();
+
+protected:
+	virtual CLStatus Initialize();
+	virtual CLStatus Uninitialize();
+
+	virtual CLMessage* WaitForMessage();
+	virtual unsigned int WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount);
+	virtual CLStatus DispatchMessage(CLMessage *pMessage);
+
+private:
+	CLMessage* CreateQuitMessage();
+
+private:
+	CLMsgLoopManagerForWorkStealing(const CLMsgLoopManagerForWorkStealing&);
+	CLMsgLoopManagerForWorkStealing& operator=(const CLMsgLoopManagerForWorkStealing&);
+
+private:
+	CLMessageQueueByWorkStealing *m_pMsgQueue;
+	unsigned int m_nWorker;
+	std::string m_strPoolName;
+
+	CLMessage *m_pQuitMessage;
+};
+
+#endif
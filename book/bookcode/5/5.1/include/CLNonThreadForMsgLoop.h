@@ -2,15 +2,21 @@
 #define CLNonThreadForMsgLoop_H
 
 #include "CLStatus.h"
+#include "CLMessageQueueBySTLqueue.h"
 
 class CLMessageObserver;
 class CLExecutiveFunctionProvider;
 class CLMsgLoopManagerForPipeQueue;
+class CLMsgLoopManagerForShmQueue;
 class CLMessageDeserializer;
+class CLZeroCopyMessageDeserializer;
 
 #define EXECUTIVE_IN_PROCESS_USE_STL_QUEUE 0
 #define EXECUTIVE_IN_PROCESS_USE_PIPE_QUEUE 1
 #define EXECUTIVE_BETWEEN_PROCESS_USE_PIPE_QUEUE 2
+#define EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING 3
+#define EXECUTIVE_BETWEEN_PROCESS_USE_SHM_QUEUE 4
+#define EXECUTIVE_IN_PROCESS_USE_EPOLL 5
 
 /*
 ֱ߳ӽϢѭǴ߳
@@ -20,12 +26,14 @@ class CLNonThreadForMsgLoop
 public:
 	/*
 	pMsgObserverӦӶз䣬ҲصdeletepstrThreadName߳ƱΨһ
+	nQueueCapacityOverflowPolicyEXECUTIVE_IN_PROCESS_USE_STL_QUEUEЧĬΪ޽
 	*/
-	CLNonThreadForMsgLoop(CLMessageObserver *pMsgObserver, const char *pstrThreadName, int ExecutiveType = EXECUTIVE_IN_PROCESS_USE_STL_QUEUE);
+	CLNonThreadForMsgLoop(CLMessageObserver *pMsgObserver, const char *pstrThreadName, int ExecutiveType = EXECUTIVE_IN_PROCESS_USE_STL_QUEUE, unsigned long nQueueCapacity = MESSAGE_QUEUE_UNBOUNDED, int OverflowPolicy = MESSAGE_QUEUE_OVERFLOW_BLOCK);
 	virtual ~CLNonThreadForMsgLoop();
 
 	CLStatus Run(void *pContext);
 	CLStatus RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer);
+	CLStatus RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer);
 
 private:
 	CLNonThreadForMsgLoop(const CLNonThreadForMsgLoop&);
@@ -34,6 +42,7 @@ private:
 private:
 	CLExecutiveFunctionProvider *m_pFunctionProvider;
 	CLMsgLoopManagerForPipeQueue *m_pPipeMsgQueue;
+	CLMsgLoopManagerForShmQueue *m_pShmMsgQueue;
 };
 
 #endif
\ No newline at end of file
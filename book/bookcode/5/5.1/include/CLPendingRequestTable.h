@@ -0,0 +1,53 @@
+#ifndef CLPendingRequestTable_H
+#define CLPendingRequestTable_H
+
+#include <vector>
+#include "CLMessageLoopManager.h"
+
+#define BITS_OF_REQUEST_INDEX 24
+#define MAX_NUMBER_OF_PENDING_REQUESTS (1 << BITS_OF_REQUEST_INDEX)
+
+struct SLPendingRequest
+{
+	unsigned long nRequestID;
+	CallBackForResponse pFunction;
+	void *pContext;
+	unsigned long nTimerID;
+	int Next;
+};
+
+/*
+¼һϢѭѷδյӦ
+IDĵ24λΪ±꣬λΪ±걻õĴ˳ʱȡ֮ٵӦ𲻻ᱻ
+಻̰߳ȫģֻӦһϢѭʹ
+*/
+class CLPendingRequestTable
+{
+public:
+	CLPendingRequestTable();
+	virtual ~CLPendingRequestTable();
+
+	/*
+	IDʧʱ0
+	*/
+	unsigned long Add(CallBackForResponse pFunction, void *pContext);
+
+	/*
+	δҵʱ0صָһAdd֮ǰЧ
+	*/
+	SLPendingRequest *Find(unsigned long nRequestID);
+	bool Remove(unsigned long nRequestID);
+
+	unsigned int GetNumberOfRequests();
+
+private:
+	CLPendingRequestTable(const CLPendingRequestTable&);
+	CLPendingRequestTable& operator=(const CLPendingRequestTable&);
+
+private:
+	std::vector<SLPendingRequest> m_Requests;
+	int m_nFreeRequest;
+	unsigned int m_nRequests;
+};
+
+#endif
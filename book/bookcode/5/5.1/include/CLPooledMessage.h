@@ -0,0 +1,25 @@
+#ifndef CLPooledMessage_H
+#define CLPooledMessage_H
+
+#include <stddef.h>
+#include "CLMessage.h"
+
+/*
+ҪƵշϢɴӸCLMessagePool䣬ֱʹȫֵnew/delete
+÷CLMessageͬӶnewϢѭϢѭdelete
+*/
+class CLPooledMessage : public CLMessage
+{
+public:
+	CLPooledMessage(unsigned long lMsgID);
+	virtual ~CLPooledMessage();
+
+	static void* operator new(size_t nSize);
+	static void operator delete(void *p);
+
+private:
+	CLPooledMessage(const CLPooledMessage&);
+	CLPooledMessage& operator=(const CLPooledMessage&);
+};
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef CLProcessFunctionForExec_H
 #define CLProcessFunctionForExec_H
 
+#include <unistd.h>
+#include <vector>
 #include "CLExecutiveFunctionProvider.h"
 
 class CLProcessFunctionForExec : public CLExecutiveFunctionProvider
@@ -11,8 +13,16 @@ public:
 
 	virtual CLStatus RunExecutiveFunction(void* pCmdLine);
 
+	/*
+	ڸֱposix_spawnӽִ̲pCmdLineĿ¼лļĹرվӽ
+	RunExecutiveFunctionһӽֻ012ļexecʧʱس
+	Cⲻ֧posix_spawnչʱصĴΪENOSYSӦ˻صforkٵRunExecutiveFunctionķʽ
+	*/
+	CLStatus SpawnProcess(void* pCmdLine, pid_t *pProcessID);
+
 private:
 	CLStatus SetWorkDirectory(char *pstrArgv0);
+	static void SplitCmdLine(char *pstrCmdLine, std::vector<char *>& vstrArgs);
 
 private:
 	CLProcessFunctionForExec(const CLProcessFunctionForExec&);
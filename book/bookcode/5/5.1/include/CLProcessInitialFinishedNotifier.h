@@ -0,0 +1,28 @@
+#ifndef CLProcessInitialFinishedNotifier_H
+#define CLProcessInitialFinishedNotifier_H
+
+#include "CLExecutiveInitialFinishedNotifier.h"
+
+/*
+ӽʹãͨܵд򸸽дһֽڣ1ʾʼɹ0ʾʧ
+֪֮ͨ󼴹رдˣ̶ļʱ֪δ֪ͨӽѾ
+*/
+class CLProcessInitialFinishedNotifier : public CLExecutiveInitialFinishedNotifier
+{
+public:
+	explicit CLProcessInitialFinishedNotifier(int fd);
+	virtual ~CLProcessInitialFinishedNotifier();
+
+	virtual CLStatus NotifyInitialFinished(bool bInitialSuccess);
+	virtual bool IsInitialSuccess();
+
+private:
+	CLProcessInitialFinishedNotifier(const CLProcessInitialFinishedNotifier&);
+	CLProcessInitialFinishedNotifier& operator=(const CLProcessInitialFinishedNotifier&);
+
+private:
+	bool m_bSuccess;
+	int m_Fd;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef CLProcessPool_H
+#define CLProcessPool_H
+
+#include <unistd.h>
+#include <vector>
+#include <string>
+#include "CLStatus.h"
+
+class CLMessage;
+class CLMessageObserver;
+class CLMessageSerializer;
+class CLMessageDeserializer;
+class CLZeroCopyMessageSerializer;
+class CLZeroCopyMessageDeserializer;
+class CLExecutiveCommunicationByProcessPool;
+
+/*
+̳أԤforḳÿڹ洢ϢϢѭڶҵ֮临
+i̵ϢѭΪ̳_iͨCLExecutiveNameServerͶݸ̳ƵϢڹ֮为ؾ
+̲exec̳˸forkʱȫڴ棬ҵֻ贫ݲ¼س
+CLProcessPoolķͷ⣬ʹ߸
+*/
+class CLProcessPool
+{
+public:
+	/*
+	ObserversеĶӦӶз䣬Ҳصdelete̵ĸObserversĸ
+	i۲ֻڵiУڸֻͷ
+	pstrPoolNameƱΨһ
+	*/
+	CLProcessPool(const std::vector<CLMessageObserver*>& Observers, const char *pstrPoolName);
+	virtual ~CLProcessPool();
+
+	/*
+	Run֮ǰעᣬлڱͶϢлڹ̽Ϣ
+	ӦӶз䣬Ҳصdelete
+	*/
+	CLStatus RegisterSerializer(unsigned long lMsgID, CLMessageSerializer *pSerializer);
+	CLStatus RegisterSerializer(unsigned long lMsgID, CLZeroCopyMessageSerializer *pSerializer);
+	CLStatus RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer);
+	CLStatus RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer);
+
+	/*
+	й̣ϢѭʼϺŷأ۷ȷֻɵһ
+	forkֻƵ̣̳߳߳еӽԶͷţӦڴ֮߳ǰ
+	һ̳ʼʧʱĹ̽˳
+	*/
+	CLStatus Run(void *pContext);
+
+	/*
+	֪ͨй˳Ϣѭȴ̳֮ͶϢлԶ
+	*/
+	CLStatus Shutdown();
+
+	static CLStatus PostExecutiveMessage(const char *pstrPoolName, CLMessage *pMessage, unsigned long lAffinityKey);
+
+private:
+	void RunWorker(unsigned int nIndex, int fd, void *pContext);
+	void WaitForWorkers();
+
+private:
+	CLProcessPool(const CLProcessPool&);
+	CLProcessPool& operator=(const CLProcessPool&);
+
+private:
+	std::vector<CLMessageObserver*> m_Observers;
+	std::vector<std::string> m_WorkerNames;
+	std::vector<pid_t> m_ProcessIDs;
+
+	std::vector<std::pair<unsigned long, CLZeroCopyMessageDeserializer*> > m_Deserializers;
+
+	std::string m_strPoolName;
+	CLExecutiveCommunicationByProcessPool *m_pCommunication;
+
+	bool m_bRunCalled;
+	bool m_bRegistered;
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef CLRelaxedAtomic_H
+#define CLRelaxedAtomic_H
+
+/*
+ֻһ߳޸ġ߳ʱȡļڴΪ__ATOMIC_RELAXED
+ɵָͨдͬǰ׺ȡݾ
+֮û˳֤ȡߵõһвһ
+RelaxedAddԭӵĶ--дֻΨһ޸ߵ
+*/
+template<typename T>
+inline T RelaxedLoad(const T *p)
+{
+	return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+
+template<typename T>
+inline void RelaxedStore(T *p, T Value)
+{
+	__atomic_store_n(p, Value, __ATOMIC_RELAXED);
+}
+
+template<typename T>
+inline void RelaxedAdd(T *p, T Value)
+{
+	__atomic_store_n(p, __atomic_load_n(p, __ATOMIC_RELAXED) + Value, __ATOMIC_RELAXED);
+}
+
+#endif
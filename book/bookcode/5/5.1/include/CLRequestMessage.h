@@ -0,0 +1,36 @@
+#ifndef CLRequestMessage_H
+#define CLRequestMessage_H
+
+#include <string>
+#include "CLMessage.h"
+#include "CLStatus.h"
+
+class CLResponseMessage;
+
+/*
+CLMessageLoopManager::SendRequest͵ûӸʹԼϢID
+m_nRequestIDm_strReplyToSendRequestдһReplyӦͶݻ
+Ҫڴ֮ӦӦm_strReplyTom_nRequestID֮þ̬Reply
+*/
+class CLRequestMessage : public CLMessage
+{
+public:
+	explicit CLRequestMessage(unsigned long lMsgID);
+	virtual ~CLRequestMessage();
+
+	/*
+	pResponseӦӶз䣬۳ɹ񶼲deleteѳʱ˳ʱʧ
+	*/
+	CLStatus Reply(CLResponseMessage *pResponse);
+	static CLStatus Reply(const char *pstrReplyTo, unsigned long nRequestID, CLResponseMessage *pResponse);
+
+public:
+	unsigned long m_nRequestID;
+	std::string m_strReplyTo;
+
+private:
+	CLRequestMessage(const CLRequestMessage&);
+	CLRequestMessage& operator=(const CLRequestMessage&);
+};
+
+#endif
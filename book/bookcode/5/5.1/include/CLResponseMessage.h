@@ -0,0 +1,28 @@
+#ifndef CLResponseMessage_H
+#define CLResponseMessage_H
+
+#include "CLMessage.h"
+
+//ϢIDûϢӦʹ
+#define MESSAGE_ID_OF_RESPONSE 0xfffffffeUL
+#define MESSAGE_ID_OF_REQUEST_TIMEOUT 0xfffffffdUL
+
+/*
+ӦûɴӸЯCLRequestMessage::ReplyͶݻ
+Ӧ𲻾ϢIDӳ󷽵Ϣѭm_nRequestIDSendRequestʱָĻص
+*/
+class CLResponseMessage : public CLMessage
+{
+public:
+	CLResponseMessage();
+	virtual ~CLResponseMessage();
+
+public:
+	unsigned long m_nRequestID;
+
+private:
+	CLResponseMessage(const CLResponseMessage&);
+	CLResponseMessage& operator=(const CLResponseMessage&);
+};
+
+#endif
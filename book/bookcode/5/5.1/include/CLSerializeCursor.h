@@ -0,0 +1,48 @@
+#ifndef CLSerializeCursor_H
+#define CLSerializeCursor_H
+
+#include <vector>
+#include <sys/uio.h>
+#include "CLStatus.h"
+
+/*
+CLZeroCopyMessageSerializerλ
+Իʱֱдû繲洢еļ¼
+ĬϹʱΪۼʽWriteƵݴڲУWriteReferenceֻ¼ַ
+iovecʽwritevõwritevǰЧ
+*/
+class CLSerializeCursor
+{
+public:
+	CLSerializeCursor(char *pBuffer, unsigned int nLength);
+	CLSerializeCursor();
+	virtual ~CLSerializeCursor();
+
+	CLStatus Write(const void *pData, unsigned int nLength);
+	CLStatus WriteReference(const void *pData, unsigned int nLength);
+
+	unsigned int GetLength();
+
+	/*
+	ºֻھۼʽnMaxLengthΪ֮ͨWriteƵݵ󳤶
+	*/
+	void Reset(unsigned int nMaxLength);
+	const struct iovec *GetIovecs();
+	int GetIovecCount();
+
+private:
+	CLSerializeCursor(const CLSerializeCursor&);
+	CLSerializeCursor& operator=(const CLSerializeCursor&);
+
+private:
+	bool m_bGather;
+
+	char *m_pBuffer;
+	unsigned int m_nCapacity;
+	unsigned int m_nUsed;
+
+	unsigned int m_nLength;
+	std::vector<struct iovec> m_Iovecs;
+};
+
+#endif
@@ -5,7 +5,9 @@
 
 struct SLEventInfo
 {
-	long Flag;
+	//FlagWaitersfutex32λ
+	volatile int Flag;
+	volatile int Waiters;
 	long bSemaphore;
 	long Context;
 };
@@ -1,12 +1,13 @@
 #ifndef CLSharedExecutiveCommunicationByNamedPipe_H
 #define CLSharedExecutiveCommunicationByNamedPipe_H
 
-#include <map>
 #include "CLExecutiveCommunicationByNamedPipe.h"
+#include "CLMessageIDTable.h"
 
 using namespace std;
 
 class CLMessageSerializer;
+class CLZeroCopyMessageSerializer;
 
 class CLSharedExecutiveCommunicationByNamedPipe : public CLExecutiveCommunicationByNamedPipe
 {
@@ -15,16 +16,17 @@ public:
 	virtual ~CLSharedExecutiveCommunicationByNamedPipe();
 
 	CLStatus RegisterSerializer(unsigned long lMsgID, CLMessageSerializer *pSerializer);
+	CLStatus RegisterSerializer(unsigned long lMsgID, CLZeroCopyMessageSerializer *pSerializer);
 
 protected:
-	virtual char *GetMsgBuf(CLMessage *pMsg, unsigned int *pLength);
+	virtual CLStatus WriteMsgToPipe(CLMessage *pMsg);
 
 private:
 	CLSharedExecutiveCommunicationByNamedPipe(const CLSharedExecutiveCommunicationByNamedPipe&);
 	CLSharedExecutiveCommunicationByNamedPipe& operator=(const CLSharedExecutiveCommunicationByNamedPipe&);
 
 private:
-	map<unsigned long, CLMessageSerializer*> m_SerializerTable;
+	CLMessageIDTable<CLZeroCopyMessageSerializer*> m_SerializerTable;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,46 @@
+#ifndef CLSharedExecutiveCommunicationByShmRing_H
+#define CLSharedExecutiveCommunicationByShmRing_H
+
+#include "CLExecutiveCommunication.h"
+#include "CLSharedMemoryRing.h"
+#include "CLMessageIDTable.h"
+
+class CLMessageSerializer;
+class CLZeroCopyMessageSerializer;
+
+/*
+СʹEXECUTIVE_BETWEEN_PROCESS_USE_SHM_QUEUEϢѭϢ
+ϢĳȲPIPE_BUFƣCLZeroCopyMessageSerializerֱӽϢд뻷еļ¼
+*/
+class CLSharedExecutiveCommunicationByShmRing : public CLExecutiveCommunication
+{
+public:
+	explicit CLSharedExecutiveCommunicationByShmRing(const char *pstrExecutiveName);
+	virtual ~CLSharedExecutiveCommunicationByShmRing();
+
+	CLStatus RegisterSerializer(unsigned long lMsgID, CLMessageSerializer *pSerializer);
+	CLStatus RegisterSerializer(unsigned long lMsgID, CLZeroCopyMessageSerializer *pSerializer);
+
+	virtual CLStatus PostExecutiveMessage(CLMessage *pMessage);
+
+	/*
+	ʹõ߳елϢעлڶͨŶͬһл
+	*/
+	CLStatus PostExecutiveMessage(CLMessage *pMessage, CLZeroCopyMessageSerializer *pSerializer);
+
+	unsigned long GetPendingLength();
+
+private:
+	CLStatus WriteToRecord(CLZeroCopyMessageSerializer *pSerializer, CLMessage *pMessage, unsigned int nLength);
+	CLStatus WriteToChain(CLZeroCopyMessageSerializer *pSerializer, CLMessage *pMessage, unsigned int nLength);
+
+private:
+	CLSharedExecutiveCommunicationByShmRing(const CLSharedExecutiveCommunicationByShmRing&);
+	CLSharedExecutiveCommunicationByShmRing& operator=(const CLSharedExecutiveCommunicationByShmRing&);
+
+private:
+	CLSharedMemoryRing m_Ring;
+	CLMessageIDTable<CLZeroCopyMessageSerializer*> m_SerializerTable;
+};
+
+#endif
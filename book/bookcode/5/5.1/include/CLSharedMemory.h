@@ -1,30 +1,48 @@
 #ifndef CLSharedMemory_H
 #define CLSharedMemory_H
 
+#include <stddef.h>
 #include "CLStatus.h"
-#include "CLMutex.h"
-
+#include "CLSharedMemoryInterface.h"
+
+#define SHARED_MEMORY_USE_SYSV 0
+#define SHARED_MEMORY_USE_POSIX 1
+#define SHARED_MEMORY_USE_FILE 2
+
+#define SHARED_MEMORY_FLAG_HUGE_PAGE 1
+#define SHARED_MEMORY_FLAG_POPULATE 2
+
+/*
+pstrFileNameʶڴ棬ͬơͷͬһ鹲ڴ棻nSizeΪ0ʱֻѴڵĹڴ
+SHARED_MEMORY_USE_SYSVSystem Vڴ棬С̶֧nFlags
+SHARED_MEMORY_USE_POSIXPOSIXڴ棬һ̷ʱɾ
+SHARED_MEMORY_USE_FILEӳ/tmpµļݱ
+֧ResizenFlagsSHARED_MEMORY_FLAG_HUGE_PAGEڹ/dev/hugepagesʱʹôҳʾʹ͸ҳ
+SHARED_MEMORY_FLAG_POPULATEӳʱԤȷȫҳ棬״ηʱȱҳ
+*/
 class CLSharedMemory
 {
 public:
-	explicit CLSharedMemory(const char *pstrFileName, size_t nSize = 0);
+	explicit CLSharedMemory(const char *pstrFileName, size_t nSize = 0, int nType = SHARED_MEMORY_USE_SYSV, int nFlags = 0);
 	virtual ~CLSharedMemory();
 
 	void *GetAddress();
+	size_t GetSize();
 	int GetRefCount();
 
-private:
-	CLStatus DeleteSharedMemory();
+	/*
+	ֻ󣬳ɹGetAddressķֵܸı䣬˹ڴӦƫƶָ
+	RefreshܷĲ
+	*/
+	CLStatus Resize(size_t nNewSize);
+	CLStatus Refresh();
 
 private:
 	CLSharedMemory(const CLSharedMemory&);
 	CLSharedMemory& operator=(const CLSharedMemory&);
 
 private:
-	void *m_pSharedMemory;
-	int m_SharedMemoryID;
-
-	CLMutex m_Mutex;
+	CLSharedMemoryInterface *m_pSharedMemory;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef CLSharedMemoryByMmap_H
+#define CLSharedMemoryByMmap_H
+
+#include <string>
+#include "CLSharedMemoryInterface.h"
+#include "CLMutex.h"
+
+#define SIZE_OF_SHARED_MEMORY_HEAD 64
+
+struct SLSharedMemoryHead
+{
+	int nRefCount;
+	unsigned long long nSize;
+};
+
+/*
+shm_openͨļmmapĹڴ棬ӳĿͷSIZE_OF_SHARED_MEMORY_HEADֽڴü뵱ǰС
+bPersistentΪfalseʱʹPOSIXڴ棬һ̷ʱɾΪtrueʱӳ/tmpµļļ
+Resizeֻӳĵַ˸ı䣻̵RefreshܿĲ
+*/
+class CLSharedMemoryByMmap : public CLSharedMemoryInterface
+{
+public:
+	CLSharedMemoryByMmap(const char *pstrFileName, size_t nSize, bool bPersistent, int nFlags);
+	virtual ~CLSharedMemoryByMmap();
+
+	virtual CLStatus Initialize();
+	virtual CLStatus Uninitialize();
+
+	virtual void *GetAddress();
+	virtual size_t GetSize();
+	virtual int GetRefCount();
+
+	virtual CLStatus Resize(size_t nNewSize);
+	virtual CLStatus Refresh();
+
+private:
+	CLStatus OpenFile();
+	CLStatus Grow(size_t nNewSize);
+	CLStatus Remap(size_t nMappedSize);
+	size_t GetMappedSize(size_t nSize);
+	void Populate(char *p, size_t nLength);
+
+private:
+	CLSharedMemoryByMmap(const CLSharedMemoryByMmap&);
+	CLSharedMemoryByMmap& operator=(const CLSharedMemoryByMmap&);
+
+private:
+	std::string m_strFileName;
+	std::string m_strPathName;
+	size_t m_nSize;
+	bool m_bPersistent;
+	int m_nFlags;
+
+	//ʹhugetlbfsʱΪtrueҳֻǸ͸ҳʾ
+	bool m_bHugeTLB;
+
+	int m_Fd;
+	char *m_pMapped;
+	size_t m_nMappedSize;
+
+	CLMutex m_Mutex;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef CLSharedMemoryBySysV_H
+#define CLSharedMemoryBySysV_H
+
+#include <string>
+#include "CLSharedMemoryInterface.h"
+#include "CLMutex.h"
+
+/*
+shmget/shmatĹڴ棬/tmpͬļftokֵΪСڴʱȷ
+һ̷ʱɾڴ
+*/
+class CLSharedMemoryBySysV : public CLSharedMemoryInterface
+{
+public:
+	CLSharedMemoryBySysV(const char *pstrFileName, size_t nSize);
+	virtual ~CLSharedMemoryBySysV();
+
+	virtual CLStatus Initialize();
+	virtual CLStatus Uninitialize();
+
+	virtual void *GetAddress();
+	virtual size_t GetSize();
+	virtual int GetRefCount();
+
+private:
+	CLStatus DeleteSharedMemory();
+
+private:
+	CLSharedMemoryBySysV(const CLSharedMemoryBySysV&);
+	CLSharedMemoryBySysV& operator=(const CLSharedMemoryBySysV&);
+
+private:
+	std::string m_strFileName;
+	size_t m_nSize;
+
+	void *m_pSharedMemory;
+	int m_SharedMemoryID;
+
+	CLMutex m_Mutex;
+};
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef CLSharedMemoryInterface_H
+#define CLSharedMemoryInterface_H
+
+#include <stddef.h>
+#include "CLStatus.h"
+
+class CLSharedMemoryInterface
+{
+public:
+	CLSharedMemoryInterface();
+	virtual ~CLSharedMemoryInterface();
+
+	virtual CLStatus Initialize() = 0;
+	virtual CLStatus Uninitialize() = 0;
+
+	virtual void *GetAddress() = 0;
+	virtual size_t GetSize() = 0;
+	virtual int GetRefCount() = 0;
+
+	/*
+	Ĭʵֲָ֧ıСResizeʧܣRefreshֱӷسɹ
+	*/
+	virtual CLStatus Resize(size_t nNewSize);
+	virtual CLStatus Refresh();
+
+private:
+	CLSharedMemoryInterface(const CLSharedMemoryInterface&);
+	CLSharedMemoryInterface& operator=(const CLSharedMemoryInterface&);
+};
+
+#endif
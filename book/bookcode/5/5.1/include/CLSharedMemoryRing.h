@@ -0,0 +1,113 @@
+#ifndef CLSharedMemoryRing_H
+#define CLSharedMemoryRing_H
+
+#include <map>
+#include <string>
+#include "CLStatus.h"
+#include "CLEvent.h"
+
+class CLSharedMemory;
+
+#define SIZE_OF_SHARED_MEMORY_RING (1 << 20)
+#define MAX_LENGTH_OF_SHARED_MEMORY_RING_RECORD (SIZE_OF_SHARED_MEMORY_RING / 8)
+#define SIZE_OF_SHARED_MEMORY_RING_CACHE_LINE 64
+
+#define SHARED_MEMORY_RING_RECORD_EMPTY 0
+#define SHARED_MEMORY_RING_RECORD_MESSAGE 1
+#define SHARED_MEMORY_RING_RECORD_PADDING 2
+#define SHARED_MEMORY_RING_RECORD_FRAGMENT 3
+
+/*
+洢ȫΪ0ʱΪЧĳʼ״̬˴ʹԼʼ˳
+*/
+struct SLSharedMemoryRingHeader
+{
+	volatile unsigned long nTail;
+	char Padding1[SIZE_OF_SHARED_MEMORY_RING_CACHE_LINE];
+	volatile unsigned long nHead;
+	char Padding2[SIZE_OF_SHARED_MEMORY_RING_CACHE_LINE];
+	volatile int bConsumerSleeping;
+	volatile unsigned long nChainID;
+	char Padding3[SIZE_OF_SHARED_MEMORY_RING_CACHE_LINE];
+};
+
+struct SLSharedMemoryRingRecord
+{
+	volatile unsigned int nType;
+	unsigned int nLength;
+
+	//ֻڷƬ¼
+	unsigned long lChainID;
+	unsigned int nTotalLength;
+	unsigned int nOffset;
+};
+
+struct SLSharedMemoryRingChain
+{
+	char *pBuffer;
+	unsigned int nReceived;
+};
+
+/*
+ڹ洢ֽڻλֶ֧̣̣߳д߶
+ÿ¼ڻţ߿ֱڻжȡ¼踴
+ȳMAX_LENGTH_OF_SHARED_MEMORY_RING_RECORDݱɶƬд룬ƴ
+ֻеʱ߲ŻͨCLEvent
+*/
+class CLSharedMemoryRing
+{
+public:
+	explicit CLSharedMemoryRing(const char *pstrRingName);
+	virtual ~CLSharedMemoryRing();
+
+	/*
+	пռ䲻ʱʧܣƬݵĵһƬд󣬺Ƭȴڳռ
+	*/
+	CLStatus Write(const char *pBuffer, unsigned int nLength);
+
+	/*
+	ڻԤһΪnLengthļ¼ֱַдݺEndWrite
+	nLengthMAX_LENGTH_OF_SHARED_MEMORY_RING_RECORDпռ䲻ʱ0
+	bCommitΪfalseʱü¼Ϊ䱻
+	*/
+	char *BeginWrite(unsigned int nLength);
+	CLStatus EndWrite(char *pRecord, bool bCommit);
+
+	/*
+	ºֻߵ
+	GetRecordֱһļ¼ؼ¼ĵַTryGetRecordûм¼ʱ0
+	صĵַڵReleaseRecord֮ǰЧÿֻܳһ¼
+	*/
+	char *GetRecord(unsigned int *pLength);
+	char *TryGetRecord(unsigned int *pLength);
+	void ReleaseRecord();
+
+	/*
+	д뵫δͷŵֽ߿ɾݴ˹ߵĸأ֤ȷ
+	*/
+	unsigned long GetPendingLength();
+
+private:
+	SLSharedMemoryRingRecord *ReserveRecord(unsigned int nLength, bool bWait);
+	bool WriteRecord(unsigned int nType, const char *pBuffer, unsigned int nLength, unsigned long lChainID, unsigned int nTotalLength, unsigned int nOffset, bool bWait);
+	char *AppendFragment(SLSharedMemoryRingRecord *pRecord, unsigned int *pLength);
+	void ReleaseSpace(unsigned long nSize);
+	CLStatus WakeupConsumer();
+
+private:
+	CLSharedMemoryRing(const CLSharedMemoryRing&);
+	CLSharedMemoryRing& operator=(const CLSharedMemoryRing&);
+
+private:
+	CLSharedMemory *m_pSharedMemory;
+	SLSharedMemoryRingHeader *m_pHeader;
+	char *m_pData;
+
+	CLEvent *m_pEvent;
+
+	unsigned long m_nSizeOfHeldRecord;
+	char *m_pHeldChainBuffer;
+	std::map<unsigned long, SLSharedMemoryRingChain> m_Chains;
+};
+
+#endif
@@ -1,10 +1,11 @@
 #ifndef CLSharedMsgQueueByNamedPipe_H
 #define CLSharedMsgQueueByNamedPipe_H
 
-#include <map>
 #include "CLMessageQueueByNamedPipe.h"
+#include "CLMessageIDTable.h"
 
 class CLMessageDeserializer;
+class CLZeroCopyMessageDeserializer;
 class CLMessage;
 
 class CLSharedMsgQueueByNamedPipe : public CLMessageQueueByNamedPipe
@@ -14,6 +15,7 @@ public:
 	virtual ~CLSharedMsgQueueByNamedPipe();
 
 	CLStatus RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer);
+	CLStatus RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer);
 
 protected:
 	virtual CLMessage *ReadMsgFromPipe(int fd);
@@ -23,7 +25,10 @@ private:
 	CLSharedMsgQueueByNamedPipe& operator=(const CLSharedMsgQueueByNamedPipe&);
 
 private:
-	map<unsigned long, CLMessageDeserializer*> m_DeserializerTable;
+	CLMessageIDTable<CLZeroCopyMessageDeserializer*> m_DeserializerTable;
+
+	//ΪPIPE_BUFϢֱӽлϢ֮ظʹ
+	char *m_pReadBuffer;
 };
 
-#endif
\ No newline at end of file
+#endif
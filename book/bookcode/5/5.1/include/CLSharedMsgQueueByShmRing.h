@@ -0,0 +1,43 @@
+#ifndef CLSharedMsgQueueByShmRing_H
+#define CLSharedMsgQueueByShmRing_H
+
+#include "CLStatus.h"
+#include "CLSharedMemoryRing.h"
+#include "CLMessageIDTable.h"
+
+class CLMessageDeserializer;
+class CLZeroCopyMessageDeserializer;
+class CLMessage;
+
+/*
+ϢѭһĹ洢ϢУлֱڻжȡϢٶ仺
+*/
+class CLSharedMsgQueueByShmRing
+{
+public:
+	explicit CLSharedMsgQueueByShmRing(const char *pstrQueueName);
+	virtual ~CLSharedMsgQueueByShmRing();
+
+	CLStatus RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer);
+	CLStatus RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer);
+
+	CLMessage *GetMessage();
+
+	/*
+	ֱһϢȻһȡnMaxCountϢȡϢ
+	*/
+	unsigned int GetMessages(CLMessage **ppMessages, unsigned int nMaxCount);
+
+private:
+	CLMessage *DeserializeRecord(char *pRecord, unsigned int nLength);
+
+private:
+	CLSharedMsgQueueByShmRing(const CLSharedMsgQueueByShmRing&);
+	CLSharedMsgQueueByShmRing& operator=(const CLSharedMsgQueueByShmRing&);
+
+private:
+	CLSharedMemoryRing m_Ring;
+	CLMessageIDTable<CLZeroCopyMessageDeserializer*> m_DeserializerTable;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define CLSharedObjectsImpl_H
 
 #include <string>
+#include <vector>
 #include "CLStatus.h"
 
 using namespace std;
@@ -12,9 +13,15 @@ using namespace std;
 #define INITIALIZED_SHARED_OBJECT 1
 #define ALLOCATED_SHARED_OBJECT 2
 
-#define NUMBER_OF_SHARED_OBJECT 1024
+#define NUMBER_OF_SHARED_OBJECT_PER_SEGMENT 1024
+#define MAX_NUMBER_OF_SHARED_OBJECT_SEGMENTS 64
+#define NUMBER_OF_SHARED_OBJECT (NUMBER_OF_SHARED_OBJECT_PER_SEGMENT * MAX_NUMBER_OF_SHARED_OBJECT_SEGMENTS)
+#define INITIAL_CAPACITY_OF_SHARED_OBJECT_INDEX 2048
 #define MAGIC_NUMBER_FOR_SHARED_OBJECT 0x12345678
 
+#define EMPTY_SHARED_OBJECT_INDEX_ENTRY (-1)
+#define DELETED_SHARED_OBJECT_INDEX_ENTRY (-2)
+
 class CLSharedMemory;
 
 struct SLSharedObjectHead
@@ -22,8 +29,48 @@ struct SLSharedObjectHead
 	int Status;
 	int RefCount;
 	char strSharedObjectName[LENGTH_OF_SHARED_OBJECT_NAME];
+	unsigned int Hash;
+	int NextFree;
+};
+
+/*
+λڵ0εʼ¼ѴĶεĿжԼǰĴ
+nIndexGenerationΪINITIAL_CAPACITY_OF_SHARED_OBJECT_INDEX << nIndexGeneration
+*/
+struct SLSharedObjectSpaceHead
+{
+	int MagicNumber;
+	int nSegments;
+	int nIndexGeneration;
+	int nFreeObjects[MAX_NUMBER_OF_SHARED_OBJECT_SEGMENTS];
+};
+
+struct SLSharedObjectSegmentHead
+{
+	int MagicNumber;
+	int FirstFree;
+};
+
+struct SLSharedObjectIndexHead
+{
+	int MagicNumber;
+	unsigned int nCapacity;
+	unsigned int nUsed;
+	unsigned int nLive;
 };
 
+struct SLSharedObjectIndexEntry
+{
+	unsigned int Hash;
+	int Object;
+};
+
+/*
+󰴶δţÿNUMBER_OF_SHARED_OBJECT_PER_SEGMENTþʱٴһΣΪκ * ÿζ + 
+ֵŵӳ䱣ڵĹ洢УΪŶַɢбװӳ1/2ʱؽʱһ
+ÿεʱ0μ¼Ķ½Ķκ
+кɵڽ̼以µ
+*/
 class CLSharedObjectsImpl
 {
 public:
@@ -39,15 +86,37 @@ public:
 	virtual CLStatus InitializeSharedObject(SLSharedObjectHead *pObject) = 0;
 	virtual CLStatus DestroySharedObject(SLSharedObjectHead *pObject) = 0;
 
+private:
+	bool AttachSegments();
+	bool AttachSegment(int nSegment, bool bInitialize);
+	void InitializeSegment(int nSegment);
+	bool AttachIndex(bool bRebuild);
+	void RebuildIndex();
+	void InsertIndex(unsigned int Hash, int nObject);
+	SLSharedObjectIndexEntry *FindIndex(const char *pstrSharedObjectName, unsigned int Hash);
+	int AllocateObject();
+	void FreeObject(int nObject);
+	SLSharedObjectHead *GetObjectHead(int nObject);
+	string GetNameOfSegment(int nSegment);
+	static unsigned int HashName(const char *pstrSharedObjectName);
+
 private:
 	CLSharedObjectsImpl(const CLSharedObjectsImpl&);
 	CLSharedObjectsImpl& operator=(const CLSharedObjectsImpl&);
 
 protected:
-	CLSharedMemory *m_pSharedMemory;
 	unsigned int m_nItemSize;
 	string m_strSharedSpaceName;
-	SLSharedObjectHead *m_pSharedObjects;
+
+private:
+	vector<CLSharedMemory *> m_Segments;
+	vector<char *> m_SegmentObjects;
+	SLSharedObjectSpaceHead *m_pSpaceHead;
+
+	CLSharedMemory *m_pIndexMemory;
+	int m_nIndexGeneration;
+	SLSharedObjectIndexHead *m_pIndexHead;
+	SLSharedObjectIndexEntry *m_pIndex;
 };
 
 #endif
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "CLStatus.h"
 #include "CLEvent.h"
 
+class CLThreadPlacement;
+
 /*
 CLThreadһ̣߳ڣ̵߳
 
@@ -17,12 +19,14 @@ WaitForDeath
 
 RunWaitForDeathسɹֻܵһΡ
 RunʧܣCLThreadˣRunֻܴһ¶
+
+pPlacementΪ0ʱָCPUϡNUMAڵջ̣߳캯ḴƸö
 */
 class CLThread : public CLExecutive
 {
 public:
 	explicit CLThread(CLExecutiveFunctionProvider *pExecutiveFunctionProvider);
-	CLThread(CLExecutiveFunctionProvider *pExecutiveFunctionProvider, bool bWaitForDeath);
+	CLThread(CLExecutiveFunctionProvider *pExecutiveFunctionProvider, bool bWaitForDeath, const CLThreadPlacement *pPlacement = 0);
 	virtual ~CLThread();
 
 	virtual CLStatus Run(void *pContext = 0);
@@ -31,6 +35,7 @@ public:
 
 private:
 	static void* StartFunctionOfThread(void *pContext);
+	int CreateThread();
 
 private:
 	void *m_pContext;
@@ -42,6 +47,10 @@ private:
 
 	bool m_bWaitForDeath;
 	bool m_bThreadCreated;
+
+	CLThreadPlacement *m_pPlacement;
+	void *m_pStack;
+	size_t m_nStackSize;
 };
 
 #endif
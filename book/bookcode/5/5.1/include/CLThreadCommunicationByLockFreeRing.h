@@ -0,0 +1,29 @@
+#ifndef CLThreadCommunicationByLockFreeRing_H
+#define CLThreadCommunicationByLockFreeRing_H
+
+#include "CLExecutiveCommunication.h"
+#include "CLStatus.h"
+
+class CLMessage;
+class CLMessageQueueByLockFreeRing;
+
+class CLThreadCommunicationByLockFreeRing : public CLExecutiveCommunication
+{
+public:
+	/*
+	pMsgQueueӶз䣬Ҳʾdelete
+	*/
+	CLThreadCommunicationByLockFreeRing(CLMessageQueueByLockFreeRing *pMsgQueue);
+	virtual ~CLThreadCommunicationByLockFreeRing();
+
+	virtual CLStatus PostExecutiveMessage(CLMessage *pMessage);
+
+private:
+	CLThreadCommunicationByLockFreeRing(const CLThreadCommunicationByLockFreeRing&);
+	CLThreadCommunicationByLockFreeRing& operator=(const CLThreadCommunicationByLockFreeRing&);
+
+private:
+	CLMessageQueueByLockFreeRing *m_pMsgQueue;
+};
+
+#endif
@@ -7,7 +7,10 @@
 class CLMessageObserver;
 class CLThread;
 class CLMsgLoopManagerForPipeQueue;
+class CLMsgLoopManagerForShmQueue;
 class CLMessageDeserializer;
+class CLZeroCopyMessageDeserializer;
+class CLThreadPlacement;
 
 /************************************************************************/
 /* CLThreadForMsgLoogķͷ⣬ʹ߸                     */
@@ -20,12 +23,15 @@ public:
 	/*
 	pMsgObserverӦӶз䣬ҲصdeletepstrThreadName߳ƱΨһ
 	ĬbWaitForDeathΪfalseΪtrueеȴ߳
+	nQueueCapacityOverflowPolicyEXECUTIVE_IN_PROCESS_USE_STL_QUEUEЧĬΪ޽
+	pPlacement̵ָ߳CPUNUMAڵջCLThreadPlacementָNUMAڵʱζҲڸýڵ
 	*/
-	CLThreadForMsgLoop(CLMessageObserver *pMsgObserver, const char *pstrThreadName, bool bWaitForDeath = false, int ExecutiveType = EXECUTIVE_IN_PROCESS_USE_STL_QUEUE);
+	CLThreadForMsgLoop(CLMessageObserver *pMsgObserver, const char *pstrThreadName, bool bWaitForDeath = false, int ExecutiveType = EXECUTIVE_IN_PROCESS_USE_STL_QUEUE, unsigned long nQueueCapacity = MESSAGE_QUEUE_UNBOUNDED, int OverflowPolicy = MESSAGE_QUEUE_OVERFLOW_BLOCK, const CLThreadPlacement *pPlacement = 0);
 
 	virtual ~CLThreadForMsgLoop();
 
 	CLStatus RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer);
+	CLStatus RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer);
 
 	/*
 	Run۷ȷֻɵһΡ
@@ -41,6 +47,7 @@ private:
 	bool m_bWaitForDeath;
 
 	CLMsgLoopManagerForPipeQueue *m_pPipeQueue;
+	CLMsgLoopManagerForShmQueue *m_pShmQueue;
 };
 
 #endif
\ No newline at end of file
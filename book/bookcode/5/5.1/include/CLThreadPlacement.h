@@ -0,0 +1,73 @@
+#ifndef CLThreadPlacement_H
+#define CLThreadPlacement_H
+
+#include <sched.h>
+#include <pthread.h>
+#include <stddef.h>
+#include "CLStatus.h"
+
+#define SIZE_OF_HUGE_PAGE (2 * 1024 * 1024)
+
+/*
+̵߳ķ÷ʽеCPUϡڴڵNUMAڵ㡢ջСԼǷôҳΪջ
+CLThreadCLThreadForMsgLoopĹ캯Ը
+ֻNUMAڵʱ߳̿ڸýڵȫCPUϣ̴߳˺ڴԸýڵ
+NUMAعֱʹϵͳãlibnumaûNUMAϵͳֻнڵ0
+*/
+class CLThreadPlacement
+{
+public:
+	CLThreadPlacement();
+	virtual ~CLThreadPlacement();
+
+	CLStatus AddCPU(int nCPU);
+	CLStatus SetNUMANode(int nNode);
+
+	/*
+	nStackSizeΪ0ʱʹϵͳĬϵջС
+	ҳջֻbWaitForDeathΪtrue߳ЧջСȡSIZE_OF_HUGE_PAGE
+	ϵͳûԤҳʱ˶ʹ͸ҳ
+	*/
+	CLStatus SetStackSize(size_t nStackSize);
+	void UseHugePageStack(bool bHugePageStack);
+
+	int GetNUMANode();
+	bool IsHugePageStackUsed();
+
+	/*
+	CLThreadʹãRun֮ǰ߳ԣppStackҪ߳̽FreeStackͷŵջΪ0
+	߳̿ʼʱApplyToCurrentThread
+	*/
+	CLStatus SetThreadAttributes(pthread_attr_t *pAttr, bool bCanAllocateStack, void **ppStack, size_t *pnStackSize);
+	CLStatus ApplyToCurrentThread();
+
+public:
+	static int GetNumberOfNUMANodes();
+	static CLStatus GetCPUsOfNUMANode(int nNode, cpu_set_t *pCPUSet);
+	static int GetNUMANodeOfCPU(int nCPU);
+
+	/*
+	صǰ߳ͨCLThreadPlacementָNUMAڵ㣬δָʱ-1
+	Ϣѭݴ˰ϢзŵڵĽڵ
+	*/
+	static int GetNUMANodeOfCurrentThread();
+
+	/*
+	[p, p + nSize)ڵҳȷnNodeϣѷҳᱻǨ
+	*/
+	static CLStatus BindMemoryToNUMANode(void *p, size_t nSize, int nNode);
+
+	static void FreeStack(void *pStack, size_t nStackSize);
+
+private:
+	static void *AllocateHugePageStack(size_t nStackSize);
+
+private:
+	cpu_set_t m_CPUSet;
+	bool m_bUseCPUSet;
+	int m_nNUMANode;
+	size_t m_nStackSize;
+	bool m_bHugePageStack;
+};
+
+#endif
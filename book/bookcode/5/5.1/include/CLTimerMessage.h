@@ -0,0 +1,26 @@
+#ifndef CLTimerMessage_H
+#define CLTimerMessage_H
+
+#include "CLPooledMessage.h"
+
+/*
+ʱʱϢѭϢϢIDΪöʱʱָID
+m_nExpirationsΪϢĵڴڶʱϢѭæʱܴ1
+*/
+class CLTimerMessage : public CLPooledMessage
+{
+public:
+	CLTimerMessage(unsigned long lMsgID, unsigned long nTimerID, void *pContext, unsigned long nExpirations);
+	virtual ~CLTimerMessage();
+
+public:
+	unsigned long m_nTimerID;
+	void *m_pContext;
+	unsigned long m_nExpirations;
+
+private:
+	CLTimerMessage(const CLTimerMessage&);
+	CLTimerMessage& operator=(const CLTimerMessage&);
+};
+
+#endif
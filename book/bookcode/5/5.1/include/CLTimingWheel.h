@@ -0,0 +1,104 @@
+#ifndef CLTimingWheel_H
+#define CLTimingWheel_H
+
+#include <vector>
+
+#define NUMBER_OF_TIMING_WHEEL_LEVELS 4
+#define BITS_OF_TIMING_WHEEL_SLOTS 8
+#define NUMBER_OF_TIMING_WHEEL_SLOTS (1 << BITS_OF_TIMING_WHEEL_SLOTS)
+#define MASK_OF_TIMING_WHEEL_SLOTS (NUMBER_OF_TIMING_WHEEL_SLOTS - 1)
+#define WORDS_OF_TIMING_WHEEL_BITMAP (NUMBER_OF_TIMING_WHEEL_SLOTS / 64)
+
+//÷ΧԼ49죩ӳٱض
+#define MAX_DELAY_OF_TIMING_WHEEL 0xffffffffUL
+
+#define BITS_OF_TIMER_INDEX 24
+#define MAX_NUMBER_OF_TIMERS (1 << BITS_OF_TIMER_INDEX)
+
+//Ĳ֮ѵ
+#define EXPIRED_LIST_OF_TIMING_WHEEL (NUMBER_OF_TIMING_WHEEL_LEVELS * NUMBER_OF_TIMING_WHEEL_SLOTS)
+#define NUMBER_OF_TIMING_WHEEL_LISTS (EXPIRED_LIST_OF_TIMING_WHEEL + 1)
+
+struct SLTimingWheelTimer
+{
+	unsigned long nTimerID;
+	int Prev;
+	int Next;
+	int List;
+	unsigned long long nExpire;
+	unsigned long lIntervalMs;
+	unsigned long lMsgID;
+	void *pContext;
+	int nTarget;
+};
+
+struct SLExpiredTimer
+{
+	unsigned long nTimerID;
+	unsigned long lMsgID;
+	void *pContext;
+	int nTarget;
+	unsigned long nExpirations;
+};
+
+/*
+ֲʱ֣ʱ䵥λΪ룬4㣬ÿ256ۣkÿۿΪ256^k
+ʱУ±˫ȡΪO(1)ǰ౻3
+ʱIDĵ24λΪ±꣬λΪ±걻õĴȡѵڻȡĶʱǰȫ
+಻̰߳ȫģֻӦһϢѭʹ
+*/
+class CLTimingWheel
+{
+public:
+	explicit CLTimingWheel(unsigned long long nNow);
+	virtual ~CLTimingWheel();
+
+	/*
+	lIntervalMsΪ0ʱΪһԶʱضʱIDʧʱ0
+	*/
+	unsigned long AddTimer(unsigned long long nNow, unsigned long lDelayMs, unsigned long lIntervalMs, unsigned long lMsgID, void *pContext, int nTarget);
+	bool CancelTimer(unsigned long nTimerID);
+
+	/*
+	ʱƽnNowڵĶʱѵPopExpiredTimerȡ
+	ڶʱȡʱ¼ʱ֣һԶʱȡ󼴱ͷ
+	*/
+	void Advance(unsigned long long nNow);
+	bool PopExpiredTimer(SLExpiredTimer *pExpiredTimer);
+
+	/*
+	ؾһҪAdvanceĺûжʱʱ-1
+	ᳬǰ0ʣĲ˵ȴڼ䲻ϲ㶨ʱ
+	*/
+	long GetTimeout(unsigned long long nNow);
+
+	unsigned int GetNumberOfTimers();
+
+	static unsigned long long GetCurrentTime();
+
+private:
+	void Insert(int nIndex);
+	void LinkTimer(int nIndex, int List);
+	void UnlinkTimer(int nIndex);
+	void Cascade(int nLevel);
+	void FreeTimer(int nIndex);
+
+private:
+	CLTimingWheel(const CLTimingWheel&);
+	CLTimingWheel& operator=(const CLTimingWheel&);
+
+private:
+	std::vector<SLTimingWheelTimer> m_Timers;
+	int m_nFreeTimer;
+
+	int m_Heads[NUMBER_OF_TIMING_WHEEL_LISTS];
+	int m_nExpiredTail;
+	unsigned long long m_Bitmap[WORDS_OF_TIMING_WHEEL_BITMAP];
+
+	//һʱ
+	unsigned long long m_nCurrent;
+	unsigned int m_nTimersInWheel;
+	unsigned int m_nTimers;
+};
+
+#endif
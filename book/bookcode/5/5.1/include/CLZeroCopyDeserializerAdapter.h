@@ -0,0 +1,28 @@
+#ifndef CLZeroCopyDeserializerAdapter_H
+#define CLZeroCopyDeserializerAdapter_H
+
+#include "CLZeroCopyMessageDeserializer.h"
+
+class CLMessageDeserializer;
+
+/*
+ʹеCLMessageDeserializerCLZeroCopyMessageDeserializerλ
+pDeserializerӦӶз䣬ɸฺɾ
+*/
+class CLZeroCopyDeserializerAdapter : public CLZeroCopyMessageDeserializer
+{
+public:
+	explicit CLZeroCopyDeserializerAdapter(CLMessageDeserializer *pDeserializer);
+	virtual ~CLZeroCopyDeserializerAdapter();
+
+	virtual CLMessage *Deserialize(const char *pBuffer, unsigned int nLength);
+
+private:
+	CLZeroCopyDeserializerAdapter(const CLZeroCopyDeserializerAdapter&);
+	CLZeroCopyDeserializerAdapter& operator=(const CLZeroCopyDeserializerAdapter&);
+
+private:
+	CLMessageDeserializer *m_pDeserializer;
+};
+
+#endif
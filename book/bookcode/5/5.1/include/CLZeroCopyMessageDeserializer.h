@@ -0,0 +1,22 @@
+#ifndef CLZeroCopyMessageDeserializer_H
+#define CLZeroCopyMessageDeserializer_H
+
+class CLMessage;
+
+/*
+pBufferɵ߳УֻDeserializeǰЧ繲洢еļ¼ܱ
+*/
+class CLZeroCopyMessageDeserializer
+{
+public:
+	CLZeroCopyMessageDeserializer();
+	virtual ~CLZeroCopyMessageDeserializer();
+
+	virtual CLMessage *Deserialize(const char *pBuffer, unsigned int nLength) = 0;
+
+private:
+	CLZeroCopyMessageDeserializer(const CLZeroCopyMessageDeserializer&);
+	CLZeroCopyMessageDeserializer& operator=(const CLZeroCopyMessageDeserializer&);
+};
+
+#endif
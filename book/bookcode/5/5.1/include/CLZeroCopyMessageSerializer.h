@@ -0,0 +1,27 @@
+#ifndef CLZeroCopyMessageSerializer_H
+#define CLZeroCopyMessageSerializer_H
+
+#include "CLStatus.h"
+
+class CLMessage;
+class CLSerializeCursor;
+
+/*
+CLMessageSerializerͬлĽֱдṩCLSerializeCursor
+ͨGetSerializedLengthõȲ׼λãȻͬһϢSerialize
+*/
+class CLZeroCopyMessageSerializer
+{
+public:
+	CLZeroCopyMessageSerializer();
+	virtual ~CLZeroCopyMessageSerializer();
+
+	virtual unsigned int GetSerializedLength(CLMessage *pMsg) = 0;
+	virtual CLStatus Serialize(CLMessage *pMsg, CLSerializeCursor *pCursor) = 0;
+
+private:
+	CLZeroCopyMessageSerializer(const CLZeroCopyMessageSerializer&);
+	CLZeroCopyMessageSerializer& operator=(const CLZeroCopyMessageSerializer&);
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef CLZeroCopySerializerAdapter_H
+#define CLZeroCopySerializerAdapter_H
+
+#include "CLZeroCopyMessageSerializer.h"
+
+class CLMessageSerializer;
+
+/*
+ʹеCLMessageSerializerCLZeroCopyMessageSerializerλ
+GetSerializedLengthԭлֲ߳̾ĻУ
+߳ͬһϢSerializeʱ临ƵλúͷţÿϢֻлһ
+뵥εص״̬߳̿ͬʱʹͬһ
+pSerializerӦӶз䣬ɸฺɾ
+*/
+class CLZeroCopySerializerAdapter : public CLZeroCopyMessageSerializer
+{
+public:
+	explicit CLZeroCopySerializerAdapter(CLMessageSerializer *pSerializer);
+	virtual ~CLZeroCopySerializerAdapter();
+
+	virtual unsigned int GetSerializedLength(CLMessage *pMsg);
+	virtual CLStatus Serialize(CLMessage *pMsg, CLSerializeCursor *pCursor);
+
+private:
+	CLZeroCopySerializerAdapter(const CLZeroCopySerializerAdapter&);
+	CLZeroCopySerializerAdapter& operator=(const CLZeroCopySerializerAdapter&);
+
+private:
+	CLMessageSerializer *m_pSerializer;
+};
+
+#endif
@@ -8,14 +8,36 @@
 #include "CLConditionVariable.h"
 #include "CLEvent.h"
 #include "CLThread.h"
+#include "CLThreadPlacement.h"
 #include "CLExecutiveFunctionForMsgLoop.h"
 #include "CLMsgLoopManagerForSTLqueue.h"
 #include "CLMessageQueueBySTLqueue.h"
 #include "CLThreadCommunicationBySTLqueue.h"
+#include "CLMsgLoopManagerForLockFreeRing.h"
+#include "CLMessageQueueByLockFreeRing.h"
+#include "CLThreadCommunicationByLockFreeRing.h"
+#include "CLMsgLoopManagerForEpoll.h"
 #include "CLThreadInitialFinishedNotifier.h"
 #include "CLMessage.h"
+#include "CLPooledMessage.h"
+#include "CLMessagePool.h"
 #include "CLMessageObserver.h"
+#include "CLMessageIDTable.h"
+#include "CLTimingWheel.h"
+#include "CLTimerMessage.h"
+#include "CLRelaxedAtomic.h"
+#include "CLLatencyHistogram.h"
+#include "CLExecutiveMetrics.h"
+#include "CLMetricsExporter.h"
+#include "CLRequestMessage.h"
+#include "CLResponseMessage.h"
+#include "CLPendingRequestTable.h"
+#include "CLCoroutine.h"
+#include "CLCoroutineMessage.h"
+#include "CLCoroutineExecutive.h"
+#include "CLCoroutineScheduler.h"
 #include "CLExecutiveNameServer.h"
+#include "CLExecutiveHandle.h"
 #include "CLThreadForMsgLoop.h"
 #include "CLNonThreadForMsgLoop.h"
 #include "CLLibExecutiveInitializer.h"
@@ -24,6 +46,8 @@
 #include "CLMutexByRecordLockingAndPThread.h"
 #include "CLMutexBySharedPThread.h"
 #include "CLSharedMemory.h"
+#include "CLSharedMemoryBySysV.h"
+#include "CLSharedMemoryByMmap.h"
 #include "CLSharedObjectsImpl.h"
 #include "CLSharedMutexAllocator.h"
 #include "CLSharedConditionVariableAllocator.h"
@@ -34,8 +58,34 @@
 #include "CLMessageDeserializer.h"
 #include "CLMsgLoopManagerForPipeQueue.h"
 #include "CLMessageSerializer.h"
+#include "CLSerializeCursor.h"
+#include "CLZeroCopyMessageSerializer.h"
+#include "CLZeroCopyMessageDeserializer.h"
+#include "CLZeroCopySerializerAdapter.h"
+#include "CLZeroCopyDeserializerAdapter.h"
+#include "CLMessageIDSerializer.h"
+#include "CLMessageIDDeserializer.h"
 #include "CLExecutiveCommunicationByNamedPipe.h"
 #include "CLPrivateExecutiveCommunicationByNamedPipe.h"
 #include "CLSharedExecutiveCommunicationByNamedPipe.h"
+#include "CLSharedMemoryRing.h"
+#include "CLSharedMsgQueueByShmRing.h"
+#include "CLMsgLoopManagerForShmQueue.h"
+#include "CLSharedExecutiveCommunicationByShmRing.h"
+#include "CLMessageQueueByWorkStealing.h"
+#include "CLMsgLoopManagerForWorkStealing.h"
+#include "CLExecutiveCommunicationByWorkStealing.h"
+#include "CLExecutivePool.h"
+#include "CLProcessInitialFinishedNotifier.h"
+#include "CLMsgLoopManagerForProcessPool.h"
+#include "CLExecutiveCommunicationByProcessPool.h"
+#include "CLProcessPool.h"
+#include "CLMapReduceHashTable.h"
+#include "CLMapReduceMapper.h"
+#include "CLMapReduceEmitter.h"
+#include "CLMapReduceBatchMessage.h"
+#include "CLMapReduceReducer.h"
+#include "CLMapReduceMapperFunction.h"
+#include "CLMapReduceJob.h"
 
 #endif
\ No newline at end of file
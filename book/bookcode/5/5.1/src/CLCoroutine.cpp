@@ -0,0 +1,98 @@
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "CLCoroutine.h"
+#include "CLLogger.h"
+
+CLCoroutine::CLCoroutine(unsigned long nStackSize)
+{
+	unsigned long nPageSize = sysconf(_SC_PAGESIZE);
+
+	if(nStackSize == 0)
+		throw "In CLCoroutine::CLCoroutine(), nStackSize error";
+
+	nStackSize = (nStackSize + nPageSize - 1) / nPageSize * nPageSize;
+	m_nMappedSize = nStackSize + nPageSize;
+
+	m_pStack = mmap(0, m_nMappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(m_pStack == MAP_FAILED)
+	{
+		CLLogger::WriteLogMsg("In CLCoroutine::CLCoroutine(), mmap error", errno);
+		throw "In CLCoroutine::CLCoroutine(), mmap error";
+	}
+
+	//ջ͵ַ͵һҳΪҳ
+	if(mprotect(m_pStack, nPageSize, PROT_NONE) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLCoroutine::CLCoroutine(), mprotect error", errno);
+		munmap(m_pStack, m_nMappedSize);
+		throw "In CLCoroutine::CLCoroutine(), mprotect error";
+	}
+
+	if(getcontext(&m_Context) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLCoroutine::CLCoroutine(), getcontext error", errno);
+		munmap(m_pStack, m_nMappedSize);
+		throw "In CLCoroutine::CLCoroutine(), getcontext error";
+	}
+
+	m_Context.uc_stack.ss_sp = (char *)m_pStack + nPageSize;
+	m_Context.uc_stack.ss_size = nStackSize;
+	m_Context.uc_link = &m_CallerContext;
+
+	//makecontextֻܴintthisָ뱻ɸߵ
+	unsigned long long p = (unsigned long long)(unsigned long)this;
+	makecontext(&m_Context, (void (*)())(&CLCoroutine::EntryPoint), 2, (unsigned int)(p >> 32), (unsigned int)(p & 0xffffffffULL));
+
+	m_bRunning = false;
+	m_bFinished = false;
+}
+
+CLCoroutine::~CLCoroutine()
+{
+	munmap(m_pStack, m_nMappedSize);
+}
+
+void CLCoroutine::EntryPoint(unsigned int nHigh, unsigned int nLow)
+{
+	CLCoroutine *pCoroutine = (CLCoroutine *)(unsigned long)(((unsigned long long)nHigh << 32) | nLow);
+
+	pCoroutine->RunCoroutine();
+
+	//غuc_linkлһεResume
+	pCoroutine->m_bFinished = true;
+	pCoroutine->m_bRunning = false;
+}
+
+CLStatus CLCoroutine::Resume()
+{
+	if(m_bRunning || m_bFinished)
+		return CLStatus(-1, 0);
+
+	m_bRunning = true;
+
+	if(swapcontext(&m_CallerContext, &m_Context) == -1)
+	{
+		m_bRunning = false;
+		CLLogger::WriteLogMsg("In CLCoroutine::Resume(), swapcontext error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	return CLStatus(0, 0);
+}
+
+void CLCoroutine::Yield()
+{
+	if(!m_bRunning)
+		return;
+
+	m_bRunning = false;
+
+	if(swapcontext(&m_Context, &m_CallerContext) == -1)
+		CLLogger::WriteLogMsg("In CLCoroutine::Yield(), swapcontext error", errno);
+}
+
+bool CLCoroutine::IsFinished()
+{
+	return m_bFinished;
+}
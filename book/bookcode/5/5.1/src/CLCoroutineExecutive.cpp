@@ -0,0 +1,57 @@
+#include "CLCoroutineExecutive.h"
+#include "CLCoroutineScheduler.h"
+#include "CLMessage.h"
+#include "CLLogger.h"
+
+CLCoroutineExecutive::CLCoroutineExecutive(unsigned long nStackSize) : CLCoroutine(nStackSize)
+{
+	m_pScheduler = 0;
+	m_nCoroutineID = 0;
+	m_pContext = 0;
+
+	m_nWaitFor = 0;
+	m_lWaitMsgID = 0;
+	m_nTimerID = 0;
+	m_pResult = 0;
+	m_pCurrentMessage = 0;
+}
+
+CLCoroutineExecutive::~CLCoroutineExecutive()
+{
+	delete m_pCurrentMessage;
+
+	for(unsigned int i = 0; i < m_Mailbox.size(); i++)
+		delete m_Mailbox[i];
+}
+
+unsigned long CLCoroutineExecutive::GetCoroutineID()
+{
+	return m_nCoroutineID;
+}
+
+void CLCoroutineExecutive::RunCoroutine()
+{
+	CLStatus s = RunExecutiveFunction(m_pContext);
+	if(!s.IsSuccess())
+		CLLogger::WriteLogMsg("In CLCoroutineExecutive::RunCoroutine(), RunExecutiveFunction error", 0);
+}
+
+CLMessage *CLCoroutineExecutive::WaitForMessage(unsigned long lMsgID, long lTimeoutMs)
+{
+	return m_pScheduler->WaitForMessage(this, true, lMsgID, lTimeoutMs);
+}
+
+CLMessage *CLCoroutineExecutive::WaitForAnyMessage(long lTimeoutMs)
+{
+	return m_pScheduler->WaitForMessage(this, false, 0, lTimeoutMs);
+}
+
+CLResponseMessage *CLCoroutineExecutive::SendRequestAndWait(const char *pstrExecutiveName, CLRequestMessage *pRequest, unsigned long lTimeoutMs)
+{
+	return m_pScheduler->SendRequestAndWait(this, pstrExecutiveName, pRequest, lTimeoutMs);
+}
+
+CLStatus CLCoroutineExecutive::Sleep(unsigned long lMs)
+{
+	return m_pScheduler->Sleep(this, lMs);
+}
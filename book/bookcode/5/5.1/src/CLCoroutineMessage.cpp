@@ -0,0 +1,24 @@
+#include "CLCoroutineMessage.h"
+#include "CLCoroutineExecutive.h"
+
+CLCoroutineMessage::CLCoroutineMessage(unsigned long nCoroutineID, CLMessage *pMessage) : CLMessage(COROUTINE_SCHEDULER_DELIVER_ID)
+{
+	m_nCoroutineID = nCoroutineID;
+	m_pMessage = pMessage;
+	m_pCoroutine = 0;
+	m_pContext = 0;
+}
+
+CLCoroutineMessage::CLCoroutineMessage(unsigned long nCoroutineID, CLCoroutineExecutive *pCoroutine, void *pContext) : CLMessage(COROUTINE_SCHEDULER_SPAWN_ID)
+{
+	m_nCoroutineID = nCoroutineID;
+	m_pMessage = 0;
+	m_pCoroutine = pCoroutine;
+	m_pContext = pContext;
+}
+
+CLCoroutineMessage::~CLCoroutineMessage()
+{
+	delete m_pMessage;
+	delete m_pCoroutine;
+}
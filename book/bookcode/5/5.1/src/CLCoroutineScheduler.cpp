@@ -0,0 +1,251 @@
+#include "CLCoroutineScheduler.h"
+#include "CLCoroutineExecutive.h"
+#include "CLMessageLoopManager.h"
+#include "CLExecutiveNameServer.h"
+#include "CLTimerMessage.h"
+#include "CLRequestMessage.h"
+#include "CLResponseMessage.h"
+#include "CLLogger.h"
+
+#define COROUTINE_WAIT_FOR_NOTHING 0
+#define COROUTINE_WAIT_FOR_MESSAGE 1
+#define COROUTINE_WAIT_FOR_ANY_MESSAGE 2
+#define COROUTINE_WAIT_FOR_RESPONSE 3
+#define COROUTINE_WAIT_FOR_TIMER 4
+
+CLCoroutineScheduler::CLCoroutineScheduler()
+{
+	m_pMessageLoop = 0;
+}
+
+CLCoroutineScheduler::~CLCoroutineScheduler()
+{
+	std::map<unsigned long, CLCoroutineExecutive*>::iterator it;
+	for(it = m_Coroutines.begin(); it != m_Coroutines.end(); ++it)
+		delete it->second;
+}
+
+CLStatus CLCoroutineScheduler::Initialize(CLMessageLoopManager *pMessageLoop, void*)
+{
+	m_pMessageLoop = pMessageLoop;
+
+	pMessageLoop->Register(COROUTINE_SCHEDULER_SPAWN_ID, (CallBackForMessageLoop)(&CLCoroutineScheduler::On_Spawn));
+	pMessageLoop->Register(COROUTINE_SCHEDULER_DELIVER_ID, (CallBackForMessageLoop)(&CLCoroutineScheduler::On_Deliver));
+	pMessageLoop->Register(COROUTINE_SCHEDULER_TIMER_ID, (CallBackForMessageLoop)(&CLCoroutineScheduler::On_Timer));
+	pMessageLoop->Register(COROUTINE_SCHEDULER_QUIT_ID, (CallBackForMessageLoop)(&CLCoroutineScheduler::On_Quit));
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLCoroutineScheduler::Spawn(const char *pstrSchedulerName, unsigned long nCoroutineID, CLCoroutineExecutive *pCoroutine, void *pContext)
+{
+	if(pCoroutine == 0)
+		return CLStatus(-1, 0);
+
+	return CLExecutiveNameServer::PostExecutiveMessage(pstrSchedulerName, new CLCoroutineMessage(nCoroutineID, pCoroutine, pContext));
+}
+
+CLStatus CLCoroutineScheduler::PostCoroutineMessage(const char *pstrSchedulerName, unsigned long nCoroutineID, CLMessage *pMessage)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	return CLExecutiveNameServer::PostExecutiveMessage(pstrSchedulerName, new CLCoroutineMessage(nCoroutineID, pMessage));
+}
+
+unsigned int CLCoroutineScheduler::GetNumberOfCoroutines()
+{
+	return m_Coroutines.size();
+}
+
+CLStatus CLCoroutineScheduler::On_Spawn(CLMessage *pm)
+{
+	CLCoroutineMessage *pMsg = (CLCoroutineMessage *)pm;
+
+	if(FindCoroutine(pMsg->m_nCoroutineID) != 0)
+	{
+		CLLogger::WriteLogMsg("In CLCoroutineScheduler::On_Spawn(), coroutine ID already exists", 0);
+		return CLStatus(-1, 0);
+	}
+
+	CLCoroutineExecutive *pCoroutine = pMsg->m_pCoroutine;
+	pMsg->m_pCoroutine = 0;
+
+	pCoroutine->m_pScheduler = this;
+	pCoroutine->m_nCoroutineID = pMsg->m_nCoroutineID;
+	pCoroutine->m_pContext = pMsg->m_pContext;
+
+	m_Coroutines[pMsg->m_nCoroutineID] = pCoroutine;
+
+	//еһεȴΪֹ
+	Resume(pCoroutine, 0);
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLCoroutineScheduler::On_Deliver(CLMessage *pm)
+{
+	CLCoroutineMessage *pMsg = (CLCoroutineMessage *)pm;
+
+	CLCoroutineExecutive *pCoroutine = FindCoroutine(pMsg->m_nCoroutineID);
+	if(pCoroutine == 0)
+	{
+		CLLogger::WriteLogMsg("In CLCoroutineScheduler::On_Deliver(), coroutine not found", 0);
+		return CLStatus(-1, 0);
+	}
+
+	CLMessage *pMessage = pMsg->m_pMessage;
+	pMsg->m_pMessage = 0;
+
+	if((pCoroutine->m_nWaitFor == COROUTINE_WAIT_FOR_ANY_MESSAGE) || ((pCoroutine->m_nWaitFor == COROUTINE_WAIT_FOR_MESSAGE) && (pCoroutine->m_lWaitMsgID == pMessage->m_clMsgID)))
+		Resume(pCoroutine, pMessage);
+	else
+		pCoroutine->m_Mailbox.push_back(pMessage);
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLCoroutineScheduler::On_Timer(CLMessage *pm)
+{
+	CLTimerMessage *pTimer = (CLTimerMessage *)pm;
+
+	CLCoroutineExecutive *pCoroutine = FindCoroutine((unsigned long)pTimer->m_pContext);
+	if((pCoroutine == 0) || (pCoroutine->m_nTimerID != pTimer->m_nTimerID))
+		return CLStatus(0, 0);
+
+	//һԶʱںѾʧЧKillTimer
+	pCoroutine->m_nTimerID = 0;
+
+	Resume(pCoroutine, 0);
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLCoroutineScheduler::On_Quit(CLMessage *)
+{
+	return CLStatus(QUIT_MESSAGE_LOOP, 0);
+}
+
+CLStatus CLCoroutineScheduler::On_Response(CLResponseMessage *pResponse, void *pContext)
+{
+	CLCoroutineExecutive *pCoroutine = FindCoroutine((unsigned long)pContext);
+	if((pCoroutine == 0) || (pCoroutine->m_nWaitFor != COROUTINE_WAIT_FOR_RESPONSE))
+		return CLStatus(0, 0);
+
+	//ӦڱغϢѭͷţЭִһεȴ֮
+	Resume(pCoroutine, pResponse);
+
+	return CLStatus(0, 0);
+}
+
+CLMessage *CLCoroutineScheduler::WaitForMessage(CLCoroutineExecutive *pCoroutine, bool bMatchID, unsigned long lMsgID, long lTimeoutMs)
+{
+	delete pCoroutine->m_pCurrentMessage;
+	pCoroutine->m_pCurrentMessage = 0;
+
+	std::deque<CLMessage*>& Mailbox = pCoroutine->m_Mailbox;
+	for(unsigned int i = 0; i < Mailbox.size(); i++)
+	{
+		if((!bMatchID) || (Mailbox[i]->m_clMsgID == lMsgID))
+		{
+			pCoroutine->m_pCurrentMessage = Mailbox[i];
+			Mailbox.erase(Mailbox.begin() + i);
+			return pCoroutine->m_pCurrentMessage;
+		}
+	}
+
+	if(lTimeoutMs == 0)
+		return 0;
+
+	pCoroutine->m_lWaitMsgID = lMsgID;
+
+	pCoroutine->m_pCurrentMessage = Suspend(pCoroutine, bMatchID ? COROUTINE_WAIT_FOR_MESSAGE : COROUTINE_WAIT_FOR_ANY_MESSAGE, lTimeoutMs);
+
+	return pCoroutine->m_pCurrentMessage;
+}
+
+CLResponseMessage *CLCoroutineScheduler::SendRequestAndWait(CLCoroutineExecutive *pCoroutine, const char *pstrExecutiveName, CLRequestMessage *pRequest, unsigned long lTimeoutMs)
+{
+	delete pCoroutine->m_pCurrentMessage;
+	pCoroutine->m_pCurrentMessage = 0;
+
+	//ʱϢѭʱOn_ResponseյpResponseΪ0
+	unsigned long nRequestID = m_pMessageLoop->SendRequest(pstrExecutiveName, pRequest, (CallBackForResponse)(&CLCoroutineScheduler::On_Response), lTimeoutMs, (void *)pCoroutine->m_nCoroutineID);
+	if(nRequestID == 0)
+		return 0;
+
+	return (CLResponseMessage *)Suspend(pCoroutine, COROUTINE_WAIT_FOR_RESPONSE, -1);
+}
+
+CLStatus CLCoroutineScheduler::Sleep(CLCoroutineExecutive *pCoroutine, unsigned long lMs)
+{
+	delete pCoroutine->m_pCurrentMessage;
+	pCoroutine->m_pCurrentMessage = 0;
+
+	if(lMs == 0)
+		return CLStatus(0, 0);
+
+	unsigned long nTimerID = m_pMessageLoop->SetTimer(COROUTINE_SCHEDULER_TIMER_ID, lMs, 0, (void *)pCoroutine->m_nCoroutineID);
+	if(nTimerID == 0)
+		return CLStatus(-1, 0);
+
+	pCoroutine->m_nTimerID = nTimerID;
+
+	Suspend(pCoroutine, COROUTINE_WAIT_FOR_TIMER, -1);
+
+	return CLStatus(0, 0);
+}
+
+CLMessage *CLCoroutineScheduler::Suspend(CLCoroutineExecutive *pCoroutine, int nWaitFor, long lTimeoutMs)
+{
+	if(lTimeoutMs > 0)
+	{
+		unsigned long nTimerID = m_pMessageLoop->SetTimer(COROUTINE_SCHEDULER_TIMER_ID, lTimeoutMs, 0, (void *)pCoroutine->m_nCoroutineID);
+		if(nTimerID == 0)
+			return 0;
+
+		pCoroutine->m_nTimerID = nTimerID;
+	}
+
+	pCoroutine->m_nWaitFor = nWaitFor;
+	pCoroutine->m_pResult = 0;
+
+	pCoroutine->Yield();
+
+	//Ϣʱʱʱδ
+	if(pCoroutine->m_nTimerID != 0)
+	{
+		m_pMessageLoop->KillTimer(pCoroutine->m_nTimerID);
+		pCoroutine->m_nTimerID = 0;
+	}
+
+	CLMessage *pResult = pCoroutine->m_pResult;
+	pCoroutine->m_pResult = 0;
+
+	return pResult;
+}
+
+void CLCoroutineScheduler::Resume(CLCoroutineExecutive *pCoroutine, CLMessage *pResult)
+{
+	pCoroutine->m_nWaitFor = COROUTINE_WAIT_FOR_NOTHING;
+	pCoroutine->m_pResult = pResult;
+
+	CLStatus s = pCoroutine->Resume();
+	if(!s.IsSuccess())
+		CLLogger::WriteLogMsg("In CLCoroutineScheduler::Resume(), pCoroutine->Resume error", 0);
+
+	if(pCoroutine->IsFinished())
+	{
+		m_Coroutines.erase(pCoroutine->m_nCoroutineID);
+		delete pCoroutine;
+	}
+}
+
+CLCoroutineExecutive *CLCoroutineScheduler::FindCoroutine(unsigned long nCoroutineID)
+{
+	std::map<unsigned long, CLCoroutineExecutive*>::iterator it = m_Coroutines.find(nCoroutineID);
+	if(it == m_Coroutines.end())
+		return 0;
+
+	return it->second;
+}
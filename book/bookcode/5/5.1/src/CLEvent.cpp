@@ -1,5 +1,9 @@
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 #include "CLEvent.h"
-#include "CLCriticalSection.h"
 #include "CLLogger.h"
 #include "CLSharedEventImpl.h"
 #include "CLSharedEventAllocator.h"
@@ -10,8 +14,10 @@ CLEvent::CLEvent()
 
 	m_pEventInfo->bSemaphore = 0;
 	m_pEventInfo->Flag = 0;
+	m_pEventInfo->Waiters = 0;
 	m_pEventInfo->Context = 0;
 
+	m_nFutexFlag = FUTEX_PRIVATE_FLAG;
 	m_bNeededDestroy = true;
 
 	m_strEventName = "";
@@ -27,14 +33,16 @@ CLEvent::CLEvent(bool bSemaphore)
 		m_pEventInfo->bSemaphore = 0;
 
 	m_pEventInfo->Flag = 0;
+	m_pEventInfo->Waiters = 0;
 	m_pEventInfo->Context = 0;
 
+	m_nFutexFlag = FUTEX_PRIVATE_FLAG;
 	m_bNeededDestroy = true;
 
 	m_strEventName = "";
 }
 
-CLEvent::CLEvent(const char *pstrEventName) : m_Mutex(pstrEventName, MUTEX_USE_SHARED_PTHREAD), m_Cond(pstrEventName)
+CLEvent::CLEvent(const char *pstrEventName)
 {
 	m_pEventInfo = CLSharedEventAllocator::Get(pstrEventName);
 	if(m_pEventInfo == 0)
@@ -44,10 +52,11 @@ CLEvent::CLEvent(const char *pstrEventName) : m_Mutex(pstrEventName, MUTEX_USE_S
 	}
 
 	m_strEventName = pstrEventName;
+	m_nFutexFlag = 0;
 	m_bNeededDestroy = false;
 }
 
-CLEvent::CLEvent(const char *pstrEventName, bool bSemaphore) : m_Mutex(pstrEventName, MUTEX_USE_SHARED_PTHREAD), m_Cond(pstrEventName)
+CLEvent::CLEvent(const char *pstrEventName, bool bSemaphore)
 {
 	m_pEventInfo = CLSharedEventAllocator::Get(pstrEventName);
 	if(m_pEventInfo == 0)
@@ -57,6 +66,7 @@ CLEvent::CLEvent(const char *pstrEventName, bool bSemaphore) : m_Mutex(pstrEvent
 	}
 
 	m_strEventName = pstrEventName;
+	m_nFutexFlag = 0;
 
 	if(bSemaphore)
 		m_pEventInfo->bSemaphore = 1;
@@ -80,22 +90,16 @@ CLEvent::~CLEvent()
 
 CLStatus CLEvent::Set()
 {
-	try
-	{
-		CLCriticalSection cs(&m_Mutex);
+	//ԭӼӷͬʱڴϣWaitжWaitersԣ֤ȴ߲
+	__sync_fetch_and_add(&(m_pEventInfo->Flag), 1);
 
-		m_pEventInfo->Flag = m_pEventInfo->Flag + 1;
-	}
-	catch(const char *str)
-	{
-		CLLogger::WriteLogMsg("In CLEvent::Set(), exception arise", 0);
-		return CLStatus(-1, 0);
-	}
+	if(m_pEventInfo->Waiters == 0)
+		return CLStatus(0, 0);
 
-	CLStatus s = m_Cond.Wakeup();
+	CLStatus s = WakeupWaiter();
 	if(!s.IsSuccess())
 	{
-		CLLogger::WriteLogMsg("In CLEvent::Set(), m_Cond.Wakeup error", 0);
+		CLLogger::WriteLogMsg("In CLEvent::Set(), WakeupWaiter error", 0);
 		return CLStatus(-1, 0);
 	}
 
@@ -104,34 +108,130 @@ CLStatus CLEvent::Set()
 
 CLStatus CLEvent::Wait()
 {
-	try
+	while(true)
 	{
-		CLCriticalSection cs(&m_Mutex);
+		int Flag = m_pEventInfo->Flag;
+		if(Flag > 0)
+		{
+			int NewFlag = (m_pEventInfo->bSemaphore != 0) ? (Flag - 1) : 0;
+			if(__sync_bool_compare_and_swap(&(m_pEventInfo->Flag), Flag, NewFlag))
+				return CLStatus(0, 0);
+
+			continue;
+		}
 
-		while(m_pEventInfo->Flag == 0)
+		CLStatus s = WaitForSignal(0);
+		if(!s.IsSuccess())
 		{
-			CLStatus s = m_Cond.Wait(&m_Mutex);
-			if(!s.IsSuccess())
-			{
-				CLLogger::WriteLogMsg("In CLEvent::Wait(), m_Cond.Wait error", 0);
-				return CLStatus(-1, 0);
-			}
+			CLLogger::WriteLogMsg("In CLEvent::Wait(), WaitForSignal error", 0);
+			return CLStatus(-1, 0);
 		}
+	}
+}
 
-		if(m_pEventInfo->bSemaphore != 0)
+CLStatus CLEvent::TimedWait(long lTimeoutMs)
+{
+	if(lTimeoutMs < 0)
+		return Wait();
+
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+	deadline.tv_sec += lTimeoutMs / 1000;
+	deadline.tv_nsec += (lTimeoutMs % 1000) * 1000000;
+	if(deadline.tv_nsec >= 1000000000)
+	{
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000;
+	}
+
+	while(true)
+	{
+		int Flag = m_pEventInfo->Flag;
+		if(Flag > 0)
 		{
-			m_pEventInfo->Flag = m_pEventInfo->Flag - 1;
+			int NewFlag = (m_pEventInfo->bSemaphore != 0) ? (Flag - 1) : 0;
+			if(__sync_bool_compare_and_swap(&(m_pEventInfo->Flag), Flag, NewFlag))
+				return CLStatus(0, 0);
+
+			continue;
 		}
-		else
+
+		//futexĳʱʱ䣬Ѻʣʱµȴ
+		struct timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+
+		struct timespec remaining;
+		remaining.tv_sec = deadline.tv_sec - now.tv_sec;
+		remaining.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+		if(remaining.tv_nsec < 0)
+		{
+			remaining.tv_sec--;
+			remaining.tv_nsec += 1000000000;
+		}
+
+		if(remaining.tv_sec < 0)
+			return CLStatus(-1, ETIMEDOUT);
+
+		CLStatus s = WaitForSignal(&remaining);
+		if(!s.IsSuccess())
 		{
-			m_pEventInfo->Flag = 0;
+			CLLogger::WriteLogMsg("In CLEvent::TimedWait(), WaitForSignal error", 0);
+			return CLStatus(-1, 0);
 		}
 	}
-	catch(const char* str)
-	{
-		CLLogger::WriteLogMsg("In CLEvent::Wait(), exception arise", 0);
+}
+
+CLStatus CLEvent::TryWait(long lMaxCount, long *plCount)
+{
+	if((plCount == 0) || (lMaxCount <= 0))
 		return CLStatus(-1, 0);
+
+	*plCount = 0;
+
+	while(true)
+	{
+		int Flag = m_pEventInfo->Flag;
+		if(Flag <= 0)
+			return CLStatus(0, 0);
+
+		long count = 1;
+		int NewFlag = 0;
+
+		if(m_pEventInfo->bSemaphore != 0)
+		{
+			count = (Flag < lMaxCount) ? Flag : lMaxCount;
+			NewFlag = Flag - count;
+		}
+
+		if(__sync_bool_compare_and_swap(&(m_pEventInfo->Flag), Flag, NewFlag))
+		{
+			*plCount = count;
+			return CLStatus(0, 0);
+		}
 	}
-	
+}
+
+CLStatus CLEvent::WaitForSignal(const struct timespec *pTimeout)
+{
+	__sync_fetch_and_add(&(m_pEventInfo->Waiters), 1);
+
+	//ֻFlagΪ0ʱŻ˯ߣEAGAIN
+	long r = syscall(SYS_futex, &(m_pEventInfo->Flag), FUTEX_WAIT | m_nFutexFlag, 0, pTimeout, 0, 0);
+	int err = errno;
+
+	__sync_fetch_and_sub(&(m_pEventInfo->Waiters), 1);
+
+	if((r == -1) && (err != EAGAIN) && (err != EINTR) && (err != ETIMEDOUT))
+		return CLStatus(-1, err);
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLEvent::WakeupWaiter()
+{
+	if(syscall(SYS_futex, &(m_pEventInfo->Flag), FUTEX_WAKE | m_nFutexFlag, 1, 0, 0, 0) == -1)
+		return CLStatus(-1, errno);
+
 	return CLStatus(0, 0);
 }
@@ -41,26 +41,14 @@ CLExecutiveCommunicationByNamedPipe::~CLExecutiveCommunicationByNamedPipe()
 
 CLStatus CLExecutiveCommunicationByNamedPipe::PostExecutiveMessage(CLMessage *pMessage)
 {
-	char *pBuf = NULL;
-
 	try
 	{
 		if(pMessage == NULL)
 			return CLStatus(-1, 0);
 
-		unsigned int length;
-		pBuf = GetMsgBuf(pMessage, &length);
-		if(pBuf == 0)
-			throw CLStatus(-1, 0);
-
-		if(length > m_lPipeBufSize)
-			throw CLStatus(-1, 0);
-
-		if(write(m_Fd, pBuf, length) == -1)
-		{
-			CLLogger::WriteLogMsg("In CLExecutiveCommunicationByNamedPipe::PostExecutiveMessage(), write error", errno);
-			throw CLStatus(-1, errno);
-		}
+		CLStatus s1 = WriteMsgToPipe(pMessage);
+		if(!s1.IsSuccess())
+			throw s1;
 
 		if(!m_Event.Set().IsSuccess())
 		{
@@ -80,9 +68,35 @@ CLStatus CLExecutiveCommunicationByNamedPipe::PostExecutiveMessage(CLMessage *pM
 				delete pMessage;
 		}
 
-		if(pBuf != NULL)
-			delete [] pBuf;
-
 		return s;
 	}
+}
+
+CLStatus CLExecutiveCommunicationByNamedPipe::WriteMsgToPipe(CLMessage *pMsg)
+{
+	unsigned int length;
+	char *pBuf = GetMsgBuf(pMsg, &length);
+	if(pBuf == 0)
+		return CLStatus(-1, 0);
+
+	if(length > m_lPipeBufSize)
+	{
+		delete [] pBuf;
+		return CLStatus(-1, 0);
+	}
+
+	if(write(m_Fd, pBuf, length) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveCommunicationByNamedPipe::WriteMsgToPipe(), write error", errno);
+		delete [] pBuf;
+		return CLStatus(-1, errno);
+	}
+
+	delete [] pBuf;
+	return CLStatus(0, 0);
+}
+
+char *CLExecutiveCommunicationByNamedPipe::GetMsgBuf(CLMessage *, unsigned int *)
+{
+	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "CLExecutiveCommunicationByProcessPool.h"
+#include "CLSharedExecutiveCommunicationByShmRing.h"
+#include "CLMsgLoopManagerForProcessPool.h"
+#include "CLMessageSerializer.h"
+#include "CLZeroCopyMessageSerializer.h"
+#include "CLZeroCopySerializerAdapter.h"
+#include "CLMessageIDSerializer.h"
+#include "CLMessage.h"
+#include "CLLogger.h"
+
+using namespace std;
+
+CLExecutiveCommunicationByProcessPool::CLExecutiveCommunicationByProcessPool(const vector<string>& WorkerNames)
+{
+	if(WorkerNames.empty())
+		throw "In CLExecutiveCommunicationByProcessPool::CLExecutiveCommunicationByProcessPool(), WorkerNames error";
+
+	try
+	{
+		for(unsigned int i = 0; i < WorkerNames.size(); i++)
+			m_Workers.push_back(new CLSharedExecutiveCommunicationByShmRing(WorkerNames[i].c_str()));
+	}
+	catch(const char *pstr)
+	{
+		for(unsigned int i = 0; i < m_Workers.size(); i++)
+			delete m_Workers[i];
+
+		throw pstr;
+	}
+
+	m_SerializerTable.Set(PROCESS_POOL_QUIT_ID, new CLMessageIDSerializer);
+
+	m_nNextChoice = 0;
+}
+
+CLExecutiveCommunicationByProcessPool::~CLExecutiveCommunicationByProcessPool()
+{
+	for(unsigned int i = 0; i < m_Workers.size(); i++)
+		delete m_Workers[i];
+
+	vector<CLZeroCopyMessageSerializer*> Serializers;
+	m_SerializerTable.GetAllValues(Serializers);
+
+	for(unsigned int i = 0; i < Serializers.size(); i++)
+		delete Serializers[i];
+}
+
+CLStatus CLExecutiveCommunicationByProcessPool::RegisterSerializer(unsigned long lMsgID, CLMessageSerializer *pSerializer)
+{
+	if(pSerializer == 0)
+		return CLStatus(-1, 0);
+
+	return RegisterSerializer(lMsgID, new CLZeroCopySerializerAdapter(pSerializer));
+}
+
+CLStatus CLExecutiveCommunicationByProcessPool::RegisterSerializer(unsigned long lMsgID, CLZeroCopyMessageSerializer *pSerializer)
+{
+	if(pSerializer == 0)
+		return CLStatus(-1, 0);
+
+	if(m_SerializerTable.Find(lMsgID) != 0)
+	{
+		delete pSerializer;
+		CLLogger::WriteLogMsg("In CLExecutiveCommunicationByProcessPool::RegisterSerializer(), m_SerializerTable.Find error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	m_SerializerTable.Set(lMsgID, pSerializer);
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLExecutiveCommunicationByProcessPool::PostExecutiveMessage(CLMessage *pMessage)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	unsigned int nWorkers = m_Workers.size();
+
+	unsigned long n = __sync_fetch_and_add(&m_nNextChoice, 1);
+	unsigned int i = n % nWorkers;
+	unsigned int j = ((n * 2654435761UL) >> 16) % nWorkers;
+
+	//ѡֻȽеĻѹ빤޹أȴӽ
+	if((i != j) && (m_Workers[j]->GetPendingLength() < m_Workers[i]->GetPendingLength()))
+		i = j;
+
+	return PostToWorker(i, pMessage);
+}
+
+CLStatus CLExecutiveCommunicationByProcessPool::PostExecutiveMessage(CLMessage *pMessage, unsigned long lAffinityKey)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	return PostToWorker(lAffinityKey % m_Workers.size(), pMessage);
+}
+
+unsigned int CLExecutiveCommunicationByProcessPool::GetNumberOfWorkers()
+{
+	return m_Workers.size();
+}
+
+CLStatus CLExecutiveCommunicationByProcessPool::PostToWorker(unsigned int nIndex, CLMessage *pMessage)
+{
+	CLZeroCopyMessageSerializer **ppSerializer = m_SerializerTable.Find(pMessage->m_clMsgID);
+	if(ppSerializer == 0)
+	{
+		delete pMessage;
+		CLLogger::WriteLogMsg("In CLExecutiveCommunicationByProcessPool::PostToWorker(), m_SerializerTable.Find error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	return m_Workers[nIndex]->PostExecutiveMessage(pMessage, *ppSerializer);
+}
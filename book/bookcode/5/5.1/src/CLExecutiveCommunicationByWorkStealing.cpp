@@ -0,0 +1,33 @@
+#include "CLExecutiveCommunicationByWorkStealing.h"
+#include "CLMessageQueueByWorkStealing.h"
+#include "CLMessage.h"
+
+CLExecutiveCommunicationByWorkStealing::CLExecutiveCommunicationByWorkStealing(CLMessageQueueByWorkStealing *pMsgQueue)
+{
+	if(pMsgQueue == 0)
+		throw "In CLExecutiveCommunicationByWorkStealing::CLExecutiveCommunicationByWorkStealing(), pMsgQueue error";
+
+	m_pMsgQueue = pMsgQueue;
+	m_pMsgQueue->AddReference();
+}
+
+CLExecutiveCommunicationByWorkStealing::~CLExecutiveCommunicationByWorkStealing()
+{
+	m_pMsgQueue->Release();
+}
+
+CLStatus CLExecutiveCommunicationByWorkStealing::PostExecutiveMessage(CLMessage *pMessage)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	return m_pMsgQueue->PushMessage(pMessage);
+}
+
+CLStatus CLExecutiveCommunicationByWorkStealing::PostExecutiveMessage(CLMessage *pMessage, unsigned long lAffinityKey)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	return m_pMsgQueue->PushMessage(pMessage, lAffinityKey);
+}
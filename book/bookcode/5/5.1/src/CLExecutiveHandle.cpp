@@ -0,0 +1,39 @@
+#include "CLExecutiveHandle.h"
+#include "CLExecutiveNameServer.h"
+#include "CLMessage.h"
+#include "CLLogger.h"
+
+CLExecutiveHandle::CLExecutiveHandle(const char *pstrExecutiveName)
+{
+	CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+	if(pNameServer == 0)
+		throw "In CLExecutiveHandle::CLExecutiveHandle(), CLExecutiveNameServer::GetInstance error";
+
+	m_pPtrCount = pNameServer->AcquirePtrCount(pstrExecutiveName);
+	if(m_pPtrCount == 0)
+		throw "In CLExecutiveHandle::CLExecutiveHandle(), pNameServer->AcquirePtrCount error";
+}
+
+CLExecutiveHandle::~CLExecutiveHandle()
+{
+	CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+	if(pNameServer == 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveHandle::~CLExecutiveHandle(), CLExecutiveNameServer::GetInstance error", 0);
+		return;
+	}
+
+	CLStatus s = pNameServer->ReleasePtrCount(m_pPtrCount);
+	if(!s.IsSuccess())
+		CLLogger::WriteLogMsg("In CLExecutiveHandle::~CLExecutiveHandle(), pNameServer->ReleasePtrCount error", 0);
+}
+
+CLStatus CLExecutiveHandle::PostExecutiveMessage(CLMessage *pMessage)
+{
+	return m_pPtrCount->pExecutiveCommunication->PostExecutiveMessage(pMessage);
+}
+
+CLExecutiveCommunication *CLExecutiveHandle::GetCommunicationPtr()
+{
+	return m_pPtrCount->pExecutiveCommunication;
+}
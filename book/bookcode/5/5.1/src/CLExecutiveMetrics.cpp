@@ -0,0 +1,402 @@
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include "CLExecutiveMetrics.h"
+#include "CLMessageLoopManager.h"
+#include "CLMessage.h"
+#include "CLCriticalSection.h"
+#include "CLLogger.h"
+#include "CLRelaxedAtomic.h"
+
+using namespace std;
+
+#define MAX_LENGTH_OF_METRICS_LINE 512
+
+volatile bool CLExecutiveMetrics::m_bEnabled = false;
+
+pthread_mutex_t CLExecutiveMetrics::m_MutexForRegistry = PTHREAD_MUTEX_INITIALIZER;
+std::vector<CLExecutiveMetrics*> CLExecutiveMetrics::m_Registry;
+
+CLExecutiveMetrics::CLExecutiveMetrics(const char *pstrExecutiveName, CLMessageLoopManager *pMessageLoop)
+{
+	if((pstrExecutiveName == 0) || (strlen(pstrExecutiveName) == 0))
+		throw "In CLExecutiveMetrics::CLExecutiveMetrics(), pstrExecutiveName error";
+
+	m_strExecutiveName = pstrExecutiveName;
+	m_pMessageLoop = pMessageLoop;
+
+	m_nDispatched = 0;
+	m_nFailed = 0;
+
+	m_bRegistered = false;
+}
+
+CLExecutiveMetrics::~CLExecutiveMetrics()
+{
+	Unregister();
+
+	for(unsigned int i = 0; i < m_MessageIDMetrics.size(); i++)
+		delete m_MessageIDMetrics[i];
+}
+
+CLStatus CLExecutiveMetrics::Register()
+{
+	int r = pthread_mutex_lock(&m_MutexForRegistry);
+	if(r != 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::Register(), pthread_mutex_lock error", r);
+		return CLStatus(-1, r);
+	}
+
+	if(!m_bRegistered)
+	{
+		m_Registry.push_back(this);
+		m_bRegistered = true;
+	}
+
+	r = pthread_mutex_unlock(&m_MutexForRegistry);
+	if(r != 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::Register(), pthread_mutex_unlock error", r);
+		return CLStatus(-1, r);
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLExecutiveMetrics::Unregister()
+{
+	int r = pthread_mutex_lock(&m_MutexForRegistry);
+	if(r != 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::Unregister(), pthread_mutex_lock error", r);
+		return CLStatus(-1, r);
+	}
+
+	if(m_bRegistered)
+	{
+		for(unsigned int i = 0; i < m_Registry.size(); i++)
+		{
+			if(m_Registry[i] == this)
+			{
+				m_Registry[i] = m_Registry.back();
+				m_Registry.pop_back();
+				break;
+			}
+		}
+
+		m_bRegistered = false;
+	}
+
+	r = pthread_mutex_unlock(&m_MutexForRegistry);
+	if(r != 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::Unregister(), pthread_mutex_unlock error", r);
+		return CLStatus(-1, r);
+	}
+
+	return CLStatus(0, 0);
+}
+
+void CLExecutiveMetrics::RecordDispatch(CLMessage *pMessage, unsigned long long nBegin, unsigned long long nEnd, const CLStatus& s)
+{
+	RelaxedAdd(&m_nDispatched, 1UL);
+	if(s.m_clReturnCode < 0)
+		RelaxedAdd(&m_nFailed, 1UL);
+
+	unsigned long long nHandlerTime = (nEnd > nBegin) ? (nEnd - nBegin) : 0;
+	m_HandlerTime.Record(nHandlerTime);
+
+	//ͳ֮ǰͶݵϢûͶʱ
+	if((pMessage->m_nEnqueueTime != 0) && (nBegin >= pMessage->m_nEnqueueTime))
+		m_QueueLatency.Record(nBegin - pMessage->m_nEnqueueTime);
+
+	SLMessageIDMetrics *p = GetMessageIDMetrics(pMessage->m_clMsgID);
+	if(p == 0)
+		return;
+
+	RelaxedAdd(&p->nCount, 1UL);
+	RelaxedAdd(&p->nTotalTime, nHandlerTime);
+	if(nHandlerTime > p->nMaxTime)
+		RelaxedStore(&p->nMaxTime, nHandlerTime);
+}
+
+SLMessageIDMetrics *CLExecutiveMetrics::GetMessageIDMetrics(unsigned long lMsgID)
+{
+	SLMessageIDMetrics **pp = m_MessageIDTable.Find(lMsgID);
+	if(pp != 0)
+		return *pp;
+
+	SLMessageIDMetrics *p = new SLMessageIDMetrics;
+	p->lMsgID = lMsgID;
+	p->nCount = 0;
+	p->nTotalTime = 0;
+	p->nMaxTime = 0;
+
+	try
+	{
+		CLCriticalSection cs(&m_MutexForMessageIDs);
+
+		m_MessageIDMetrics.push_back(p);
+	}
+	catch(const char* str)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::GetMessageIDMetrics(), exception arise", 0);
+		delete p;
+		return 0;
+	}
+
+	m_MessageIDTable.Set(lMsgID, p);
+
+	return p;
+}
+
+void CLExecutiveMetrics::AddToSnapshot(SLExecutiveMetricsSnapshot *pSnapshot)
+{
+	pSnapshot->nMessageLoops++;
+	pSnapshot->nDispatched += RelaxedLoad(&m_nDispatched);
+	pSnapshot->nFailed += RelaxedLoad(&m_nFailed);
+
+	pSnapshot->QueueLatency.Add(&m_QueueLatency);
+	pSnapshot->HandlerTime.Add(&m_HandlerTime);
+
+	SLMessageQueueStatistics statistics;
+	if((m_pMessageLoop != 0) && (m_pMessageLoop->GetQueueStatistics(&statistics).IsSuccess()))
+	{
+		SLMessageQueueStatistics *p = &pSnapshot->QueueStatistics;
+
+		for(int i = 0; i < NUMBER_OF_MESSAGE_PRIORITIES; i++)
+			p->nDepth[i] += statistics.nDepth[i];
+
+		p->nMaxDepth += statistics.nMaxDepth;
+		p->nCapacity += statistics.nCapacity;
+		p->nPushed += statistics.nPushed;
+		p->nDropped += statistics.nDropped;
+		p->nRejected += statistics.nRejected;
+		p->nBlocked += statistics.nBlocked;
+
+		pSnapshot->bHasQueueStatistics = true;
+	}
+
+	try
+	{
+		CLCriticalSection cs(&m_MutexForMessageIDs);
+
+		for(unsigned int i = 0; i < m_MessageIDMetrics.size(); i++)
+		{
+			SLMessageIDMetrics *pFrom = m_MessageIDMetrics[i];
+
+			unsigned int j = 0;
+			while((j < pSnapshot->MessageIDs.size()) && (pSnapshot->MessageIDs[j].lMsgID != pFrom->lMsgID))
+				j++;
+
+			if(j == pSnapshot->MessageIDs.size())
+			{
+				SLMessageIDMetrics metrics;
+				memset(&metrics, 0, sizeof(metrics));
+				metrics.lMsgID = pFrom->lMsgID;
+				pSnapshot->MessageIDs.push_back(metrics);
+			}
+
+			SLMessageIDMetrics *pTo = &pSnapshot->MessageIDs[j];
+			pTo->nCount += RelaxedLoad(&pFrom->nCount);
+			pTo->nTotalTime += RelaxedLoad(&pFrom->nTotalTime);
+
+			unsigned long long nMaxTime = RelaxedLoad(&pFrom->nMaxTime);
+			if(nMaxTime > pTo->nMaxTime)
+				pTo->nMaxTime = nMaxTime;
+		}
+	}
+	catch(const char* str)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::AddToSnapshot(), exception arise", 0);
+	}
+}
+
+void CLExecutiveMetrics::Enable(bool bEnabled)
+{
+	m_bEnabled = bEnabled;
+}
+
+bool CLExecutiveMetrics::IsEnabled()
+{
+	return m_bEnabled;
+}
+
+unsigned long long CLExecutiveMetrics::GetCurrentTime()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void CLExecutiveMetrics::StampEnqueueTime(CLMessage *pMessage)
+{
+	if(m_bEnabled)
+		pMessage->m_nEnqueueTime = GetCurrentTime();
+}
+
+CLStatus CLExecutiveMetrics::GetSnapshot(const char *pstrExecutiveName, SLExecutiveMetricsSnapshot *pSnapshot)
+{
+	if((pstrExecutiveName == 0) || (pSnapshot == 0))
+		return CLStatus(-1, 0);
+
+	pSnapshot->nMessageLoops = 0;
+	pSnapshot->nDispatched = 0;
+	pSnapshot->nFailed = 0;
+	pSnapshot->bHasQueueStatistics = false;
+	memset(&pSnapshot->QueueStatistics, 0, sizeof(pSnapshot->QueueStatistics));
+	pSnapshot->QueueLatency.Reset();
+	pSnapshot->HandlerTime.Reset();
+	pSnapshot->MessageIDs.clear();
+
+	int r = pthread_mutex_lock(&m_MutexForRegistry);
+	if(r != 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::GetSnapshot(), pthread_mutex_lock error", r);
+		return CLStatus(-1, r);
+	}
+
+	for(unsigned int i = 0; i < m_Registry.size(); i++)
+	{
+		if(m_Registry[i]->m_strExecutiveName == pstrExecutiveName)
+			m_Registry[i]->AddToSnapshot(pSnapshot);
+	}
+
+	r = pthread_mutex_unlock(&m_MutexForRegistry);
+	if(r != 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::GetSnapshot(), pthread_mutex_unlock error", r);
+		return CLStatus(-1, r);
+	}
+
+	if(pSnapshot->nMessageLoops == 0)
+		return CLStatus(-1, 0);
+
+	return CLStatus(0, 0);
+}
+
+void CLExecutiveMetrics::GetExecutiveNames(std::vector<std::string>& Names)
+{
+	Names.clear();
+
+	int r = pthread_mutex_lock(&m_MutexForRegistry);
+	if(r != 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::GetExecutiveNames(), pthread_mutex_lock error", r);
+		return;
+	}
+
+	for(unsigned int i = 0; i < m_Registry.size(); i++)
+	{
+		unsigned int j = 0;
+		while((j < Names.size()) && (Names[j] != m_Registry[i]->m_strExecutiveName))
+			j++;
+
+		if(j == Names.size())
+			Names.push_back(m_Registry[i]->m_strExecutiveName);
+	}
+
+	r = pthread_mutex_unlock(&m_MutexForRegistry);
+	if(r != 0)
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::GetExecutiveNames(), pthread_mutex_unlock error", r);
+}
+
+CLStatus CLExecutiveMetrics::Dump(int fd)
+{
+	vector<string> Names;
+	GetExecutiveNames(Names);
+
+	string strOutput;
+	char buf[MAX_LENGTH_OF_METRICS_LINE];
+
+	SLExecutiveMetricsSnapshot *pSnapshot = new SLExecutiveMetricsSnapshot;
+
+	for(unsigned int i = 0; i < Names.size(); i++)
+	{
+		//ִȡ֮˳
+		if(!GetSnapshot(Names[i].c_str(), pSnapshot).IsSuccess())
+			continue;
+
+		SLMessageQueueStatistics *q = &pSnapshot->QueueStatistics;
+
+		snprintf(buf, sizeof(buf), "executive=%s loops=%u dispatched=%lu failed=%lu", Names[i].c_str(), pSnapshot->nMessageLoops, pSnapshot->nDispatched, pSnapshot->nFailed);
+		strOutput += buf;
+
+		if(pSnapshot->bHasQueueStatistics)
+		{
+			snprintf(buf, sizeof(buf), " depth=%lu high_depth=%lu max_depth=%lu capacity=%lu dropped=%lu rejected=%lu", q->nDepth[MESSAGE_PRIORITY_NORMAL] + q->nDepth[MESSAGE_PRIORITY_HIGH], q->nDepth[MESSAGE_PRIORITY_HIGH], q->nMaxDepth, q->nCapacity, q->nDropped, q->nRejected);
+			strOutput += buf;
+		}
+
+		CLLatencyHistogram *pq = &pSnapshot->QueueLatency;
+		CLLatencyHistogram *ph = &pSnapshot->HandlerTime;
+
+		snprintf(buf, sizeof(buf), " queue_ns_p50=%llu queue_ns_p99=%llu queue_ns_p999=%llu queue_ns_max=%llu handler_ns_p50=%llu handler_ns_p99=%llu handler_ns_max=%llu\n",
+			pq->GetValueAtPercentile(50), pq->GetValueAtPercentile(99), pq->GetValueAtPercentile(99.9), pq->GetMax(),
+			ph->GetValueAtPercentile(50), ph->GetValueAtPercentile(99), ph->GetMax());
+		strOutput += buf;
+
+		for(unsigned int j = 0; j < pSnapshot->MessageIDs.size(); j++)
+		{
+			SLMessageIDMetrics *p = &pSnapshot->MessageIDs[j];
+
+			snprintf(buf, sizeof(buf), "\tmsg_id=%lu count=%lu handler_ns_avg=%llu handler_ns_max=%llu\n", p->lMsgID, p->nCount, p->nCount ? p->nTotalTime / p->nCount : 0, p->nMaxTime);
+			strOutput += buf;
+		}
+	}
+
+	delete pSnapshot;
+
+	const char *pData = strOutput.c_str();
+	size_t nLeft = strOutput.size();
+
+	while(nLeft > 0)
+	{
+		ssize_t n = write(fd, pData, nLeft);
+		if(n == -1)
+		{
+			if(errno == EINTR)
+				continue;
+
+			CLLogger::WriteLogMsg("In CLExecutiveMetrics::Dump(), write error", errno);
+			return CLStatus(-1, errno);
+		}
+
+		pData += n;
+		nLeft -= n;
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLExecutiveMetrics::DumpToFile(const char *pstrPath)
+{
+	if((pstrPath == 0) || (strlen(pstrPath) == 0))
+		return CLStatus(-1, 0);
+
+	//Էʽ򿪣ܵûжʱ߳
+	int fd = open(pstrPath, O_WRONLY | O_CREAT | O_TRUNC | O_NONBLOCK, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+	if(fd == -1)
+	{
+		if(errno != ENXIO)
+			CLLogger::WriteLogMsg("In CLExecutiveMetrics::DumpToFile(), open error", errno);
+
+		return CLStatus(-1, errno);
+	}
+
+	int flags = fcntl(fd, F_GETFL);
+	if((flags == -1) || (fcntl(fd, F_SETFL, flags & ~O_NONBLOCK) == -1))
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::DumpToFile(), fcntl error", errno);
+
+	CLStatus s = Dump(fd);
+
+	if(close(fd) == -1)
+		CLLogger::WriteLogMsg("In CLExecutiveMetrics::DumpToFile(), close error", errno);
+
+	return s;
+}
@@ -1,4 +1,5 @@
 #include <string.h>
+#include <stdlib.h>
 #include "CLExecutiveNameServer.h"
 #include "CLCriticalSection.h"
 #include "CLLogger.h"
@@ -6,61 +7,87 @@
 #include "CLMessage.h"
 #include "CLMutex.h"
 
+using namespace std;
+
+struct SLExecutiveNameServerReader
+{
+	//Ϊ0ʾڶٽ
+	volatile unsigned long nActiveEpoch;
+
+	bool bInUse;
+	SLExecutiveNameServerReader *pNext;
+};
+
+static __thread SLExecutiveNameServerReader *t_pReader = 0;
+
 CLExecutiveNameServer* CLExecutiveNameServer::m_pNameServer = 0;
 pthread_mutex_t CLExecutiveNameServer::m_Mutex = PTHREAD_MUTEX_INITIALIZER;
 
+volatile unsigned long CLExecutiveNameServer::m_nEpoch = 1;
+
+pthread_once_t CLExecutiveNameServer::m_OnceForKey = PTHREAD_ONCE_INIT;
+pthread_key_t CLExecutiveNameServer::m_KeyForReader;
+pthread_mutex_t CLExecutiveNameServer::m_MutexForReaders = PTHREAD_MUTEX_INITIALIZER;
+SLExecutiveNameServerReader *CLExecutiveNameServer::m_pReaders = 0;
+
 CLExecutiveNameServer::CLExecutiveNameServer()
 {
+	m_pNameTable = CreateNameTable(0);
 }
 
 CLExecutiveNameServer::~CLExecutiveNameServer()
 {
+	for(unsigned int i = 0; i < m_pNameTable->nCapacity; i++)
+		delete m_pNameTable->pEntries[i].pPtrCount;
+
+	DeleteNameTable(m_pNameTable);
+
+	for(unsigned int i = 0; i < m_Retired.size(); i++)
+	{
+		DeleteNameTable(m_Retired[i].pNameTable);
+		delete m_Retired[i].pPtrCount;
+	}
 }
 
 CLStatus CLExecutiveNameServer::PostExecutiveMessage(const char* pstrExecutiveName, CLMessage *pMessage)
 {
-	 if(pMessage == 0)
-	 	return CLStatus(-1, 0);
-
-	 if((pstrExecutiveName == 0) || (strlen(pstrExecutiveName) == 0))
-	 {
-	 	delete pMessage;
-	 	return CLStatus(-1, 0);
-	 }
-	 
-	 CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
-	 if(pNameServer == 0)
-	 {
-	 	CLLogger::WriteLogMsg("In CLExecutiveNameServer::PostExecutiveMessage(), CLExecutiveNameServer::GetInstance error", 0);
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	if((pstrExecutiveName == 0) || (strlen(pstrExecutiveName) == 0))
+	{
+		delete pMessage;
+		return CLStatus(-1, 0);
+	}
+
+	CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+	if(pNameServer == 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveNameServer::PostExecutiveMessage(), CLExecutiveNameServer::GetInstance error", 0);
 		delete pMessage;
-	 	return CLStatus(-1, 0);
-	 }
+		return CLStatus(-1, 0);
+	}
 
-	 CLExecutiveCommunication* pComm = pNameServer->GetCommunicationPtr(pstrExecutiveName);
-	 if(pComm == 0)
-	 {
-	 	CLLogger::WriteLogMsg("In CLExecutiveNameServer::PostExecutiveMessage(), pNameServer->GetCommunicationPtr error", 0);
+	SLExecutiveCommunicationPtrCount *pPtrCount = pNameServer->AcquirePtrCount(pstrExecutiveName);
+	if(pPtrCount == 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutiveNameServer::PostExecutiveMessage(), pNameServer->AcquirePtrCount error", 0);
 		delete pMessage;
-	 	return CLStatus(-1, 0);
-	 }	
+		return CLStatus(-1, 0);
+	}
 
-	 CLStatus s = pComm->PostExecutiveMessage(pMessage);
-	 if(!s.IsSuccess())
-	 {
-	 	CLLogger::WriteLogMsg("In CLExecutiveNameServer::PostExecutiveMessage(), pComm->PostExecutiveMessage error", 0);
+	CLStatus s = pPtrCount->pExecutiveCommunication->PostExecutiveMessage(pMessage);
+	if(!s.IsSuccess())
+		CLLogger::WriteLogMsg("In CLExecutiveNameServer::PostExecutiveMessage(), pComm->PostExecutiveMessage error", 0);
 
-		CLStatus s1 = pNameServer->ReleaseCommunicationPtr(pstrExecutiveName);
-		if(!s1.IsSuccess())
-			CLLogger::WriteLogMsg("In CLExecutiveNameServer::PostExecutiveMessage(), pNameServer->ReleaseCommunicationPtr error", 0);
-		
-	 	return CLStatus(-1, 0);
-	 }
+	CLStatus s1 = pNameServer->ReleasePtrCount(pPtrCount);
+	if(!s1.IsSuccess())
+		CLLogger::WriteLogMsg("In CLExecutiveNameServer::PostExecutiveMessage(), pNameServer->ReleasePtrCount error", 0);
 
-	 CLStatus s2 = pNameServer->ReleaseCommunicationPtr(pstrExecutiveName);
-	 if(!s2.IsSuccess())
-			CLLogger::WriteLogMsg("In CLExecutiveNameServer::PostExecutiveMessage(), pNameServer->ReleaseCommunicationPtr error", 0);
+	if(!s.IsSuccess())
+		return CLStatus(-1, 0);
 
-	 return CLStatus(0, 0);
+	return CLStatus(0, 0);
 }
 
 CLStatus CLExecutiveNameServer::Register(const char* strExecutiveName, CLExecutiveCommunication *pExecutiveCommunication)
@@ -74,7 +101,7 @@ CLStatus CLExecutiveNameServer::Register(const char* strExecutiveName, CLExecuti
 		return CLStatus(-1, 0);
 	}
 
-	CLMutex mutex(&m_Mutex);	
+	CLMutex mutex(&m_Mutex);
 	CLCriticalSection cs(&mutex);
 
 	if(m_pNameServer == 0)
@@ -82,88 +109,322 @@ CLStatus CLExecutiveNameServer::Register(const char* strExecutiveName, CLExecuti
 		CLLogger::WriteLogMsg("In CLExecutiveNameServer::Register(), m_pNameServer is 0", 0);
 		return CLStatus(-1, 0);
 	}
-	
-	std::map<std::string, SLExecutiveCommunicationPtrCount*>::iterator it = m_NameTable.find(strExecutiveName);	
-	if(it != m_NameTable.end())
+
+	//ѽΪ0ıȴͷɾΪ
+	SLExecutiveCommunicationPtrCount *pOld = FindNameTable(m_pNameTable, strExecutiveName);
+	if((pOld != 0) && (pOld->nCount != 0))
 	{
 		delete pExecutiveCommunication;
 		CLLogger::WriteLogMsg("In CLExecutiveNameServer::Register(), m_NameTable.find error", 0);
 		return CLStatus(-1, 0);
 	}
-	
+
 	SLExecutiveCommunicationPtrCount *p = new SLExecutiveCommunicationPtrCount;
 	p->pExecutiveCommunication = pExecutiveCommunication;
 	p->nCount = 1;
-	
-	m_NameTable[strExecutiveName] = p;
-	
+	p->strExecutiveName = strExecutiveName;
+
+	SLExecutiveNameTable *pNameTable = CreateNameTable(m_pNameTable->nNames + 1);
+
+	for(unsigned int i = 0; i < m_pNameTable->nCapacity; i++)
+	{
+		SLExecutiveNameTableEntry *pEntry = &(m_pNameTable->pEntries[i]);
+		if((pEntry->pPtrCount != 0) && (pEntry->pPtrCount != pOld))
+			InsertNameTable(pNameTable, pEntry->Hash, pEntry->pPtrCount);
+	}
+
+	InsertNameTable(pNameTable, HashName(strExecutiveName), p);
+
+	//pOldͷ߽
+	PublishNameTable(pNameTable, 0);
+
 	return CLStatus(0, 0);
 }
 
 CLExecutiveCommunication* CLExecutiveNameServer::GetCommunicationPtr(const char* strExecutiveName)
 {
-	if((strExecutiveName == 0) || (strlen(strExecutiveName) == 0))
+	SLExecutiveCommunicationPtrCount *pPtrCount = AcquirePtrCount(strExecutiveName);
+	if(pPtrCount == 0)
 		return 0;
-	
-	CLMutex mutex(&m_Mutex);	
-	CLCriticalSection cs(&mutex);
 
-	if(m_pNameServer == 0)
+	return pPtrCount->pExecutiveCommunication;
+}
+
+CLStatus CLExecutiveNameServer::ReleaseCommunicationPtr(const char* strExecutiveName)
+{
+	if((strExecutiveName == 0) || (strlen(strExecutiveName) == 0))
+		return CLStatus(-1, 0);
+
+	SLExecutiveNameServerReader *pReader = GetReader();
+	if(pReader == 0)
+		return CLStatus(-1, 0);
+
+	pReader->nActiveEpoch = m_nEpoch;
+	__sync_synchronize();
+
+	SLExecutiveCommunicationPtrCount *pPtrCount = FindNameTable(m_pNameTable, strExecutiveName);
+
+	//߳ãڼΪ0֮ǰᱻɾ
+	pReader->nActiveEpoch = 0;
+
+	if(pPtrCount == 0)
 	{
-		CLLogger::WriteLogMsg("In CLExecutiveNameServer::GetCommunicationPtr(), m_pNameServer is 0", 0);
-		return 0;
+		CLLogger::WriteLogMsg("In CLExecutiveNameServer::ReleaseCommunicationPtr(), m_NameTable.find error", 0);
+		return CLStatus(-1, 0);
 	}
 
-	std::map<std::string, SLExecutiveCommunicationPtrCount*>::iterator it = m_NameTable.find(strExecutiveName);
-	if(it == m_NameTable.end())
-	{
-		CLLogger::WriteLogMsg("In CLExecutiveNameServer::GetCommunicationPtr(), m_NameTable.find error", 0);
+	return ReleasePtrCount(pPtrCount);
+}
+
+SLExecutiveCommunicationPtrCount* CLExecutiveNameServer::AcquirePtrCount(const char* strExecutiveName)
+{
+	if((strExecutiveName == 0) || (strlen(strExecutiveName) == 0))
+		return 0;
+
+	SLExecutiveNameServerReader *pReader = GetReader();
+	if(pReader == 0)
 		return 0;
+
+	pReader->nActiveEpoch = m_nEpoch;
+	__sync_synchronize();
+
+	SLExecutiveCommunicationPtrCount *pPtrCount = FindNameTable(m_pNameTable, strExecutiveName);
+
+	//ѽΪ0ıٱ
+	while(pPtrCount != 0)
+	{
+		unsigned int nCount = pPtrCount->nCount;
+		if(nCount == 0)
+		{
+			pPtrCount = 0;
+			break;
+		}
+
+		if(__sync_bool_compare_and_swap(&(pPtrCount->nCount), nCount, nCount + 1))
+			break;
 	}
 
-	it->second->nCount++;
+	__sync_synchronize();
+	pReader->nActiveEpoch = 0;
+
+	if(pPtrCount == 0)
+		CLLogger::WriteLogMsg("In CLExecutiveNameServer::AcquirePtrCount(), m_NameTable.find error", 0);
 
-	return it->second->pExecutiveCommunication;
+	return pPtrCount;
 }
 
-CLStatus CLExecutiveNameServer::ReleaseCommunicationPtr(const char* strExecutiveName)
+CLStatus CLExecutiveNameServer::ReleasePtrCount(SLExecutiveCommunicationPtrCount *pPtrCount)
 {
-	if((strExecutiveName == 0) || (strlen(strExecutiveName) == 0))
-		return CLStatus(-1, 0);
+	if(__sync_sub_and_fetch(&(pPtrCount->nCount), 1) != 0)
+		return CLStatus(0, 0);
+
+	CLExecutiveCommunication *pTmp = pPtrCount->pExecutiveCommunication;
 
-	CLExecutiveCommunication *pTmp = 0;
-	
 	{
-		CLMutex mutex(&m_Mutex);	
+		CLMutex mutex(&m_Mutex);
 		CLCriticalSection cs(&mutex);
 
 		if(m_pNameServer == 0)
 		{
-			CLLogger::WriteLogMsg("In CLExecutiveNameServer::ReleaseCommunicationPtr(), m_pNameServer is 0", 0);
+			CLLogger::WriteLogMsg("In CLExecutiveNameServer::ReleasePtrCount(), m_pNameServer is 0", 0);
 			return CLStatus(-1, 0);
 		}
 
-		std::map<std::string, SLExecutiveCommunicationPtrCount*>::iterator it = m_NameTable.find(strExecutiveName);
-		if(it == m_NameTable.end())
+		//ִͬעᲢ滻˸ñ
+		if(FindNameTable(m_pNameTable, pPtrCount->strExecutiveName.c_str()) == pPtrCount)
 		{
-			CLLogger::WriteLogMsg("In CLExecutiveNameServer::ReleaseCommunicationPtr(), m_NameTable.find error", 0);
-			return CLStatus(-1, 0);
+			SLExecutiveNameTable *pNameTable = CreateNameTable(m_pNameTable->nNames - 1);
+
+			for(unsigned int i = 0; i < m_pNameTable->nCapacity; i++)
+			{
+				SLExecutiveNameTableEntry *pEntry = &(m_pNameTable->pEntries[i]);
+				if((pEntry->pPtrCount != 0) && (pEntry->pPtrCount != pPtrCount))
+					InsertNameTable(pNameTable, pEntry->Hash, pEntry->pPtrCount);
+			}
+
+			PublishNameTable(pNameTable, pPtrCount);
 		}
+		else
+			PublishNameTable(0, pPtrCount);
+	}
 
-		it->second->nCount--;
+	delete pTmp;
 
-		if(it->second->nCount == 0)
+	return CLStatus(0, 0);
+}
+
+void CLExecutiveNameServer::PublishNameTable(SLExecutiveNameTable *pNameTable, SLExecutiveCommunicationPtrCount *pRemoved)
+{
+	SLExecutiveNameServerRetired retired;
+	retired.pNameTable = 0;
+	retired.pPtrCount = pRemoved;
+
+	if(pNameTable != 0)
+	{
+		retired.pNameTable = m_pNameTable;
+
+		__sync_synchronize();
+		m_pNameTable = pNameTable;
+	}
+
+	retired.nEpoch = __sync_fetch_and_add(&m_nEpoch, 1);
+
+	m_Retired.push_back(retired);
+
+	ReclaimRetired();
+}
+
+void CLExecutiveNameServer::ReclaimRetired()
+{
+	unsigned long nMinEpoch = (unsigned long)-1;
+
+	if(pthread_mutex_lock(&m_MutexForReaders) != 0)
+		return;
+
+	for(SLExecutiveNameServerReader *pReader = m_pReaders; pReader != 0; pReader = pReader->pNext)
+	{
+		unsigned long nEpoch = pReader->nActiveEpoch;
+		if((nEpoch != 0) && (nEpoch < nMinEpoch))
+			nMinEpoch = nEpoch;
+	}
+
+	pthread_mutex_unlock(&m_MutexForReaders);
+
+	unsigned int nKept = 0;
+	for(unsigned int i = 0; i < m_Retired.size(); i++)
+	{
+		if(m_Retired[i].nEpoch < nMinEpoch)
 		{
-			pTmp = it->second->pExecutiveCommunication;
-			delete it->second;
-			m_NameTable.erase(it);
+			DeleteNameTable(m_Retired[i].pNameTable);
+			delete m_Retired[i].pPtrCount;
 		}
+		else
+			m_Retired[nKept++] = m_Retired[i];
 	}
 
-	if(pTmp != 0)
-		delete pTmp;
-		
-	return CLStatus(0, 0);
+	m_Retired.resize(nKept);
+}
+
+SLExecutiveNameTable* CLExecutiveNameServer::CreateNameTable(unsigned int nNames)
+{
+	unsigned int nCapacity = MIN_CAPACITY_OF_EXECUTIVE_NAME_TABLE;
+	while(nCapacity < nNames * 2)
+		nCapacity <<= 1;
+
+	SLExecutiveNameTable *pNameTable = new SLExecutiveNameTable;
+	pNameTable->nCapacity = nCapacity;
+	pNameTable->nNames = 0;
+	pNameTable->pEntries = new SLExecutiveNameTableEntry[nCapacity];
+
+	memset(pNameTable->pEntries, 0, sizeof(SLExecutiveNameTableEntry) * nCapacity);
+
+	return pNameTable;
+}
+
+void CLExecutiveNameServer::InsertNameTable(SLExecutiveNameTable *pNameTable, unsigned int Hash, SLExecutiveCommunicationPtrCount *pPtrCount)
+{
+	unsigned int nMask = pNameTable->nCapacity - 1;
+
+	unsigned int i = Hash & nMask;
+	while(pNameTable->pEntries[i].pPtrCount != 0)
+		i = (i + 1) & nMask;
+
+	pNameTable->pEntries[i].Hash = Hash;
+	pNameTable->pEntries[i].pPtrCount = pPtrCount;
+	pNameTable->nNames++;
+}
+
+SLExecutiveCommunicationPtrCount* CLExecutiveNameServer::FindNameTable(SLExecutiveNameTable *pNameTable, const char* strExecutiveName)
+{
+	unsigned int Hash = HashName(strExecutiveName);
+	unsigned int nMask = pNameTable->nCapacity - 1;
+
+	for(unsigned int i = Hash & nMask; pNameTable->pEntries[i].pPtrCount != 0; i = (i + 1) & nMask)
+	{
+		SLExecutiveNameTableEntry *pEntry = &(pNameTable->pEntries[i]);
+		if((pEntry->Hash == Hash) && (strcmp(pEntry->pPtrCount->strExecutiveName.c_str(), strExecutiveName) == 0))
+			return pEntry->pPtrCount;
+	}
+
+	return 0;
+}
+
+void CLExecutiveNameServer::DeleteNameTable(SLExecutiveNameTable *pNameTable)
+{
+	if(pNameTable == 0)
+		return;
+
+	delete [] pNameTable->pEntries;
+	delete pNameTable;
+}
+
+unsigned int CLExecutiveNameServer::HashName(const char* strExecutiveName)
+{
+	//FNV-1a
+	unsigned int Hash = 2166136261U;
+
+	for(const unsigned char *p = (const unsigned char *)strExecutiveName; *p != 0; p++)
+	{
+		Hash ^= *p;
+		Hash *= 16777619U;
+	}
+
+	return Hash;
+}
+
+SLExecutiveNameServerReader* CLExecutiveNameServer::GetReader()
+{
+	if(t_pReader != 0)
+		return t_pReader;
+
+	if(pthread_once(&m_OnceForKey, CreateKey) != 0)
+		return 0;
+
+	if(pthread_mutex_lock(&m_MutexForReaders) != 0)
+		return 0;
+
+	SLExecutiveNameServerReader *pReader = m_pReaders;
+	while((pReader != 0) && (pReader->bInUse))
+		pReader = pReader->pNext;
+
+	if(pReader == 0)
+	{
+		pReader = (SLExecutiveNameServerReader *)malloc(sizeof(SLExecutiveNameServerReader));
+		if(pReader != 0)
+		{
+			memset(pReader, 0, sizeof(SLExecutiveNameServerReader));
+			pReader->pNext = m_pReaders;
+			m_pReaders = pReader;
+		}
+	}
+
+	if(pReader != 0)
+		pReader->bInUse = true;
+
+	pthread_mutex_unlock(&m_MutexForReaders);
+
+	if(pReader == 0)
+		return 0;
+
+	pthread_setspecific(m_KeyForReader, pReader);
+	t_pReader = pReader;
+
+	return pReader;
+}
+
+void CLExecutiveNameServer::CreateKey()
+{
+	pthread_key_create(&m_KeyForReader, OnThreadExit);
+}
+
+void CLExecutiveNameServer::OnThreadExit(void *pReader)
+{
+	if(pthread_mutex_lock(&m_MutexForReaders) != 0)
+		return;
+
+	((SLExecutiveNameServerReader *)pReader)->bInUse = false;
+
+	pthread_mutex_unlock(&m_MutexForReaders);
 }
 
 CLExecutiveNameServer* CLExecutiveNameServer::GetInstance()
@@ -186,7 +447,7 @@ CLStatus CLExecutiveNameServer::Destroy()
 
 	CLMutex mutex(&m_Mutex);
 	CLCriticalSection cs(&mutex);
-	
+
 	//m_NameTableеĶӦû֤ͷ⣬
 	//ûҪ֤ڳⷴʼ֮ǰReleaseCommunicationPtr
 	delete m_pNameServer;
@@ -194,4 +455,4 @@ CLStatus CLExecutiveNameServer::Destroy()
 	m_pNameServer = 0;
 
 	return CLStatus(0, 0);
-}
\ No newline at end of file
+}
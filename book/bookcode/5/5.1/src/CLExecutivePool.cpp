@@ -0,0 +1,180 @@
+#include <string.h>
+#include "CLExecutivePool.h"
+#include "CLThread.h"
+#include "CLExecutiveFunctionForMsgLoop.h"
+#include "CLMsgLoopManagerForWorkStealing.h"
+#include "CLMessageQueueByWorkStealing.h"
+#include "CLExecutiveCommunicationByWorkStealing.h"
+#include "CLExecutiveNameServer.h"
+#include "CLThreadInitialFinishedNotifier.h"
+#include "CLMessageObserver.h"
+#include "CLMessage.h"
+#include "CLEvent.h"
+#include "CLLogger.h"
+
+CLExecutivePool::CLExecutivePool(const std::vector<CLMessageObserver*>& Observers, const char *pstrPoolName, bool bWaitForDeath)
+{
+	if(Observers.empty())
+		throw "In CLExecutivePool::CLExecutivePool(), Observers error";
+
+	for(unsigned int i = 0; i < Observers.size(); i++)
+	{
+		if(Observers[i] == 0)
+			throw "In CLExecutivePool::CLExecutivePool(), Observers error";
+	}
+
+	if((pstrPoolName == 0) || (strlen(pstrPoolName) == 0))
+		throw "In CLExecutivePool::CLExecutivePool(), pstrPoolName error";
+
+	m_strPoolName = pstrPoolName;
+	m_bWaitForDeath = bWaitForDeath;
+	m_bRunCalled = false;
+	m_nStartedThreads = 0;
+
+	m_pMsgQueue = new CLMessageQueueByWorkStealing(Observers.size());
+
+	for(unsigned int i = 0; i < Observers.size(); i++)
+	{
+		CLMsgLoopManagerForWorkStealing *pManager = new CLMsgLoopManagerForWorkStealing(Observers[i], pstrPoolName, m_pMsgQueue, i);
+		m_Threads.push_back(new CLThread(new CLExecutiveFunctionForMsgLoop(pManager), bWaitForDeath));
+	}
+}
+
+CLExecutivePool::~CLExecutivePool()
+{
+	for(unsigned int i = 0; i < m_Threads.size(); i++)
+	{
+		if(m_Threads[i] == 0)
+			continue;
+
+		if(i >= m_nStartedThreads)
+		{
+			delete m_Threads[i];
+			continue;
+		}
+
+		if(m_bWaitForDeath)
+		{
+			CLStatus s = m_Threads[i]->WaitForDeath();
+			if(!s.IsSuccess())
+				CLLogger::WriteLogMsg("In CLExecutivePool::~CLExecutivePool(), m_Threads[i]->WaitForDeath error", 0);
+		}
+	}
+
+	m_pMsgQueue->Release();
+}
+
+CLStatus CLExecutivePool::Run(void *pContext)
+{
+	if(m_bRunCalled)
+		return CLStatus(-1, 0);
+
+	m_bRunCalled = true;
+
+	CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+	if(pNameServer == 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutivePool::Run(), CLExecutiveNameServer::GetInstance error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	CLStatus s = pNameServer->Register(m_strPoolName.c_str(), new CLExecutiveCommunicationByWorkStealing(m_pMsgQueue));
+	if(!s.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLExecutivePool::Run(), pNameServer->Register error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	//ڼռһֹĹ߳˳ʱע
+	m_pMsgQueue->EnterExecutive();
+
+	bool bSuccess = true;
+
+	for(unsigned int i = 0; i < m_Threads.size(); i++)
+	{
+		CLEvent event;
+		CLThreadInitialFinishedNotifier notifier(&event);
+
+		SLExecutiveInitialParameter para;
+		para.pContext = pContext;
+		para.pNotifier = &notifier;
+
+		m_nStartedThreads++;
+
+		CLStatus s1 = m_Threads[i]->Run(&para);
+		if(!s1.IsSuccess())
+		{
+			CLLogger::WriteLogMsg("In CLExecutivePool::Run(), m_Threads[i]->Run error", 0);
+			m_Threads[i] = 0;
+			bSuccess = false;
+			break;
+		}
+
+		CLStatus s2 = event.Wait();
+		if(!s2.IsSuccess())
+			CLLogger::WriteLogMsg("In CLExecutivePool::Run(), event.Wait error", 0);
+
+		if(!notifier.IsInitialSuccess())
+		{
+			bSuccess = false;
+			break;
+		}
+	}
+
+	if(!bSuccess)
+		m_pMsgQueue->Quit();
+
+	if(m_pMsgQueue->LeaveExecutive() == 0)
+	{
+		CLStatus s3 = pNameServer->ReleaseCommunicationPtr(m_strPoolName.c_str());
+		if(!s3.IsSuccess())
+			CLLogger::WriteLogMsg("In CLExecutivePool::Run(), pNameServer->ReleaseCommunicationPtr error", 0);
+	}
+
+	if(bSuccess)
+		return CLStatus(0, 0);
+	else
+		return CLStatus(-1, 0);
+}
+
+CLStatus CLExecutivePool::PostExecutiveMessage(const char *pstrPoolName, CLMessage *pMessage, unsigned long lAffinityKey)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+	if(pNameServer == 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutivePool::PostExecutiveMessage(), CLExecutiveNameServer::GetInstance error", 0);
+		delete pMessage;
+		return CLStatus(-1, 0);
+	}
+
+	CLExecutiveCommunication *pComm = pNameServer->GetCommunicationPtr(pstrPoolName);
+	if(pComm == 0)
+	{
+		CLLogger::WriteLogMsg("In CLExecutivePool::PostExecutiveMessage(), pNameServer->GetCommunicationPtr error", 0);
+		delete pMessage;
+		return CLStatus(-1, 0);
+	}
+
+	bool bSuccess = false;
+
+	CLExecutiveCommunicationByWorkStealing *pPoolComm = dynamic_cast<CLExecutiveCommunicationByWorkStealing *>(pComm);
+	if(pPoolComm != 0)
+		bSuccess = pPoolComm->PostExecutiveMessage(pMessage, lAffinityKey).IsSuccess();
+	else
+	{
+		CLLogger::WriteLogMsg("In CLExecutivePool::PostExecutiveMessage(), pstrPoolName is not an executive pool", 0);
+		delete pMessage;
+	}
+
+	CLStatus s1 = pNameServer->ReleaseCommunicationPtr(pstrPoolName);
+	if(!s1.IsSuccess())
+		CLLogger::WriteLogMsg("In CLExecutivePool::PostExecutiveMessage(), pNameServer->ReleaseCommunicationPtr error", 0);
+
+	if(bSuccess)
+		return CLStatus(0, 0);
+	else
+		return CLStatus(-1, 0);
+}
@@ -0,0 +1,133 @@
+#include <string.h>
+#include "CLLatencyHistogram.h"
+#include "CLRelaxedAtomic.h"
+
+CLLatencyHistogram::CLLatencyHistogram()
+{
+	Reset();
+}
+
+CLLatencyHistogram::~CLLatencyHistogram()
+{
+}
+
+void CLLatencyHistogram::Record(unsigned long long nValue)
+{
+	RelaxedAdd(&m_Counts[GetBucketIndex(nValue)], 1ULL);
+
+	RelaxedAdd(&m_nCount, 1ULL);
+	RelaxedAdd(&m_nSum, nValue);
+
+	if(nValue < m_nMin)
+		RelaxedStore(&m_nMin, nValue);
+
+	if(nValue > m_nMax)
+		RelaxedStore(&m_nMax, nValue);
+}
+
+void CLLatencyHistogram::Add(const CLLatencyHistogram *pHistogram)
+{
+	if(pHistogram == 0)
+		return;
+
+	for(int i = 0; i < NUMBER_OF_HISTOGRAM_BUCKETS; i++)
+		m_Counts[i] += RelaxedLoad(&pHistogram->m_Counts[i]);
+
+	m_nCount += RelaxedLoad(&pHistogram->m_nCount);
+	m_nSum += RelaxedLoad(&pHistogram->m_nSum);
+
+	unsigned long long nMin = RelaxedLoad(&pHistogram->m_nMin);
+	if(nMin < m_nMin)
+		m_nMin = nMin;
+
+	unsigned long long nMax = RelaxedLoad(&pHistogram->m_nMax);
+	if(nMax > m_nMax)
+		m_nMax = nMax;
+}
+
+void CLLatencyHistogram::Reset()
+{
+	memset(m_Counts, 0, sizeof(m_Counts));
+
+	m_nCount = 0;
+	m_nSum = 0;
+	m_nMin = ~0ULL;
+	m_nMax = 0;
+}
+
+unsigned long long CLLatencyHistogram::GetCount()
+{
+	return m_nCount;
+}
+
+unsigned long long CLLatencyHistogram::GetMin()
+{
+	if(m_nCount == 0)
+		return 0;
+
+	return m_nMin;
+}
+
+unsigned long long CLLatencyHistogram::GetMax()
+{
+	return m_nMax;
+}
+
+double CLLatencyHistogram::GetMean()
+{
+	if(m_nCount == 0)
+		return 0;
+
+	return (double)m_nSum / m_nCount;
+}
+
+unsigned long long CLLatencyHistogram::GetValueAtPercentile(double dPercentile)
+{
+	if(m_nCount == 0)
+		return 0;
+
+	unsigned long long nTarget = (unsigned long long)(dPercentile / 100 * m_nCount + 0.5);
+	if(nTarget == 0)
+		nTarget = 1;
+
+	if(nTarget > m_nCount)
+		nTarget = m_nCount;
+
+	unsigned long long nSeen = 0;
+	for(int i = 0; i < NUMBER_OF_HISTOGRAM_BUCKETS; i++)
+	{
+		nSeen += m_Counts[i];
+		if(nSeen >= nTarget)
+		{
+			unsigned long long nValue = GetBucketUpperBound(i);
+			return (nValue > m_nMax) ? m_nMax : nValue;
+		}
+	}
+
+	return m_nMax;
+}
+
+int CLLatencyHistogram::GetBucketIndex(unsigned long long nValue)
+{
+	//С16ֵռһͰ
+	if(nValue < NUMBER_OF_HISTOGRAM_SUB_BUCKETS)
+		return (int)nValue;
+
+	int nMSB = 63 - __builtin_clzll(nValue);
+	int nShift = nMSB - BITS_OF_HISTOGRAM_SUB_BUCKETS;
+	int nSub = (int)((nValue >> nShift) & (NUMBER_OF_HISTOGRAM_SUB_BUCKETS - 1));
+
+	return (nShift + 1) * NUMBER_OF_HISTOGRAM_SUB_BUCKETS + nSub;
+}
+
+unsigned long long CLLatencyHistogram::GetBucketUpperBound(int nIndex)
+{
+	if(nIndex < NUMBER_OF_HISTOGRAM_SUB_BUCKETS)
+		return (unsigned long long)nIndex;
+
+	int nShift = nIndex / NUMBER_OF_HISTOGRAM_SUB_BUCKETS - 1;
+	unsigned long long nSub = nIndex % NUMBER_OF_HISTOGRAM_SUB_BUCKETS;
+
+	unsigned long long nLower = (NUMBER_OF_HISTOGRAM_SUB_BUCKETS + nSub) << nShift;
+	return nLower + ((1ULL << nShift) - 1);
+}
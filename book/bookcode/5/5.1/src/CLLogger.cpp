@@ -4,15 +4,51 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <sched.h>
+#include <time.h>
 #include "CLLogger.h"
 
 #define LOG_FILE_NAME "logger"
 #define MAX_SIZE 265
 #define BUFFER_SIZE_LOG_FILE 4096
+#define SIZE_OF_LOGGER_CACHE_LINE 64
+
+/*
+ߣ̣߳ߣֽ̨̣߳ڻλ
+nHeadnTailnSizeȡģλ
+*/
+struct SLLoggerThreadBuffer
+{
+	char *pData;
+	unsigned int nSize;
+
+	char Padding1[SIZE_OF_LOGGER_CACHE_LINE];
+	volatile unsigned long nTail;
+	volatile unsigned long nDropped;
+	volatile int bWriting;
+	char Padding2[SIZE_OF_LOGGER_CACHE_LINE];
+	volatile unsigned long nHead;
+	unsigned long nReportedDrops;
+	char Padding3[SIZE_OF_LOGGER_CACHE_LINE];
+
+	bool bInUse;
+	SLLoggerThreadBuffer *pNext;
+};
+
+static __thread SLLoggerThreadBuffer *t_pLoggerThreadBuffer = 0;
 
 CLLogger* CLLogger::m_pLog = 0;
 pthread_mutex_t CLLogger::m_Mutex = PTHREAD_MUTEX_INITIALIZER;
 
+pthread_once_t CLLogger::m_OnceForKey = PTHREAD_ONCE_INIT;
+pthread_key_t CLLogger::m_KeyForThreadBuffer;
+pthread_mutex_t CLLogger::m_MutexForThreadBuffers = PTHREAD_MUTEX_INITIALIZER;
+SLLoggerThreadBuffer *CLLogger::m_pThreadBuffers = 0;
+
+volatile int CLLogger::m_bAsyncMode = 0;
+unsigned int CLLogger::m_nSizeOfThreadBuffer = DEFAULT_SIZE_OF_LOGGER_THREAD_BUFFER;
+
 CLLogger::CLLogger()
 {
 	m_Fd = open(LOG_FILE_NAME, O_RDWR | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR); 
@@ -21,10 +57,24 @@ CLLogger::CLLogger()
 
 	m_pLogBuffer = new char[BUFFER_SIZE_LOG_FILE];
 	m_nUsedBytesForBuffer = 0;
+
+	m_nOverflowPolicy = LOGGER_OVERFLOW_DROP;
+	m_bFlusherSleeping = 0;
+	m_bStopFlusher = 0;
+
+	int r = pthread_mutex_init(&m_MutexForDrain, 0);
+	if(r != 0)
+	{
+		delete [] m_pLogBuffer;
+		close(m_Fd);
+		throw "In CLLogger::CLLogger(), pthread_mutex_init error";
+	}
 }
 
 CLLogger::~CLLogger()
 {
+	pthread_mutex_destroy(&m_MutexForDrain);
+
 	delete [] m_pLogBuffer;
 
 	close(m_Fd);
@@ -119,6 +169,13 @@ int CLLogger::WriteOfProcessSafety(int fd, const void *buff, size_t nbytes)
 
 CLStatus CLLogger::Flush()
 {
+	if(m_bAsyncMode)
+	{
+		CLStatus s = DrainThreadBuffers();
+		if(!s.IsSuccess())
+			return s;
+	}
+
 	int r = pthread_mutex_lock(&m_Mutex);
 	if(r != 0)
 		return CLStatus(-1, r);
@@ -189,6 +246,29 @@ CLStatus CLLogger::WriteLog(const char *pstrMsg, long lErrorCode)
 	int len_code = strlen(buf);
 	unsigned int total_len = len_strmsg + len_code;
 
+	if(m_bAsyncMode)
+	{
+		SLLoggerThreadBuffer *pBuffer = GetThreadBuffer();
+		if(pBuffer != 0)
+		{
+			//DisableAsyncModeϣر첽ģʽ󣬲̷߳ʻͺ̨߳
+			pBuffer->bWriting = 1;
+			__sync_synchronize();
+
+			if(m_bAsyncMode)
+			{
+				CLStatus s = WriteLogToThreadBuffer(pBuffer, pstrMsg, len_strmsg, buf, len_code);
+
+				__sync_synchronize();
+				pBuffer->bWriting = 0;
+
+				return s;
+			}
+
+			pBuffer->bWriting = 0;
+		}
+	}
+
 	int r = pthread_mutex_lock(&m_Mutex);
 	if(r != 0)
 		return CLStatus(-1, r);
@@ -265,6 +345,9 @@ CLStatus CLLogger::Destroy()
 
 	try
 	{
+		if(!m_pLog->DisableAsyncMode().IsSuccess())
+			throw CLStatus(-1, 0);
+
 		if(m_pLog->m_nUsedBytesForBuffer != 0)
 		{
 			if(WriteOfProcessSafety(m_pLog->m_Fd, m_pLog->m_pLogBuffer, m_pLog->m_nUsedBytesForBuffer) == -1)
@@ -293,4 +376,410 @@ CLStatus CLLogger::Destroy()
 
 		return CLStatus(-1, 0);
 	}
-}
\ No newline at end of file
+}
+
+int CLLogger::WritevOfProcessSafety(int fd, const struct iovec *iov, int iovcnt)
+{
+	struct flock lock;
+	lock.l_type = F_WRLCK;
+	lock.l_start = 0;
+	lock.l_whence = SEEK_END;
+	lock.l_len = 0;
+
+	if(fcntl(fd, F_SETLKW, &lock) == -1)
+		return -1;
+
+	ssize_t writedbytes = 0;
+	for(int i = 0; i < iovcnt; i += IOV_MAX)
+	{
+		int n = iovcnt - i;
+		if(n > IOV_MAX)
+			n = IOV_MAX;
+
+		ssize_t r = writev(fd, iov + i, n);
+		if(r == -1)
+			break;
+
+		writedbytes += r;
+	}
+
+	lock.l_type = F_UNLCK;
+	lock.l_start = -writedbytes;
+	lock.l_whence = SEEK_END;
+	lock.l_len = 0;
+
+	fcntl(fd, F_SETLKW, &lock);
+
+	return writedbytes;
+}
+
+CLStatus CLLogger::EnableAsyncMode(unsigned int nBufferSize, int nOverflowPolicy)
+{
+	if((nBufferSize == 0) || ((nOverflowPolicy != LOGGER_OVERFLOW_DROP) && (nOverflowPolicy != LOGGER_OVERFLOW_BLOCK)))
+		return CLStatus(-1, 0);
+
+	int r = pthread_mutex_lock(&m_Mutex);
+	if(r != 0)
+		return CLStatus(-1, r);
+
+	try
+	{
+		if((m_pLog == 0) || (m_bAsyncMode))
+			throw CLStatus(-1, 0);
+
+		//ͬģʽ»־дԱ˳
+		if(m_pLog->m_nUsedBytesForBuffer != 0)
+		{
+			if(WriteOfProcessSafety(m_pLog->m_Fd, m_pLog->m_pLogBuffer, m_pLog->m_nUsedBytesForBuffer) == -1)
+				throw CLStatus(-1, errno);
+
+			m_pLog->m_nUsedBytesForBuffer = 0;
+		}
+
+		m_nSizeOfThreadBuffer = nBufferSize;
+		m_pLog->m_nOverflowPolicy = nOverflowPolicy;
+		m_pLog->m_bFlusherSleeping = 0;
+		m_pLog->m_bStopFlusher = 0;
+
+		if(sem_init(&(m_pLog->m_SemaphoreForFlusher), 0, 0) == -1)
+			throw CLStatus(-1, errno);
+
+		r = pthread_create(&(m_pLog->m_FlusherThreadID), 0, FlusherThread, m_pLog);
+		if(r != 0)
+		{
+			sem_destroy(&(m_pLog->m_SemaphoreForFlusher));
+			throw CLStatus(-1, r);
+		}
+
+		__sync_synchronize();
+		m_bAsyncMode = 1;
+
+		throw CLStatus(0, 0);
+	}
+	catch(CLStatus& s)
+	{
+		r = pthread_mutex_unlock(&m_Mutex);
+		if(r != 0)
+			return CLStatus(-1, r);
+
+		return s;
+	}
+	catch(...)
+	{
+		r = pthread_mutex_unlock(&m_Mutex);
+		if(r != 0)
+			return CLStatus(-1, r);
+
+		return CLStatus(-1, 0);
+	}
+}
+
+CLStatus CLLogger::DisableAsyncMode()
+{
+	if(!m_bAsyncMode)
+		return CLStatus(0, 0);
+
+	m_bAsyncMode = 0;
+	__sync_synchronize();
+
+	int r = pthread_mutex_lock(&m_MutexForThreadBuffers);
+	if(r != 0)
+		return CLStatus(-1, r);
+
+	SLLoggerThreadBuffer *pFirst = m_pThreadBuffers;
+
+	pthread_mutex_unlock(&m_MutexForThreadBuffers);
+
+	//ȴд߳ɣǿܻڵȴ̨߳ڳռ
+	for(SLLoggerThreadBuffer *pBuffer = pFirst; pBuffer != 0; pBuffer = pBuffer->pNext)
+	{
+		while(pBuffer->bWriting)
+			sched_yield();
+	}
+
+	m_bStopFlusher = 1;
+	sem_post(&m_SemaphoreForFlusher);
+
+	r = pthread_join(m_FlusherThreadID, 0);
+	if(r != 0)
+		return CLStatus(-1, r);
+
+	CLStatus s = DrainThreadBuffers();
+
+	sem_destroy(&m_SemaphoreForFlusher);
+
+	return s;
+}
+
+CLStatus CLLogger::WriteLogToThreadBuffer(SLLoggerThreadBuffer *pBuffer, const char *pstrMsg, unsigned int nMsgLength, const char *pstrErrcode, unsigned int nErrcodeLength)
+{
+	unsigned int nLength = nMsgLength + nErrcodeLength;
+
+	if(nLength > pBuffer->nSize)
+	{
+		if(m_nOverflowPolicy == LOGGER_OVERFLOW_DROP)
+		{
+			pBuffer->nDropped++;
+			return CLStatus(-1, 0);
+		}
+
+		//ȵȴ֮߳ǰ־дֱдļԱ˳
+		while(pBuffer->nHead != pBuffer->nTail)
+		{
+			WakeupFlusher();
+			sched_yield();
+		}
+
+		return WriteMsgAndErrcodeToFile(m_Fd, pstrMsg, pstrErrcode);
+	}
+
+	unsigned long nTail = pBuffer->nTail;
+
+	while(nTail + nLength - pBuffer->nHead > pBuffer->nSize)
+	{
+		if(m_nOverflowPolicy == LOGGER_OVERFLOW_DROP)
+		{
+			pBuffer->nDropped++;
+			return CLStatus(-1, 0);
+		}
+
+		WakeupFlusher();
+		sched_yield();
+	}
+
+	CopyToThreadBuffer(pBuffer, nTail, pstrMsg, nMsgLength);
+	CopyToThreadBuffer(pBuffer, nTail + nMsgLength, pstrErrcode, nErrcodeLength);
+
+	__sync_synchronize();
+	pBuffer->nTail = nTail + nLength;
+
+	//ʱŻѺ̨̣߳ȴ䶨ʱд
+	if(nTail + nLength - pBuffer->nHead > pBuffer->nSize / 2)
+		WakeupFlusher();
+
+	return CLStatus(0, 0);
+}
+
+void CLLogger::CopyToThreadBuffer(SLLoggerThreadBuffer *pBuffer, unsigned long nPosition, const char *pData, unsigned int nLength)
+{
+	unsigned int nStart = nPosition % pBuffer->nSize;
+	unsigned int nFirst = pBuffer->nSize - nStart;
+	if(nFirst > nLength)
+		nFirst = nLength;
+
+	memcpy(pBuffer->pData + nStart, pData, nFirst);
+	memcpy(pBuffer->pData, pData + nFirst, nLength - nFirst);
+}
+
+void CLLogger::WakeupFlusher()
+{
+	if((m_bFlusherSleeping) && (__sync_bool_compare_and_swap(&m_bFlusherSleeping, 1, 0)))
+		sem_post(&m_SemaphoreForFlusher);
+}
+
+void* CLLogger::FlusherThread(void *pContext)
+{
+	CLLogger *pLog = (CLLogger *)pContext;
+
+	while(true)
+	{
+		pLog->DrainThreadBuffers();
+
+		if(pLog->m_bStopFlusher)
+			break;
+
+		struct timespec ts;
+		clock_gettime(CLOCK_REALTIME, &ts);
+		ts.tv_sec += LOGGER_ASYNC_FLUSH_INTERVAL_MS / 1000;
+		ts.tv_nsec += (LOGGER_ASYNC_FLUSH_INTERVAL_MS % 1000) * 1000000L;
+		if(ts.tv_nsec >= 1000000000L)
+		{
+			ts.tv_sec++;
+			ts.tv_nsec -= 1000000000L;
+		}
+
+		//Ļʹ־ӳһд
+		pLog->m_bFlusherSleeping = 1;
+		__sync_synchronize();
+
+		while((sem_timedwait(&(pLog->m_SemaphoreForFlusher), &ts) == -1) && (errno == EINTR))
+			;
+
+		pLog->m_bFlusherSleeping = 0;
+	}
+
+	return 0;
+}
+
+CLStatus CLLogger::DrainThreadBuffers()
+{
+	int r = pthread_mutex_lock(&m_MutexForDrain);
+	if(r != 0)
+		return CLStatus(-1, r);
+
+	r = pthread_mutex_lock(&m_MutexForThreadBuffers);
+	if(r != 0)
+	{
+		pthread_mutex_unlock(&m_MutexForDrain);
+		return CLStatus(-1, r);
+	}
+
+	SLLoggerThreadBuffer *pFirst = m_pThreadBuffers;
+
+	pthread_mutex_unlock(&m_MutexForThreadBuffers);
+
+	m_DrainIovecs.clear();
+	m_DrainBuffers.clear();
+	m_DrainTails.clear();
+
+	unsigned long nDropped = 0;
+
+	for(SLLoggerThreadBuffer *pBuffer = pFirst; pBuffer != 0; pBuffer = pBuffer->pNext)
+	{
+		unsigned long nDroppedOfBuffer = pBuffer->nDropped;
+		nDropped += nDroppedOfBuffer - pBuffer->nReportedDrops;
+		pBuffer->nReportedDrops = nDroppedOfBuffer;
+
+		unsigned long nTail = pBuffer->nTail;
+		__sync_synchronize();
+
+		unsigned long nHead = pBuffer->nHead;
+		if(nTail == nHead)
+			continue;
+
+		unsigned int nStart = nHead % pBuffer->nSize;
+		unsigned long nLength = nTail - nHead;
+		unsigned long nFirst = pBuffer->nSize - nStart;
+		if(nFirst > nLength)
+			nFirst = nLength;
+
+		struct iovec iov;
+		iov.iov_base = pBuffer->pData + nStart;
+		iov.iov_len = nFirst;
+		m_DrainIovecs.push_back(iov);
+
+		if(nLength > nFirst)
+		{
+			iov.iov_base = pBuffer->pData;
+			iov.iov_len = nLength - nFirst;
+			m_DrainIovecs.push_back(iov);
+		}
+
+		m_DrainBuffers.push_back(pBuffer);
+		m_DrainTails.push_back(nTail);
+	}
+
+	char buf[MAX_SIZE];
+	if(nDropped != 0)
+	{
+		snprintf(buf, MAX_SIZE, "In CLLogger::DrainThreadBuffers(), thread buffer full, logs dropped	Error code: %lu\r\n", nDropped);
+
+		struct iovec iov;
+		iov.iov_base = buf;
+		iov.iov_len = strlen(buf);
+		m_DrainIovecs.push_back(iov);
+	}
+
+	long lReturnCode = 0;
+	long lErrorCode = 0;
+
+	if(!m_DrainIovecs.empty())
+	{
+		if(WritevOfProcessSafety(m_Fd, &(m_DrainIovecs[0]), m_DrainIovecs.size()) == -1)
+		{
+			lReturnCode = -1;
+			lErrorCode = errno;
+		}
+	}
+
+	//дʧʱͬͷſռ䣬д־߳̿һֱ
+	__sync_synchronize();
+
+	for(unsigned int i = 0; i < m_DrainBuffers.size(); i++)
+		m_DrainBuffers[i]->nHead = m_DrainTails[i];
+
+	pthread_mutex_unlock(&m_MutexForDrain);
+
+	return CLStatus(lReturnCode, lErrorCode);
+}
+
+unsigned long CLLogger::GetNumberOfDroppedLogs()
+{
+	if(pthread_mutex_lock(&m_MutexForThreadBuffers) != 0)
+		return 0;
+
+	unsigned long nDropped = 0;
+	for(SLLoggerThreadBuffer *pBuffer = m_pThreadBuffers; pBuffer != 0; pBuffer = pBuffer->pNext)
+		nDropped += pBuffer->nDropped;
+
+	pthread_mutex_unlock(&m_MutexForThreadBuffers);
+
+	return nDropped;
+}
+
+SLLoggerThreadBuffer* CLLogger::GetThreadBuffer()
+{
+	if(t_pLoggerThreadBuffer != 0)
+		return t_pLoggerThreadBuffer;
+
+	if(pthread_once(&m_OnceForKey, CreateKey) != 0)
+		return 0;
+
+	if(pthread_mutex_lock(&m_MutexForThreadBuffers) != 0)
+		return 0;
+
+	SLLoggerThreadBuffer *pBuffer = m_pThreadBuffers;
+	while((pBuffer != 0) && (pBuffer->bInUse))
+		pBuffer = pBuffer->pNext;
+
+	if(pBuffer == 0)
+	{
+		pBuffer = (SLLoggerThreadBuffer *)malloc(sizeof(SLLoggerThreadBuffer));
+		if(pBuffer != 0)
+		{
+			memset(pBuffer, 0, sizeof(SLLoggerThreadBuffer));
+
+			pBuffer->nSize = m_nSizeOfThreadBuffer;
+			pBuffer->pData = (char *)malloc(pBuffer->nSize);
+			if(pBuffer->pData == 0)
+			{
+				free(pBuffer);
+				pBuffer = 0;
+			}
+			else
+			{
+				pBuffer->pNext = m_pThreadBuffers;
+				m_pThreadBuffers = pBuffer;
+			}
+		}
+	}
+
+	if(pBuffer != 0)
+		pBuffer->bInUse = true;
+
+	pthread_mutex_unlock(&m_MutexForThreadBuffers);
+
+	if(pBuffer == 0)
+		return 0;
+
+	pthread_setspecific(m_KeyForThreadBuffer, pBuffer);
+	t_pLoggerThreadBuffer = pBuffer;
+
+	return pBuffer;
+}
+
+void CLLogger::CreateKey()
+{
+	pthread_key_create(&m_KeyForThreadBuffer, OnThreadExit);
+}
+
+void CLLogger::OnThreadExit(void *pBuffer)
+{
+	if(pthread_mutex_lock(&m_MutexForThreadBuffers) != 0)
+		return;
+
+	//δд־ɺ̨߳д֮߳̽ӹ
+	((SLLoggerThreadBuffer *)pBuffer)->bInUse = false;
+
+	pthread_mutex_unlock(&m_MutexForThreadBuffers);
+}
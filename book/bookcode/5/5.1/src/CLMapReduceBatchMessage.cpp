@@ -0,0 +1,79 @@
+#include <string.h>
+#include "CLMapReduceBatchMessage.h"
+#include "CLMapReduceHashTable.h"
+#include "CLMapReduceReducer.h"
+
+#define SIZE_OF_MAP_REDUCE_BATCH_ENTRY_HEAD 16
+#define ALIGN_OF_MAP_REDUCE_BATCH_ENTRY(n) (((n) + 7) & ~7UL)
+
+CLMapReduceBatchMessage::CLMapReduceBatchMessage(CLMapReduceHashTable *pTable) : CLMessage(MAP_REDUCE_BATCH_ID)
+{
+	m_pBuffer = 0;
+	m_nLength = 0;
+	m_nEntries = 0;
+
+	if(pTable == 0)
+		throw "In CLMapReduceBatchMessage::CLMapReduceBatchMessage(), pTable error";
+
+	SLMapReduceEntry *pEntries = pTable->GetEntries();
+	unsigned int nSize = pTable->GetSize();
+
+	//еĿλòͳƳһη
+	unsigned int nFound = 0;
+	for(unsigned int i = 0; nFound < nSize; i++)
+	{
+		if(pEntries[i].pKey == 0)
+			continue;
+
+		m_nLength += SIZE_OF_MAP_REDUCE_BATCH_ENTRY_HEAD + ALIGN_OF_MAP_REDUCE_BATCH_ENTRY(pEntries[i].nKeyLength);
+		nFound++;
+	}
+
+	if(m_nLength == 0)
+		return;
+
+	m_pBuffer = new char[m_nLength];
+
+	char *p = m_pBuffer;
+	for(unsigned int i = 0; m_nEntries < nSize; i++)
+	{
+		if(pEntries[i].pKey == 0)
+			continue;
+
+		*(unsigned int *)p = pEntries[i].nHash;
+		*(unsigned int *)(p + 4) = pEntries[i].nKeyLength;
+		*(unsigned long long *)(p + 8) = pEntries[i].nValue;
+		memcpy(p + SIZE_OF_MAP_REDUCE_BATCH_ENTRY_HEAD, pEntries[i].pKey, pEntries[i].nKeyLength);
+
+		p += SIZE_OF_MAP_REDUCE_BATCH_ENTRY_HEAD + ALIGN_OF_MAP_REDUCE_BATCH_ENTRY(pEntries[i].nKeyLength);
+		m_nEntries++;
+	}
+}
+
+CLMapReduceBatchMessage::~CLMapReduceBatchMessage()
+{
+	delete [] m_pBuffer;
+}
+
+void CLMapReduceBatchMessage::AddTo(CLMapReduceHashTable *pTable)
+{
+	if(pTable == 0)
+		return;
+
+	char *p = m_pBuffer;
+	for(unsigned int i = 0; i < m_nEntries; i++)
+	{
+		unsigned int nHash = *(unsigned int *)p;
+		unsigned int nKeyLength = *(unsigned int *)(p + 4);
+		unsigned long long nValue = *(unsigned long long *)(p + 8);
+
+		pTable->Add(p + SIZE_OF_MAP_REDUCE_BATCH_ENTRY_HEAD, nKeyLength, nHash, nValue);
+
+		p += SIZE_OF_MAP_REDUCE_BATCH_ENTRY_HEAD + ALIGN_OF_MAP_REDUCE_BATCH_ENTRY(nKeyLength);
+	}
+}
+
+unsigned int CLMapReduceBatchMessage::GetNumberOfEntries()
+{
+	return m_nEntries;
+}
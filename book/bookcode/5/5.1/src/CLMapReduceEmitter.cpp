@@ -0,0 +1,80 @@
+#include "CLMapReduceEmitter.h"
+#include "CLMapReduceHashTable.h"
+#include "CLMapReduceBatchMessage.h"
+#include "CLExecutiveNameServer.h"
+#include "CLLogger.h"
+
+CLMapReduceEmitter::CLMapReduceEmitter(const std::vector<std::string>& ReducerNames, unsigned int nMaxKeys)
+{
+	if(ReducerNames.empty())
+		throw "In CLMapReduceEmitter::CLMapReduceEmitter(), ReducerNames error";
+
+	if(nMaxKeys == 0)
+		throw "In CLMapReduceEmitter::CLMapReduceEmitter(), nMaxKeys error";
+
+	m_ReducerNames = ReducerNames;
+
+	m_nMaxKeysPerPartition = nMaxKeys / ReducerNames.size();
+	if(m_nMaxKeysPerPartition == 0)
+		m_nMaxKeysPerPartition = 1;
+
+	m_nBatches = 0;
+	m_nFailedBatches = 0;
+
+	for(unsigned int i = 0; i < ReducerNames.size(); i++)
+		m_Tables.push_back(new CLMapReduceHashTable);
+}
+
+CLMapReduceEmitter::~CLMapReduceEmitter()
+{
+	for(unsigned int i = 0; i < m_Tables.size(); i++)
+		delete m_Tables[i];
+}
+
+void CLMapReduceEmitter::Emit(const char *pKey, unsigned int nKeyLength, unsigned long long nValue)
+{
+	unsigned int nHash = CLMapReduceHashTable::Hash(pKey, nKeyLength);
+	unsigned int nPartition = CLMapReduceHashTable::GetPartition(nHash, m_Tables.size());
+
+	CLMapReduceHashTable *pTable = m_Tables[nPartition];
+	pTable->Add(pKey, nKeyLength, nHash, nValue);
+
+	if(pTable->GetSize() >= m_nMaxKeysPerPartition)
+		FlushPartition(nPartition);
+}
+
+CLStatus CLMapReduceEmitter::Flush()
+{
+	for(unsigned int i = 0; i < m_Tables.size(); i++)
+		FlushPartition(i);
+
+	if(m_nFailedBatches != 0)
+		return CLStatus(-1, 0);
+
+	return CLStatus(0, 0);
+}
+
+void CLMapReduceEmitter::FlushPartition(unsigned int nPartition)
+{
+	CLMapReduceHashTable *pTable = m_Tables[nPartition];
+	if(pTable->GetSize() == 0)
+		return;
+
+	CLMapReduceBatchMessage *pMsg = new CLMapReduceBatchMessage(pTable);
+	pTable->Clear();
+
+	m_nBatches++;
+
+	//ԼִĶн磬ʱڴӳִ岻Ƶռڴ
+	CLStatus s = CLExecutiveNameServer::PostExecutiveMessage(m_ReducerNames[nPartition].c_str(), pMsg);
+	if(!s.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLMapReduceEmitter::FlushPartition(), CLExecutiveNameServer::PostExecutiveMessage error", 0);
+		m_nFailedBatches++;
+	}
+}
+
+unsigned long long CLMapReduceEmitter::GetNumberOfBatches()
+{
+	return m_nBatches;
+}
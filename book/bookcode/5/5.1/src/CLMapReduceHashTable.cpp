@@ -0,0 +1,195 @@
+#include <string.h>
+#include <algorithm>
+#include "CLMapReduceHashTable.h"
+
+CLMapReduceHashTable::CLMapReduceHashTable(unsigned int nInitialCapacity)
+{
+	m_nCapacity = 16;
+	while(m_nCapacity < nInitialCapacity)
+		m_nCapacity <<= 1;
+
+	m_pEntries = new SLMapReduceEntry[m_nCapacity];
+	memset(m_pEntries, 0, sizeof(SLMapReduceEntry) * m_nCapacity);
+
+	m_nSize = 0;
+	m_bSorted = false;
+
+	m_pArenaCurrent = 0;
+	m_nArenaLeft = 0;
+}
+
+CLMapReduceHashTable::~CLMapReduceHashTable()
+{
+	for(unsigned int i = 0; i < m_ArenaBlocks.size(); i++)
+		delete [] m_ArenaBlocks[i];
+
+	for(unsigned int i = 0; i < m_LargeKeys.size(); i++)
+		delete [] m_LargeKeys[i];
+
+	delete [] m_pEntries;
+}
+
+void CLMapReduceHashTable::Add(const char *pKey, unsigned int nKeyLength, unsigned int nHash, unsigned long long nValue)
+{
+	if(m_bSorted)
+		return;
+
+	unsigned int nMask = m_nCapacity - 1;
+	unsigned int i = nHash & nMask;
+
+	while(m_pEntries[i].pKey != 0)
+	{
+		SLMapReduceEntry *p = &m_pEntries[i];
+		if((p->nHash == nHash) && (p->nKeyLength == nKeyLength) && (memcmp(p->pKey, pKey, nKeyLength) == 0))
+		{
+			p->nValue += nValue;
+			return;
+		}
+
+		i = (i + 1) & nMask;
+	}
+
+	m_pEntries[i].pKey = CopyKey(pKey, nKeyLength);
+	m_pEntries[i].nKeyLength = nKeyLength;
+	m_pEntries[i].nHash = nHash;
+	m_pEntries[i].nValue = nValue;
+
+	//Ӳ1/2̽кܶ
+	if(++m_nSize * 2 > m_nCapacity)
+		Grow();
+}
+
+void CLMapReduceHashTable::Grow()
+{
+	unsigned int nCapacity = m_nCapacity * 2;
+	unsigned int nMask = nCapacity - 1;
+
+	SLMapReduceEntry *pEntries = new SLMapReduceEntry[nCapacity];
+	memset(pEntries, 0, sizeof(SLMapReduceEntry) * nCapacity);
+
+	for(unsigned int i = 0; i < m_nCapacity; i++)
+	{
+		if(m_pEntries[i].pKey == 0)
+			continue;
+
+		unsigned int j = m_pEntries[i].nHash & nMask;
+		while(pEntries[j].pKey != 0)
+			j = (j + 1) & nMask;
+
+		pEntries[j] = m_pEntries[i];
+	}
+
+	delete [] m_pEntries;
+
+	m_pEntries = pEntries;
+	m_nCapacity = nCapacity;
+}
+
+const char *CLMapReduceHashTable::CopyKey(const char *pKey, unsigned int nKeyLength)
+{
+	//Ϊ0ļҲҪһ0ĵַڿλ
+	unsigned long nSize = (nKeyLength == 0) ? 1 : nKeyLength;
+
+	//ļ䣬˷ѵǰʣռ
+	if(nSize > SIZE_OF_MAP_REDUCE_ARENA_BLOCK / 16)
+	{
+		char *pLarge = new char[nSize];
+		memcpy(pLarge, pKey, nKeyLength);
+		m_LargeKeys.push_back(pLarge);
+		return pLarge;
+	}
+
+	if(nSize > m_nArenaLeft)
+	{
+		m_pArenaCurrent = new char[SIZE_OF_MAP_REDUCE_ARENA_BLOCK];
+		m_nArenaLeft = SIZE_OF_MAP_REDUCE_ARENA_BLOCK;
+		m_ArenaBlocks.push_back(m_pArenaCurrent);
+	}
+
+	char *p = m_pArenaCurrent;
+	memcpy(p, pKey, nKeyLength);
+
+	m_pArenaCurrent += nSize;
+	m_nArenaLeft -= nSize;
+
+	return p;
+}
+
+void CLMapReduceHashTable::Clear()
+{
+	memset(m_pEntries, 0, sizeof(SLMapReduceEntry) * m_nCapacity);
+	m_nSize = 0;
+	m_bSorted = false;
+
+	for(unsigned int i = 0; i < m_LargeKeys.size(); i++)
+		delete [] m_LargeKeys[i];
+
+	m_LargeKeys.clear();
+
+	if(m_ArenaBlocks.empty())
+		return;
+
+	for(unsigned int i = 1; i < m_ArenaBlocks.size(); i++)
+		delete [] m_ArenaBlocks[i];
+
+	m_ArenaBlocks.resize(1);
+
+	m_pArenaCurrent = m_ArenaBlocks[0];
+	m_nArenaLeft = SIZE_OF_MAP_REDUCE_ARENA_BLOCK;
+}
+
+void CLMapReduceHashTable::CompactAndSort()
+{
+	if(m_bSorted)
+		return;
+
+	unsigned int n = 0;
+	for(unsigned int i = 0; i < m_nCapacity; i++)
+	{
+		if(m_pEntries[i].pKey != 0)
+			m_pEntries[n++] = m_pEntries[i];
+	}
+
+	std::sort(m_pEntries, m_pEntries + n, IsKeyLess);
+
+	m_bSorted = true;
+}
+
+unsigned int CLMapReduceHashTable::GetSize()
+{
+	return m_nSize;
+}
+
+SLMapReduceEntry *CLMapReduceHashTable::GetEntries()
+{
+	return m_pEntries;
+}
+
+unsigned int CLMapReduceHashTable::Hash(const char *pKey, unsigned int nKeyLength)
+{
+	//FNV-1a
+	unsigned int h = 2166136261U;
+	for(unsigned int i = 0; i < nKeyLength; i++)
+	{
+		h ^= (unsigned char)pKey[i];
+		h *= 16777619U;
+	}
+
+	return h;
+}
+
+unsigned int CLMapReduceHashTable::GetPartition(unsigned int nHash, unsigned int nPartitions)
+{
+	return (unsigned int)(((unsigned long long)nHash * nPartitions) >> 32);
+}
+
+bool CLMapReduceHashTable::IsKeyLess(const SLMapReduceEntry& e1, const SLMapReduceEntry& e2)
+{
+	unsigned int n = (e1.nKeyLength < e2.nKeyLength) ? e1.nKeyLength : e2.nKeyLength;
+
+	int r = memcmp(e1.pKey, e2.pKey, n);
+	if(r != 0)
+		return r < 0;
+
+	return e1.nKeyLength < e2.nKeyLength;
+}
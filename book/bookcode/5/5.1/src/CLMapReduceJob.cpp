@@ -0,0 +1,378 @@
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include "CLMapReduceJob.h"
+#include "CLMapReduceMapper.h"
+#include "CLMapReduceMapperFunction.h"
+#include "CLMapReduceEmitter.h"
+#include "CLMapReduceHashTable.h"
+#include "CLMapReduceReducer.h"
+#include "CLThreadForMsgLoop.h"
+#include "CLMessageQueueBySTLqueue.h"
+#include "CLExecutiveNameServer.h"
+#include "CLThread.h"
+#include "CLMessage.h"
+#include "CLLogger.h"
+
+#define LENGTH_OF_REDUCER_INDEX 32
+#define SIZE_OF_MAP_REDUCE_OUTPUT_BUFFER (1024 * 1024)
+
+CLMapReduceJob::CLMapReduceJob(const std::vector<CLMapReduceMapper*>& Mappers, unsigned int nReducers, const char *pstrJobName, unsigned long nSplitSize)
+{
+	if(Mappers.empty())
+		throw "In CLMapReduceJob::CLMapReduceJob(), Mappers error";
+
+	for(unsigned int i = 0; i < Mappers.size(); i++)
+	{
+		if(Mappers[i] == 0)
+			throw "In CLMapReduceJob::CLMapReduceJob(), Mappers error";
+	}
+
+	if(nReducers == 0)
+		throw "In CLMapReduceJob::CLMapReduceJob(), nReducers error";
+
+	if((pstrJobName == 0) || (strlen(pstrJobName) == 0))
+		throw "In CLMapReduceJob::CLMapReduceJob(), pstrJobName error";
+
+	if(nSplitSize == 0)
+		throw "In CLMapReduceJob::CLMapReduceJob(), nSplitSize error";
+
+	m_Mappers = Mappers;
+	m_strJobName = pstrJobName;
+	m_nSplitSize = nSplitSize;
+	m_bRunCalled = false;
+
+	m_nNextSplit = 0;
+	m_nInputLength = 0;
+
+	m_nBatches = 0;
+	m_nFailedMappers = 0;
+	m_nKeys = 0;
+
+	for(unsigned int i = 0; i < nReducers; i++)
+	{
+		char index[LENGTH_OF_REDUCER_INDEX];
+		snprintf(index, LENGTH_OF_REDUCER_INDEX, "_reduce_%u", i);
+
+		m_ReducerNames.push_back(m_strJobName + index);
+		m_Tables.push_back(new CLMapReduceHashTable);
+	}
+}
+
+CLMapReduceJob::~CLMapReduceJob()
+{
+	StopReducers();
+
+	for(unsigned int i = 0; i < m_Tables.size(); i++)
+		delete m_Tables[i];
+
+	for(unsigned int i = 0; i < m_InputFiles.size(); i++)
+	{
+		if(munmap(m_InputFiles[i].pAddress, m_InputFiles[i].nLength) == -1)
+			CLLogger::WriteLogMsg("In CLMapReduceJob::~CLMapReduceJob(), munmap error", errno);
+	}
+
+	for(unsigned int i = 0; i < m_Mappers.size(); i++)
+		delete m_Mappers[i];
+}
+
+CLStatus CLMapReduceJob::AddInputFile(const char *pstrFileName)
+{
+	if(m_bRunCalled || (pstrFileName == 0))
+		return CLStatus(-1, 0);
+
+	int fd = open(pstrFileName, O_RDONLY);
+	if(fd == -1)
+	{
+		CLLogger::WriteLogMsg("In CLMapReduceJob::AddInputFile(), open error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	struct stat st;
+	if(fstat(fd, &st) == -1)
+	{
+		int err = errno;
+		CLLogger::WriteLogMsg("In CLMapReduceJob::AddInputFile(), fstat error", err);
+		close(fd);
+		return CLStatus(-1, err);
+	}
+
+	if(st.st_size == 0)
+	{
+		close(fd);
+		return CLStatus(0, 0);
+	}
+
+	void *pAddress = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	int err = errno;
+	close(fd);
+
+	if(pAddress == MAP_FAILED)
+	{
+		CLLogger::WriteLogMsg("In CLMapReduceJob::AddInputFile(), mmap error", err);
+		return CLStatus(-1, err);
+	}
+
+	//ÿһӳִͷβ˳ɨ
+	madvise(pAddress, st.st_size, MADV_SEQUENTIAL);
+
+	SLMapReduceInputFile file;
+	file.pAddress = pAddress;
+	file.nLength = st.st_size;
+	m_InputFiles.push_back(file);
+
+	m_nInputLength += file.nLength;
+
+	const char *pData = (const char *)pAddress;
+	unsigned long nOffset = 0;
+
+	while(nOffset < file.nLength)
+	{
+		unsigned long nEnd = file.nLength;
+		if(file.nLength - nOffset > m_nSplitSize)
+		{
+			nEnd = m_Mappers[0]->FindSplitEnd(pData, file.nLength, nOffset + m_nSplitSize);
+			if((nEnd <= nOffset) || (nEnd > file.nLength))
+				nEnd = file.nLength;
+		}
+
+		SLMapReduceSplit split;
+		split.pData = pData + nOffset;
+		split.nLength = nEnd - nOffset;
+		m_Splits.push_back(split);
+
+		nOffset = nEnd;
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMapReduceJob::AddInputDirectory(const char *pstrDirName)
+{
+	if(m_bRunCalled || (pstrDirName == 0))
+		return CLStatus(-1, 0);
+
+	DIR *pDir = opendir(pstrDirName);
+	if(pDir == 0)
+	{
+		CLLogger::WriteLogMsg("In CLMapReduceJob::AddInputDirectory(), opendir error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	//ļʹε˳readdirص˳޹
+	std::vector<std::string> Files;
+	while(struct dirent *pDirent = readdir(pDir))
+	{
+		std::string strPath = std::string(pstrDirName) + "/" + pDirent->d_name;
+
+		struct stat st;
+		if((stat(strPath.c_str(), &st) == 0) && S_ISREG(st.st_mode))
+			Files.push_back(strPath);
+	}
+
+	closedir(pDir);
+
+	std::sort(Files.begin(), Files.end());
+
+	for(unsigned int i = 0; i < Files.size(); i++)
+	{
+		CLStatus s = AddInputFile(Files[i].c_str());
+		if(!s.IsSuccess())
+			return s;
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMapReduceJob::Run(const char *pstrOutputFile)
+{
+	if(m_bRunCalled)
+		return CLStatus(-1, 0);
+
+	m_bRunCalled = true;
+
+	CLStatus s = StartReducers();
+	if(!s.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLMapReduceJob::Run(), StartReducers error", 0);
+		StopReducers();
+		return CLStatus(-1, 0);
+	}
+
+	CLStatus s1 = RunMappers();
+
+	//ӳִ嶼ѽǷζڹԼִĶУϢ
+	StopReducers();
+
+	if(!s1.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLMapReduceJob::Run(), RunMappers error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	return WriteOutput(pstrOutputFile);
+}
+
+CLStatus CLMapReduceJob::StartReducers()
+{
+	for(unsigned int i = 0; i < m_ReducerNames.size(); i++)
+	{
+		CLThreadForMsgLoop *pReducer = new CLThreadForMsgLoop(new CLMapReduceReducer(m_Tables[i]), m_ReducerNames[i].c_str(), true, EXECUTIVE_IN_PROCESS_USE_STL_QUEUE, CAPACITY_OF_MAP_REDUCE_REDUCER_QUEUE, MESSAGE_QUEUE_OVERFLOW_BLOCK);
+
+		m_Reducers.push_back(pReducer);
+
+		CLStatus s = pReducer->Run(0);
+		if(!s.IsSuccess())
+		{
+			CLLogger::WriteLogMsg("In CLMapReduceJob::StartReducers(), pReducer->Run error", 0);
+			return CLStatus(-1, 0);
+		}
+	}
+
+	return CLStatus(0, 0);
+}
+
+void CLMapReduceJob::StopReducers()
+{
+	for(unsigned int i = 0; i < m_Reducers.size(); i++)
+	{
+		CLStatus s = CLExecutiveNameServer::PostExecutiveMessage(m_ReducerNames[i].c_str(), new CLMessage(MAP_REDUCE_FINISH_ID));
+		if(!s.IsSuccess())
+			CLLogger::WriteLogMsg("In CLMapReduceJob::StopReducers(), CLExecutiveNameServer::PostExecutiveMessage error", 0);
+	}
+
+	//ʱȴԼ߳˳
+	for(unsigned int i = 0; i < m_Reducers.size(); i++)
+		delete m_Reducers[i];
+
+	m_Reducers.clear();
+}
+
+CLStatus CLMapReduceJob::RunMappers()
+{
+	std::vector<CLThread*> Threads;
+
+	for(unsigned int i = 0; i < m_Mappers.size(); i++)
+	{
+		CLThread *pThread = new CLThread(new CLMapReduceMapperFunction(this, m_Mappers[i], new CLMapReduceEmitter(m_ReducerNames)), true);
+
+		//RunʧʱCLThreadѱɾʣµӳִԻȡ
+		CLStatus s = pThread->Run(0);
+		if(!s.IsSuccess())
+		{
+			CLLogger::WriteLogMsg("In CLMapReduceJob::RunMappers(), pThread->Run error", 0);
+			continue;
+		}
+
+		Threads.push_back(pThread);
+	}
+
+	for(unsigned int i = 0; i < Threads.size(); i++)
+	{
+		CLStatus s = Threads[i]->WaitForDeath();
+		if(!s.IsSuccess())
+			CLLogger::WriteLogMsg("In CLMapReduceJob::RunMappers(), Threads[i]->WaitForDeath error", 0);
+	}
+
+	if(Threads.empty() || (m_nFailedMappers != 0))
+		return CLStatus(-1, 0);
+
+	return CLStatus(0, 0);
+}
+
+SLMapReduceSplit *CLMapReduceJob::GetNextSplit()
+{
+	unsigned long n = __sync_fetch_and_add(&m_nNextSplit, 1);
+	if(n >= m_Splits.size())
+		return 0;
+
+	return &m_Splits[n];
+}
+
+void CLMapReduceJob::OnMapperFinished(unsigned long long nBatches, bool bSuccess)
+{
+	__sync_fetch_and_add(&m_nBatches, nBatches);
+
+	if(!bSuccess)
+		__sync_fetch_and_add(&m_nFailedMappers, 1);
+}
+
+CLStatus CLMapReduceJob::WriteOutput(const char *pstrOutputFile)
+{
+	m_nKeys = 0;
+	for(unsigned int i = 0; i < m_Tables.size(); i++)
+		m_nKeys += m_Tables[i]->GetSize();
+
+	if(pstrOutputFile == 0)
+		return CLStatus(0, 0);
+
+	FILE *fp = fopen(pstrOutputFile, "w");
+	if(fp == 0)
+	{
+		CLLogger::WriteLogMsg("In CLMapReduceJob::WriteOutput(), fopen error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	setvbuf(fp, 0, _IOFBF, SIZE_OF_MAP_REDUCE_OUTPUT_BUFFER);
+
+	//ѷֱźһֻһȡǰСļ
+	std::vector<unsigned int> Positions(m_Tables.size(), 0);
+
+	for(;;)
+	{
+		SLMapReduceEntry *pMin = 0;
+		unsigned int nMinPartition = 0;
+
+		for(unsigned int i = 0; i < m_Tables.size(); i++)
+		{
+			if(Positions[i] >= m_Tables[i]->GetSize())
+				continue;
+
+			SLMapReduceEntry *p = &(m_Tables[i]->GetEntries()[Positions[i]]);
+			if((pMin == 0) || CLMapReduceHashTable::IsKeyLess(*p, *pMin))
+			{
+				pMin = p;
+				nMinPartition = i;
+			}
+		}
+
+		if(pMin == 0)
+			break;
+
+		Positions[nMinPartition]++;
+
+		fwrite(pMin->pKey, 1, pMin->nKeyLength, fp);
+		fprintf(fp, "\t%llu\n", pMin->nValue);
+	}
+
+	bool bError = (ferror(fp) != 0);
+
+	if((fclose(fp) != 0) || bError)
+	{
+		CLLogger::WriteLogMsg("In CLMapReduceJob::WriteOutput(), write error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	return CLStatus(0, 0);
+}
+
+unsigned long long CLMapReduceJob::GetInputLength()
+{
+	return m_nInputLength;
+}
+
+unsigned long long CLMapReduceJob::GetNumberOfKeys()
+{
+	return m_nKeys;
+}
+
+unsigned long long CLMapReduceJob::GetNumberOfBatches()
+{
+	return m_nBatches;
+}
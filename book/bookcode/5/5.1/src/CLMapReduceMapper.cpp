@@ -0,0 +1,22 @@
+#include <string.h>
+#include "CLMapReduceMapper.h"
+
+CLMapReduceMapper::CLMapReduceMapper()
+{
+}
+
+CLMapReduceMapper::~CLMapReduceMapper()
+{
+}
+
+unsigned long CLMapReduceMapper::FindSplitEnd(const char *pData, unsigned long nLength, unsigned long nOffset)
+{
+	if(nOffset >= nLength)
+		return nLength;
+
+	const char *p = (const char *)memchr(pData + nOffset, '\n', nLength - nOffset);
+	if(p == 0)
+		return nLength;
+
+	return p - pData + 1;
+}
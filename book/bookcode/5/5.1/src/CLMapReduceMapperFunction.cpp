@@ -0,0 +1,49 @@
+#include "CLMapReduceMapperFunction.h"
+#include "CLMapReduceJob.h"
+#include "CLMapReduceMapper.h"
+#include "CLMapReduceEmitter.h"
+#include "CLLogger.h"
+
+CLMapReduceMapperFunction::CLMapReduceMapperFunction(CLMapReduceJob *pJob, CLMapReduceMapper *pMapper, CLMapReduceEmitter *pEmitter)
+{
+	if((pJob == 0) || (pMapper == 0) || (pEmitter == 0))
+		throw "In CLMapReduceMapperFunction::CLMapReduceMapperFunction(), parameter error";
+
+	m_pJob = pJob;
+	m_pMapper = pMapper;
+	m_pEmitter = pEmitter;
+}
+
+CLMapReduceMapperFunction::~CLMapReduceMapperFunction()
+{
+	delete m_pEmitter;
+}
+
+CLStatus CLMapReduceMapperFunction::RunExecutiveFunction(void*)
+{
+	bool bSuccess = true;
+
+	while(SLMapReduceSplit *pSplit = m_pJob->GetNextSplit())
+	{
+		CLStatus s = m_pMapper->Map(pSplit->pData, pSplit->nLength, m_pEmitter);
+		if(!s.IsSuccess())
+		{
+			CLLogger::WriteLogMsg("In CLMapReduceMapperFunction::RunExecutiveFunction(), m_pMapper->Map error", 0);
+			bSuccess = false;
+		}
+	}
+
+	CLStatus s1 = m_pEmitter->Flush();
+	if(!s1.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLMapReduceMapperFunction::RunExecutiveFunction(), m_pEmitter->Flush error", 0);
+		bSuccess = false;
+	}
+
+	m_pJob->OnMapperFinished(m_pEmitter->GetNumberOfBatches(), bSuccess);
+
+	if(bSuccess)
+		return CLStatus(0, 0);
+	else
+		return CLStatus(-1, 0);
+}
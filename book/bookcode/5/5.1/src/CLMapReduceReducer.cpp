@@ -0,0 +1,43 @@
+#include "CLMapReduceReducer.h"
+#include "CLMapReduceBatchMessage.h"
+#include "CLMapReduceHashTable.h"
+#include "CLMessageLoopManager.h"
+#include "CLMessage.h"
+
+CLMapReduceReducer::CLMapReduceReducer(CLMapReduceHashTable *pTable)
+{
+	if(pTable == 0)
+		throw "In CLMapReduceReducer::CLMapReduceReducer(), pTable error";
+
+	m_pTable = pTable;
+}
+
+CLMapReduceReducer::~CLMapReduceReducer()
+{
+}
+
+CLStatus CLMapReduceReducer::Initialize(CLMessageLoopManager *pMessageLoop, void*)
+{
+	pMessageLoop->Register(MAP_REDUCE_BATCH_ID, (CallBackForMessageLoop)(&CLMapReduceReducer::On_Batch));
+	pMessageLoop->Register(MAP_REDUCE_FINISH_ID, (CallBackForMessageLoop)(&CLMapReduceReducer::On_Finish));
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMapReduceReducer::On_Batch(CLMessage *pm)
+{
+	CLMapReduceBatchMessage *p = dynamic_cast<CLMapReduceBatchMessage *>(pm);
+	if(p == 0)
+		return CLStatus(0, 0);
+
+	p->AddTo(m_pTable);
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMapReduceReducer::On_Finish(CLMessage *)
+{
+	m_pTable->CompactAndSort();
+
+	return CLStatus(QUIT_MESSAGE_LOOP, 0);
+}
@@ -1,8 +1,14 @@
 #include "CLMessage.h"
 
-CLMessage::CLMessage(unsigned long lMsgID) : m_clMsgID(m_lMsgID)
+CLMessage::CLMessage(unsigned long lMsgID, int nPriority) : m_clMsgID(m_lMsgID), m_clPriority(m_nPriority)
 {
 	m_lMsgID = lMsgID;
+	m_nEnqueueTime = 0;
+
+	if((nPriority < 0) || (nPriority >= NUMBER_OF_MESSAGE_PRIORITIES))
+		m_nPriority = MESSAGE_PRIORITY_NORMAL;
+	else
+		m_nPriority = nPriority;
 }
 
 CLMessage::~CLMessage()
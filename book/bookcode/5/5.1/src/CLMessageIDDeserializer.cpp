@@ -0,0 +1,18 @@
+#include "CLMessageIDDeserializer.h"
+#include "CLMessage.h"
+
+CLMessageIDDeserializer::CLMessageIDDeserializer()
+{
+}
+
+CLMessageIDDeserializer::~CLMessageIDDeserializer()
+{
+}
+
+CLMessage *CLMessageIDDeserializer::Deserialize(const char *pBuffer, unsigned int nLength)
+{
+	if((pBuffer == 0) || (nLength < sizeof(unsigned long)))
+		return 0;
+
+	return new CLMessage(*((const unsigned long *)pBuffer));
+}
@@ -0,0 +1,29 @@
+#include "CLMessageIDSerializer.h"
+#include "CLSerializeCursor.h"
+#include "CLMessage.h"
+
+CLMessageIDSerializer::CLMessageIDSerializer()
+{
+}
+
+CLMessageIDSerializer::~CLMessageIDSerializer()
+{
+}
+
+unsigned int CLMessageIDSerializer::GetSerializedLength(CLMessage *pMsg)
+{
+	if(pMsg == 0)
+		return 0;
+
+	return sizeof(unsigned long);
+}
+
+CLStatus CLMessageIDSerializer::Serialize(CLMessage *pMsg, CLSerializeCursor *pCursor)
+{
+	if((pMsg == 0) || (pCursor == 0))
+		return CLStatus(-1, 0);
+
+	unsigned long lMsgID = pMsg->m_clMsgID;
+
+	return pCursor->Write(&lMsgID, sizeof(lMsgID));
+}
@@ -1,19 +1,41 @@
+#include <string.h>
 #include "CLMessageLoopManager.h"
 #include "CLMessageObserver.h"
 #include "CLMessage.h"
 #include "CLLogger.h"
 #include "CLExecutiveInitialFinishedNotifier.h"
+#include "CLExecutiveNameServer.h"
+#include "CLTimingWheel.h"
+#include "CLTimerMessage.h"
+#include "CLExecutiveMetrics.h"
+#include "CLRequestMessage.h"
+#include "CLResponseMessage.h"
+#include "CLPendingRequestTable.h"
 
-CLMessageLoopManager::CLMessageLoopManager(CLMessageObserver *pMessageObserver)
+CLMessageLoopManager::CLMessageLoopManager(CLMessageObserver *pMessageObserver, const char *pstrExecutiveName, bool bSharedName)
 {
 	if(pMessageObserver == 0)
 		throw "In CLMessageLoopManager::CLMessageLoopManager(), pMessageObserver error";
 	
 	m_pMessageObserver = pMessageObserver;
+	m_nBatchSize = 1;
+	m_pTimingWheel = 0;
+	m_pPendingRequests = 0;
+	m_bSharedName = bSharedName;
+
+	m_pMetrics = 0;
+	if((pstrExecutiveName != 0) && (strlen(pstrExecutiveName) != 0))
+	{
+		m_strExecutiveName = pstrExecutiveName;
+		m_pMetrics = new CLExecutiveMetrics(pstrExecutiveName, this);
+	}
 }
 
 CLMessageLoopManager::~CLMessageLoopManager()
 {
+	delete m_pPendingRequests;
+	delete m_pMetrics;
+	delete m_pTimingWheel;
 	delete m_pMessageObserver;
 }
 
@@ -22,11 +44,150 @@ CLStatus CLMessageLoopManager::Register(unsigned long lMsgID, CallBackForMessage
 	if(pMsgProcessFunction == 0)
 		return CLStatus(-1, 0);
 	
-	m_MsgMappingTable[lMsgID] = pMsgProcessFunction;
+	m_MsgMappingTable.Set(lMsgID, pMsgProcessFunction);
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMessageLoopManager::SetBatchSize(unsigned int nBatchSize)
+{
+	if((nBatchSize == 0) || (nBatchSize > MAX_SIZE_OF_MESSAGE_BATCH))
+		return CLStatus(-1, 0);
+
+	m_nBatchSize = nBatchSize;
+
+	return CLStatus(0, 0);
+}
+
+unsigned long CLMessageLoopManager::SetTimer(unsigned long lMsgID, unsigned long lDelayMs, unsigned long lIntervalMs, void *pContext, const char *pstrExecutiveName)
+{
+	if(!IsTimedWaitSupported())
+	{
+		CLLogger::WriteLogMsg("In CLMessageLoopManager::SetTimer(), timed wait is not supported", 0);
+		return 0;
+	}
+
+	int nTarget = -1;
+	if(pstrExecutiveName != 0)
+	{
+		for(unsigned int i = 0; i < m_TimerTargets.size(); i++)
+		{
+			if(m_TimerTargets[i] == pstrExecutiveName)
+			{
+				nTarget = i;
+				break;
+			}
+		}
+
+		if(nTarget == -1)
+		{
+			nTarget = m_TimerTargets.size();
+			m_TimerTargets.push_back(pstrExecutiveName);
+		}
+	}
+
+	unsigned long long nNow = CLTimingWheel::GetCurrentTime();
+
+	if(m_pTimingWheel == 0)
+		m_pTimingWheel = new CLTimingWheel(nNow);
+
+	unsigned long nTimerID = m_pTimingWheel->AddTimer(nNow, lDelayMs, lIntervalMs, lMsgID, pContext, nTarget);
+	if(nTimerID == 0)
+		CLLogger::WriteLogMsg("In CLMessageLoopManager::SetTimer(), m_pTimingWheel->AddTimer error", 0);
+
+	return nTimerID;
+}
+
+CLStatus CLMessageLoopManager::KillTimer(unsigned long nTimerID)
+{
+	if((m_pTimingWheel == 0) || (!m_pTimingWheel->CancelTimer(nTimerID)))
+		return CLStatus(-1, 0);
+
+	return CLStatus(0, 0);
+}
+
+unsigned long CLMessageLoopManager::SendRequest(const char *pstrExecutiveName, CLRequestMessage *pRequest, CallBackForResponse pFunction, unsigned long lTimeoutMs, void *pContext)
+{
+	if(pRequest == 0)
+		return 0;
+
+	if((pFunction == 0) || m_strExecutiveName.empty())
+	{
+		CLLogger::WriteLogMsg("In CLMessageLoopManager::SendRequest(), pFunction or executive name error", 0);
+		delete pRequest;
+		return 0;
+	}
+
+	//ӦͶݣƱʱϢѭȡ
+	if(m_bSharedName)
+	{
+		CLLogger::WriteLogMsg("In CLMessageLoopManager::SendRequest(), the executive name is shared, responses can't be routed back", 0);
+		delete pRequest;
+		return 0;
+	}
+
+	if(m_pPendingRequests == 0)
+		m_pPendingRequests = new CLPendingRequestTable;
+
+	unsigned long nRequestID = m_pPendingRequests->Add(pFunction, pContext);
+	if(nRequestID == 0)
+	{
+		CLLogger::WriteLogMsg("In CLMessageLoopManager::SendRequest(), m_pPendingRequests->Add error", 0);
+		delete pRequest;
+		return 0;
+	}
+
+	if(lTimeoutMs != 0)
+	{
+		unsigned long nTimerID = SetTimer(MESSAGE_ID_OF_REQUEST_TIMEOUT, lTimeoutMs, 0, (void *)nRequestID);
+		if(nTimerID == 0)
+		{
+			CLLogger::WriteLogMsg("In CLMessageLoopManager::SendRequest(), SetTimer error", 0);
+			m_pPendingRequests->Remove(nRequestID);
+			delete pRequest;
+			return 0;
+		}
+
+		m_pPendingRequests->Find(nRequestID)->nTimerID = nTimerID;
+	}
+
+	pRequest->m_nRequestID = nRequestID;
+	pRequest->m_strReplyTo = m_strExecutiveName;
+
+	//ͶʧʱַͷpRequest
+	CLStatus s = CLExecutiveNameServer::PostExecutiveMessage(pstrExecutiveName, pRequest);
+	if(!s.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLMessageLoopManager::SendRequest(), CLExecutiveNameServer::PostExecutiveMessage error", 0);
+		CancelRequest(nRequestID);
+		return 0;
+	}
+
+	return nRequestID;
+}
+
+CLStatus CLMessageLoopManager::CancelRequest(unsigned long nRequestID)
+{
+	if(m_pPendingRequests == 0)
+		return CLStatus(-1, 0);
+
+	SLPendingRequest *pRequest = m_pPendingRequests->Find(nRequestID);
+	if(pRequest == 0)
+		return CLStatus(-1, 0);
+
+	if(pRequest->nTimerID != 0)
+		KillTimer(pRequest->nTimerID);
+
+	m_pPendingRequests->Remove(nRequestID);
 
 	return CLStatus(0, 0);
 }
 
+CLStatus CLMessageLoopManager::GetQueueStatistics(SLMessageQueueStatistics *)
+{
+	return CLStatus(-1, 0);
+}
+
 CLStatus CLMessageLoopManager::EnterMessageLoop(void *pContext)
 {	
 	SLExecutiveInitialParameter *para = (SLExecutiveInitialParameter *)pContext;
@@ -55,25 +216,41 @@ CLStatus CLMessageLoopManager::EnterMessageLoop(void *pContext)
 		return CLStatus(-1, 0);
 	}
 
+	if(m_pMetrics != 0)
+		m_pMetrics->Register();
+
 	para->pNotifier->NotifyInitialFinished(true);
-	
-	while(true)
+
+	if(m_nBatchSize > 1)
+		EnterBatchedMessageLoop();
+	else
 	{
-		CLMessage *pMsg = WaitForMessage();
-		if(pMsg == 0)
+		while(true)
 		{
-			CLLogger::WriteLogMsg("In CLMessageLoopManager::EnterMessageLoop(), pMsg == 0", 0);
-			continue;
-		}
+			CLMessage *pMsg = 0;
+			bool bQuit = false;
+
+			if(GetMessages(&pMsg, 1, &bQuit) == 0)
+			{
+				if(bQuit)
+					break;
+
+				continue;
+			}
 		
-		CLStatus s3 = DispatchMessage(pMsg);
+			CLStatus s3 = DispatchMessage(pMsg);
 
-		delete pMsg;
+			delete pMsg;
 
-		if(s3.m_clReturnCode == QUIT_MESSAGE_LOOP)
-			break;
+			if(s3.m_clReturnCode == QUIT_MESSAGE_LOOP)
+				break;
+		}
 	}
 
+	//עͳƿղٷϢУUninitializeܰȫͷ
+	if(m_pMetrics != 0)
+		m_pMetrics->Unregister();
+
 	CLStatus s4 = Uninitialize();
 	if(!s4.IsSuccess())
 	{
@@ -86,16 +263,181 @@ CLStatus CLMessageLoopManager::EnterMessageLoop(void *pContext)
 
 CLStatus CLMessageLoopManager::DispatchMessage(CLMessage *pMessage)
 {
-	std::map<unsigned long, CallBackForMessageLoop>::iterator it;
-	it = m_MsgMappingTable.find(pMessage->m_clMsgID);
+	if((m_pPendingRequests != 0) && ((pMessage->m_clMsgID == MESSAGE_ID_OF_RESPONSE) || (pMessage->m_clMsgID == MESSAGE_ID_OF_REQUEST_TIMEOUT)))
+		return DispatchResponse(pMessage);
 
-	if(it == m_MsgMappingTable.end())
+	CallBackForMessageLoop *ppFunction = m_MsgMappingTable.Find(pMessage->m_clMsgID);
+	if(ppFunction == 0)
 	{
-		CLLogger::WriteLogMsg("In CLMessageLoopManager::MessageDispatch(), it == m_MsgMappingTable.end", 0);
+		CLLogger::WriteLogMsg("In CLMessageLoopManager::MessageDispatch(), m_MsgMappingTable.Find error", 0);
 		return CLStatus(-1, 0);
 	}
-	
-	CallBackForMessageLoop pFunction = it->second;
 
-	return (m_pMessageObserver->*pFunction)(pMessage);
+	if((m_pMetrics == 0) || (!CLExecutiveMetrics::IsEnabled()))
+		return (m_pMessageObserver->*(*ppFunction))(pMessage);
+
+	unsigned long long nBegin = CLExecutiveMetrics::GetCurrentTime();
+
+	CLStatus s = (m_pMessageObserver->*(*ppFunction))(pMessage);
+
+	m_pMetrics->RecordDispatch(pMessage, nBegin, CLExecutiveMetrics::GetCurrentTime(), s);
+
+	return s;
+}
+
+CLStatus CLMessageLoopManager::DispatchResponse(CLMessage *pMessage)
+{
+	CLResponseMessage *pResponse = 0;
+	unsigned long nRequestID;
+
+	if(pMessage->m_clMsgID == MESSAGE_ID_OF_RESPONSE)
+	{
+		pResponse = (CLResponseMessage *)pMessage;
+		nRequestID = pResponse->m_nRequestID;
+	}
+	else
+		nRequestID = (unsigned long)(((CLTimerMessage *)pMessage)->m_pContext);
+
+	//ѳʱȡӦٵ
+	SLPendingRequest *pRequest = m_pPendingRequests->Find(nRequestID);
+	if(pRequest == 0)
+		return CLStatus(0, 0);
+
+	CallBackForResponse pFunction = pRequest->pFunction;
+	void *pContext = pRequest->pContext;
+
+	//ʱϢʱʱѾʧЧ
+	if((pResponse != 0) && (pRequest->nTimerID != 0))
+		KillTimer(pRequest->nTimerID);
+
+	//ƳٻصصпԼ
+	m_pPendingRequests->Remove(nRequestID);
+
+	return (m_pMessageObserver->*pFunction)(pResponse, pContext);
+}
+
+unsigned int CLMessageLoopManager::WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	if((ppMessages == 0) || (nMaxCount == 0))
+		return 0;
+
+	ppMessages[0] = WaitForMessage();
+	if(ppMessages[0] == 0)
+		return 0;
+
+	return 1;
+}
+
+bool CLMessageLoopManager::IsTimedWaitSupported()
+{
+	return false;
+}
+
+unsigned int CLMessageLoopManager::TimedWaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount, long)
+{
+	return WaitForMessages(ppMessages, nMaxCount);
+}
+
+void CLMessageLoopManager::EnterBatchedMessageLoop()
+{
+	unsigned int nBatchSize = m_nBatchSize;
+	CLMessage **ppMessages = new CLMessage*[nBatchSize];
+	bool bQuit = false;
+
+	while(!bQuit)
+	{
+		unsigned int n = GetMessages(ppMessages, nBatchSize, &bQuit);
+		if(n == 0)
+			continue;
+
+		CLStatus s = m_pMessageObserver->OnBatchBegin(n);
+		if(!s.IsSuccess())
+			CLLogger::WriteLogMsg("In CLMessageLoopManager::EnterBatchedMessageLoop(), m_pMessageObserver->OnBatchBegin error", 0);
+
+		for(unsigned int i = 0; i < n; i++)
+		{
+			//յ˳Ϣ󣬸ʣϢٴʽ¶ʣϢĴʽһ
+			if(!bQuit)
+			{
+				CLStatus s1 = DispatchMessage(ppMessages[i]);
+				if(s1.m_clReturnCode == QUIT_MESSAGE_LOOP)
+					bQuit = true;
+			}
+
+			delete ppMessages[i];
+		}
+
+		CLStatus s2 = m_pMessageObserver->OnBatchEnd(n);
+		if(!s2.IsSuccess())
+			CLLogger::WriteLogMsg("In CLMessageLoopManager::EnterBatchedMessageLoop(), m_pMessageObserver->OnBatchEnd error", 0);
+	}
+
+	delete [] ppMessages;
+}
+
+unsigned int CLMessageLoopManager::GetMessages(CLMessage **ppMessages, unsigned int nMaxCount, bool *pbQuit)
+{
+	if(!IsTimedWaitSupported())
+	{
+		unsigned int n = 0;
+
+		if(nMaxCount == 1)
+		{
+			ppMessages[0] = WaitForMessage();
+			if(ppMessages[0] != 0)
+				n = 1;
+		}
+		else
+			n = WaitForMessages(ppMessages, nMaxCount);
+
+		if(n == 0)
+			CLLogger::WriteLogMsg("In CLMessageLoopManager::GetMessages(), no message", 0);
+
+		return n;
+	}
+
+	CLStatus s = ProcessExpiredTimers();
+	if(s.m_clReturnCode == QUIT_MESSAGE_LOOP)
+	{
+		*pbQuit = true;
+		return 0;
+	}
+
+	long lTimeoutMs = -1;
+	if(m_pTimingWheel != 0)
+		lTimeoutMs = m_pTimingWheel->GetTimeout(CLTimingWheel::GetCurrentTime());
+
+	return TimedWaitForMessages(ppMessages, nMaxCount, lTimeoutMs);
+}
+
+CLStatus CLMessageLoopManager::ProcessExpiredTimers()
+{
+	if((m_pTimingWheel == 0) || (m_pTimingWheel->GetNumberOfTimers() == 0))
+		return CLStatus(0, 0);
+
+	m_pTimingWheel->Advance(CLTimingWheel::GetCurrentTime());
+
+	SLExpiredTimer timer;
+	while(m_pTimingWheel->PopExpiredTimer(&timer))
+	{
+		CLMessage *pMsg = new CLTimerMessage(timer.lMsgID, timer.nTimerID, timer.pContext, timer.nExpirations);
+
+		if(timer.nTarget != -1)
+		{
+			CLStatus s = CLExecutiveNameServer::PostExecutiveMessage(m_TimerTargets[timer.nTarget].c_str(), pMsg);
+			if(!s.IsSuccess())
+				CLLogger::WriteLogMsg("In CLMessageLoopManager::ProcessExpiredTimers(), CLExecutiveNameServer::PostExecutiveMessage error", 0);
+
+			continue;
+		}
+
+		CLStatus s1 = DispatchMessage(pMsg);
+
+		delete pMsg;
+
+		if(s1.m_clReturnCode == QUIT_MESSAGE_LOOP)
+			return CLStatus(QUIT_MESSAGE_LOOP, 0);
+	}
+
+	return CLStatus(0, 0);
 }
\ No newline at end of file
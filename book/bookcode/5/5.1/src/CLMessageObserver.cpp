@@ -6,4 +6,14 @@ CLMessageObserver::CLMessageObserver()
 
 CLMessageObserver::~CLMessageObserver()
 {
+}
+
+CLStatus CLMessageObserver::OnBatchBegin(unsigned int)
+{
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMessageObserver::OnBatchEnd(unsigned int)
+{
+	return CLStatus(0, 0);
 }
\ No newline at end of file
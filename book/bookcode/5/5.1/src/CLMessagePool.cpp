@@ -0,0 +1,268 @@
+#include <stdlib.h>
+#include <string.h>
+#include "CLMessagePool.h"
+#include "CLLogger.h"
+
+#define SIZE_OF_MESSAGE_POOL_CACHE_LINE 64
+
+struct SLMessagePoolBlockHeader
+{
+	//Ϊ0ʾÿֱmalloc
+	SLMessagePoolThreadCache *pOwner;
+	unsigned long nSizeClass;
+};
+
+struct SLMessagePoolFreeBlock
+{
+	SLMessagePoolFreeBlock *pNext;
+};
+
+struct SLMessagePoolThreadCache
+{
+	SLMessagePoolFreeBlock *pFreeLists[NUMBER_OF_MESSAGE_POOL_SIZE_CLASSES];
+
+	char Padding1[SIZE_OF_MESSAGE_POOL_CACHE_LINE];
+	SLMessagePoolFreeBlock * volatile pRemoteFreeLists[NUMBER_OF_MESSAGE_POOL_SIZE_CLASSES];
+	char Padding2[SIZE_OF_MESSAGE_POOL_CACHE_LINE];
+
+	volatile unsigned long nAllocations;
+	volatile unsigned long nFrees;
+	volatile unsigned long nRemoteFrees;
+	volatile unsigned long nSlabAllocations;
+	volatile unsigned long nLargeAllocations;
+
+	bool bInUse;
+	SLMessagePoolThreadCache *pNext;
+};
+
+static __thread SLMessagePoolThreadCache *t_pThreadCache = 0;
+
+pthread_once_t CLMessagePool::m_OnceForKey = PTHREAD_ONCE_INIT;
+pthread_key_t CLMessagePool::m_KeyForThreadCache;
+pthread_mutex_t CLMessagePool::m_MutexForThreadCaches = PTHREAD_MUTEX_INITIALIZER;
+SLMessagePoolThreadCache *CLMessagePool::m_pThreadCaches = 0;
+
+static inline void* GetPayload(SLMessagePoolBlockHeader *pHeader)
+{
+	return (char *)pHeader + sizeof(SLMessagePoolBlockHeader);
+}
+
+static inline SLMessagePoolBlockHeader* GetHeader(void *p)
+{
+	return (SLMessagePoolBlockHeader *)((char *)p - sizeof(SLMessagePoolBlockHeader));
+}
+
+void* CLMessagePool::Allocate(size_t nSize)
+{
+	SLMessagePoolThreadCache *pCache = GetThreadCache();
+	if(pCache == 0)
+		return 0;
+
+	if(nSize > MAX_SIZE_OF_MESSAGE_POOL_BLOCK)
+	{
+		SLMessagePoolBlockHeader *pHeader = (SLMessagePoolBlockHeader *)malloc(sizeof(SLMessagePoolBlockHeader) + nSize);
+		if(pHeader == 0)
+			return 0;
+
+		pHeader->pOwner = 0;
+		pHeader->nSizeClass = 0;
+
+		pCache->nAllocations++;
+		pCache->nLargeAllocations++;
+
+		return GetPayload(pHeader);
+	}
+
+	unsigned int nSizeClass = GetSizeClass(nSize);
+
+	if(pCache->pFreeLists[nSizeClass] == 0)
+	{
+		//һȡ̹߳黹ȫ飬ֻб̻߳ȡ˲ABA
+		if(pCache->pRemoteFreeLists[nSizeClass] != 0)
+			pCache->pFreeLists[nSizeClass] = __sync_lock_test_and_set(&(pCache->pRemoteFreeLists[nSizeClass]), (SLMessagePoolFreeBlock *)0);
+
+		if((pCache->pFreeLists[nSizeClass] == 0) && (!AllocateSlab(pCache, nSizeClass)))
+			return 0;
+	}
+
+	SLMessagePoolFreeBlock *pBlock = pCache->pFreeLists[nSizeClass];
+	pCache->pFreeLists[nSizeClass] = pBlock->pNext;
+
+	pCache->nAllocations++;
+
+	return pBlock;
+}
+
+void CLMessagePool::Free(void *p)
+{
+	if(p == 0)
+		return;
+
+	SLMessagePoolBlockHeader *pHeader = GetHeader(p);
+	SLMessagePoolThreadCache *pCache = GetThreadCache();
+
+	if(pHeader->pOwner == 0)
+	{
+		free(pHeader);
+
+		if(pCache != 0)
+			pCache->nFrees++;
+
+		return;
+	}
+
+	SLMessagePoolFreeBlock *pBlock = (SLMessagePoolFreeBlock *)p;
+	unsigned long nSizeClass = pHeader->nSizeClass;
+	SLMessagePoolThreadCache *pOwner = pHeader->pOwner;
+
+	if(pOwner == pCache)
+	{
+		pBlock->pNext = pCache->pFreeLists[nSizeClass];
+		pCache->pFreeLists[nSizeClass] = pBlock;
+		pCache->nFrees++;
+		return;
+	}
+
+	SLMessagePoolFreeBlock *pOldHead;
+	do
+	{
+		pOldHead = pOwner->pRemoteFreeLists[nSizeClass];
+		pBlock->pNext = pOldHead;
+	}while(!__sync_bool_compare_and_swap(&(pOwner->pRemoteFreeLists[nSizeClass]), pOldHead, pBlock));
+
+	if(pCache != 0)
+	{
+		pCache->nFrees++;
+		pCache->nRemoteFrees++;
+	}
+}
+
+CLStatus CLMessagePool::GetStatistics(SLMessagePoolStatistics *pStatistics)
+{
+	if(pStatistics == 0)
+		return CLStatus(-1, 0);
+
+	memset(pStatistics, 0, sizeof(SLMessagePoolStatistics));
+
+	int r = pthread_mutex_lock(&m_MutexForThreadCaches);
+	if(r != 0)
+	{
+		CLLogger::WriteLogMsg("In CLMessagePool::GetStatistics(), pthread_mutex_lock error", r);
+		return CLStatus(-1, r);
+	}
+
+	for(SLMessagePoolThreadCache *pCache = m_pThreadCaches; pCache != 0; pCache = pCache->pNext)
+	{
+		pStatistics->nAllocations += pCache->nAllocations;
+		pStatistics->nFrees += pCache->nFrees;
+		pStatistics->nRemoteFrees += pCache->nRemoteFrees;
+		pStatistics->nSlabAllocations += pCache->nSlabAllocations;
+		pStatistics->nLargeAllocations += pCache->nLargeAllocations;
+		pStatistics->nThreadCaches++;
+	}
+
+	r = pthread_mutex_unlock(&m_MutexForThreadCaches);
+	if(r != 0)
+	{
+		CLLogger::WriteLogMsg("In CLMessagePool::GetStatistics(), pthread_mutex_unlock error", r);
+		return CLStatus(-1, r);
+	}
+
+	return CLStatus(0, 0);
+}
+
+SLMessagePoolThreadCache* CLMessagePool::GetThreadCache()
+{
+	if(t_pThreadCache != 0)
+		return t_pThreadCache;
+
+	if(pthread_once(&m_OnceForKey, CreateKey) != 0)
+		return 0;
+
+	if(pthread_mutex_lock(&m_MutexForThreadCaches) != 0)
+		return 0;
+
+	SLMessagePoolThreadCache *pCache = m_pThreadCaches;
+	while((pCache != 0) && (pCache->bInUse))
+		pCache = pCache->pNext;
+
+	if(pCache == 0)
+	{
+		pCache = (SLMessagePoolThreadCache *)malloc(sizeof(SLMessagePoolThreadCache));
+		if(pCache != 0)
+		{
+			memset(pCache, 0, sizeof(SLMessagePoolThreadCache));
+			pCache->pNext = m_pThreadCaches;
+			m_pThreadCaches = pCache;
+		}
+	}
+
+	if(pCache != 0)
+		pCache->bInUse = true;
+
+	pthread_mutex_unlock(&m_MutexForThreadCaches);
+
+	if(pCache == 0)
+		return 0;
+
+	pthread_setspecific(m_KeyForThreadCache, pCache);
+	t_pThreadCache = pCache;
+
+	return pCache;
+}
+
+void CLMessagePool::CreateKey()
+{
+	pthread_key_create(&m_KeyForThreadCache, OnThreadExit);
+}
+
+void CLMessagePool::OnThreadExit(void *pCache)
+{
+	if(pthread_mutex_lock(&m_MutexForThreadCaches) != 0)
+		return;
+
+	((SLMessagePoolThreadCache *)pCache)->bInUse = false;
+
+	pthread_mutex_unlock(&m_MutexForThreadCaches);
+}
+
+unsigned int CLMessagePool::GetSizeClass(size_t nSize)
+{
+	unsigned int nSizeClass = 0;
+	size_t nBlockSize = MIN_SIZE_OF_MESSAGE_POOL_BLOCK;
+
+	while(nBlockSize < nSize)
+	{
+		nBlockSize <<= 1;
+		nSizeClass++;
+	}
+
+	return nSizeClass;
+}
+
+bool CLMessagePool::AllocateSlab(SLMessagePoolThreadCache *pCache, unsigned int nSizeClass)
+{
+	size_t nStride = sizeof(SLMessagePoolBlockHeader) + (MIN_SIZE_OF_MESSAGE_POOL_BLOCK << nSizeClass);
+
+	char *pSlab = (char *)malloc(nStride * NUMBER_OF_BLOCKS_PER_MESSAGE_POOL_SLAB);
+	if(pSlab == 0)
+	{
+		CLLogger::WriteLogMsg("In CLMessagePool::AllocateSlab(), malloc error", 0);
+		return false;
+	}
+
+	for(int i = NUMBER_OF_BLOCKS_PER_MESSAGE_POOL_SLAB - 1; i >= 0; i--)
+	{
+		SLMessagePoolBlockHeader *pHeader = (SLMessagePoolBlockHeader *)(pSlab + i * nStride);
+		pHeader->pOwner = pCache;
+		pHeader->nSizeClass = nSizeClass;
+
+		SLMessagePoolFreeBlock *pBlock = (SLMessagePoolFreeBlock *)GetPayload(pHeader);
+		pBlock->pNext = pCache->pFreeLists[nSizeClass];
+		pCache->pFreeLists[nSizeClass] = pBlock;
+	}
+
+	pCache->nSlabAllocations++;
+
+	return true;
+}
@@ -0,0 +1,308 @@
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdint.h>
+#include "CLMessageQueueByLockFreeRing.h"
+#include "CLMessage.h"
+#include "CLLogger.h"
+#include "CLExecutiveMetrics.h"
+#include "CLThreadPlacement.h"
+
+CLMessageQueueByLockFreeRing::CLMessageQueueByLockFreeRing(unsigned long nCapacity)
+{
+	if((nCapacity < 2) || ((nCapacity & (nCapacity - 1)) != 0))
+		throw "In CLMessageQueueByLockFreeRing::CLMessageQueueByLockFreeRing(), nCapacity error";
+
+	m_EventFd = eventfd(0, 0);
+	if(m_EventFd == -1)
+	{
+		CLLogger::WriteLogMsg("In CLMessageQueueByLockFreeRing::CLMessageQueueByLockFreeRing(), eventfd error", errno);
+		throw "In CLMessageQueueByLockFreeRing::CLMessageQueueByLockFreeRing(), eventfd error";
+	}
+
+	m_pCells = new SLLockFreeRingCell[nCapacity];
+	for(unsigned long i = 0; i < nCapacity; i++)
+	{
+		m_pCells[i].Sequence = i;
+		m_pCells[i].pMessage = 0;
+	}
+
+	m_nMask = nCapacity - 1;
+	m_nTail = 0;
+	m_nHead = 0;
+	m_nRejected = 0;
+	m_bConsumerSleeping = 0;
+}
+
+CLMessageQueueByLockFreeRing::~CLMessageQueueByLockFreeRing()
+{
+	while(true)
+	{
+		CLMessage *pMsg = Pop();
+		if(pMsg == 0)
+			break;
+
+		delete pMsg;
+	}
+
+	delete [] m_pCells;
+
+	if(close(m_EventFd) == -1)
+		CLLogger::WriteLogMsg("In CLMessageQueueByLockFreeRing::~CLMessageQueueByLockFreeRing(), close error", errno);
+}
+
+CLStatus CLMessageQueueByLockFreeRing::PushMessage(CLMessage * pMessage)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	CLExecutiveMetrics::StampEnqueueTime(pMessage);
+
+	//ıѹźţͨԣֻ¼־
+	if(!Push(pMessage))
+	{
+		__sync_fetch_and_add(&m_nRejected, 1);
+		delete pMessage;
+		return CLStatus(-1, 0);
+	}
+
+	//GetMessageжm_bConsumerSleepingԣ֤߲
+	__sync_synchronize();
+
+	if(m_bConsumerSleeping == 0)
+		return CLStatus(0, 0);
+
+	if(!__sync_bool_compare_and_swap(&m_bConsumerSleeping, 1, 0))
+		return CLStatus(0, 0);
+
+	CLStatus s = WakeupConsumer();
+	if(!s.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLMessageQueueByLockFreeRing::PushMessage(), WakeupConsumer error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLMessage* CLMessageQueueByLockFreeRing::GetMessage()
+{
+	while(true)
+	{
+		CLMessage *pMsg = Pop();
+		if(pMsg != 0)
+			return pMsg;
+
+		m_bConsumerSleeping = 1;
+		__sync_synchronize();
+
+		pMsg = Pop();
+		if(pMsg != 0)
+		{
+			m_bConsumerSleeping = 0;
+			return pMsg;
+		}
+
+		uint64_t count = 0;
+		if(read(m_EventFd, &count, sizeof(count)) == -1)
+		{
+			if(errno == EINTR)
+				continue;
+
+			CLLogger::WriteLogMsg("In CLMessageQueueByLockFreeRing::GetMessage(), read error", errno);
+			m_bConsumerSleeping = 0;
+			return 0;
+		}
+
+		m_bConsumerSleeping = 0;
+	}
+}
+
+unsigned int CLMessageQueueByLockFreeRing::GetMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	if((ppMessages == 0) || (nMaxCount == 0))
+		return 0;
+
+	ppMessages[0] = GetMessage();
+	if(ppMessages[0] == 0)
+		return 0;
+
+	unsigned int n = 1;
+	while(n < nMaxCount)
+	{
+		CLMessage *pMsg = Pop();
+		if(pMsg == 0)
+			break;
+
+		ppMessages[n++] = pMsg;
+	}
+
+	return n;
+}
+
+unsigned int CLMessageQueueByLockFreeRing::GetMessages(CLMessage **ppMessages, unsigned int nMaxCount, long lTimeoutMs)
+{
+	if(lTimeoutMs < 0)
+		return GetMessages(ppMessages, nMaxCount);
+
+	unsigned int n = TryGetMessages(ppMessages, nMaxCount);
+	if(n != 0)
+		return n;
+
+	if(!PrepareToSleep())
+		return TryGetMessages(ppMessages, nMaxCount);
+
+	struct pollfd fd;
+	fd.fd = m_EventFd;
+	fd.events = POLLIN;
+	fd.revents = 0;
+
+	int r = poll(&fd, 1, lTimeoutMs);
+	if((r == -1) && (errno != EINTR))
+		CLLogger::WriteLogMsg("In CLMessageQueueByLockFreeRing::GetMessages(), poll error", errno);
+
+	FinishSleeping(r == 1);
+
+	return TryGetMessages(ppMessages, nMaxCount);
+}
+
+int CLMessageQueueByLockFreeRing::GetEventFd()
+{
+	return m_EventFd;
+}
+
+unsigned int CLMessageQueueByLockFreeRing::TryGetMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	if(ppMessages == 0)
+		return 0;
+
+	unsigned int n = 0;
+	while(n < nMaxCount)
+	{
+		CLMessage *pMsg = Pop();
+		if(pMsg == 0)
+			break;
+
+		ppMessages[n++] = pMsg;
+	}
+
+	return n;
+}
+
+bool CLMessageQueueByLockFreeRing::PrepareToSleep()
+{
+	m_bConsumerSleeping = 1;
+	__sync_synchronize();
+
+	if(IsEmpty())
+		return true;
+
+	m_bConsumerSleeping = 0;
+	return false;
+}
+
+void CLMessageQueueByLockFreeRing::FinishSleeping(bool bEventFdReadable)
+{
+	m_bConsumerSleeping = 0;
+
+	if(!bEventFdReadable)
+		return;
+
+	uint64_t count = 0;
+	while(read(m_EventFd, &count, sizeof(count)) == -1)
+	{
+		if(errno != EINTR)
+		{
+			CLLogger::WriteLogMsg("In CLMessageQueueByLockFreeRing::FinishSleeping(), read error", errno);
+			return;
+		}
+	}
+}
+
+CLStatus CLMessageQueueByLockFreeRing::WakeupConsumer()
+{
+	uint64_t count = 1;
+
+	while(write(m_EventFd, &count, sizeof(count)) == -1)
+	{
+		if(errno != EINTR)
+			return CLStatus(-1, errno);
+	}
+
+	return CLStatus(0, 0);
+}
+
+bool CLMessageQueueByLockFreeRing::Push(CLMessage * pMessage)
+{
+	unsigned long pos = m_nTail;
+	SLLockFreeRingCell *pCell = 0;
+
+	while(true)
+	{
+		pCell = &m_pCells[pos & m_nMask];
+
+		long diff = (long)pCell->Sequence - (long)pos;
+		if(diff == 0)
+		{
+			if(__sync_bool_compare_and_swap(&m_nTail, pos, pos + 1))
+				break;
+		}
+		else if(diff < 0)
+			return false;
+
+		pos = m_nTail;
+	}
+
+	pCell->pMessage = pMessage;
+	__sync_synchronize();
+	pCell->Sequence = pos + 1;
+
+	return true;
+}
+
+CLMessage* CLMessageQueueByLockFreeRing::Pop()
+{
+	SLLockFreeRingCell *pCell = &m_pCells[m_nHead & m_nMask];
+	if(pCell->Sequence != m_nHead + 1)
+		return 0;
+
+	__sync_synchronize();
+	CLMessage *p = pCell->pMessage;
+	pCell->pMessage = 0;
+	__sync_synchronize();
+
+	pCell->Sequence = m_nHead + m_nMask + 1;
+	m_nHead++;
+
+	return p;
+}
+
+unsigned long CLMessageQueueByLockFreeRing::GetDepth()
+{
+	//m_nHeadֻ޸ģ̶߳ĿǾֵ
+	unsigned long nHead = *(volatile unsigned long *)&m_nHead;
+	unsigned long nTail = m_nTail;
+
+	return (nTail > nHead) ? (nTail - nHead) : 0;
+}
+
+unsigned long CLMessageQueueByLockFreeRing::GetCapacity()
+{
+	return m_nMask + 1;
+}
+
+unsigned long CLMessageQueueByLockFreeRing::GetRejectedCount()
+{
+	return m_nRejected;
+}
+
+bool CLMessageQueueByLockFreeRing::IsEmpty()
+{
+	return m_pCells[m_nHead & m_nMask].Sequence != m_nHead + 1;
+}
+
+CLStatus CLMessageQueueByLockFreeRing::BindToNUMANode(int nNode)
+{
+	return CLThreadPlacement::BindMemoryToNUMANode(m_pCells, (m_nMask + 1) * sizeof(SLLockFreeRingCell), nNode);
+}
@@ -48,4 +48,38 @@ CLMessage* CLMessageQueueByNamedPipe::GetMessage()
 	}
 
 	return ReadMsgFromPipe(m_Fd);
+}
+
+unsigned int CLMessageQueueByNamedPipe::GetMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	if((ppMessages == 0) || (nMaxCount == 0))
+		return 0;
+
+	CLStatus s = m_Event.Wait();
+	if(!s.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLMessageQueueByNamedPipe::GetMessages(), m_Event.Wait error", 0);
+		return 0;
+	}
+
+	long nExtra = 0;
+	if(nMaxCount > 1)
+	{
+		CLStatus s1 = m_Event.TryWait(nMaxCount - 1, &nExtra);
+		if(!s1.IsSuccess())
+		{
+			CLLogger::WriteLogMsg("In CLMessageQueueByNamedPipe::GetMessages(), m_Event.TryWait error", 0);
+			nExtra = 0;
+		}
+	}
+
+	unsigned int n = 0;
+	for(long i = 0; i <= nExtra; i++)
+	{
+		CLMessage *pMsg = ReadMsgFromPipe(m_Fd);
+		if(pMsg != 0)
+			ppMessages[n++] = pMsg;
+	}
+
+	return n;
 }
\ No newline at end of file
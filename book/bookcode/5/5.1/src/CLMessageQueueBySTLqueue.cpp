@@ -1,10 +1,26 @@
+#include <errno.h>
 #include "CLMessageQueueBySTLqueue.h"
 #include "CLCriticalSection.h"
 #include "CLMessage.h"
 #include "CLLogger.h"
+#include "CLExecutiveMetrics.h"
 
-CLMessageQueueBySTLqueue::CLMessageQueueBySTLqueue() : m_Event(true)
+CLMessageQueueBySTLqueue::CLMessageQueueBySTLqueue(unsigned long nCapacity, int OverflowPolicy) : m_Event(true)
 {
+	if((OverflowPolicy != MESSAGE_QUEUE_OVERFLOW_BLOCK) && (OverflowPolicy != MESSAGE_QUEUE_OVERFLOW_FAIL) && (OverflowPolicy != MESSAGE_QUEUE_OVERFLOW_DROP_OLDEST))
+		throw "In CLMessageQueueBySTLqueue::CLMessageQueueBySTLqueue(), OverflowPolicy error";
+
+	m_nCapacity = nCapacity;
+	m_OverflowPolicy = OverflowPolicy;
+	m_bClosed = false;
+
+	m_nBlockedProducers = 0;
+
+	m_nMaxDepth = 0;
+	m_nPushed = 0;
+	m_nDropped = 0;
+	m_nRejected = 0;
+	m_nBlocked = 0;
 }
 
 CLMessageQueueBySTLqueue::~CLMessageQueueBySTLqueue()
@@ -24,13 +40,25 @@ CLStatus CLMessageQueueBySTLqueue::PushMessage(CLMessage * pMessage)
 	if(pMessage == NULL)
 		return CLStatus(-1, 0);
 	
-	CLStatus s = Push(pMessage);
+	CLExecutiveMetrics::StampEnqueueTime(pMessage);
+
+	CLMessage *pDropped = 0;
+
+	//ܾϢѼͳƣPushֻڵһξܾʱ¼־
+	CLStatus s = Push(pMessage, &pDropped);
 	if(!s.IsSuccess())
 	{
-		CLLogger::WriteLogMsg("In CLMessageQueue::PushMessage(), Push error", 0);
+		delete pMessage;
 		return CLStatus(-1, 0);
 	}
 
+	//滻ϢʱеϢ䣬ٷź
+	if(pDropped != 0)
+	{
+		delete pDropped;
+		return CLStatus(0, 0);
+	}
+
 	CLStatus s2 = m_Event.Set();
 	if(!s2.IsSuccess())
 	{
@@ -53,40 +81,196 @@ CLMessage* CLMessageQueueBySTLqueue::GetMessage()
 	return Pop();
 }
 
-CLStatus CLMessageQueueBySTLqueue::Push(CLMessage * pMessage)
+unsigned int CLMessageQueueBySTLqueue::GetMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	return GetMessages(ppMessages, nMaxCount, -1);
+}
+
+unsigned int CLMessageQueueBySTLqueue::GetMessages(CLMessage **ppMessages, unsigned int nMaxCount, long lTimeoutMs)
+{
+	if((ppMessages == 0) || (nMaxCount == 0))
+		return 0;
+
+	CLStatus s = m_Event.TimedWait(lTimeoutMs);
+	if(!s.IsSuccess())
+	{
+		if(s.m_clErrorCode != ETIMEDOUT)
+			CLLogger::WriteLogMsg("In CLMessageQueue::GetMessages(), m_Event.TimedWait error", 0);
+
+		return 0;
+	}
+
+	long nExtra = 0;
+	if(nMaxCount > 1)
+	{
+		CLStatus s1 = m_Event.TryWait(nMaxCount - 1, &nExtra);
+		if(!s1.IsSuccess())
+		{
+			CLLogger::WriteLogMsg("In CLMessageQueue::GetMessages(), m_Event.TryWait error", 0);
+			nExtra = 0;
+		}
+	}
+
+	return Pop(ppMessages, nExtra + 1);
+}
+
+void CLMessageQueueBySTLqueue::Close()
+{
+	try
+	{
+		CLCriticalSection cs(&m_Mutex);
+
+		m_bClosed = true;
+
+		if(m_nBlockedProducers != 0)
+			m_CondForNotFull.WakeupAll();
+	}
+	catch(const char* str)
+	{
+		CLLogger::WriteLogMsg("In CLMessageQueue::Close(), exception arise", 0);
+	}
+}
+
+CLStatus CLMessageQueueBySTLqueue::GetStatistics(SLMessageQueueStatistics *pStatistics)
 {
+	if(pStatistics == 0)
+		return CLStatus(-1, 0);
+
 	try
 	{
 		CLCriticalSection cs(&m_Mutex);
 
-		m_MessageQueue.push(pMessage);
+		for(int i = 0; i < NUMBER_OF_MESSAGE_PRIORITIES; i++)
+			pStatistics->nDepth[i] = m_MessageQueue[i].size();
+
+		pStatistics->nMaxDepth = m_nMaxDepth;
+		pStatistics->nCapacity = m_nCapacity;
+		pStatistics->nPushed = m_nPushed;
+		pStatistics->nDropped = m_nDropped;
+		pStatistics->nRejected = m_nRejected;
+		pStatistics->nBlocked = m_nBlocked;
+	}
+	catch(const char* str)
+	{
+		CLLogger::WriteLogMsg("In CLMessageQueue::GetStatistics(), exception arise", 0);
+		return CLStatus(-1, 0);
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMessageQueueBySTLqueue::Push(CLMessage * pMessage, CLMessage **ppDropped)
+{
+	try
+	{
+		CLCriticalSection cs(&m_Mutex);
+
+		int nPriority = pMessage->m_clPriority;
+		std::queue<CLMessage*> *pQueue = &m_MessageQueue[nPriority];
+
+		//ȼĿϢ
+		bool bFull = (nPriority != MESSAGE_PRIORITY_HIGH) && (m_nCapacity != MESSAGE_QUEUE_UNBOUNDED) && (pQueue->size() >= m_nCapacity);
+
+		if((!m_bClosed) && bFull)
+		{
+			if(m_OverflowPolicy == MESSAGE_QUEUE_OVERFLOW_DROP_OLDEST)
+			{
+				*ppDropped = pQueue->front();
+				pQueue->pop();
+				m_nDropped++;
+			}
+			else if(m_OverflowPolicy == MESSAGE_QUEUE_OVERFLOW_BLOCK)
+			{
+				m_nBlocked++;
+
+				while((!m_bClosed) && (pQueue->size() >= m_nCapacity))
+				{
+					m_nBlockedProducers++;
+					CLStatus s = m_CondForNotFull.Wait(&m_Mutex);
+					m_nBlockedProducers--;
+
+					if(!s.IsSuccess())
+					{
+						CLLogger::WriteLogMsg("In CLMessageQueue::Push(), m_CondForNotFull.Wait error", 0);
+						m_nRejected++;
+						return CLStatus(-1, 0);
+					}
+				}
+			}
+			else
+			{
+				CountRejection();
+				return CLStatus(-1, 0);
+			}
+		}
+
+		if(m_bClosed)
+		{
+			CountRejection();
+			return CLStatus(-1, 0);
+		}
+
+		pQueue->push(pMessage);
+		m_nPushed++;
+
+		unsigned long nDepth = m_MessageQueue[MESSAGE_PRIORITY_HIGH].size() + m_MessageQueue[MESSAGE_PRIORITY_NORMAL].size();
+		if(nDepth > m_nMaxDepth)
+			m_nMaxDepth = nDepth;
 	}
 	catch(const char* str)
 	{
 		CLLogger::WriteLogMsg("In CLMessageQueue::Push(), exception arise", 0);
-		delete pMessage;
 		return CLStatus(-1, 0);
 	}
 
 	return CLStatus(0, 0);
 }
 
+void CLMessageQueueBySTLqueue::CountRejection()
+{
+	//ʱÿϢᱻֻܾ¼һ־֮ľܾͳл
+	if(m_nRejected++ == 0)
+		CLLogger::WriteLogMsg("In CLMessageQueue::Push(), queue is full or closed, later rejections are only counted", 0);
+}
+
 CLMessage* CLMessageQueueBySTLqueue::Pop()
 {
+	CLMessage *p = 0;
+	if(Pop(&p, 1) == 0)
+		return 0;
+
+	return p;
+}
+
+unsigned int CLMessageQueueBySTLqueue::Pop(CLMessage **ppMessages, unsigned int nCount)
+{
+	unsigned int n = 0;
+
 	try
 	{
 		CLCriticalSection cs(&m_Mutex);
 
-		if(m_MessageQueue.empty())
-			return 0;
+		for(int i = 0; i < NUMBER_OF_MESSAGE_PRIORITIES; i++)
+		{
+			while((n < nCount) && (!m_MessageQueue[i].empty()))
+			{
+				ppMessages[n++] = m_MessageQueue[i].front();
+				m_MessageQueue[i].pop();
+			}
+		}
 
-		CLMessage *p = m_MessageQueue.front();
-		m_MessageQueue.pop();
-		return p;
+		if((n != 0) && (m_nBlockedProducers != 0))
+		{
+			if(n == 1)
+				m_CondForNotFull.Wakeup();
+			else
+				m_CondForNotFull.WakeupAll();
+		}
 	}
 	catch(const char* str)
 	{
 		CLLogger::WriteLogMsg("In CLMessageQueue::Pop(), exception arise", 0);
-		return 0;
 	}
+
+	return n;
 }
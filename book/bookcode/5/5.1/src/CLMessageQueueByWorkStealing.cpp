@@ -0,0 +1,432 @@
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdint.h>
+#include <vector>
+#include "CLMessageQueueByWorkStealing.h"
+#include "CLCriticalSection.h"
+#include "CLMessage.h"
+#include "CLLogger.h"
+#include "CLExecutiveMetrics.h"
+
+static __thread CLMessageQueueByWorkStealing *t_pCurrentQueue = 0;
+static __thread unsigned int t_nCurrentWorker = 0;
+
+CLMessageQueueByWorkStealing::CLMessageQueueByWorkStealing(unsigned int nWorkers)
+{
+	if(nWorkers == 0)
+		throw "In CLMessageQueueByWorkStealing::CLMessageQueueByWorkStealing(), nWorkers error";
+
+	m_ppWorkers = new SLWorkStealingWorker*[nWorkers];
+
+	for(unsigned int i = 0; i < nWorkers; i++)
+	{
+		m_ppWorkers[i] = new SLWorkStealingWorker;
+		m_ppWorkers[i]->nMessages = 0;
+		m_ppWorkers[i]->nStealable = 0;
+		m_ppWorkers[i]->bSleeping = 0;
+
+		m_ppWorkers[i]->EventFd = eventfd(0, 0);
+		if(m_ppWorkers[i]->EventFd == -1)
+		{
+			CLLogger::WriteLogMsg("In CLMessageQueueByWorkStealing::CLMessageQueueByWorkStealing(), eventfd error", errno);
+
+			for(unsigned int j = 0; j < i; j++)
+			{
+				close(m_ppWorkers[j]->EventFd);
+				delete m_ppWorkers[j];
+			}
+
+			delete m_ppWorkers[i];
+			delete [] m_ppWorkers;
+
+			throw "In CLMessageQueueByWorkStealing::CLMessageQueueByWorkStealing(), eventfd error";
+		}
+	}
+
+	m_nWorkers = nWorkers;
+	m_nReferences = 1;
+	m_nExecutives = 0;
+	m_bQuit = 0;
+	m_nNextWorker = 0;
+	m_nSleepingWorkers = 0;
+}
+
+CLMessageQueueByWorkStealing::~CLMessageQueueByWorkStealing()
+{
+	for(unsigned int i = 0; i < m_nWorkers; i++)
+	{
+		SLWorkStealingWorker *pWorker = m_ppWorkers[i];
+
+		for(unsigned int j = 0; j < pWorker->Messages.size(); j++)
+			delete pWorker->Messages[j];
+
+		while(!pWorker->PinnedMessages.empty())
+		{
+			delete pWorker->PinnedMessages.front();
+			pWorker->PinnedMessages.pop();
+		}
+
+		if(close(pWorker->EventFd) == -1)
+			CLLogger::WriteLogMsg("In CLMessageQueueByWorkStealing::~CLMessageQueueByWorkStealing(), close error", errno);
+
+		delete pWorker;
+	}
+
+	delete [] m_ppWorkers;
+}
+
+void CLMessageQueueByWorkStealing::AddReference()
+{
+	__sync_fetch_and_add(&m_nReferences, 1);
+}
+
+void CLMessageQueueByWorkStealing::Release()
+{
+	if(__sync_sub_and_fetch(&m_nReferences, 1) == 0)
+		delete this;
+}
+
+void CLMessageQueueByWorkStealing::EnterExecutive()
+{
+	__sync_fetch_and_add(&m_nExecutives, 1);
+}
+
+unsigned int CLMessageQueueByWorkStealing::LeaveExecutive()
+{
+	return __sync_sub_and_fetch(&m_nExecutives, 1);
+}
+
+unsigned int CLMessageQueueByWorkStealing::GetNumberOfWorkers()
+{
+	return m_nWorkers;
+}
+
+void CLMessageQueueByWorkStealing::BindCurrentThread(unsigned int nWorker)
+{
+	t_pCurrentQueue = this;
+	t_nCurrentWorker = nWorker;
+}
+
+CLStatus CLMessageQueueByWorkStealing::PushMessage(CLMessage *pMessage)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	unsigned int nWorker;
+	if(t_pCurrentQueue == this)
+		nWorker = t_nCurrentWorker;
+	else
+		nWorker = __sync_fetch_and_add(&m_nNextWorker, 1) % m_nWorkers;
+
+	CLExecutiveMetrics::StampEnqueueTime(pMessage);
+
+	CLStatus s = Push(nWorker, pMessage, false);
+	if(!s.IsSuccess())
+		return s;
+
+	//GetMessageжbSleepingԣ֤̲߳
+	__sync_synchronize();
+
+	if(m_ppWorkers[nWorker]->bSleeping)
+	{
+		WakeupWorker(nWorker);
+		return CLStatus(0, 0);
+	}
+
+	//Ŀ߳æһеĹ߳ȡ
+	if(m_nSleepingWorkers != 0)
+		WakeupSleepingWorker(nWorker + 1);
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMessageQueueByWorkStealing::PushMessage(CLMessage *pMessage, unsigned long lAffinityKey)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	unsigned int nWorker = lAffinityKey % m_nWorkers;
+
+	CLExecutiveMetrics::StampEnqueueTime(pMessage);
+
+	CLStatus s = Push(nWorker, pMessage, true);
+	if(!s.IsSuccess())
+		return s;
+
+	__sync_synchronize();
+
+	if(m_ppWorkers[nWorker]->bSleeping)
+		WakeupWorker(nWorker);
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMessageQueueByWorkStealing::Push(unsigned int nWorker, CLMessage *pMessage, bool bPinned)
+{
+	if(m_bQuit)
+	{
+		delete pMessage;
+		return CLStatus(-1, 0);
+	}
+
+	SLWorkStealingWorker *pWorker = m_ppWorkers[nWorker];
+
+	try
+	{
+		CLCriticalSection cs(&(pWorker->Mutex));
+
+		if(bPinned)
+			pWorker->PinnedMessages.push(pMessage);
+		else
+		{
+			pWorker->Messages.push_back(pMessage);
+			pWorker->nStealable++;
+		}
+
+		pWorker->nMessages++;
+	}
+	catch(const char* str)
+	{
+		CLLogger::WriteLogMsg("In CLMessageQueueByWorkStealing::Push(), exception arise", 0);
+		delete pMessage;
+		return CLStatus(-1, 0);
+	}
+
+	return CLStatus(0, 0);
+}
+
+void CLMessageQueueByWorkStealing::WakeupWorker(unsigned int nWorker)
+{
+	if(!__sync_bool_compare_and_swap(&(m_ppWorkers[nWorker]->bSleeping), 1, 0))
+		return;
+
+	uint64_t count = 1;
+	while(write(m_ppWorkers[nWorker]->EventFd, &count, sizeof(count)) == -1)
+	{
+		if(errno != EINTR)
+		{
+			CLLogger::WriteLogMsg("In CLMessageQueueByWorkStealing::WakeupWorker(), write error", errno);
+			return;
+		}
+	}
+}
+
+bool CLMessageQueueByWorkStealing::WakeupSleepingWorker(unsigned int nBegin)
+{
+	for(unsigned int i = 0; i < m_nWorkers; i++)
+	{
+		unsigned int nWorker = (nBegin + i) % m_nWorkers;
+		if((m_ppWorkers[nWorker]->bSleeping) && (__sync_bool_compare_and_swap(&(m_ppWorkers[nWorker]->bSleeping), 1, 0)))
+		{
+			uint64_t count = 1;
+			while((write(m_ppWorkers[nWorker]->EventFd, &count, sizeof(count)) == -1) && (errno == EINTR))
+				;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+CLMessage* CLMessageQueueByWorkStealing::GetMessage(unsigned int nWorker)
+{
+	SLWorkStealingWorker *pWorker = m_ppWorkers[nWorker];
+
+	while(true)
+	{
+		if(m_bQuit)
+			return 0;
+
+		CLMessage *pMsg = PopLocal(nWorker);
+		if(pMsg != 0)
+			return pMsg;
+
+		pMsg = Steal(nWorker);
+		if(pMsg != 0)
+			return pMsg;
+
+		pWorker->bSleeping = 1;
+		__sync_fetch_and_add(&m_nSleepingWorkers, 1);
+		__sync_synchronize();
+
+		if((m_bQuit) || (HasMessages(nWorker)))
+		{
+			//CASʧܣ˵дeventfd´˯߻
+			__sync_bool_compare_and_swap(&(pWorker->bSleeping), 1, 0);
+			__sync_fetch_and_sub(&m_nSleepingWorkers, 1);
+			continue;
+		}
+
+		uint64_t count = 0;
+		int r = read(pWorker->EventFd, &count, sizeof(count));
+
+		__sync_fetch_and_sub(&m_nSleepingWorkers, 1);
+		pWorker->bSleeping = 0;
+
+		if((r == -1) && (errno != EINTR))
+		{
+			CLLogger::WriteLogMsg("In CLMessageQueueByWorkStealing::GetMessage(), read error", errno);
+			return 0;
+		}
+	}
+}
+
+unsigned int CLMessageQueueByWorkStealing::GetMessages(unsigned int nWorker, CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	if((ppMessages == 0) || (nMaxCount == 0))
+		return 0;
+
+	ppMessages[0] = GetMessage(nWorker);
+	if(ppMessages[0] == 0)
+		return 0;
+
+	unsigned int n = 1;
+	while(n < nMaxCount)
+	{
+		CLMessage *pMsg = PopLocal(nWorker);
+		if(pMsg == 0)
+			break;
+
+		ppMessages[n++] = pMsg;
+	}
+
+	return n;
+}
+
+CLMessage* CLMessageQueueByWorkStealing::PopLocal(unsigned int nWorker)
+{
+	SLWorkStealingWorker *pWorker = m_ppWorkers[nWorker];
+	if(pWorker->nMessages == 0)
+		return 0;
+
+	try
+	{
+		CLCriticalSection cs(&(pWorker->Mutex));
+
+		CLMessage *p = 0;
+
+		if(!pWorker->PinnedMessages.empty())
+		{
+			p = pWorker->PinnedMessages.front();
+			pWorker->PinnedMessages.pop();
+		}
+		else if(!pWorker->Messages.empty())
+		{
+			p = pWorker->Messages.front();
+			pWorker->Messages.pop_front();
+			pWorker->nStealable--;
+		}
+
+		if(p != 0)
+			pWorker->nMessages--;
+
+		return p;
+	}
+	catch(const char* str)
+	{
+		CLLogger::WriteLogMsg("In CLMessageQueueByWorkStealing::PopLocal(), exception arise", 0);
+		return 0;
+	}
+}
+
+CLMessage* CLMessageQueueByWorkStealing::Steal(unsigned int nWorker)
+{
+	std::vector<CLMessage*> Stolen;
+
+	for(unsigned int i = 1; i < m_nWorkers; i++)
+	{
+		SLWorkStealingWorker *pVictim = m_ppWorkers[(nWorker + i) % m_nWorkers];
+		if(pVictim->nStealable == 0)
+			continue;
+
+		try
+		{
+			CLCriticalSection cs(&(pVictim->Mutex));
+
+			//ȡһ룬һ׺Ϣȡ
+			unsigned int nCount = (pVictim->Messages.size() + 1) / 2;
+			for(unsigned int j = 0; j < nCount; j++)
+			{
+				Stolen.push_back(pVictim->Messages.back());
+				pVictim->Messages.pop_back();
+			}
+
+			pVictim->nMessages -= nCount;
+			pVictim->nStealable -= nCount;
+		}
+		catch(const char* str)
+		{
+			CLLogger::WriteLogMsg("In CLMessageQueueByWorkStealing::Steal(), exception arise", 0);
+			return 0;
+		}
+
+		if(!Stolen.empty())
+			break;
+	}
+
+	if(Stolen.empty())
+		return 0;
+
+	//StolenеϢڱȡ߶е˳෴һ
+	CLMessage *pMsg = Stolen.back();
+	Stolen.pop_back();
+
+	if(Stolen.empty())
+		return pMsg;
+
+	SLWorkStealingWorker *pWorker = m_ppWorkers[nWorker];
+
+	try
+	{
+		CLCriticalSection cs(&(pWorker->Mutex));
+
+		for(unsigned int j = Stolen.size(); j > 0; j--)
+			pWorker->Messages.push_back(Stolen[j - 1]);
+
+		pWorker->nMessages += Stolen.size();
+		pWorker->nStealable += Stolen.size();
+	}
+	catch(const char* str)
+	{
+		CLLogger::WriteLogMsg("In CLMessageQueueByWorkStealing::Steal(), exception arise", 0);
+
+		for(unsigned int j = 0; j < Stolen.size(); j++)
+			delete Stolen[j];
+	}
+
+	return pMsg;
+}
+
+bool CLMessageQueueByWorkStealing::HasMessages(unsigned int nWorker)
+{
+	if(m_ppWorkers[nWorker]->nMessages != 0)
+		return true;
+
+	for(unsigned int i = 0; i < m_nWorkers; i++)
+	{
+		if(m_ppWorkers[i]->nStealable != 0)
+			return true;
+	}
+
+	return false;
+}
+
+void CLMessageQueueByWorkStealing::Quit()
+{
+	m_bQuit = 1;
+	__sync_synchronize();
+
+	for(unsigned int i = 0; i < m_nWorkers; i++)
+	{
+		uint64_t count = 1;
+		while((write(m_ppWorkers[i]->EventFd, &count, sizeof(count)) == -1) && (errno == EINTR))
+			;
+	}
+}
+
+bool CLMessageQueueByWorkStealing::IsQuitting()
+{
+	return m_bQuit != 0;
+}
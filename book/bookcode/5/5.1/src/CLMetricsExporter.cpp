@@ -0,0 +1,48 @@
+#include <string.h>
+#include "CLMetricsExporter.h"
+#include "CLMessageLoopManager.h"
+#include "CLExecutiveMetrics.h"
+#include "CLLogger.h"
+
+CLMetricsExporter::CLMetricsExporter(const char *pstrPath, unsigned long lIntervalMs)
+{
+	if((pstrPath == 0) || (strlen(pstrPath) == 0))
+		throw "In CLMetricsExporter::CLMetricsExporter(), pstrPath error";
+
+	if(lIntervalMs == 0)
+		throw "In CLMetricsExporter::CLMetricsExporter(), lIntervalMs error";
+
+	m_strPath = pstrPath;
+	m_lIntervalMs = lIntervalMs;
+}
+
+CLMetricsExporter::~CLMetricsExporter()
+{
+}
+
+CLStatus CLMetricsExporter::Initialize(CLMessageLoopManager *pMessageLoop, void*)
+{
+	pMessageLoop->Register(METRICS_EXPORTER_TIMER_ID, (CallBackForMessageLoop)(&CLMetricsExporter::On_Timer));
+	pMessageLoop->Register(METRICS_EXPORTER_QUIT_ID, (CallBackForMessageLoop)(&CLMetricsExporter::On_Quit));
+
+	if(pMessageLoop->SetTimer(METRICS_EXPORTER_TIMER_ID, m_lIntervalMs, m_lIntervalMs) == 0)
+	{
+		CLLogger::WriteLogMsg("In CLMetricsExporter::Initialize(), pMessageLoop->SetTimer error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMetricsExporter::On_Timer(CLMessage *)
+{
+	//ܵʱûжʱε
+	CLExecutiveMetrics::DumpToFile(m_strPath.c_str());
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMetricsExporter::On_Quit(CLMessage *)
+{
+	CLExecutiveMetrics::DumpToFile(m_strPath.c_str());
+	return CLStatus(QUIT_MESSAGE_LOOP, 0);
+}
@@ -0,0 +1,421 @@
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdint.h>
+#include <sys/timerfd.h>
+#include "CLMsgLoopManagerForEpoll.h"
+#include "CLMessageQueueByLockFreeRing.h"
+#include "CLMessageQueueBySTLqueue.h"
+#include "CLExecutiveNameServer.h"
+#include "CLThreadCommunicationByLockFreeRing.h"
+#include "CLMessageObserver.h"
+#include "CLMessage.h"
+#include "CLLogger.h"
+#include "CLThreadPlacement.h"
+
+CLMsgLoopManagerForEpoll::CLMsgLoopManagerForEpoll(CLMessageObserver *pMsgObserver, const char* pstrThreadName) : CLMessageLoopManager(pMsgObserver, pstrThreadName)
+{
+	if((pstrThreadName == 0) || (strlen(pstrThreadName) == 0))
+		throw "In CLMsgLoopManagerForEpoll::CLMsgLoopManagerForEpoll(), pstrThreadName error";
+
+	m_strThreadName = pstrThreadName;
+
+	m_EpollFd = epoll_create1(EPOLL_CLOEXEC);
+	if(m_EpollFd == -1)
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::CLMsgLoopManagerForEpoll(), epoll_create1 error", errno);
+		throw "In CLMsgLoopManagerForEpoll::CLMsgLoopManagerForEpoll(), epoll_create1 error";
+	}
+
+	m_pMsgQueue = new CLMessageQueueByLockFreeRing;
+
+	m_nMessagesSinceWait = 0;
+	m_bQuit = false;
+	m_pQuitMessage = 0;
+}
+
+CLMsgLoopManagerForEpoll::~CLMsgLoopManagerForEpoll()
+{
+	if((m_EpollFd != -1) && (close(m_EpollFd) == -1))
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::~CLMsgLoopManagerForEpoll(), close error", errno);
+}
+
+CLStatus CLMsgLoopManagerForEpoll::Initialize()
+{
+	CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+	if(pNameServer == 0)
+	{
+		delete m_pMsgQueue;
+		m_pMsgQueue = 0;
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::Initialize(), CLExecutiveNameServer::GetInstance error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	int EventFd = m_pMsgQueue->GetEventFd();
+
+	int nNode = CLThreadPlacement::GetNUMANodeOfCurrentThread();
+	if((nNode != -1) && (!m_pMsgQueue->BindToNUMANode(nNode).IsSuccess()))
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::Initialize(), m_pMsgQueue->BindToNUMANode error", 0);
+
+	CLStatus s = pNameServer->Register(m_strThreadName.c_str(), new CLThreadCommunicationByLockFreeRing(m_pMsgQueue));
+	if(!s.IsSuccess())
+	{
+		m_pMsgQueue = 0;
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::Initialize(), pNameServer->Register error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	CLStatus s1 = AddHandler(EventFd, EPOLLIN, EPOLL_HANDLER_MESSAGE_QUEUE);
+	if(!s1.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::Initialize(), AddHandler error", 0);
+
+		CLStatus s2 = pNameServer->ReleaseCommunicationPtr(m_strThreadName.c_str());
+		if(!s2.IsSuccess())
+			CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::Initialize(), pNameServer->ReleaseCommunicationPtr error", 0);
+
+		m_pMsgQueue = 0;
+		return CLStatus(-1, 0);
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMsgLoopManagerForEpoll::Uninitialize()
+{
+	//ʹߵļʹ߹رգʱϢѭڴ
+	for(unsigned int fd = 0; fd < m_Handlers.size(); fd++)
+	{
+		if(m_Handlers[fd].Type == EPOLL_HANDLER_TIMER)
+			DestroyTimer(fd);
+	}
+
+	if(close(m_EpollFd) == -1)
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::Uninitialize(), close error", errno);
+
+	m_EpollFd = -1;
+	m_Handlers.clear();
+
+	CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+	if(pNameServer == 0)
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::Uninitialize(), CLExecutiveNameServer::GetInstance error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	return pNameServer->ReleaseCommunicationPtr(m_strThreadName.c_str());
+}
+
+CLStatus CLMsgLoopManagerForEpoll::RegisterFileDescriptor(int fd, unsigned int nEvents, CallBackForFileDescriptor pFunction)
+{
+	if((fd < 0) || (pFunction == 0))
+		return CLStatus(-1, 0);
+
+	CLStatus s = AddHandler(fd, nEvents, EPOLL_HANDLER_FILE_DESCRIPTOR);
+	if(!s.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::RegisterFileDescriptor(), AddHandler error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	m_Handlers[fd].pFileDescriptorFunction = pFunction;
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMsgLoopManagerForEpoll::ModifyFileDescriptor(int fd, unsigned int nEvents)
+{
+	SLEpollHandler *pHandler = GetHandler(fd);
+	if((pHandler == 0) || (pHandler->Type != EPOLL_HANDLER_FILE_DESCRIPTOR))
+		return CLStatus(-1, 0);
+
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = nEvents;
+	event.data.fd = fd;
+
+	if(epoll_ctl(m_EpollFd, EPOLL_CTL_MOD, fd, &event) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::ModifyFileDescriptor(), epoll_ctl error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMsgLoopManagerForEpoll::UnregisterFileDescriptor(int fd)
+{
+	SLEpollHandler *pHandler = GetHandler(fd);
+	if((pHandler == 0) || (pHandler->Type != EPOLL_HANDLER_FILE_DESCRIPTOR))
+		return CLStatus(-1, 0);
+
+	return RemoveHandler(fd);
+}
+
+int CLMsgLoopManagerForEpoll::CreateTimer(unsigned long lInitialMs, unsigned long lIntervalMs, CallBackForTimer pFunction)
+{
+	if(pFunction == 0)
+		return -1;
+
+	int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if(fd == -1)
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::CreateTimer(), timerfd_create error", errno);
+		return -1;
+	}
+
+	//it_valueȫΪ0ֹͣʱ
+	if(lInitialMs == 0)
+		lInitialMs = 1;
+
+	struct itimerspec spec;
+	spec.it_value.tv_sec = lInitialMs / 1000;
+	spec.it_value.tv_nsec = (lInitialMs % 1000) * 1000000;
+	spec.it_interval.tv_sec = lIntervalMs / 1000;
+	spec.it_interval.tv_nsec = (lIntervalMs % 1000) * 1000000;
+
+	if(timerfd_settime(fd, 0, &spec, 0) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::CreateTimer(), timerfd_settime error", errno);
+		close(fd);
+		return -1;
+	}
+
+	CLStatus s = AddHandler(fd, EPOLLIN, EPOLL_HANDLER_TIMER);
+	if(!s.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::CreateTimer(), AddHandler error", 0);
+		close(fd);
+		return -1;
+	}
+
+	m_Handlers[fd].pTimerFunction = pFunction;
+
+	return fd;
+}
+
+CLStatus CLMsgLoopManagerForEpoll::DestroyTimer(int nTimerID)
+{
+	SLEpollHandler *pHandler = GetHandler(nTimerID);
+	if((pHandler == 0) || (pHandler->Type != EPOLL_HANDLER_TIMER))
+		return CLStatus(-1, 0);
+
+	CLStatus s = RemoveHandler(nTimerID);
+
+	if(close(nTimerID) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::DestroyTimer(), close error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	return s;
+}
+
+CLMessage* CLMsgLoopManagerForEpoll::WaitForMessage()
+{
+	CLMessage *pMsg = 0;
+	if(WaitForMessages(&pMsg, 1) == 0)
+		return 0;
+
+	return pMsg;
+}
+
+unsigned int CLMsgLoopManagerForEpoll::WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	if((ppMessages == 0) || (nMaxCount == 0))
+		return 0;
+
+	while(true)
+	{
+		unsigned int n = TimedWaitForMessages(ppMessages, nMaxCount, -1);
+		if(n != 0)
+			return n;
+	}
+}
+
+bool CLMsgLoopManagerForEpoll::IsTimedWaitSupported()
+{
+	return true;
+}
+
+unsigned int CLMsgLoopManagerForEpoll::TimedWaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount, long lTimeoutMs)
+{
+	if((ppMessages == 0) || (nMaxCount == 0))
+		return 0;
+
+	if(m_bQuit)
+	{
+		ppMessages[0] = CreateQuitMessage();
+		return 1;
+	}
+
+	if(m_nMessagesSinceWait >= MAX_NUMBER_OF_MESSAGES_BETWEEN_EPOLL_WAIT)
+	{
+		m_nMessagesSinceWait = 0;
+
+		if(!WaitForEvents(0))
+			return 0;
+	}
+	else
+	{
+		unsigned int n = m_pMsgQueue->TryGetMessages(ppMessages, nMaxCount);
+		if(n != 0)
+		{
+			m_nMessagesSinceWait += n;
+			return n;
+		}
+
+		m_nMessagesSinceWait = 0;
+
+		//Ϣʱ账Ѿļ
+		if(!WaitForEvents(m_pMsgQueue->PrepareToSleep() ? (int)lTimeoutMs : 0))
+			return 0;
+	}
+
+	if(m_bQuit)
+	{
+		ppMessages[0] = CreateQuitMessage();
+		return 1;
+	}
+
+	//0ʱļĻصµĶʱϢѭ¼㳬ʱ
+	unsigned int n = m_pMsgQueue->TryGetMessages(ppMessages, nMaxCount);
+	m_nMessagesSinceWait += n;
+
+	return n;
+}
+
+CLStatus CLMsgLoopManagerForEpoll::DispatchMessage(CLMessage *pMessage)
+{
+	//ϢϢѭɾ
+	if(pMessage == m_pQuitMessage)
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+
+	return CLMessageLoopManager::DispatchMessage(pMessage);
+}
+
+bool CLMsgLoopManagerForEpoll::WaitForEvents(int nTimeout)
+{
+	int n = epoll_wait(m_EpollFd, m_Events, MAX_NUMBER_OF_EPOLL_EVENTS, nTimeout);
+	if(n == -1)
+	{
+		m_pMsgQueue->FinishSleeping(false);
+
+		if(errno == EINTR)
+			return true;
+
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::WaitForEvents(), epoll_wait error", errno);
+		return false;
+	}
+
+	bool bEventFdReadable = false;
+	for(int i = 0; i < n; i++)
+	{
+		SLEpollHandler *pHandler = GetHandler(m_Events[i].data.fd);
+		if((pHandler != 0) && (pHandler->Type == EPOLL_HANDLER_MESSAGE_QUEUE))
+			bEventFdReadable = true;
+	}
+
+	m_pMsgQueue->FinishSleeping(bEventFdReadable);
+
+	for(int i = 0; (i < n) && (!m_bQuit); i++)
+	{
+		int fd = m_Events[i].data.fd;
+
+		//֮ǰĻصע˸ļ
+		SLEpollHandler *pHandler = GetHandler(fd);
+		if(pHandler == 0)
+			continue;
+
+		if(pHandler->Type == EPOLL_HANDLER_FILE_DESCRIPTOR)
+		{
+			CLStatus s = (m_pMessageObserver->*(pHandler->pFileDescriptorFunction))(fd, m_Events[i].events);
+			if(s.m_clReturnCode == QUIT_MESSAGE_LOOP)
+				m_bQuit = true;
+		}
+		else if(pHandler->Type == EPOLL_HANDLER_TIMER)
+		{
+			uint64_t nExpirations = 0;
+			if(read(fd, &nExpirations, sizeof(nExpirations)) != sizeof(nExpirations))
+				continue;
+
+			CLStatus s = (m_pMessageObserver->*(pHandler->pTimerFunction))(fd, nExpirations);
+			if(s.m_clReturnCode == QUIT_MESSAGE_LOOP)
+				m_bQuit = true;
+		}
+	}
+
+	return true;
+}
+
+SLEpollHandler *CLMsgLoopManagerForEpoll::GetHandler(int fd)
+{
+	if((fd < 0) || (fd >= (int)m_Handlers.size()) || (m_Handlers[fd].Type == EPOLL_HANDLER_NONE))
+		return 0;
+
+	return &m_Handlers[fd];
+}
+
+CLStatus CLMsgLoopManagerForEpoll::AddHandler(int fd, unsigned int nEvents, int Type)
+{
+	if(GetHandler(fd) != 0)
+		return CLStatus(-1, 0);
+
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = nEvents;
+	event.data.fd = fd;
+
+	if(epoll_ctl(m_EpollFd, EPOLL_CTL_ADD, fd, &event) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::AddHandler(), epoll_ctl error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	if(fd >= (int)m_Handlers.size())
+	{
+		SLEpollHandler handler;
+		memset(&handler, 0, sizeof(handler));
+		handler.Type = EPOLL_HANDLER_NONE;
+
+		m_Handlers.resize(fd + 1, handler);
+	}
+
+	m_Handlers[fd].Type = Type;
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMsgLoopManagerForEpoll::RemoveHandler(int fd)
+{
+	m_Handlers[fd].Type = EPOLL_HANDLER_NONE;
+
+	if(epoll_ctl(m_EpollFd, EPOLL_CTL_DEL, fd, 0) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForEpoll::RemoveHandler(), epoll_ctl error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLMessage* CLMsgLoopManagerForEpoll::CreateQuitMessage()
+{
+	m_pQuitMessage = new CLMessage(0);
+
+	return m_pQuitMessage;
+}
+
+CLStatus CLMsgLoopManagerForEpoll::GetQueueStatistics(SLMessageQueueStatistics *pStatistics)
+{
+	if((pStatistics == 0) || (m_pMsgQueue == 0))
+		return CLStatus(-1, 0);
+
+	//ζֻṩȡܾ
+	memset(pStatistics, 0, sizeof(SLMessageQueueStatistics));
+	pStatistics->nDepth[MESSAGE_PRIORITY_NORMAL] = m_pMsgQueue->GetDepth();
+	pStatistics->nCapacity = m_pMsgQueue->GetCapacity();
+	pStatistics->nRejected = m_pMsgQueue->GetRejectedCount();
+
+	return CLStatus(0, 0);
+}
@@ -0,0 +1,95 @@
+#include <string.h>
+#include "CLMsgLoopManagerForLockFreeRing.h"
+#include "CLMessageQueueByLockFreeRing.h"
+#include "CLMessageQueueBySTLqueue.h"
+#include "CLExecutiveNameServer.h"
+#include "CLThreadCommunicationByLockFreeRing.h"
+#include "CLLogger.h"
+#include "CLThreadPlacement.h"
+
+CLMsgLoopManagerForLockFreeRing::CLMsgLoopManagerForLockFreeRing(CLMessageObserver *pMsgObserver, const char* pstrThreadName) : CLMessageLoopManager(pMsgObserver, pstrThreadName)
+{
+	if((pstrThreadName == 0) || (strlen(pstrThreadName) == 0))
+		throw "In CLMsgLoopManagerForLockFreeRing::CLMsgLoopManagerForLockFreeRing(), pstrThreadName error";
+
+	m_strThreadName = pstrThreadName;
+
+	m_pMsgQueue = new CLMessageQueueByLockFreeRing;
+}
+
+CLMsgLoopManagerForLockFreeRing::~CLMsgLoopManagerForLockFreeRing()
+{
+}
+
+CLStatus CLMsgLoopManagerForLockFreeRing::Initialize()
+{
+	CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+	if(pNameServer == 0)
+	{
+		delete m_pMsgQueue;
+		m_pMsgQueue = 0;
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForLockFreeRing::Initialize(), CLExecutiveNameServer::GetInstance error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	//Initialize߳УͶݿʼ֮ǰѶǨƵ߳ڵĽڵ
+	int nNode = CLThreadPlacement::GetNUMANodeOfCurrentThread();
+	if((nNode != -1) && (!m_pMsgQueue->BindToNUMANode(nNode).IsSuccess()))
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForLockFreeRing::Initialize(), m_pMsgQueue->BindToNUMANode error", 0);
+
+	CLStatus s = pNameServer->Register(m_strThreadName.c_str(), new CLThreadCommunicationByLockFreeRing(m_pMsgQueue));
+	if(!s.IsSuccess())
+	{
+		m_pMsgQueue = 0;
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForLockFreeRing::Initialize(), pNameServer->Register error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMsgLoopManagerForLockFreeRing::Uninitialize()
+{
+	CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+	if(pNameServer == 0)
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForLockFreeRing::Uninitialize(), CLExecutiveNameServer::GetInstance error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	return pNameServer->ReleaseCommunicationPtr(m_strThreadName.c_str());
+}
+
+CLMessage* CLMsgLoopManagerForLockFreeRing::WaitForMessage()
+{
+	return m_pMsgQueue->GetMessage();
+}
+
+unsigned int CLMsgLoopManagerForLockFreeRing::WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	return m_pMsgQueue->GetMessages(ppMessages, nMaxCount);
+}
+
+bool CLMsgLoopManagerForLockFreeRing::IsTimedWaitSupported()
+{
+	return true;
+}
+
+unsigned int CLMsgLoopManagerForLockFreeRing::TimedWaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount, long lTimeoutMs)
+{
+	return m_pMsgQueue->GetMessages(ppMessages, nMaxCount, lTimeoutMs);
+}
+
+CLStatus CLMsgLoopManagerForLockFreeRing::GetQueueStatistics(SLMessageQueueStatistics *pStatistics)
+{
+	if((pStatistics == 0) || (m_pMsgQueue == 0))
+		return CLStatus(-1, 0);
+
+	//ζֻṩȡܾ
+	memset(pStatistics, 0, sizeof(SLMessageQueueStatistics));
+	pStatistics->nDepth[MESSAGE_PRIORITY_NORMAL] = m_pMsgQueue->GetDepth();
+	pStatistics->nCapacity = m_pMsgQueue->GetCapacity();
+	pStatistics->nRejected = m_pMsgQueue->GetRejectedCount();
+
+	return CLStatus(0, 0);
+}
@@ -7,7 +7,7 @@
 #include "CLExecutiveNameServer.h"
 #include "CLPrivateExecutiveCommunicationByNamedPipe.h"
 
-CLMsgLoopManagerForPipeQueue::CLMsgLoopManagerForPipeQueue(CLMessageObserver *pMsgObserver, const char* pstrThreadName, int PipeQueueType) : CLMessageLoopManager(pMsgObserver)
+CLMsgLoopManagerForPipeQueue::CLMsgLoopManagerForPipeQueue(CLMessageObserver *pMsgObserver, const char* pstrThreadName, int PipeQueueType) : CLMessageLoopManager(pMsgObserver, pstrThreadName)
 {
 	if((pstrThreadName == 0) || (strlen(pstrThreadName) == 0))
 		throw "In CLMsgLoopManagerForPipeQueue::CLMsgLoopManagerForPipeQueue(), pstrThreadName error";
@@ -71,6 +71,11 @@ CLMessage* CLMsgLoopManagerForPipeQueue::WaitForMessage()
 	return m_pMsgQueue->GetMessage();
 }
 
+unsigned int CLMsgLoopManagerForPipeQueue::WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	return m_pMsgQueue->GetMessages(ppMessages, nMaxCount);
+}
+
 CLStatus CLMsgLoopManagerForPipeQueue::RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer)
 {
 	CLSharedMsgQueueByNamedPipe *pQueue = dynamic_cast<CLSharedMsgQueueByNamedPipe *>(m_pMsgQueue);
@@ -78,4 +83,13 @@ CLStatus CLMsgLoopManagerForPipeQueue::RegisterDeserializer(unsigned long lMsgID
 		return pQueue->RegisterDeserializer(lMsgID, pDeserializer);
 	else
 		return CLStatus(-1, 0);
-}
\ No newline at end of file
+}
+
+CLStatus CLMsgLoopManagerForPipeQueue::RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer)
+{
+	CLSharedMsgQueueByNamedPipe *pQueue = dynamic_cast<CLSharedMsgQueueByNamedPipe *>(m_pMsgQueue);
+	if(pQueue != 0)
+		return pQueue->RegisterDeserializer(lMsgID, pDeserializer);
+	else
+		return CLStatus(-1, 0);
+}
@@ -0,0 +1,22 @@
+#include "CLMsgLoopManagerForProcessPool.h"
+#include "CLMessageIDDeserializer.h"
+#include "CLMessage.h"
+
+CLMsgLoopManagerForProcessPool::CLMsgLoopManagerForProcessPool(CLMessageObserver *pMsgObserver, const char* pstrWorkerName) : CLMsgLoopManagerForShmQueue(pMsgObserver, pstrWorkerName)
+{
+	CLStatus s = RegisterDeserializer(PROCESS_POOL_QUIT_ID, new CLMessageIDDeserializer);
+	if(!s.IsSuccess())
+		throw "In CLMsgLoopManagerForProcessPool::CLMsgLoopManagerForProcessPool(), RegisterDeserializer error";
+}
+
+CLMsgLoopManagerForProcessPool::~CLMsgLoopManagerForProcessPool()
+{
+}
+
+CLStatus CLMsgLoopManagerForProcessPool::DispatchMessage(CLMessage *pMessage)
+{
+	if(pMessage->m_clMsgID == PROCESS_POOL_QUIT_ID)
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+
+	return CLMsgLoopManagerForShmQueue::DispatchMessage(pMessage);
+}
@@ -5,14 +5,14 @@
 #include "CLThreadCommunicationBySTLqueue.h"
 #include "CLLogger.h"
 
-CLMsgLoopManagerForSTLqueue::CLMsgLoopManagerForSTLqueue(CLMessageObserver *pMsgObserver, const char* pstrThreadName) : CLMessageLoopManager(pMsgObserver)
+CLMsgLoopManagerForSTLqueue::CLMsgLoopManagerForSTLqueue(CLMessageObserver *pMsgObserver, const char* pstrThreadName, unsigned long nCapacity, int OverflowPolicy) : CLMessageLoopManager(pMsgObserver, pstrThreadName)
 {
 	if((pstrThreadName == 0) || (strlen(pstrThreadName) == 0))
 		throw "In CLMsgLoopManagerForSTLqueue::CLMsgLoopManagerForSTLqueue(), pstrThreadName error";
 		
 	m_strThreadName = pstrThreadName;
 
-	m_pMsgQueue = new CLMessageQueueBySTLqueue;
+	m_pMsgQueue = new CLMessageQueueBySTLqueue(nCapacity, OverflowPolicy);
 }
 
 CLMsgLoopManagerForSTLqueue::~CLMsgLoopManagerForSTLqueue()
@@ -53,6 +53,9 @@ CLStatus CLMsgLoopManagerForSTLqueue::Uninitialize()
 		return CLStatus(-1, 0);
 	}
 
+	//ķߣ֮Ͷݾʧ
+	m_pMsgQueue->Close();
+
 	return pNameServer->ReleaseCommunicationPtr(m_strThreadName.c_str());
 }
 	
@@ -60,3 +63,23 @@ CLMessage* CLMsgLoopManagerForSTLqueue::WaitForMessage()
 {
 	return m_pMsgQueue->GetMessage();
 }
+
+unsigned int CLMsgLoopManagerForSTLqueue::WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	return m_pMsgQueue->GetMessages(ppMessages, nMaxCount);
+}
+
+bool CLMsgLoopManagerForSTLqueue::IsTimedWaitSupported()
+{
+	return true;
+}
+
+unsigned int CLMsgLoopManagerForSTLqueue::TimedWaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount, long lTimeoutMs)
+{
+	return m_pMsgQueue->GetMessages(ppMessages, nMaxCount, lTimeoutMs);
+}
+
+CLStatus CLMsgLoopManagerForSTLqueue::GetQueueStatistics(SLMessageQueueStatistics *pStatistics)
+{
+	return m_pMsgQueue->GetStatistics(pStatistics);
+}
@@ -0,0 +1,46 @@
+#include <string.h>
+#include "CLMsgLoopManagerForShmQueue.h"
+#include "CLSharedMsgQueueByShmRing.h"
+
+CLMsgLoopManagerForShmQueue::CLMsgLoopManagerForShmQueue(CLMessageObserver *pMsgObserver, const char* pstrThreadName) : CLMessageLoopManager(pMsgObserver, pstrThreadName)
+{
+	if((pstrThreadName == 0) || (strlen(pstrThreadName) == 0))
+		throw "In CLMsgLoopManagerForShmQueue::CLMsgLoopManagerForShmQueue(), pstrThreadName error";
+
+	m_pMsgQueue = new CLSharedMsgQueueByShmRing(pstrThreadName);
+}
+
+CLMsgLoopManagerForShmQueue::~CLMsgLoopManagerForShmQueue()
+{
+	delete m_pMsgQueue;
+}
+
+CLStatus CLMsgLoopManagerForShmQueue::Initialize()
+{
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMsgLoopManagerForShmQueue::Uninitialize()
+{
+	return CLStatus(0, 0);
+}
+
+CLMessage* CLMsgLoopManagerForShmQueue::WaitForMessage()
+{
+	return m_pMsgQueue->GetMessage();
+}
+
+unsigned int CLMsgLoopManagerForShmQueue::WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	return m_pMsgQueue->GetMessages(ppMessages, nMaxCount);
+}
+
+CLStatus CLMsgLoopManagerForShmQueue::RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer)
+{
+	return m_pMsgQueue->RegisterDeserializer(lMsgID, pDeserializer);
+}
+
+CLStatus CLMsgLoopManagerForShmQueue::RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer)
+{
+	return m_pMsgQueue->RegisterDeserializer(lMsgID, pDeserializer);
+}
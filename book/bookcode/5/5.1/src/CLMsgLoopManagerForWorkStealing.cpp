@@ -0,0 +1,92 @@
+#include <string.h>
+#include "CLMsgLoopManagerForWorkStealing.h"
+#include "CLMessageQueueByWorkStealing.h"
+#include "CLExecutiveNameServer.h"
+#include "CLMessage.h"
+#include "CLLogger.h"
+
+CLMsgLoopManagerForWorkStealing::CLMsgLoopManagerForWorkStealing(CLMessageObserver *pMsgObserver, const char* pstrPoolName, CLMessageQueueByWorkStealing *pMsgQueue, unsigned int nWorker) : CLMessageLoopManager(pMsgObserver, pstrPoolName, true)
+{
+	if((pstrPoolName == 0) || (strlen(pstrPoolName) == 0))
+		throw "In CLMsgLoopManagerForWorkStealing::CLMsgLoopManagerForWorkStealing(), pstrPoolName error";
+
+	if((pMsgQueue == 0) || (nWorker >= pMsgQueue->GetNumberOfWorkers()))
+		throw "In CLMsgLoopManagerForWorkStealing::CLMsgLoopManagerForWorkStealing(), pMsgQueue error";
+
+	m_strPoolName = pstrPoolName;
+	m_nWorker = nWorker;
+	m_pQuitMessage = 0;
+
+	m_pMsgQueue = pMsgQueue;
+	m_pMsgQueue->AddReference();
+}
+
+CLMsgLoopManagerForWorkStealing::~CLMsgLoopManagerForWorkStealing()
+{
+	m_pMsgQueue->Release();
+}
+
+CLStatus CLMsgLoopManagerForWorkStealing::Initialize()
+{
+	m_pMsgQueue->EnterExecutive();
+	m_pMsgQueue->BindCurrentThread(m_nWorker);
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLMsgLoopManagerForWorkStealing::Uninitialize()
+{
+	//CLExecutivePool::Runעᣬһ˳Ĺ̸߳ע
+	if(m_pMsgQueue->LeaveExecutive() != 0)
+		return CLStatus(0, 0);
+
+	CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+	if(pNameServer == 0)
+	{
+		CLLogger::WriteLogMsg("In CLMsgLoopManagerForWorkStealing::Uninitialize(), CLExecutiveNameServer::GetInstance error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	return pNameServer->ReleaseCommunicationPtr(m_strPoolName.c_str());
+}
+
+CLMessage* CLMsgLoopManagerForWorkStealing::WaitForMessage()
+{
+	CLMessage *pMsg = m_pMsgQueue->GetMessage(m_nWorker);
+	if((pMsg == 0) && (m_pMsgQueue->IsQuitting()))
+		return CreateQuitMessage();
+
+	return pMsg;
+}
+
+unsigned int CLMsgLoopManagerForWorkStealing::WaitForMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	unsigned int n = m_pMsgQueue->GetMessages(m_nWorker, ppMessages, nMaxCount);
+	if((n == 0) && (m_pMsgQueue->IsQuitting()) && (ppMessages != 0) && (nMaxCount != 0))
+	{
+		ppMessages[0] = CreateQuitMessage();
+		return 1;
+	}
+
+	return n;
+}
+
+CLStatus CLMsgLoopManagerForWorkStealing::DispatchMessage(CLMessage *pMessage)
+{
+	//ϢϢѭɾ
+	if(pMessage == m_pQuitMessage)
+		return CLStatus(QUIT_MESSAGE_LOOP, 0);
+
+	CLStatus s = CLMessageLoopManager::DispatchMessage(pMessage);
+	if(s.m_clReturnCode == QUIT_MESSAGE_LOOP)
+		m_pMsgQueue->Quit();
+
+	return s;
+}
+
+CLMessage* CLMsgLoopManagerForWorkStealing::CreateQuitMessage()
+{
+	m_pQuitMessage = new CLMessage(0);
+
+	return m_pQuitMessage;
+}
@@ -2,11 +2,14 @@
 #include "CLNonThreadForMsgLoop.h"
 #include "CLExecutiveFunctionForMsgLoop.h"
 #include "CLMsgLoopManagerForSTLqueue.h"
+#include "CLMsgLoopManagerForLockFreeRing.h"
 #include "CLLogger.h"
 #include "CLThreadInitialFinishedNotifier.h"
 #include "CLMsgLoopManagerForPipeQueue.h"
+#include "CLMsgLoopManagerForShmQueue.h"
+#include "CLMsgLoopManagerForEpoll.h"
 
-CLNonThreadForMsgLoop::CLNonThreadForMsgLoop(CLMessageObserver *pMsgObserver, const char *pstrThreadName, int ExecutiveType)
+CLNonThreadForMsgLoop::CLNonThreadForMsgLoop(CLMessageObserver *pMsgObserver, const char *pstrThreadName, int ExecutiveType, unsigned long nQueueCapacity, int OverflowPolicy)
 {
 	if(pMsgObserver == 0)
 		throw "In CLNonThreadForMsgLoop::CLNonThreadForMsgLoop(), pMsgObserver error";
@@ -15,10 +18,11 @@ CLNonThreadForMsgLoop::CLNonThreadForMsgLoop(CLMessageObserver *pMsgObserver, co
 		throw "In CLNonThreadForMsgLoop::CLNonThreadForMsgLoop(), pstrThreadName error";
 
 	m_pPipeMsgQueue = NULL;
+	m_pShmMsgQueue = NULL;
 
 	if(ExecutiveType == EXECUTIVE_IN_PROCESS_USE_STL_QUEUE)
 	{
-		m_pFunctionProvider = new CLExecutiveFunctionForMsgLoop(new CLMsgLoopManagerForSTLqueue(pMsgObserver, pstrThreadName));
+		m_pFunctionProvider = new CLExecutiveFunctionForMsgLoop(new CLMsgLoopManagerForSTLqueue(pMsgObserver, pstrThreadName, nQueueCapacity, OverflowPolicy));
 	}
 	else if(ExecutiveType == EXECUTIVE_IN_PROCESS_USE_PIPE_QUEUE)
 	{
@@ -30,6 +34,19 @@ CLNonThreadForMsgLoop::CLNonThreadForMsgLoop(CLMessageObserver *pMsgObserver, co
 		m_pPipeMsgQueue = new CLMsgLoopManagerForPipeQueue(pMsgObserver, pstrThreadName, PIPE_QUEUE_BETWEEN_PROCESS);
 		m_pFunctionProvider = new CLExecutiveFunctionForMsgLoop(m_pPipeMsgQueue);
 	}
+	else if(ExecutiveType == EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING)
+	{
+		m_pFunctionProvider = new CLExecutiveFunctionForMsgLoop(new CLMsgLoopManagerForLockFreeRing(pMsgObserver, pstrThreadName));
+	}
+	else if(ExecutiveType == EXECUTIVE_BETWEEN_PROCESS_USE_SHM_QUEUE)
+	{
+		m_pShmMsgQueue = new CLMsgLoopManagerForShmQueue(pMsgObserver, pstrThreadName);
+		m_pFunctionProvider = new CLExecutiveFunctionForMsgLoop(m_pShmMsgQueue);
+	}
+	else if(ExecutiveType == EXECUTIVE_IN_PROCESS_USE_EPOLL)
+	{
+		m_pFunctionProvider = new CLExecutiveFunctionForMsgLoop(new CLMsgLoopManagerForEpoll(pMsgObserver, pstrThreadName));
+	}
 	else
 		throw "In CLNonThreadForMsgLoop::CLNonThreadForMsgLoop(), ExecutiveType Error";
 }
@@ -55,5 +72,19 @@ CLStatus CLNonThreadForMsgLoop::RegisterDeserializer(unsigned long lMsgID, CLMes
 	if(m_pPipeMsgQueue != NULL)
 		return m_pPipeMsgQueue->RegisterDeserializer(lMsgID, pDeserializer);
 
+	if(m_pShmMsgQueue != NULL)
+		return m_pShmMsgQueue->RegisterDeserializer(lMsgID, pDeserializer);
+
+	return CLStatus(-1, 0);
+}
+
+CLStatus CLNonThreadForMsgLoop::RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer)
+{
+	if(m_pPipeMsgQueue != NULL)
+		return m_pPipeMsgQueue->RegisterDeserializer(lMsgID, pDeserializer);
+
+	if(m_pShmMsgQueue != NULL)
+		return m_pShmMsgQueue->RegisterDeserializer(lMsgID, pDeserializer);
+
 	return CLStatus(-1, 0);
-}
\ No newline at end of file
+}
@@ -0,0 +1,83 @@
+#include <string.h>
+#include "CLPendingRequestTable.h"
+
+CLPendingRequestTable::CLPendingRequestTable()
+{
+	m_nFreeRequest = -1;
+	m_nRequests = 0;
+}
+
+CLPendingRequestTable::~CLPendingRequestTable()
+{
+}
+
+unsigned long CLPendingRequestTable::Add(CallBackForResponse pFunction, void *pContext)
+{
+	if(m_nRequests >= MAX_NUMBER_OF_PENDING_REQUESTS)
+		return 0;
+
+	int nIndex = m_nFreeRequest;
+	if(nIndex != -1)
+		m_nFreeRequest = m_Requests[nIndex].Next;
+	else
+	{
+		SLPendingRequest request;
+		memset(&request, 0, sizeof(request));
+
+		nIndex = (int)m_Requests.size();
+		m_Requests.push_back(request);
+	}
+
+	SLPendingRequest *pRequest = &m_Requests[nIndex];
+
+	unsigned long nReused = ((pRequest->nRequestID >> BITS_OF_REQUEST_INDEX) + 1) << BITS_OF_REQUEST_INDEX;
+	if(nReused == 0)
+		nReused = 1UL << BITS_OF_REQUEST_INDEX;
+
+	pRequest->nRequestID = nReused | (unsigned long)nIndex;
+	pRequest->pFunction = pFunction;
+	pRequest->pContext = pContext;
+	pRequest->nTimerID = 0;
+	pRequest->Next = -1;
+
+	m_nRequests++;
+
+	return pRequest->nRequestID;
+}
+
+SLPendingRequest *CLPendingRequestTable::Find(unsigned long nRequestID)
+{
+	unsigned long nIndex = nRequestID & (MAX_NUMBER_OF_PENDING_REQUESTS - 1);
+	if(nIndex >= m_Requests.size())
+		return 0;
+
+	SLPendingRequest *pRequest = &m_Requests[nIndex];
+
+	//ͷŵpFunctionΪ0
+	if((pRequest->nRequestID != nRequestID) || (pRequest->pFunction == 0))
+		return 0;
+
+	return pRequest;
+}
+
+bool CLPendingRequestTable::Remove(unsigned long nRequestID)
+{
+	SLPendingRequest *pRequest = Find(nRequestID);
+	if(pRequest == 0)
+		return false;
+
+	pRequest->pFunction = 0;
+	pRequest->pContext = 0;
+	pRequest->nTimerID = 0;
+	pRequest->Next = m_nFreeRequest;
+	m_nFreeRequest = (int)(nRequestID & (MAX_NUMBER_OF_PENDING_REQUESTS - 1));
+
+	m_nRequests--;
+
+	return true;
+}
+
+unsigned int CLPendingRequestTable::GetNumberOfRequests()
+{
+	return m_nRequests;
+}
@@ -0,0 +1,25 @@
+#include <new>
+#include "CLPooledMessage.h"
+#include "CLMessagePool.h"
+
+CLPooledMessage::CLPooledMessage(unsigned long lMsgID) : CLMessage(lMsgID)
+{
+}
+
+CLPooledMessage::~CLPooledMessage()
+{
+}
+
+void* CLPooledMessage::operator new(size_t nSize)
+{
+	void *p = CLMessagePool::Allocate(nSize);
+	if(p == 0)
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void CLPooledMessage::operator delete(void *p)
+{
+	CLMessagePool::Free(p);
+}
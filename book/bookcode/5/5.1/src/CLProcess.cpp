@@ -10,6 +10,7 @@
 #include <syscall.h>
 #include "CLProcess.h"
 #include "CLExecutiveFunctionProvider.h"
+#include "CLProcessFunctionForExec.h"
 #include "CLLogger.h"
 
 using namespace std;
@@ -55,6 +56,27 @@ CLStatus CLProcess::Run(void *pstrCmdLine)
 	if(m_bProcessCreated)
 		return CLStatus(-1, 0);
 
+	//Ҫȴexecֱposix_spawnپRunChildFunction
+	if(m_bWaitForDeath)
+	{
+		CLProcessFunctionForExec *pExec = dynamic_cast<CLProcessFunctionForExec *>(m_pExecutiveFunctionProvider);
+		if(pExec != 0)
+		{
+			CLStatus s = pExec->SpawnProcess(pstrCmdLine, &m_ProcessID);
+			if(s.IsSuccess())
+			{
+				m_bProcessCreated = true;
+				return CLStatus(0, 0);
+			}
+
+			if(s.m_clErrorCode != ENOSYS)
+			{
+				delete this;
+				return CLStatus(-1, 0);
+			}
+		}
+	}
+
 	pid_t pid = vfork();
 	if(pid == -1)
 	{
@@ -123,6 +145,13 @@ CLStatus CLProcess::WaitForDeath()
 
 CLStatus CLProcess::CloseFileDescriptor()
 {
+#ifdef SYS_close_range
+	if(syscall(SYS_close_range, 3, ~0U, 0) == 0)
+		return CLStatus(0, 0);
+
+	//ں5.9ʱ֧close_range˻صɨ/proc
+#endif
+
 	string strPath = "/proc/";
 
 	char id[LENGTH_OF_PROCESSID];
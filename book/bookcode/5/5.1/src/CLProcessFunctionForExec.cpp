@@ -2,6 +2,7 @@
 #include <vector>
 #include <unistd.h>
 #include <errno.h>
+#include <spawn.h>
 #include <string>
 #include "CLProcessFunctionForExec.h"
 #include "CLLogger.h"
@@ -10,6 +11,13 @@ using namespace std;
 
 #define MAX_LENGTH_OF_PATH 1024
 
+//posix_spawn_file_actions_addchdir_npposix_spawn_file_actions_addclosefrom_npֱglibc 2.292.34ṩ
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 34))
+#define PROCESS_SPAWN_SUPPORTED
+#endif
+
+extern char **environ;
+
 CLProcessFunctionForExec::CLProcessFunctionForExec()
 {
 }
@@ -30,17 +38,8 @@ CLStatus CLProcessFunctionForExec::RunExecutiveFunction(void* pCmdLine)
 	char *pstrCmdLine = new char[len + 1];
 	strcpy(pstrCmdLine, (char *)pCmdLine);
 
-	char *p = pstrCmdLine;
-
 	vector<char *> vstrArgs;
-
-	while(char *q = strsep(&p, " "))
-	{
-		if(*q == 0)
-			continue;
-
-		vstrArgs.push_back(q);
-	}
+	SplitCmdLine(pstrCmdLine, vstrArgs);
 
 	char **argv = new char* [vstrArgs.size() + 1];
 	for(int i = 0; i < vstrArgs.size(); i++)
@@ -77,6 +76,97 @@ CLStatus CLProcessFunctionForExec::RunExecutiveFunction(void* pCmdLine)
 	}
 }
 
+CLStatus CLProcessFunctionForExec::SpawnProcess(void* pCmdLine, pid_t *pProcessID)
+{
+#ifndef PROCESS_SPAWN_SUPPORTED
+	return CLStatus(-1, ENOSYS);
+#else
+	if((pCmdLine == 0) || (pProcessID == 0))
+		return CLStatus(-1, 0);
+
+	int len = strlen((char *)pCmdLine);
+	if(len == 0)
+		return CLStatus(-1, 0);
+
+	char *pstrCmdLine = new char[len + 1];
+	strcpy(pstrCmdLine, (char *)pCmdLine);
+
+	vector<char *> vstrArgs;
+	SplitCmdLine(pstrCmdLine, vstrArgs);
+
+	if(vstrArgs.empty())
+	{
+		delete [] pstrCmdLine;
+		return CLStatus(-1, 0);
+	}
+
+	char **argv = new char* [vstrArgs.size() + 1];
+	for(unsigned int i = 0; i < vstrArgs.size(); i++)
+		argv[i] = vstrArgs[i];
+	argv[vstrArgs.size()] = NULL;
+
+	//SetWorkDirectoryͬӽлargv[0]ڵĿ¼argv[0]ֻļ
+	string strDirectory;
+	string str = argv[0];
+	size_t pos = str.rfind("/");
+	if(pos != string::npos)
+	{
+		strDirectory = str.substr(0, pos + 1);
+		argv[0] += pos + 1;
+	}
+
+	posix_spawn_file_actions_t actions;
+	int r = posix_spawn_file_actions_init(&actions);
+	if(r != 0)
+	{
+		CLLogger::WriteLogMsg("In CLProcessFunctionForExec::SpawnProcess(), posix_spawn_file_actions_init error", r);
+		delete [] argv;
+		delete [] pstrCmdLine;
+		return CLStatus(-1, r);
+	}
+
+	if(*argv[0] == 0)
+	{
+		CLLogger::WriteLogMsg("In CLProcessFunctionForExec::SpawnProcess(), argv0 error", 0);
+		r = EINVAL;
+	}
+	else if((!strDirectory.empty()) && ((r = posix_spawn_file_actions_addchdir_np(&actions, strDirectory.c_str())) != 0))
+		CLLogger::WriteLogMsg("In CLProcessFunctionForExec::SpawnProcess(), posix_spawn_file_actions_addchdir_np error", r);
+	else if((r = posix_spawn_file_actions_addclosefrom_np(&actions, 3)) != 0)
+		CLLogger::WriteLogMsg("In CLProcessFunctionForExec::SpawnProcess(), posix_spawn_file_actions_addclosefrom_np error", r);
+	else
+	{
+		//glibcposix_spawnʹCLONE_VFORKexecʧʱĴֱӷظ
+		r = posix_spawn(pProcessID, argv[0], &actions, 0, argv, environ);
+		if(r != 0)
+			CLLogger::WriteLogMsg("In CLProcessFunctionForExec::SpawnProcess(), posix_spawn error", r);
+	}
+
+	posix_spawn_file_actions_destroy(&actions);
+
+	delete [] argv;
+	delete [] pstrCmdLine;
+
+	if(r != 0)
+		return CLStatus(-1, r);
+
+	return CLStatus(0, 0);
+#endif
+}
+
+void CLProcessFunctionForExec::SplitCmdLine(char *pstrCmdLine, vector<char *>& vstrArgs)
+{
+	char *p = pstrCmdLine;
+
+	while(char *q = strsep(&p, " "))
+	{
+		if(*q == 0)
+			continue;
+
+		vstrArgs.push_back(q);
+	}
+}
+
 CLStatus CLProcessFunctionForExec::SetWorkDirectory(char *pstrArgv0)
 {
 	string str = pstrArgv0;
@@ -0,0 +1,48 @@
+#include <unistd.h>
+#include <errno.h>
+#include "CLProcessInitialFinishedNotifier.h"
+#include "CLLogger.h"
+
+CLProcessInitialFinishedNotifier::CLProcessInitialFinishedNotifier(int fd)
+{
+	m_Fd = fd;
+	m_bSuccess = false;
+}
+
+CLProcessInitialFinishedNotifier::~CLProcessInitialFinishedNotifier()
+{
+	if(m_Fd != -1)
+		close(m_Fd);
+}
+
+CLStatus CLProcessInitialFinishedNotifier::NotifyInitialFinished(bool bInitialSuccess)
+{
+	m_bSuccess = bInitialSuccess;
+
+	if(m_Fd == -1)
+		return CLStatus(-1, 0);
+
+	char c = bInitialSuccess ? 1 : 0;
+
+	ssize_t r;
+	do
+	{
+		r = write(m_Fd, &c, 1);
+	} while((r == -1) && (errno == EINTR));
+
+	close(m_Fd);
+	m_Fd = -1;
+
+	if(r != 1)
+	{
+		CLLogger::WriteLogMsg("In CLProcessInitialFinishedNotifier::NotifyInitialFinished(), write error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	return CLStatus(0, 0);
+}
+
+bool CLProcessInitialFinishedNotifier::IsInitialSuccess()
+{
+	return m_bSuccess;
+}
@@ -0,0 +1,358 @@
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "CLProcessPool.h"
+#include "CLExecutiveCommunicationByProcessPool.h"
+#include "CLMsgLoopManagerForProcessPool.h"
+#include "CLExecutiveFunctionForMsgLoop.h"
+#include "CLProcessInitialFinishedNotifier.h"
+#include "CLExecutiveNameServer.h"
+#include "CLMessageObserver.h"
+#include "CLMessageSerializer.h"
+#include "CLZeroCopyMessageSerializer.h"
+#include "CLMessageDeserializer.h"
+#include "CLZeroCopyMessageDeserializer.h"
+#include "CLZeroCopyDeserializerAdapter.h"
+#include "CLMessage.h"
+#include "CLLogger.h"
+
+using namespace std;
+
+#define LENGTH_OF_WORKER_INDEX 16
+
+CLProcessPool::CLProcessPool(const vector<CLMessageObserver*>& Observers, const char *pstrPoolName)
+{
+	if(Observers.empty())
+		throw "In CLProcessPool::CLProcessPool(), Observers error";
+
+	for(unsigned int i = 0; i < Observers.size(); i++)
+	{
+		if(Observers[i] == 0)
+			throw "In CLProcessPool::CLProcessPool(), Observers error";
+	}
+
+	if((pstrPoolName == 0) || (strlen(pstrPoolName) == 0))
+		throw "In CLProcessPool::CLProcessPool(), pstrPoolName error";
+
+	m_strPoolName = pstrPoolName;
+	m_Observers = Observers;
+
+	for(unsigned int i = 0; i < Observers.size(); i++)
+	{
+		char index[LENGTH_OF_WORKER_INDEX];
+		snprintf(index, LENGTH_OF_WORKER_INDEX, "_%u", i);
+
+		m_WorkerNames.push_back(m_strPoolName + index);
+	}
+
+	m_pCommunication = new CLExecutiveCommunicationByProcessPool(m_WorkerNames);
+
+	m_bRunCalled = false;
+	m_bRegistered = false;
+}
+
+CLProcessPool::~CLProcessPool()
+{
+	if(m_bRunCalled)
+		Shutdown();
+
+	//۲ֻڹУеĸͷ
+	for(unsigned int i = 0; i < m_Observers.size(); i++)
+		delete m_Observers[i];
+
+	for(unsigned int i = 0; i < m_Deserializers.size(); i++)
+		delete m_Deserializers[i].second;
+
+	//Ǽǵַ֮ͨŶַͷ
+	if(!m_bRegistered)
+		delete m_pCommunication;
+}
+
+CLStatus CLProcessPool::RegisterSerializer(unsigned long lMsgID, CLMessageSerializer *pSerializer)
+{
+	if(m_bRunCalled)
+	{
+		delete pSerializer;
+		return CLStatus(-1, 0);
+	}
+
+	return m_pCommunication->RegisterSerializer(lMsgID, pSerializer);
+}
+
+CLStatus CLProcessPool::RegisterSerializer(unsigned long lMsgID, CLZeroCopyMessageSerializer *pSerializer)
+{
+	if(m_bRunCalled)
+	{
+		delete pSerializer;
+		return CLStatus(-1, 0);
+	}
+
+	return m_pCommunication->RegisterSerializer(lMsgID, pSerializer);
+}
+
+CLStatus CLProcessPool::RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer)
+{
+	if(pDeserializer == 0)
+		return CLStatus(-1, 0);
+
+	return RegisterDeserializer(lMsgID, new CLZeroCopyDeserializerAdapter(pDeserializer));
+}
+
+CLStatus CLProcessPool::RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer)
+{
+	if(pDeserializer == 0)
+		return CLStatus(-1, 0);
+
+	bool bExist = m_bRunCalled || (lMsgID == PROCESS_POOL_QUIT_ID);
+	for(unsigned int i = 0; (!bExist) && (i < m_Deserializers.size()); i++)
+		bExist = (m_Deserializers[i].first == lMsgID);
+
+	if(bExist)
+	{
+		delete pDeserializer;
+		CLLogger::WriteLogMsg("In CLProcessPool::RegisterDeserializer(), lMsgID error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	m_Deserializers.push_back(make_pair(lMsgID, pDeserializer));
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLProcessPool::Run(void *pContext)
+{
+	if(m_bRunCalled)
+		return CLStatus(-1, 0);
+
+	m_bRunCalled = true;
+
+	int fd[2];
+	if(pipe(fd) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLProcessPool::Run(), pipe error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	//ӽ̻̳б׼I/Oδ
+	fflush(0);
+
+	for(unsigned int i = 0; i < m_Observers.size(); i++)
+	{
+		pid_t pid = fork();
+		if(pid == -1)
+		{
+			CLLogger::WriteLogMsg("In CLProcessPool::Run(), fork error", errno);
+			break;
+		}
+
+		if(pid == 0)
+		{
+			close(fd[0]);
+			RunWorker(i, fd[1], pContext);
+		}
+
+		m_ProcessIDs.push_back(pid);
+	}
+
+	close(fd[1]);
+
+	bool bSuccess = (m_ProcessIDs.size() == m_Observers.size());
+
+	//ÿ̳ʼϺдһֽڣļ˵й֪֮ͨǰ
+	unsigned int nNotified = 0;
+	while(nNotified < m_ProcessIDs.size())
+	{
+		char c;
+		ssize_t r = read(fd[0], &c, 1);
+		if((r == -1) && (errno == EINTR))
+			continue;
+
+		if(r != 1)
+		{
+			CLLogger::WriteLogMsg("In CLProcessPool::Run(), read error", errno);
+			bSuccess = false;
+			break;
+		}
+
+		nNotified++;
+
+		if(c == 0)
+			bSuccess = false;
+	}
+
+	close(fd[0]);
+
+	if(bSuccess)
+	{
+		CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+		if(pNameServer == 0)
+		{
+			CLLogger::WriteLogMsg("In CLProcessPool::Run(), CLExecutiveNameServer::GetInstance error", 0);
+			bSuccess = false;
+		}
+		else
+		{
+			//۳ɹͨŶѽַ
+			m_bRegistered = true;
+
+			CLStatus s = pNameServer->Register(m_strPoolName.c_str(), m_pCommunication);
+			if(!s.IsSuccess())
+			{
+				CLLogger::WriteLogMsg("In CLProcessPool::Run(), pNameServer->Register error", 0);
+				m_pCommunication = 0;
+				bSuccess = false;
+			}
+		}
+	}
+
+	if(!bSuccess)
+	{
+		Shutdown();
+		return CLStatus(-1, 0);
+	}
+
+	return CLStatus(0, 0);
+}
+
+void CLProcessPool::RunWorker(unsigned int nIndex, int fd, void *pContext)
+{
+	try
+	{
+		CLMsgLoopManagerForProcessPool *pManager = new CLMsgLoopManagerForProcessPool(m_Observers[nIndex], m_WorkerNames[nIndex].c_str());
+
+		//еķлӽеĸϢѭͷ
+		for(unsigned int i = 0; i < m_Deserializers.size(); i++)
+			pManager->RegisterDeserializer(m_Deserializers[i].first, m_Deserializers[i].second);
+
+		CLExecutiveFunctionForMsgLoop function(pManager);
+		CLProcessInitialFinishedNotifier notifier(fd);
+
+		SLExecutiveInitialParameter para;
+		para.pContext = pContext;
+		para.pNotifier = &notifier;
+
+		CLStatus s = function.RunExecutiveFunction(&para);
+		if(!s.IsSuccess())
+			CLLogger::WriteLogMsg("In CLProcessPool::RunWorker(), function.RunExecutiveFunction error", 0);
+	}
+	catch(const char *pstr)
+	{
+		CLLogger::WriteLogMsg(pstr, 0);
+	}
+
+	//ܷص̵ĴУҲִиעatexit뾲̬
+	_exit(0);
+}
+
+CLStatus CLProcessPool::Shutdown()
+{
+	if((!m_bRunCalled) || (m_ProcessIDs.empty()))
+		return CLStatus(-1, 0);
+
+	if(m_bRegistered && (m_pCommunication != 0))
+	{
+		CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+		if((pNameServer == 0) || (!pNameServer->ReleaseCommunicationPtr(m_strPoolName.c_str()).IsSuccess()))
+			CLLogger::WriteLogMsg("In CLProcessPool::Shutdown(), pNameServer->ReleaseCommunicationPtr error", 0);
+
+		m_pCommunication = 0;
+	}
+
+	//ʹöͨŶ˳ϢַеͨŶѱͷ
+	CLExecutiveCommunicationByProcessPool *pCommunication = 0;
+	try
+	{
+		pCommunication = new CLExecutiveCommunicationByProcessPool(m_WorkerNames);
+	}
+	catch(const char *pstr)
+	{
+		CLLogger::WriteLogMsg(pstr, 0);
+	}
+
+	for(unsigned int i = 0; (pCommunication != 0) && (i < m_ProcessIDs.size()); i++)
+	{
+		//ʱȴڳռ䣬ʱ
+		while(!pCommunication->PostExecutiveMessage(new CLMessage(PROCESS_POOL_QUIT_ID), i).IsSuccess())
+		{
+			if(waitpid(m_ProcessIDs[i], 0, WNOHANG) != 0)
+			{
+				m_ProcessIDs[i] = -1;
+				break;
+			}
+
+			struct timespec ts = {0, 1000000};
+			nanosleep(&ts, 0);
+		}
+	}
+
+	delete pCommunication;
+
+	WaitForWorkers();
+
+	return CLStatus(0, 0);
+}
+
+void CLProcessPool::WaitForWorkers()
+{
+	for(unsigned int i = 0; i < m_ProcessIDs.size(); i++)
+	{
+		if(m_ProcessIDs[i] == -1)
+			continue;
+
+		while(waitpid(m_ProcessIDs[i], 0, 0) == -1)
+		{
+			if(errno != EINTR)
+			{
+				CLLogger::WriteLogMsg("In CLProcessPool::WaitForWorkers(), waitpid error", errno);
+				break;
+			}
+		}
+	}
+
+	m_ProcessIDs.clear();
+}
+
+CLStatus CLProcessPool::PostExecutiveMessage(const char *pstrPoolName, CLMessage *pMessage, unsigned long lAffinityKey)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	CLExecutiveNameServer *pNameServer = CLExecutiveNameServer::GetInstance();
+	if(pNameServer == 0)
+	{
+		CLLogger::WriteLogMsg("In CLProcessPool::PostExecutiveMessage(), CLExecutiveNameServer::GetInstance error", 0);
+		delete pMessage;
+		return CLStatus(-1, 0);
+	}
+
+	CLExecutiveCommunication *pComm = pNameServer->GetCommunicationPtr(pstrPoolName);
+	if(pComm == 0)
+	{
+		CLLogger::WriteLogMsg("In CLProcessPool::PostExecutiveMessage(), pNameServer->GetCommunicationPtr error", 0);
+		delete pMessage;
+		return CLStatus(-1, 0);
+	}
+
+	bool bSuccess = false;
+
+	CLExecutiveCommunicationByProcessPool *pPoolComm = dynamic_cast<CLExecutiveCommunicationByProcessPool *>(pComm);
+	if(pPoolComm != 0)
+		bSuccess = pPoolComm->PostExecutiveMessage(pMessage, lAffinityKey).IsSuccess();
+	else
+	{
+		CLLogger::WriteLogMsg("In CLProcessPool::PostExecutiveMessage(), pstrPoolName is not a process pool", 0);
+		delete pMessage;
+	}
+
+	CLStatus s1 = pNameServer->ReleaseCommunicationPtr(pstrPoolName);
+	if(!s1.IsSuccess())
+		CLLogger::WriteLogMsg("In CLProcessPool::PostExecutiveMessage(), pNameServer->ReleaseCommunicationPtr error", 0);
+
+	if(bSuccess)
+		return CLStatus(0, 0);
+	else
+		return CLStatus(-1, 0);
+}
@@ -0,0 +1,27 @@
+#include "CLRequestMessage.h"
+#include "CLResponseMessage.h"
+#include "CLExecutiveNameServer.h"
+
+CLRequestMessage::CLRequestMessage(unsigned long lMsgID) : CLMessage(lMsgID)
+{
+	m_nRequestID = 0;
+}
+
+CLRequestMessage::~CLRequestMessage()
+{
+}
+
+CLStatus CLRequestMessage::Reply(CLResponseMessage *pResponse)
+{
+	return Reply(m_strReplyTo.c_str(), m_nRequestID, pResponse);
+}
+
+CLStatus CLRequestMessage::Reply(const char *pstrReplyTo, unsigned long nRequestID, CLResponseMessage *pResponse)
+{
+	if(pResponse == 0)
+		return CLStatus(-1, 0);
+
+	pResponse->m_nRequestID = nRequestID;
+
+	return CLExecutiveNameServer::PostExecutiveMessage(pstrReplyTo, pResponse);
+}
@@ -0,0 +1,10 @@
+#include "CLResponseMessage.h"
+
+CLResponseMessage::CLResponseMessage() : CLMessage(MESSAGE_ID_OF_RESPONSE)
+{
+	m_nRequestID = 0;
+}
+
+CLResponseMessage::~CLResponseMessage()
+{
+}
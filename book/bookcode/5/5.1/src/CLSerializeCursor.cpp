@@ -0,0 +1,116 @@
+#include <string.h>
+#include "CLSerializeCursor.h"
+
+CLSerializeCursor::CLSerializeCursor(char *pBuffer, unsigned int nLength)
+{
+	if(pBuffer == 0)
+		throw "In CLSerializeCursor::CLSerializeCursor(), pBuffer error";
+
+	m_bGather = false;
+	m_pBuffer = pBuffer;
+	m_nCapacity = nLength;
+	m_nUsed = 0;
+	m_nLength = 0;
+}
+
+CLSerializeCursor::CLSerializeCursor()
+{
+	m_bGather = true;
+	m_pBuffer = 0;
+	m_nCapacity = 0;
+	m_nUsed = 0;
+	m_nLength = 0;
+}
+
+CLSerializeCursor::~CLSerializeCursor()
+{
+	if(m_bGather)
+		delete [] m_pBuffer;
+}
+
+CLStatus CLSerializeCursor::Write(const void *pData, unsigned int nLength)
+{
+	if(nLength == 0)
+		return CLStatus(0, 0);
+
+	if((pData == 0) || (m_nUsed + nLength > m_nCapacity))
+		return CLStatus(-1, 0);
+
+	char *pDest = m_pBuffer + m_nUsed;
+	memcpy(pDest, pData, nLength);
+
+	if(m_bGather)
+	{
+		//һθƵʱϲΪһiovec
+		if((!m_Iovecs.empty()) && ((char *)m_Iovecs.back().iov_base + m_Iovecs.back().iov_len == pDest))
+			m_Iovecs.back().iov_len += nLength;
+		else
+		{
+			struct iovec iov;
+			iov.iov_base = pDest;
+			iov.iov_len = nLength;
+			m_Iovecs.push_back(iov);
+		}
+	}
+
+	m_nUsed += nLength;
+	m_nLength += nLength;
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLSerializeCursor::WriteReference(const void *pData, unsigned int nLength)
+{
+	if(!m_bGather)
+		return Write(pData, nLength);
+
+	if(nLength == 0)
+		return CLStatus(0, 0);
+
+	if(pData == 0)
+		return CLStatus(-1, 0);
+
+	struct iovec iov;
+	iov.iov_base = (void *)pData;
+	iov.iov_len = nLength;
+	m_Iovecs.push_back(iov);
+
+	m_nLength += nLength;
+
+	return CLStatus(0, 0);
+}
+
+unsigned int CLSerializeCursor::GetLength()
+{
+	return m_nLength;
+}
+
+void CLSerializeCursor::Reset(unsigned int nMaxLength)
+{
+	if(!m_bGather)
+		return;
+
+	if(nMaxLength > m_nCapacity)
+	{
+		delete [] m_pBuffer;
+		m_pBuffer = new char[nMaxLength];
+		m_nCapacity = nMaxLength;
+	}
+
+	m_nUsed = 0;
+	m_nLength = 0;
+	m_Iovecs.clear();
+}
+
+const struct iovec *CLSerializeCursor::GetIovecs()
+{
+	if(m_Iovecs.empty())
+		return 0;
+
+	return &m_Iovecs[0];
+}
+
+int CLSerializeCursor::GetIovecCount()
+{
+	return m_Iovecs.size();
+}
@@ -17,6 +17,7 @@ CLStatus CLSharedEventImpl::InitializeSharedObject(SLSharedObjectHead *pObject)
 	SLSharedEventItem *pEventItem = (SLSharedEventItem *)pObject;
 
 	pEventItem->EventInfo.Flag = 0;
+	pEventItem->EventInfo.Waiters = 0;
 	pEventItem->EventInfo.bSemaphore = 0;
 	pEventItem->EventInfo.Context = 0;
 
@@ -28,6 +29,7 @@ CLStatus CLSharedEventImpl::DestroySharedObject(SLSharedObjectHead *pObject)
 	SLSharedEventItem *pEventItem = (SLSharedEventItem *)pObject;
 	
 	pEventItem->EventInfo.Flag = 0;
+	pEventItem->EventInfo.Waiters = 0;
 	pEventItem->EventInfo.bSemaphore = 0;
 	pEventItem->EventInfo.Context = 0;
 
@@ -1,6 +1,10 @@
+#include <errno.h>
 #include "CLSharedExecutiveCommunicationByNamedPipe.h"
 #include "CLLogger.h"
 #include "CLMessageSerializer.h"
+#include "CLZeroCopyMessageSerializer.h"
+#include "CLZeroCopySerializerAdapter.h"
+#include "CLSerializeCursor.h"
 #include "CLMessage.h"
 
 CLSharedExecutiveCommunicationByNamedPipe::CLSharedExecutiveCommunicationByNamedPipe(const char *pstrExecutiveName) : CLExecutiveCommunicationByNamedPipe(pstrExecutiveName, true)
@@ -9,9 +13,11 @@ CLSharedExecutiveCommunicationByNamedPipe::CLSharedExecutiveCommunicationByNamed
 
 CLSharedExecutiveCommunicationByNamedPipe::~CLSharedExecutiveCommunicationByNamedPipe()
 {
-	map<unsigned long, CLMessageSerializer*>::iterator it;
-	for(it = m_SerializerTable.begin(); it != m_SerializerTable.end(); it++)
-		delete it->second;
+	vector<CLZeroCopyMessageSerializer*> Serializers;
+	m_SerializerTable.GetAllValues(Serializers);
+
+	for(unsigned int i = 0; i < Serializers.size(); i++)
+		delete Serializers[i];
 }
 
 CLStatus CLSharedExecutiveCommunicationByNamedPipe::RegisterSerializer(unsigned long lMsgID, CLMessageSerializer *pSerializer)
@@ -19,33 +25,54 @@ CLStatus CLSharedExecutiveCommunicationByNamedPipe::RegisterSerializer(unsigned
 	if(pSerializer == 0)
 		return CLStatus(-1, 0);
 
-	map<unsigned long, CLMessageSerializer*>::iterator it = m_SerializerTable.find(lMsgID);
-	if(it != m_SerializerTable.end())
+	return RegisterSerializer(lMsgID, new CLZeroCopySerializerAdapter(pSerializer));
+}
+
+CLStatus CLSharedExecutiveCommunicationByNamedPipe::RegisterSerializer(unsigned long lMsgID, CLZeroCopyMessageSerializer *pSerializer)
+{
+	if(pSerializer == 0)
+		return CLStatus(-1, 0);
+
+	if(m_SerializerTable.Find(lMsgID) != 0)
 	{
 		delete pSerializer;
-		CLLogger::WriteLogMsg("In CLSharedExecutiveCommunicationByNamedPipe::RegisterSerializer(), m_SerializerTable.find error", 0);
+		CLLogger::WriteLogMsg("In CLSharedExecutiveCommunicationByNamedPipe::RegisterSerializer(), m_SerializerTable.Find error", 0);
 		return CLStatus(-1, 0);
 	}
 
-	m_SerializerTable[lMsgID] = pSerializer;
+	m_SerializerTable.Set(lMsgID, pSerializer);
 
 	return CLStatus(0, 0);
 }
 
-char *CLSharedExecutiveCommunicationByNamedPipe::GetMsgBuf(CLMessage *pMsg, unsigned int *pLength)
+CLStatus CLSharedExecutiveCommunicationByNamedPipe::WriteMsgToPipe(CLMessage *pMsg)
 {
-	map<unsigned long, CLMessageSerializer*>::iterator it = m_SerializerTable.find(pMsg->m_clMsgID);
-	if(it == m_SerializerTable.end())
-		return 0;
+	CLZeroCopyMessageSerializer **ppSerializer = m_SerializerTable.Find(pMsg->m_clMsgID);
+	if(ppSerializer == 0)
+		return CLStatus(-1, 0);
+
+	unsigned int length = (*ppSerializer)->GetSerializedLength(pMsg);
+	if((length == 0) || ((long)(sizeof(int) + length) > m_lPipeBufSize))
+		return CLStatus(-1, 0);
 
-	unsigned int length = 0;
-	char *pBuf = it->second->Serialize(pMsg, &length, sizeof(int));
-	if(pBuf == 0)
-		return 0;
+	//ͷϢһwritevд룬PIPE_BUFʱдԭӵ
+	//߳̿ͬʱͬһܵͶϢαʹþֲ
+	CLSerializeCursor cursor;
+	cursor.Reset(sizeof(int) + length);
+	cursor.Write(&length, sizeof(int));
 
-	int *pHead = (int *)pBuf;
-	*pHead = length - sizeof(int);
+	CLStatus s = (*ppSerializer)->Serialize(pMsg, &cursor);
+	if((!s.IsSuccess()) || (cursor.GetLength() != sizeof(int) + length))
+	{
+		CLLogger::WriteLogMsg("In CLSharedExecutiveCommunicationByNamedPipe::WriteMsgToPipe(), Serialize error", 0);
+		return CLStatus(-1, 0);
+	}
 
-	*pLength = length;
-	return pBuf;
-}
\ No newline at end of file
+	if(writev(m_Fd, cursor.GetIovecs(), cursor.GetIovecCount()) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLSharedExecutiveCommunicationByNamedPipe::WriteMsgToPipe(), writev error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	return CLStatus(0, 0);
+}
@@ -0,0 +1,129 @@
+#include "CLSharedExecutiveCommunicationByShmRing.h"
+#include "CLMessageSerializer.h"
+#include "CLZeroCopyMessageSerializer.h"
+#include "CLZeroCopySerializerAdapter.h"
+#include "CLSerializeCursor.h"
+#include "CLMessage.h"
+#include "CLLogger.h"
+
+CLSharedExecutiveCommunicationByShmRing::CLSharedExecutiveCommunicationByShmRing(const char *pstrExecutiveName) : m_Ring(pstrExecutiveName)
+{
+}
+
+CLSharedExecutiveCommunicationByShmRing::~CLSharedExecutiveCommunicationByShmRing()
+{
+	vector<CLZeroCopyMessageSerializer*> Serializers;
+	m_SerializerTable.GetAllValues(Serializers);
+
+	for(unsigned int i = 0; i < Serializers.size(); i++)
+		delete Serializers[i];
+}
+
+CLStatus CLSharedExecutiveCommunicationByShmRing::RegisterSerializer(unsigned long lMsgID, CLMessageSerializer *pSerializer)
+{
+	if(pSerializer == 0)
+		return CLStatus(-1, 0);
+
+	return RegisterSerializer(lMsgID, new CLZeroCopySerializerAdapter(pSerializer));
+}
+
+CLStatus CLSharedExecutiveCommunicationByShmRing::RegisterSerializer(unsigned long lMsgID, CLZeroCopyMessageSerializer *pSerializer)
+{
+	if(pSerializer == 0)
+		return CLStatus(-1, 0);
+
+	if(m_SerializerTable.Find(lMsgID) != 0)
+	{
+		delete pSerializer;
+		CLLogger::WriteLogMsg("In CLSharedExecutiveCommunicationByShmRing::RegisterSerializer(), m_SerializerTable.Find error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	m_SerializerTable.Set(lMsgID, pSerializer);
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLSharedExecutiveCommunicationByShmRing::PostExecutiveMessage(CLMessage *pMessage)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	CLZeroCopyMessageSerializer **ppSerializer = m_SerializerTable.Find(pMessage->m_clMsgID);
+	if(ppSerializer == 0)
+	{
+		delete pMessage;
+		CLLogger::WriteLogMsg("In CLSharedExecutiveCommunicationByShmRing::PostExecutiveMessage(), m_SerializerTable.Find error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	return PostExecutiveMessage(pMessage, *ppSerializer);
+}
+
+CLStatus CLSharedExecutiveCommunicationByShmRing::PostExecutiveMessage(CLMessage *pMessage, CLZeroCopyMessageSerializer *pSerializer)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	if(pSerializer == 0)
+	{
+		delete pMessage;
+		return CLStatus(-1, 0);
+	}
+
+	unsigned int nLength = pSerializer->GetSerializedLength(pMessage);
+	if(nLength == 0)
+	{
+		delete pMessage;
+		return CLStatus(-1, 0);
+	}
+
+	CLStatus s = (nLength <= MAX_LENGTH_OF_SHARED_MEMORY_RING_RECORD) ? WriteToRecord(pSerializer, pMessage, nLength) : WriteToChain(pSerializer, pMessage, nLength);
+
+	delete pMessage;
+
+	return s;
+}
+
+unsigned long CLSharedExecutiveCommunicationByShmRing::GetPendingLength()
+{
+	return m_Ring.GetPendingLength();
+}
+
+CLStatus CLSharedExecutiveCommunicationByShmRing::WriteToRecord(CLZeroCopyMessageSerializer *pSerializer, CLMessage *pMessage, unsigned int nLength)
+{
+	char *pRecord = m_Ring.BeginWrite(nLength);
+	if(pRecord == 0)
+		return CLStatus(-1, 0);
+
+	CLSerializeCursor cursor(pRecord, nLength);
+	CLStatus s = pSerializer->Serialize(pMessage, &cursor);
+	if((!s.IsSuccess()) || (cursor.GetLength() != nLength))
+	{
+		CLLogger::WriteLogMsg("In CLSharedExecutiveCommunicationByShmRing::WriteToRecord(), Serialize error", 0);
+		m_Ring.EndWrite(pRecord, false);
+		return CLStatus(-1, 0);
+	}
+
+	return m_Ring.EndWrite(pRecord, true);
+}
+
+CLStatus CLSharedExecutiveCommunicationByShmRing::WriteToChain(CLZeroCopyMessageSerializer *pSerializer, CLMessage *pMessage, unsigned int nLength)
+{
+	char *pBuf = new char[nLength];
+
+	CLSerializeCursor cursor(pBuf, nLength);
+	CLStatus s = pSerializer->Serialize(pMessage, &cursor);
+	if((!s.IsSuccess()) || (cursor.GetLength() != nLength))
+	{
+		CLLogger::WriteLogMsg("In CLSharedExecutiveCommunicationByShmRing::WriteToChain(), Serialize error", 0);
+		delete [] pBuf;
+		return CLStatus(-1, 0);
+	}
+
+	CLStatus s1 = m_Ring.Write(pBuf, nLength);
+
+	delete [] pBuf;
+
+	return s1;
+}
@@ -1,107 +1,65 @@
-#include <sys/ipc.h>
-#include <sys/types.h>
-#include <sys/shm.h>
 #include <string.h>
-#include <fcntl.h>
-#include <string>
-#include <errno.h>
 #include "CLSharedMemory.h"
+#include "CLSharedMemoryBySysV.h"
+#include "CLSharedMemoryByMmap.h"
 #include "CLLogger.h"
-#include "CLCriticalSection.h"
 
-using namespace std;
-
-#define ID_FOR_KEY 32
-
-#define FILE_PATH_FOR_SHARED_MEMORY "/tmp/"
-
-CLSharedMemory::CLSharedMemory(const char *pstrFileName, size_t nSize) : m_Mutex(pstrFileName, MUTEX_USE_RECORD_LOCK)
+CLSharedMemory::CLSharedMemory(const char *pstrFileName, size_t nSize, int nType, int nFlags)
 {
-	string strPathName = FILE_PATH_FOR_SHARED_MEMORY;
-	strPathName += pstrFileName;
+	if((pstrFileName == 0) || (strlen(pstrFileName) == 0))
+		throw "In CLSharedMemory::CLSharedMemory(), pstrFileName error";
 
-	int fd = open(strPathName.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
-	if(fd == -1)
+	if(nType == SHARED_MEMORY_USE_SYSV)
 	{
-		CLLogger::WriteLogMsg("In CLSharedMemory::CLSharedMemory(), open error", errno);
-		throw "In CLSharedMemory::CLSharedMemory(), open error";
+		m_pSharedMemory = new CLSharedMemoryBySysV(pstrFileName, nSize);
 	}
-
-	if(close(fd) == -1)
-		CLLogger::WriteLogMsg("In CLSharedMemory::CLSharedMemory(), close error", errno);
-
-	key_t key = ftok(strPathName.c_str(), ID_FOR_KEY);
-	if(key == -1)
+	else if(nType == SHARED_MEMORY_USE_POSIX)
 	{
-		CLLogger::WriteLogMsg("In CLSharedMemory::CLSharedMemory(), ftok error", errno);
-		throw "In CLSharedMemory::CLSharedMemory(), ftok error";
+		m_pSharedMemory = new CLSharedMemoryByMmap(pstrFileName, nSize, false, nFlags);
 	}
-
-	try
+	else if(nType == SHARED_MEMORY_USE_FILE)
 	{
-		CLCriticalSection cs(&m_Mutex);
-
-		m_SharedMemoryID = shmget(key, nSize, IPC_CREAT);
-		if(m_SharedMemoryID == -1)
-		{
-			CLLogger::WriteLogMsg("In CLSharedMemory::CLSharedMemory(), shmget error", errno);
-			throw "In CLSharedMemory::CLSharedMemory(), shmget error";
-		}
-
-		m_pSharedMemory = shmat(m_SharedMemoryID, 0, 0);
-		if((long)m_pSharedMemory == -1)
-		{
-			CLLogger::WriteLogMsg("In CLSharedMemory::CLSharedMemory(), shmat error", errno);
-			DeleteSharedMemory();
-			throw "In CLSharedMemory::CLSharedMemory(), shmat error";
-		}
+		m_pSharedMemory = new CLSharedMemoryByMmap(pstrFileName, nSize, true, nFlags);
 	}
-	catch(const char *pstr)
+	else
+		throw "In CLSharedMemory::CLSharedMemory(), nType error";
+
+	if(!(m_pSharedMemory->Initialize()).IsSuccess())
 	{
-		throw pstr;
+		delete m_pSharedMemory;
+		throw "In CLSharedMemory::CLSharedMemory(), Initialize error";
 	}
 }
 
 CLSharedMemory::~CLSharedMemory()
 {
-	CLCriticalSection cs(&m_Mutex);
-
-	if(shmdt(m_pSharedMemory) == -1)
-	{
-		CLLogger::WriteLogMsg("In CLSharedMemory::~CLSharedMemory(), shmdt error", errno);
-		return;
-	}
+	if(!(m_pSharedMemory->Uninitialize()).IsSuccess())
+		CLLogger::WriteLogMsg("In CLSharedMemory::~CLSharedMemory(), m_pSharedMemory->Uninitialize error", 0);
 
-	DeleteSharedMemory();
+	delete m_pSharedMemory;
 }
 
 void *CLSharedMemory::GetAddress()
 {
-	return m_pSharedMemory;
+	return m_pSharedMemory->GetAddress();
 }
 
-CLStatus CLSharedMemory::DeleteSharedMemory()
+size_t CLSharedMemory::GetSize()
 {
-	if(GetRefCount() == 0)
-	{
-		if(shmctl(m_SharedMemoryID, IPC_RMID, 0) == -1)
-		{
-			CLLogger::WriteLogMsg("In CLSharedMemory::~CLSharedMemory(), shmctl IPC_RMID error", errno);
-			return CLStatus(-1, 0);
-		}
-	}
-
-	return CLStatus(0, 0);
+	return m_pSharedMemory->GetSize();
 }
 
 int CLSharedMemory::GetRefCount()
 {
-	shmid_ds buf;
-	if(shmctl(m_SharedMemoryID, IPC_STAT, &buf) == -1)
-	{
-		CLLogger::WriteLogMsg("In CLSharedMemory::~CLSharedMemory(), shmctl IPC_STAT error", errno);
-		return -1;
-	}
+	return m_pSharedMemory->GetRefCount();
+}
 
-	return buf.shm_nattch;
+CLStatus CLSharedMemory::Resize(size_t nNewSize)
+{
+	return m_pSharedMemory->Resize(nNewSize);
+}
+
+CLStatus CLSharedMemory::Refresh()
+{
+	return m_pSharedMemory->Refresh();
 }
\ No newline at end of file
@@ -0,0 +1,313 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include "CLSharedMemoryByMmap.h"
+#include "CLSharedMemory.h"
+#include "CLLogger.h"
+#include "CLCriticalSection.h"
+
+using namespace std;
+
+#define FILE_PATH_FOR_PERSISTENT_SHARED_MEMORY "/tmp/"
+#define SUFFIX_OF_PERSISTENT_SHARED_MEMORY ".shm"
+#define FILE_PATH_FOR_HUGETLBFS "/dev/hugepages/"
+#define SIZE_OF_HUGE_PAGE_FOR_SHARED_MEMORY (2 * 1024 * 1024)
+
+CLSharedMemoryByMmap::CLSharedMemoryByMmap(const char *pstrFileName, size_t nSize, bool bPersistent, int nFlags) : m_Mutex(pstrFileName, MUTEX_USE_RECORD_LOCK)
+{
+	m_strFileName = pstrFileName;
+	m_nSize = nSize;
+	m_bPersistent = bPersistent;
+	m_nFlags = nFlags;
+	m_bHugeTLB = false;
+
+	m_Fd = -1;
+	m_pMapped = 0;
+	m_nMappedSize = 0;
+}
+
+CLSharedMemoryByMmap::~CLSharedMemoryByMmap()
+{
+}
+
+CLStatus CLSharedMemoryByMmap::OpenFile()
+{
+	//¼ʹõ/tmpµͬļļ֮ͬرļͷż¼
+	if(m_bPersistent)
+	{
+		m_strPathName = FILE_PATH_FOR_PERSISTENT_SHARED_MEMORY + m_strFileName + SUFFIX_OF_PERSISTENT_SHARED_MEMORY;
+		m_Fd = open(m_strPathName.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+	}
+	else if((m_nFlags & SHARED_MEMORY_FLAG_HUGE_PAGE) && (access(FILE_PATH_FOR_HUGETLBFS, W_OK) == 0))
+	{
+		m_bHugeTLB = true;
+		m_strPathName = FILE_PATH_FOR_HUGETLBFS + m_strFileName;
+		m_Fd = open(m_strPathName.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+	}
+	else
+	{
+		m_strPathName = "/" + m_strFileName;
+		m_Fd = shm_open(m_strPathName.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+	}
+
+	if(m_Fd == -1)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::OpenFile(), open error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLSharedMemoryByMmap::Initialize()
+{
+	if(m_strFileName.find('/') != string::npos)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Initialize(), file name error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	try
+	{
+		CLCriticalSection cs(&m_Mutex);
+
+		CLStatus s = OpenFile();
+		if(!s.IsSuccess())
+			return s;
+
+		struct stat st;
+		if(fstat(m_Fd, &st) == -1)
+		{
+			CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Initialize(), fstat error", errno);
+			close(m_Fd);
+			return CLStatus(-1, errno);
+		}
+
+		bool bCreated = (st.st_size == 0);
+		if(bCreated && (m_nSize == 0))
+		{
+			CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Initialize(), shared memory does not exist", 0);
+			close(m_Fd);
+			return CLStatus(-1, 0);
+		}
+
+		size_t nMappedSize = st.st_size;
+		if(bCreated)
+		{
+			nMappedSize = GetMappedSize(m_nSize);
+			if(ftruncate(m_Fd, nMappedSize) == -1)
+			{
+				CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Initialize(), ftruncate error", errno);
+				close(m_Fd);
+				return CLStatus(-1, errno);
+			}
+		}
+
+		int nMapFlags = MAP_SHARED;
+		if(m_nFlags & SHARED_MEMORY_FLAG_POPULATE)
+			nMapFlags |= MAP_POPULATE;
+
+		void *p = mmap(0, nMappedSize, PROT_READ | PROT_WRITE, nMapFlags, m_Fd, 0);
+		if(p == MAP_FAILED)
+		{
+			CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Initialize(), mmap error", errno);
+			close(m_Fd);
+			return CLStatus(-1, errno);
+		}
+
+		m_pMapped = (char *)p;
+		m_nMappedSize = nMappedSize;
+
+		if((m_nFlags & SHARED_MEMORY_FLAG_HUGE_PAGE) && (!m_bHugeTLB))
+		{
+			//tmpfsϵ͸ҳȡ/sys/kernel/mm/transparent_hugepage/shmem_enabled
+			if(madvise(m_pMapped, m_nMappedSize, MADV_HUGEPAGE) == -1)
+				CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Initialize(), madvise error", errno);
+		}
+
+		SLSharedMemoryHead *pHead = (SLSharedMemoryHead *)m_pMapped;
+		if(bCreated)
+			pHead->nSize = m_nSize;
+
+		pHead->nRefCount++;
+
+		//ѴڵĹڴСҪĴСʱ
+		if(m_nSize > pHead->nSize)
+		{
+			CLStatus s1 = Grow(m_nSize);
+			if(!s1.IsSuccess())
+			{
+				((SLSharedMemoryHead *)m_pMapped)->nRefCount--;
+				munmap(m_pMapped, m_nMappedSize);
+				close(m_Fd);
+				return s1;
+			}
+		}
+
+		return CLStatus(0, 0);
+	}
+	catch(const char *pstr)
+	{
+		CLLogger::WriteLogMsg(pstr, 0);
+		return CLStatus(-1, 0);
+	}
+}
+
+CLStatus CLSharedMemoryByMmap::Uninitialize()
+{
+	try
+	{
+		CLCriticalSection cs(&m_Mutex);
+
+		SLSharedMemoryHead *pHead = (SLSharedMemoryHead *)m_pMapped;
+		int nRefCount = --(pHead->nRefCount);
+
+		if(munmap(m_pMapped, m_nMappedSize) == -1)
+			CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Uninitialize(), munmap error", errno);
+
+		if(close(m_Fd) == -1)
+			CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Uninitialize(), close error", errno);
+
+		if((nRefCount > 0) || m_bPersistent)
+			return CLStatus(0, 0);
+
+		int r = m_bHugeTLB ? unlink(m_strPathName.c_str()) : shm_unlink(m_strPathName.c_str());
+		if(r == -1)
+		{
+			CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Uninitialize(), unlink error", errno);
+			return CLStatus(-1, errno);
+		}
+
+		return CLStatus(0, 0);
+	}
+	catch(const char *pstr)
+	{
+		CLLogger::WriteLogMsg(pstr, 0);
+		return CLStatus(-1, 0);
+	}
+}
+
+void *CLSharedMemoryByMmap::GetAddress()
+{
+	return m_pMapped + SIZE_OF_SHARED_MEMORY_HEAD;
+}
+
+size_t CLSharedMemoryByMmap::GetSize()
+{
+	return ((SLSharedMemoryHead *)m_pMapped)->nSize;
+}
+
+int CLSharedMemoryByMmap::GetRefCount()
+{
+	return ((SLSharedMemoryHead *)m_pMapped)->nRefCount;
+}
+
+CLStatus CLSharedMemoryByMmap::Resize(size_t nNewSize)
+{
+	try
+	{
+		CLCriticalSection cs(&m_Mutex);
+
+		SLSharedMemoryHead *pHead = (SLSharedMemoryHead *)m_pMapped;
+		if(nNewSize < pHead->nSize)
+			return CLStatus(-1, 0);
+
+		if(nNewSize == pHead->nSize)
+			return Remap(GetMappedSize(nNewSize));
+
+		return Grow(nNewSize);
+	}
+	catch(const char *pstr)
+	{
+		CLLogger::WriteLogMsg(pstr, 0);
+		return CLStatus(-1, 0);
+	}
+}
+
+CLStatus CLSharedMemoryByMmap::Refresh()
+{
+	try
+	{
+		CLCriticalSection cs(&m_Mutex);
+
+		return Remap(GetMappedSize(((SLSharedMemoryHead *)m_pMapped)->nSize));
+	}
+	catch(const char *pstr)
+	{
+		CLLogger::WriteLogMsg(pstr, 0);
+		return CLStatus(-1, 0);
+	}
+}
+
+CLStatus CLSharedMemoryByMmap::Grow(size_t nNewSize)
+{
+	size_t nMappedSize = GetMappedSize(nNewSize);
+
+	struct stat st;
+	if(fstat(m_Fd, &st) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Grow(), fstat error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	if(((size_t)st.st_size < nMappedSize) && (ftruncate(m_Fd, nMappedSize) == -1))
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Grow(), ftruncate error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	CLStatus s = Remap(nMappedSize);
+	if(!s.IsSuccess())
+		return s;
+
+	((SLSharedMemoryHead *)m_pMapped)->nSize = nNewSize;
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLSharedMemoryByMmap::Remap(size_t nMappedSize)
+{
+	if(nMappedSize <= m_nMappedSize)
+		return CLStatus(0, 0);
+
+	void *p = mremap(m_pMapped, m_nMappedSize, nMappedSize, MREMAP_MAYMOVE);
+	if(p == MAP_FAILED)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryByMmap::Remap(), mremap error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	size_t nOldMappedSize = m_nMappedSize;
+
+	m_pMapped = (char *)p;
+	m_nMappedSize = nMappedSize;
+
+	if((m_nFlags & SHARED_MEMORY_FLAG_HUGE_PAGE) && (!m_bHugeTLB))
+		madvise(m_pMapped, m_nMappedSize, MADV_HUGEPAGE);
+
+	if(m_nFlags & SHARED_MEMORY_FLAG_POPULATE)
+		Populate(m_pMapped + nOldMappedSize, nMappedSize - nOldMappedSize);
+
+	return CLStatus(0, 0);
+}
+
+size_t CLSharedMemoryByMmap::GetMappedSize(size_t nSize)
+{
+	size_t nAlignment = m_bHugeTLB ? SIZE_OF_HUGE_PAGE_FOR_SHARED_MEMORY : (size_t)sysconf(_SC_PAGESIZE);
+
+	return (SIZE_OF_SHARED_MEMORY_HEAD + nSize + nAlignment - 1) / nAlignment * nAlignment;
+}
+
+void CLSharedMemoryByMmap::Populate(char *p, size_t nLength)
+{
+#ifdef MADV_POPULATE_WRITE
+	if(madvise(p, nLength, MADV_POPULATE_WRITE) == 0)
+		return;
+#endif
+
+	//mremapûMAP_POPULATEںϸMADV_WILLNEEDҳԤȽҳ
+	madvise(p, nLength, MADV_WILLNEED);
+}
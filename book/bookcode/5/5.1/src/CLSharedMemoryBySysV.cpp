@@ -0,0 +1,128 @@
+#include <sys/ipc.h>
+#include <sys/types.h>
+#include <sys/shm.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string>
+#include <errno.h>
+#include "CLSharedMemoryBySysV.h"
+#include "CLLogger.h"
+#include "CLCriticalSection.h"
+
+using namespace std;
+
+#define ID_FOR_KEY 32
+
+#define FILE_PATH_FOR_SHARED_MEMORY "/tmp/"
+
+CLSharedMemoryBySysV::CLSharedMemoryBySysV(const char *pstrFileName, size_t nSize) : m_Mutex(pstrFileName, MUTEX_USE_RECORD_LOCK)
+{
+	m_strFileName = pstrFileName;
+	m_nSize = nSize;
+
+	m_pSharedMemory = 0;
+	m_SharedMemoryID = -1;
+}
+
+CLSharedMemoryBySysV::~CLSharedMemoryBySysV()
+{
+}
+
+CLStatus CLSharedMemoryBySysV::Initialize()
+{
+	string strPathName = FILE_PATH_FOR_SHARED_MEMORY;
+	strPathName += m_strFileName;
+
+	int fd = open(strPathName.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+	if(fd == -1)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryBySysV::Initialize(), open error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	if(close(fd) == -1)
+		CLLogger::WriteLogMsg("In CLSharedMemoryBySysV::Initialize(), close error", errno);
+
+	key_t key = ftok(strPathName.c_str(), ID_FOR_KEY);
+	if(key == -1)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryBySysV::Initialize(), ftok error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	CLCriticalSection cs(&m_Mutex);
+
+	m_SharedMemoryID = shmget(key, m_nSize, IPC_CREAT);
+	if(m_SharedMemoryID == -1)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryBySysV::Initialize(), shmget error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	m_pSharedMemory = shmat(m_SharedMemoryID, 0, 0);
+	if((long)m_pSharedMemory == -1)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryBySysV::Initialize(), shmat error", errno);
+		DeleteSharedMemory();
+		return CLStatus(-1, 0);
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLSharedMemoryBySysV::Uninitialize()
+{
+	CLCriticalSection cs(&m_Mutex);
+
+	if(shmdt(m_pSharedMemory) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryBySysV::Uninitialize(), shmdt error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	return DeleteSharedMemory();
+}
+
+void *CLSharedMemoryBySysV::GetAddress()
+{
+	return m_pSharedMemory;
+}
+
+size_t CLSharedMemoryBySysV::GetSize()
+{
+	shmid_ds buf;
+	if(shmctl(m_SharedMemoryID, IPC_STAT, &buf) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryBySysV::GetSize(), shmctl IPC_STAT error", errno);
+		return 0;
+	}
+
+	return buf.shm_segsz;
+}
+
+CLStatus CLSharedMemoryBySysV::DeleteSharedMemory()
+{
+	if(GetRefCount() == 0)
+	{
+		if(shmctl(m_SharedMemoryID, IPC_RMID, 0) == -1)
+		{
+			CLLogger::WriteLogMsg("In CLSharedMemoryBySysV::DeleteSharedMemory(), shmctl IPC_RMID error", errno);
+			return CLStatus(-1, 0);
+		}
+	}
+
+	return CLStatus(0, 0);
+}
+
+int CLSharedMemoryBySysV::GetRefCount()
+{
+	shmid_ds buf;
+	if(shmctl(m_SharedMemoryID, IPC_STAT, &buf) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMemoryBySysV::GetRefCount(), shmctl IPC_STAT error", errno);
+		return -1;
+	}
+
+	return buf.shm_nattch;
+}
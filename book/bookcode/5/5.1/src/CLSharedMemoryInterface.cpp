@@ -0,0 +1,19 @@
+#include "CLSharedMemoryInterface.h"
+
+CLSharedMemoryInterface::CLSharedMemoryInterface()
+{
+}
+
+CLSharedMemoryInterface::~CLSharedMemoryInterface()
+{
+}
+
+CLStatus CLSharedMemoryInterface::Resize(size_t)
+{
+	return CLStatus(-1, 0);
+}
+
+CLStatus CLSharedMemoryInterface::Refresh()
+{
+	return CLStatus(0, 0);
+}
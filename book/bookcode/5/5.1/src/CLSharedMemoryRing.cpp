@@ -0,0 +1,334 @@
+#include <string.h>
+#include <sched.h>
+#include "CLSharedMemoryRing.h"
+#include "CLSharedMemory.h"
+#include "CLLogger.h"
+
+using namespace std;
+
+#define SUFFIX_FOR_SHARED_MEMORY_RING "_shm_ring"
+
+#define MASK_OF_SHARED_MEMORY_RING (SIZE_OF_SHARED_MEMORY_RING - 1)
+
+static inline unsigned long GetSizeOfRecord(unsigned int nLength)
+{
+	return (sizeof(SLSharedMemoryRingRecord) + nLength + 7) & ~7UL;
+}
+
+CLSharedMemoryRing::CLSharedMemoryRing(const char *pstrRingName)
+{
+	if((pstrRingName == 0) || (strlen(pstrRingName) == 0))
+		throw "In CLSharedMemoryRing::CLSharedMemoryRing(), pstrRingName error";
+
+	string strName = pstrRingName;
+	strName += SUFFIX_FOR_SHARED_MEMORY_RING;
+
+	m_pSharedMemory = new CLSharedMemory(strName.c_str(), sizeof(SLSharedMemoryRingHeader) + SIZE_OF_SHARED_MEMORY_RING);
+
+	try
+	{
+		m_pEvent = new CLEvent(strName.c_str(), false);
+	}
+	catch(const char *pstr)
+	{
+		delete m_pSharedMemory;
+		throw pstr;
+	}
+
+	m_pHeader = (SLSharedMemoryRingHeader *)m_pSharedMemory->GetAddress();
+	m_pData = (char *)m_pHeader + sizeof(SLSharedMemoryRingHeader);
+
+	m_nSizeOfHeldRecord = 0;
+	m_pHeldChainBuffer = 0;
+}
+
+CLSharedMemoryRing::~CLSharedMemoryRing()
+{
+	map<unsigned long, SLSharedMemoryRingChain>::iterator it;
+	for(it = m_Chains.begin(); it != m_Chains.end(); it++)
+		delete [] it->second.pBuffer;
+
+	delete [] m_pHeldChainBuffer;
+
+	delete m_pEvent;
+	delete m_pSharedMemory;
+}
+
+CLStatus CLSharedMemoryRing::Write(const char *pBuffer, unsigned int nLength)
+{
+	if((pBuffer == 0) || (nLength == 0))
+		return CLStatus(-1, 0);
+
+	if(nLength <= MAX_LENGTH_OF_SHARED_MEMORY_RING_RECORD)
+	{
+		if(!WriteRecord(SHARED_MEMORY_RING_RECORD_MESSAGE, pBuffer, nLength, 0, 0, 0, false))
+			return CLStatus(-1, 0);
+
+		return WakeupConsumer();
+	}
+
+	unsigned long lChainID = __sync_fetch_and_add(&(m_pHeader->nChainID), 1);
+
+	for(unsigned int nOffset = 0; nOffset < nLength; nOffset += MAX_LENGTH_OF_SHARED_MEMORY_RING_RECORD)
+	{
+		unsigned int nFragmentLength = nLength - nOffset;
+		if(nFragmentLength > MAX_LENGTH_OF_SHARED_MEMORY_RING_RECORD)
+			nFragmentLength = MAX_LENGTH_OF_SHARED_MEMORY_RING_RECORD;
+
+		if(!WriteRecord(SHARED_MEMORY_RING_RECORD_FRAGMENT, pBuffer + nOffset, nFragmentLength, lChainID, nLength, nOffset, nOffset != 0))
+			return CLStatus(-1, 0);
+
+		//ƴʱҪڳռ
+		if(!WakeupConsumer().IsSuccess())
+			return CLStatus(-1, 0);
+	}
+
+	return CLStatus(0, 0);
+}
+
+char *CLSharedMemoryRing::BeginWrite(unsigned int nLength)
+{
+	if((nLength == 0) || (nLength > MAX_LENGTH_OF_SHARED_MEMORY_RING_RECORD))
+		return 0;
+
+	SLSharedMemoryRingRecord *pRecord = ReserveRecord(nLength, false);
+	if(pRecord == 0)
+		return 0;
+
+	pRecord->lChainID = 0;
+	pRecord->nTotalLength = 0;
+	pRecord->nOffset = 0;
+
+	return (char *)pRecord + sizeof(SLSharedMemoryRingRecord);
+}
+
+CLStatus CLSharedMemoryRing::EndWrite(char *pRecord, bool bCommit)
+{
+	if(pRecord == 0)
+		return CLStatus(-1, 0);
+
+	SLSharedMemoryRingRecord *pHeader = (SLSharedMemoryRingRecord *)(pRecord - sizeof(SLSharedMemoryRingRecord));
+
+	__sync_synchronize();
+
+	if(!bCommit)
+	{
+		pHeader->nType = SHARED_MEMORY_RING_RECORD_PADDING;
+		return CLStatus(-1, 0);
+	}
+
+	pHeader->nType = SHARED_MEMORY_RING_RECORD_MESSAGE;
+
+	return WakeupConsumer();
+}
+
+bool CLSharedMemoryRing::WriteRecord(unsigned int nType, const char *pBuffer, unsigned int nLength, unsigned long lChainID, unsigned int nTotalLength, unsigned int nOffset, bool bWait)
+{
+	SLSharedMemoryRingRecord *pRecord = ReserveRecord(nLength, bWait);
+	if(pRecord == 0)
+		return false;
+
+	pRecord->lChainID = lChainID;
+	pRecord->nTotalLength = nTotalLength;
+	pRecord->nOffset = nOffset;
+	memcpy((char *)pRecord + sizeof(SLSharedMemoryRingRecord), pBuffer, nLength);
+
+	__sync_synchronize();
+	pRecord->nType = nType;
+
+	return true;
+}
+
+SLSharedMemoryRingRecord *CLSharedMemoryRing::ReserveRecord(unsigned int nLength, bool bWait)
+{
+	unsigned long nSize = GetSizeOfRecord(nLength);
+	unsigned long nTail;
+	unsigned long nPadding;
+
+	while(true)
+	{
+		nTail = m_pHeader->nTail;
+		unsigned long nHead = m_pHeader->nHead;
+
+		//¼ܿԽĩβʣռ䲻ʱ䲹
+		unsigned long nRoom = SIZE_OF_SHARED_MEMORY_RING - (nTail & MASK_OF_SHARED_MEMORY_RING);
+		nPadding = (nRoom < nSize) ? nRoom : 0;
+
+		if(nTail + nPadding + nSize - nHead > SIZE_OF_SHARED_MEMORY_RING)
+		{
+			if(!bWait)
+				return 0;
+
+			sched_yield();
+			continue;
+		}
+
+		if(__sync_bool_compare_and_swap(&(m_pHeader->nTail), nTail, nTail + nPadding + nSize))
+			break;
+	}
+
+	//һ¼ͷʽ
+	if(nPadding >= sizeof(SLSharedMemoryRingRecord))
+	{
+		SLSharedMemoryRingRecord *pPadding = (SLSharedMemoryRingRecord *)(m_pData + (nTail & MASK_OF_SHARED_MEMORY_RING));
+		pPadding->nLength = nPadding - sizeof(SLSharedMemoryRingRecord);
+		__sync_synchronize();
+		pPadding->nType = SHARED_MEMORY_RING_RECORD_PADDING;
+	}
+
+	SLSharedMemoryRingRecord *pRecord = (SLSharedMemoryRingRecord *)(m_pData + ((nTail + nPadding) & MASK_OF_SHARED_MEMORY_RING));
+	pRecord->nLength = nLength;
+
+	return pRecord;
+}
+
+CLStatus CLSharedMemoryRing::WakeupConsumer()
+{
+	__sync_synchronize();
+
+	if((m_pHeader->bConsumerSleeping) && (__sync_bool_compare_and_swap(&(m_pHeader->bConsumerSleeping), 1, 0)))
+	{
+		CLStatus s = m_pEvent->Set();
+		if(!s.IsSuccess())
+		{
+			CLLogger::WriteLogMsg("In CLSharedMemoryRing::WakeupConsumer(), m_pEvent->Set error", 0);
+			return CLStatus(-1, 0);
+		}
+	}
+
+	return CLStatus(0, 0);
+}
+
+char *CLSharedMemoryRing::GetRecord(unsigned int *pLength)
+{
+	while(true)
+	{
+		char *pRecord = TryGetRecord(pLength);
+		if(pRecord != 0)
+			return pRecord;
+
+		m_pHeader->bConsumerSleeping = 1;
+		__sync_synchronize();
+
+		if(m_pHeader->nHead != m_pHeader->nTail)
+		{
+			m_pHeader->bConsumerSleeping = 0;
+			continue;
+		}
+
+		CLStatus s = m_pEvent->Wait();
+		if(!s.IsSuccess())
+		{
+			CLLogger::WriteLogMsg("In CLSharedMemoryRing::GetRecord(), m_pEvent->Wait error", 0);
+			return 0;
+		}
+	}
+}
+
+char *CLSharedMemoryRing::TryGetRecord(unsigned int *pLength)
+{
+	if(pLength == 0)
+		return 0;
+
+	while(true)
+	{
+		unsigned long nHead = m_pHeader->nHead;
+		if(nHead == m_pHeader->nTail)
+			return 0;
+
+		unsigned long nRoom = SIZE_OF_SHARED_MEMORY_RING - (nHead & MASK_OF_SHARED_MEMORY_RING);
+		if(nRoom < sizeof(SLSharedMemoryRingRecord))
+		{
+			ReleaseSpace(nRoom);
+			continue;
+		}
+
+		SLSharedMemoryRingRecord *pRecord = (SLSharedMemoryRingRecord *)(m_pData + (nHead & MASK_OF_SHARED_MEMORY_RING));
+
+		//ռѱԤδд
+		while(pRecord->nType == SHARED_MEMORY_RING_RECORD_EMPTY)
+			sched_yield();
+
+		__sync_synchronize();
+
+		if(pRecord->nType == SHARED_MEMORY_RING_RECORD_PADDING)
+		{
+			ReleaseSpace(GetSizeOfRecord(pRecord->nLength));
+			continue;
+		}
+
+		if(pRecord->nType == SHARED_MEMORY_RING_RECORD_MESSAGE)
+		{
+			m_nSizeOfHeldRecord = GetSizeOfRecord(pRecord->nLength);
+			*pLength = pRecord->nLength;
+			return (char *)pRecord + sizeof(SLSharedMemoryRingRecord);
+		}
+
+		char *pBuffer = AppendFragment(pRecord, pLength);
+		ReleaseSpace(GetSizeOfRecord(pRecord->nLength));
+
+		if(pBuffer != 0)
+		{
+			m_pHeldChainBuffer = pBuffer;
+			return pBuffer;
+		}
+	}
+}
+
+char *CLSharedMemoryRing::AppendFragment(SLSharedMemoryRingRecord *pRecord, unsigned int *pLength)
+{
+	map<unsigned long, SLSharedMemoryRingChain>::iterator it = m_Chains.find(pRecord->lChainID);
+	if(it == m_Chains.end())
+	{
+		SLSharedMemoryRingChain chain;
+		chain.pBuffer = new char[pRecord->nTotalLength];
+		chain.nReceived = 0;
+
+		it = m_Chains.insert(make_pair(pRecord->lChainID, chain)).first;
+	}
+
+	memcpy(it->second.pBuffer + pRecord->nOffset, (char *)pRecord + sizeof(SLSharedMemoryRingRecord), pRecord->nLength);
+	it->second.nReceived += pRecord->nLength;
+
+	if(it->second.nReceived < pRecord->nTotalLength)
+		return 0;
+
+	char *pBuffer = it->second.pBuffer;
+	*pLength = pRecord->nTotalLength;
+	m_Chains.erase(it);
+
+	return pBuffer;
+}
+
+unsigned long CLSharedMemoryRing::GetPendingLength()
+{
+	unsigned long nHead = m_pHeader->nHead;
+	unsigned long nTail = m_pHeader->nTail;
+
+	return (nTail > nHead) ? (nTail - nHead) : 0;
+}
+
+void CLSharedMemoryRing::ReleaseRecord()
+{
+	if(m_pHeldChainBuffer != 0)
+	{
+		delete [] m_pHeldChainBuffer;
+		m_pHeldChainBuffer = 0;
+		return;
+	}
+
+	if(m_nSizeOfHeldRecord != 0)
+	{
+		ReleaseSpace(m_nSizeOfHeldRecord);
+		m_nSizeOfHeldRecord = 0;
+	}
+}
+
+void CLSharedMemoryRing::ReleaseSpace(unsigned long nSize)
+{
+	//֮дڴ˴ļ¼ύǰᱻΪύ
+	memset(m_pData + (m_pHeader->nHead & MASK_OF_SHARED_MEMORY_RING), 0, nSize);
+
+	__sync_synchronize();
+	m_pHeader->nHead += nSize;
+}
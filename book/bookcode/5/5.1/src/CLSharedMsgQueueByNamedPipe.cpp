@@ -1,18 +1,26 @@
 #include <fcntl.h>
 #include <errno.h>
+#include <limits.h>
 #include "CLSharedMsgQueueByNamedPipe.h"
 #include "CLMessageDeserializer.h"
+#include "CLZeroCopyMessageDeserializer.h"
+#include "CLZeroCopyDeserializerAdapter.h"
 #include "CLLogger.h"
 
 CLSharedMsgQueueByNamedPipe::CLSharedMsgQueueByNamedPipe(const char *pstrPipeName) : CLMessageQueueByNamedPipe(pstrPipeName)
 {
+	m_pReadBuffer = new char[PIPE_BUF];
 }
 
 CLSharedMsgQueueByNamedPipe::~CLSharedMsgQueueByNamedPipe()
 {
-	map<unsigned long, CLMessageDeserializer*>::iterator it;
-	for(it = m_DeserializerTable.begin(); it != m_DeserializerTable.end(); it++)
-		delete it->second;
+	vector<CLZeroCopyMessageDeserializer*> Deserializers;
+	m_DeserializerTable.GetAllValues(Deserializers);
+
+	for(unsigned int i = 0; i < Deserializers.size(); i++)
+		delete Deserializers[i];
+
+	delete [] m_pReadBuffer;
 }
 
 CLStatus CLSharedMsgQueueByNamedPipe::RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer)
@@ -20,15 +28,22 @@ CLStatus CLSharedMsgQueueByNamedPipe::RegisterDeserializer(unsigned long lMsgID,
 	if(pDeserializer == 0)
 		return CLStatus(-1, 0);
 
-	map<unsigned long, CLMessageDeserializer*>::iterator it = m_DeserializerTable.find(lMsgID);
-	if(it != m_DeserializerTable.end())
+	return RegisterDeserializer(lMsgID, new CLZeroCopyDeserializerAdapter(pDeserializer));
+}
+
+CLStatus CLSharedMsgQueueByNamedPipe::RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer)
+{
+	if(pDeserializer == 0)
+		return CLStatus(-1, 0);
+
+	if(m_DeserializerTable.Find(lMsgID) != 0)
 	{
 		delete pDeserializer;
-		CLLogger::WriteLogMsg("In CLMessageQueueByNamedPipe::RegisterDeserializer(), m_DeserializerTable.find error", 0);
+		CLLogger::WriteLogMsg("In CLMessageQueueByNamedPipe::RegisterDeserializer(), m_DeserializerTable.Find error", 0);
 		return CLStatus(-1, 0);
 	}
 
-	m_DeserializerTable[lMsgID] = pDeserializer;
+	m_DeserializerTable.Set(lMsgID, pDeserializer);
 
 	return CLStatus(0, 0);
 }
@@ -42,23 +57,22 @@ CLMessage *CLSharedMsgQueueByNamedPipe::ReadMsgFromPipe(int fd)
 		return 0;
 	}
 
-	char *pBuffer = new char[length];
-	if(read(fd, pBuffer, length) != length)
+	if((length < (int)sizeof(unsigned long)) || (length > PIPE_BUF))
 	{
-		CLLogger::WriteLogMsg("In CLSharedMsgQueueByNamedPipe::ReadMsgFromPipe(), read2 error", errno);
-		delete [] pBuffer;
+		CLLogger::WriteLogMsg("In CLSharedMsgQueueByNamedPipe::ReadMsgFromPipe(), length error", 0);
 		return 0;
 	}
 
-	unsigned long MsgID = *((unsigned long *)pBuffer);
-	map<unsigned long, CLMessageDeserializer*>::iterator it = m_DeserializerTable.find(MsgID);
-	if(it != m_DeserializerTable.end())
+	if(read(fd, m_pReadBuffer, length) != length)
 	{
-		CLMessage *pMsg = it->second->Deserialize(pBuffer);
-		delete [] pBuffer;
-		return pMsg;
+		CLLogger::WriteLogMsg("In CLSharedMsgQueueByNamedPipe::ReadMsgFromPipe(), read2 error", errno);
+		return 0;
 	}
 
-	delete [] pBuffer;
+	unsigned long MsgID = *((unsigned long *)m_pReadBuffer);
+	CLZeroCopyMessageDeserializer **ppDeserializer = m_DeserializerTable.Find(MsgID);
+	if(ppDeserializer != 0)
+		return (*ppDeserializer)->Deserialize(m_pReadBuffer, length);
+
 	return NULL;
 }
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "CLSharedMsgQueueByShmRing.h"
+#include "CLMessageDeserializer.h"
+#include "CLZeroCopyMessageDeserializer.h"
+#include "CLZeroCopyDeserializerAdapter.h"
+#include "CLLogger.h"
+
+CLSharedMsgQueueByShmRing::CLSharedMsgQueueByShmRing(const char *pstrQueueName) : m_Ring(pstrQueueName)
+{
+}
+
+CLSharedMsgQueueByShmRing::~CLSharedMsgQueueByShmRing()
+{
+	vector<CLZeroCopyMessageDeserializer*> Deserializers;
+	m_DeserializerTable.GetAllValues(Deserializers);
+
+	for(unsigned int i = 0; i < Deserializers.size(); i++)
+		delete Deserializers[i];
+}
+
+CLStatus CLSharedMsgQueueByShmRing::RegisterDeserializer(unsigned long lMsgID, CLMessageDeserializer *pDeserializer)
+{
+	if(pDeserializer == 0)
+		return CLStatus(-1, 0);
+
+	return RegisterDeserializer(lMsgID, new CLZeroCopyDeserializerAdapter(pDeserializer));
+}
+
+CLStatus CLSharedMsgQueueByShmRing::RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer)
+{
+	if(pDeserializer == 0)
+		return CLStatus(-1, 0);
+
+	if(m_DeserializerTable.Find(lMsgID) != 0)
+	{
+		delete pDeserializer;
+		CLLogger::WriteLogMsg("In CLSharedMsgQueueByShmRing::RegisterDeserializer(), m_DeserializerTable.Find error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	m_DeserializerTable.Set(lMsgID, pDeserializer);
+
+	return CLStatus(0, 0);
+}
+
+CLMessage* CLSharedMsgQueueByShmRing::GetMessage()
+{
+	unsigned int nLength = 0;
+	char *pRecord = m_Ring.GetRecord(&nLength);
+	if(pRecord == 0)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMsgQueueByShmRing::GetMessage(), m_Ring.GetRecord error", 0);
+		return 0;
+	}
+
+	CLMessage *pMsg = DeserializeRecord(pRecord, nLength);
+
+	m_Ring.ReleaseRecord();
+
+	return pMsg;
+}
+
+unsigned int CLSharedMsgQueueByShmRing::GetMessages(CLMessage **ppMessages, unsigned int nMaxCount)
+{
+	if((ppMessages == 0) || (nMaxCount == 0))
+		return 0;
+
+	unsigned int nLength = 0;
+	char *pRecord = m_Ring.GetRecord(&nLength);
+	if(pRecord == 0)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMsgQueueByShmRing::GetMessages(), m_Ring.GetRecord error", 0);
+		return 0;
+	}
+
+	unsigned int n = 0;
+	while(pRecord != 0)
+	{
+		CLMessage *pMsg = DeserializeRecord(pRecord, nLength);
+		m_Ring.ReleaseRecord();
+
+		if(pMsg != 0)
+			ppMessages[n++] = pMsg;
+
+		if(n == nMaxCount)
+			break;
+
+		pRecord = m_Ring.TryGetRecord(&nLength);
+	}
+
+	return n;
+}
+
+CLMessage *CLSharedMsgQueueByShmRing::DeserializeRecord(char *pRecord, unsigned int nLength)
+{
+	if(nLength < sizeof(unsigned long))
+	{
+		CLLogger::WriteLogMsg("In CLSharedMsgQueueByShmRing::DeserializeRecord(), nLength error", 0);
+		return 0;
+	}
+
+	unsigned long MsgID = *((unsigned long *)pRecord);
+	CLZeroCopyMessageDeserializer **ppDeserializer = m_DeserializerTable.Find(MsgID);
+	if(ppDeserializer == 0)
+	{
+		CLLogger::WriteLogMsg("In CLSharedMsgQueueByShmRing::DeserializeRecord(), m_DeserializerTable.Find error", 0);
+		return 0;
+	}
+
+	return (*ppDeserializer)->Deserialize(pRecord, nLength);
+}
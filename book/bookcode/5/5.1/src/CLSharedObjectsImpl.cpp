@@ -1,13 +1,27 @@
 #include <memory.h>
 #include <string.h>
+#include <stdio.h>
 #include "CLSharedObjectsImpl.h"
 #include "CLSharedMemory.h"
 #include "CLLogger.h"
-#include "CLCriticalSection.h"
-#include "CLMutex.h"
+
+#define SUFFIX_FOR_SHARED_OBJECT_SEGMENT "_segment_"
+#define SUFFIX_FOR_SHARED_OBJECT_INDEX "_index_"
+
+//֮ǰͷж룬еpthread_mutex_tȲ
+#define ALIGNMENT_OF_SHARED_OBJECT_AREA 64
+#define ALIGN_SHARED_OBJECT_AREA(n) (((n) + ALIGNMENT_OF_SHARED_OBJECT_AREA - 1) & ~(ALIGNMENT_OF_SHARED_OBJECT_AREA - 1))
+
+#define OFFSET_OF_SEGMENT_HEAD_IN_FIRST_SEGMENT ALIGN_SHARED_OBJECT_AREA(sizeof(SLSharedObjectSpaceHead))
+#define SIZE_OF_SHARED_OBJECT_SEGMENT_HEAD ALIGN_SHARED_OBJECT_AREA(sizeof(SLSharedObjectSegmentHead))
 
 CLSharedObjectsImpl::CLSharedObjectsImpl()
 {
+	m_pSpaceHead = 0;
+	m_pIndexMemory = 0;
+	m_nIndexGeneration = -1;
+	m_pIndexHead = 0;
+	m_pIndex = 0;
 }
 
 CLSharedObjectsImpl::~CLSharedObjectsImpl()
@@ -16,125 +30,381 @@ CLSharedObjectsImpl::~CLSharedObjectsImpl()
 
 CLStatus CLSharedObjectsImpl::Initialize()
 {
-	m_pSharedMemory = new CLSharedMemory(m_strSharedSpaceName.c_str(), sizeof(int) + NUMBER_OF_SHARED_OBJECT * m_nItemSize);
+	CLSharedMemory *pSharedMemory = new CLSharedMemory(m_strSharedSpaceName.c_str(), OFFSET_OF_SEGMENT_HEAD_IN_FIRST_SEGMENT + SIZE_OF_SHARED_OBJECT_SEGMENT_HEAD + NUMBER_OF_SHARED_OBJECT_PER_SEGMENT * m_nItemSize);
 
-	int *pMagicNumber = (int *)(m_pSharedMemory->GetAddress());
+	m_pSpaceHead = (SLSharedObjectSpaceHead *)(pSharedMemory->GetAddress());
 
-	m_pSharedObjects = (SLSharedObjectHead *)((char *)pMagicNumber + sizeof(int));
-
-	if((*pMagicNumber) == MAGIC_NUMBER_FOR_SHARED_OBJECT)
-		return CLStatus(0, 0);
+	m_Segments.push_back(pSharedMemory);
+	m_SegmentObjects.push_back((char *)m_pSpaceHead + OFFSET_OF_SEGMENT_HEAD_IN_FIRST_SEGMENT);
 
-	bool bSuccess = true;
-	for(int i = 0; i < NUMBER_OF_SHARED_OBJECT; i++)
+	if(m_pSpaceHead->MagicNumber == MAGIC_NUMBER_FOR_SHARED_OBJECT)
 	{
-		SLSharedObjectHead *pItem = (SLSharedObjectHead *)((char *)m_pSharedObjects + i * m_nItemSize);
-		if(pItem->Status == UNINITIALIZED_SHARED_OBJECT)
-		{
-			if(InitializeSharedObject(pItem).IsSuccess())
-			{
-				pItem->Status = INITIALIZED_SHARED_OBJECT;
-				pItem->RefCount = 0;
-				memset(pItem->strSharedObjectName, 0, LENGTH_OF_SHARED_OBJECT_NAME);
-			}
-			else
-				bSuccess = false;
-		}
+		if((!AttachSegments()) || (!AttachIndex(false)))
+			return CLStatus(-1, 0);
+
+		return CLStatus(0, 0);
 	}
 
-	if(bSuccess)
-		*pMagicNumber = MAGIC_NUMBER_FOR_SHARED_OBJECT;
+	m_pSpaceHead->nSegments = 1;
+	m_pSpaceHead->nIndexGeneration = 0;
+	memset(m_pSpaceHead->nFreeObjects, 0, sizeof(m_pSpaceHead->nFreeObjects));
+
+	InitializeSegment(0);
+
+	//ܲϴеͬؽ
+	if(!AttachIndex(true))
+		return CLStatus(-1, 0);
+
+	m_pSpaceHead->MagicNumber = MAGIC_NUMBER_FOR_SHARED_OBJECT;
 
 	return CLStatus(0, 0);
 }
 
 CLStatus CLSharedObjectsImpl::Destroy()
 {
-	delete m_pSharedMemory;
+	delete m_pIndexMemory;
+	m_pIndexMemory = 0;
+
+	for(int i = m_Segments.size() - 1; i >= 0; i--)
+		delete m_Segments[i];
+
+	m_Segments.clear();
+	m_SegmentObjects.clear();
+
 	return CLStatus(0, 0);
 }
 
 void *CLSharedObjectsImpl::GetSharedObject(const char *pstrSharedObjectName)
 {
-	int empty_index = -1;
-	bool bfind_empty = false;
+	if((!AttachSegments()) || (!AttachIndex(false)))
+		return 0;
 
-	for(int i = 0; i < NUMBER_OF_SHARED_OBJECT; i++)
+	unsigned int Hash = HashName(pstrSharedObjectName);
+
+	SLSharedObjectIndexEntry *pEntry = FindIndex(pstrSharedObjectName, Hash);
+	if(pEntry != 0)
 	{
-		SLSharedObjectHead *pItem = (SLSharedObjectHead *)((char *)m_pSharedObjects + i * m_nItemSize);
+		SLSharedObjectHead *pItem = GetObjectHead(pEntry->Object);
+		pItem->RefCount++;
 
-		if(pItem->Status == UNINITIALIZED_SHARED_OBJECT)
-			continue;
+		return (char *)pItem + sizeof(SLSharedObjectHead);
+	}
 
-		if(pItem->Status == INITIALIZED_SHARED_OBJECT)
-		{
-			if(bfind_empty)
-				continue;
+	int nObject = AllocateObject();
+	if(nObject == -1)
+	{
+		CLLogger::WriteLogMsg("In CLSharedObjectsImpl::GetSharedObject(), shared memory is full", 0);
+		return 0;
+	}
 
-			empty_index = i;
-			bfind_empty = true;
+	SLSharedObjectHead *pItem = GetObjectHead(nObject);
 
-			continue;
-		}
+	pItem->Status = ALLOCATED_SHARED_OBJECT;
+	pItem->RefCount = 1;
+	pItem->Hash = Hash;
 
-		if(pItem->Status == ALLOCATED_SHARED_OBJECT)
+	strcpy(pItem->strSharedObjectName, pstrSharedObjectName);
+
+	//ǰȱ֤װӲ1/2ؽʱ¶ѱΪ䣬һ
+	if((m_pIndexHead->nUsed + 1) * 2 > m_pIndexHead->nCapacity)
+	{
+		if((m_pIndexHead->nLive + 1) * 4 > m_pIndexHead->nCapacity)
 		{
-			if(strcmp(pstrSharedObjectName, pItem->strSharedObjectName) == 0)
+			m_pSpaceHead->nIndexGeneration++;
+
+			if(!AttachIndex(true))
 			{
-				pItem->RefCount++;
+				m_pSpaceHead->nIndexGeneration--;
 
-				return (char *)pItem + sizeof(SLSharedObjectHead);
+				DestroySharedObject(pItem);
+				FreeObject(nObject);
+				return 0;
 			}
 		}
+		else
+			RebuildIndex();
 	}
+	else
+		InsertIndex(Hash, nObject);
+
+	return (char *)pItem + sizeof(SLSharedObjectHead);
+}
+
+CLStatus CLSharedObjectsImpl::ReleaseSharedObject(const char *pstrSharedObjectName)
+{
+	if((!AttachSegments()) || (!AttachIndex(false)))
+		return CLStatus(-1, 0);
 
-	if(empty_index != -1)
+	SLSharedObjectIndexEntry *pEntry = FindIndex(pstrSharedObjectName, HashName(pstrSharedObjectName));
+	if(pEntry == 0)
+		return CLStatus(-1, 0);
+
+	SLSharedObjectHead *pItem = GetObjectHead(pEntry->Object);
+
+	pItem->RefCount--;
+
+	if(pItem->RefCount == 0)
 	{
-		SLSharedObjectHead *pItem = (SLSharedObjectHead *)((char *)m_pSharedObjects + empty_index * m_nItemSize);
+		int nObject = pEntry->Object;
 
-		pItem->Status = ALLOCATED_SHARED_OBJECT;
-		pItem->RefCount = 1;
+		pEntry->Object = DELETED_SHARED_OBJECT_INDEX_ENTRY;
+		m_pIndexHead->nLive--;
 
-		strcpy(pItem->strSharedObjectName, pstrSharedObjectName);
+		DestroySharedObject(pItem);
 
-		return (char *)pItem + sizeof(SLSharedObjectHead);
+		FreeObject(nObject);
 	}
-	else
+
+	return CLStatus(0, 0);
+}
+
+bool CLSharedObjectsImpl::AttachSegments()
+{
+	while((int)m_Segments.size() < m_pSpaceHead->nSegments)
 	{
-		CLLogger::WriteLogMsg("In CLSharedObjectsImpl::GetSharedObject(), shared memory is full", 0);
-		return 0;
+		if(!AttachSegment(m_Segments.size(), false))
+			return false;
 	}
+
+	return true;
 }
 
-CLStatus CLSharedObjectsImpl::ReleaseSharedObject(const char *pstrSharedObjectName)
+bool CLSharedObjectsImpl::AttachSegment(int nSegment, bool bInitialize)
 {
-	for(int i = 0; i < NUMBER_OF_SHARED_OBJECT; i++)
+	CLSharedMemory *pSharedMemory = 0;
+
+	try
 	{
-		SLSharedObjectHead *pItem = (SLSharedObjectHead *)((char *)m_pSharedObjects + i * m_nItemSize);
+		pSharedMemory = new CLSharedMemory(GetNameOfSegment(nSegment).c_str(), SIZE_OF_SHARED_OBJECT_SEGMENT_HEAD + NUMBER_OF_SHARED_OBJECT_PER_SEGMENT * m_nItemSize);
+	}
+	catch(const char *str)
+	{
+		CLLogger::WriteLogMsg(str, 0);
+		return false;
+	}
 
-		if(pItem->Status == ALLOCATED_SHARED_OBJECT)
+	m_Segments.push_back(pSharedMemory);
+	m_SegmentObjects.push_back((char *)(pSharedMemory->GetAddress()));
+
+	//öεĽȫϿʱλᱻɾ´
+	SLSharedObjectSegmentHead *pSegmentHead = (SLSharedObjectSegmentHead *)m_SegmentObjects[nSegment];
+	if((bInitialize) || (pSegmentHead->MagicNumber != MAGIC_NUMBER_FOR_SHARED_OBJECT))
+		InitializeSegment(nSegment);
+
+	return true;
+}
+
+void CLSharedObjectsImpl::InitializeSegment(int nSegment)
+{
+	SLSharedObjectSegmentHead *pSegmentHead = (SLSharedObjectSegmentHead *)m_SegmentObjects[nSegment];
+	char *pObjects = m_SegmentObjects[nSegment] + SIZE_OF_SHARED_OBJECT_SEGMENT_HEAD;
+
+	int nFree = 0;
+	int FirstFree = -1;
+
+	for(int i = NUMBER_OF_SHARED_OBJECT_PER_SEGMENT - 1; i >= 0; i--)
+	{
+		SLSharedObjectHead *pItem = (SLSharedObjectHead *)(pObjects + i * m_nItemSize);
+
+		pItem->Status = UNINITIALIZED_SHARED_OBJECT;
+		pItem->RefCount = 0;
+		memset(pItem->strSharedObjectName, 0, LENGTH_OF_SHARED_OBJECT_NAME);
+
+		if(InitializeSharedObject(pItem).IsSuccess())
 		{
-			if(strcmp(pstrSharedObjectName, pItem->strSharedObjectName) == 0)
-			{
-				pItem->RefCount--;
+			pItem->Status = INITIALIZED_SHARED_OBJECT;
+			pItem->NextFree = FirstFree;
 
-				if(pItem->RefCount == 0)
-				{
-					DestroySharedObject(pItem);
+			FirstFree = i;
+			nFree++;
+		}
+	}
 
-					pItem->Status = UNINITIALIZED_SHARED_OBJECT;
-					memset(pItem->strSharedObjectName, 0, LENGTH_OF_SHARED_OBJECT_NAME);
+	pSegmentHead->FirstFree = FirstFree;
+	pSegmentHead->MagicNumber = MAGIC_NUMBER_FOR_SHARED_OBJECT;
 
-					if(InitializeSharedObject(pItem).IsSuccess())
-					{
-						pItem->Status = INITIALIZED_SHARED_OBJECT;
-					}
-				}
+	m_pSpaceHead->nFreeObjects[nSegment] = nFree;
+}
 
-				return CLStatus(0, 0);
-			}
+bool CLSharedObjectsImpl::AttachIndex(bool bRebuild)
+{
+	if((!bRebuild) && (m_nIndexGeneration == m_pSpaceHead->nIndexGeneration))
+		return true;
+
+	unsigned int nCapacity = INITIAL_CAPACITY_OF_SHARED_OBJECT_INDEX << m_pSpaceHead->nIndexGeneration;
+
+	if(m_nIndexGeneration != m_pSpaceHead->nIndexGeneration)
+	{
+		char strGeneration[16];
+		snprintf(strGeneration, sizeof(strGeneration), "%d", m_pSpaceHead->nIndexGeneration);
+
+		string strName = m_strSharedSpaceName + SUFFIX_FOR_SHARED_OBJECT_INDEX + strGeneration;
+
+		CLSharedMemory *pIndexMemory = 0;
+
+		try
+		{
+			pIndexMemory = new CLSharedMemory(strName.c_str(), sizeof(SLSharedObjectIndexHead) + nCapacity * sizeof(SLSharedObjectIndexEntry));
+		}
+		catch(const char *str)
+		{
+			CLLogger::WriteLogMsg(str, 0);
+			return false;
+		}
+
+		delete m_pIndexMemory;
+
+		m_pIndexMemory = pIndexMemory;
+		m_nIndexGeneration = m_pSpaceHead->nIndexGeneration;
+		m_pIndexHead = (SLSharedObjectIndexHead *)(pIndexMemory->GetAddress());
+		m_pIndex = (SLSharedObjectIndexEntry *)((char *)m_pIndexHead + sizeof(SLSharedObjectIndexHead));
+	}
+
+	//һ׸ӵĽ̸ݸѷĶ
+	if((bRebuild) || (m_pIndexHead->MagicNumber != MAGIC_NUMBER_FOR_SHARED_OBJECT) || (m_pIndexHead->nCapacity != nCapacity))
+	{
+		m_pIndexHead->nCapacity = nCapacity;
+		RebuildIndex();
+		m_pIndexHead->MagicNumber = MAGIC_NUMBER_FOR_SHARED_OBJECT;
+	}
+
+	return true;
+}
+
+void CLSharedObjectsImpl::RebuildIndex()
+{
+	for(unsigned int i = 0; i < m_pIndexHead->nCapacity; i++)
+		m_pIndex[i].Object = EMPTY_SHARED_OBJECT_INDEX_ENTRY;
+
+	m_pIndexHead->nUsed = 0;
+	m_pIndexHead->nLive = 0;
+
+	for(int i = 0; i < (int)m_Segments.size() * NUMBER_OF_SHARED_OBJECT_PER_SEGMENT; i++)
+	{
+		SLSharedObjectHead *pItem = GetObjectHead(i);
+		if(pItem->Status == ALLOCATED_SHARED_OBJECT)
+			InsertIndex(pItem->Hash, i);
+	}
+}
+
+void CLSharedObjectsImpl::InsertIndex(unsigned int Hash, int nObject)
+{
+	unsigned int nMask = m_pIndexHead->nCapacity - 1;
+
+	for(unsigned int i = Hash & nMask; ; i = (i + 1) & nMask)
+	{
+		if(m_pIndex[i].Object == DELETED_SHARED_OBJECT_INDEX_ENTRY)
+		{
+			m_pIndex[i].Hash = Hash;
+			m_pIndex[i].Object = nObject;
+			m_pIndexHead->nLive++;
+			return;
 		}
+
+		if(m_pIndex[i].Object == EMPTY_SHARED_OBJECT_INDEX_ENTRY)
+		{
+			m_pIndex[i].Hash = Hash;
+			m_pIndex[i].Object = nObject;
+			m_pIndexHead->nLive++;
+			m_pIndexHead->nUsed++;
+			return;
+		}
+	}
+}
+
+SLSharedObjectIndexEntry *CLSharedObjectsImpl::FindIndex(const char *pstrSharedObjectName, unsigned int Hash)
+{
+	unsigned int nMask = m_pIndexHead->nCapacity - 1;
+
+	for(unsigned int i = Hash & nMask; m_pIndex[i].Object != EMPTY_SHARED_OBJECT_INDEX_ENTRY; i = (i + 1) & nMask)
+	{
+		if((m_pIndex[i].Object == DELETED_SHARED_OBJECT_INDEX_ENTRY) || (m_pIndex[i].Hash != Hash))
+			continue;
+
+		//ڶαɾؽıָĶѲٷ䣬Ϊ
+		SLSharedObjectHead *pItem = GetObjectHead(m_pIndex[i].Object);
+		if((pItem->Status == ALLOCATED_SHARED_OBJECT) && (strcmp(pstrSharedObjectName, pItem->strSharedObjectName) == 0))
+			return &m_pIndex[i];
+	}
+
+	return 0;
+}
+
+int CLSharedObjectsImpl::AllocateObject()
+{
+	int nSegment = 0;
+	while((nSegment < m_pSpaceHead->nSegments) && (m_pSpaceHead->nFreeObjects[nSegment] == 0))
+		nSegment++;
+
+	if(nSegment == m_pSpaceHead->nSegments)
+	{
+		if(nSegment == MAX_NUMBER_OF_SHARED_OBJECT_SEGMENTS)
+			return -1;
+
+		if(!AttachSegment(nSegment, true))
+			return -1;
+
+		m_pSpaceHead->nSegments++;
+
+		if(m_pSpaceHead->nFreeObjects[nSegment] == 0)
+			return -1;
+	}
+
+	SLSharedObjectSegmentHead *pSegmentHead = (SLSharedObjectSegmentHead *)m_SegmentObjects[nSegment];
+
+	int nObject = nSegment * NUMBER_OF_SHARED_OBJECT_PER_SEGMENT + pSegmentHead->FirstFree;
+
+	pSegmentHead->FirstFree = GetObjectHead(nObject)->NextFree;
+	m_pSpaceHead->nFreeObjects[nSegment]--;
+
+	return nObject;
+}
+
+void CLSharedObjectsImpl::FreeObject(int nObject)
+{
+	SLSharedObjectHead *pItem = GetObjectHead(nObject);
+
+	pItem->Status = UNINITIALIZED_SHARED_OBJECT;
+	memset(pItem->strSharedObjectName, 0, LENGTH_OF_SHARED_OBJECT_NAME);
+
+	if(!InitializeSharedObject(pItem).IsSuccess())
+		return;
+
+	pItem->Status = INITIALIZED_SHARED_OBJECT;
+
+	int nSegment = nObject / NUMBER_OF_SHARED_OBJECT_PER_SEGMENT;
+	SLSharedObjectSegmentHead *pSegmentHead = (SLSharedObjectSegmentHead *)m_SegmentObjects[nSegment];
+
+	pItem->NextFree = pSegmentHead->FirstFree;
+	pSegmentHead->FirstFree = nObject % NUMBER_OF_SHARED_OBJECT_PER_SEGMENT;
+	m_pSpaceHead->nFreeObjects[nSegment]++;
+}
+
+SLSharedObjectHead *CLSharedObjectsImpl::GetObjectHead(int nObject)
+{
+	char *pObjects = m_SegmentObjects[nObject / NUMBER_OF_SHARED_OBJECT_PER_SEGMENT] + SIZE_OF_SHARED_OBJECT_SEGMENT_HEAD;
+
+	return (SLSharedObjectHead *)(pObjects + (nObject % NUMBER_OF_SHARED_OBJECT_PER_SEGMENT) * m_nItemSize);
+}
+
+string CLSharedObjectsImpl::GetNameOfSegment(int nSegment)
+{
+	char strSegment[16];
+	snprintf(strSegment, sizeof(strSegment), "%d", nSegment);
+
+	return m_strSharedSpaceName + SUFFIX_FOR_SHARED_OBJECT_SEGMENT + strSegment;
+}
+
+unsigned int CLSharedObjectsImpl::HashName(const char *pstrSharedObjectName)
+{
+	//FNV-1a
+	unsigned int Hash = 2166136261U;
+
+	for(const unsigned char *p = (const unsigned char *)pstrSharedObjectName; *p != 0; p++)
+	{
+		Hash ^= *p;
+		Hash *= 16777619U;
 	}
 
-	return CLStatus(-1, 0);
-}
\ No newline at end of file
+	return Hash;
+}
@@ -1,24 +1,41 @@
+#include <errno.h>
 #include "CLThread.h"
 #include "CLExecutiveFunctionProvider.h"
 #include "CLEvent.h"
 #include "CLLogger.h"
+#include "CLThreadPlacement.h"
 
 CLThread::CLThread(CLExecutiveFunctionProvider *pExecutiveFunctionProvider) : CLExecutive(pExecutiveFunctionProvider)
 {
 	m_pContext = 0;
 	m_bWaitForDeath = false;
 	m_bThreadCreated = false;
+
+	m_pPlacement = 0;
+	m_pStack = 0;
+	m_nStackSize = 0;
 }
 
-CLThread::CLThread(CLExecutiveFunctionProvider *pExecutiveFunctionProvider, bool bWaitForDeath) : CLExecutive(pExecutiveFunctionProvider)
+CLThread::CLThread(CLExecutiveFunctionProvider *pExecutiveFunctionProvider, bool bWaitForDeath, const CLThreadPlacement *pPlacement) : CLExecutive(pExecutiveFunctionProvider)
 {
 	m_pContext = 0;
 	m_bWaitForDeath = bWaitForDeath;
 	m_bThreadCreated = false;
+
+	m_pPlacement = 0;
+	if(pPlacement != 0)
+		m_pPlacement = new CLThreadPlacement(*pPlacement);
+
+	m_pStack = 0;
+	m_nStackSize = 0;
 }
 
 CLThread::~CLThread()
 {
+	//ֻbWaitForDeathΪtrueʱŻзջʱpthread_join֮
+	CLThreadPlacement::FreeStack(m_pStack, m_nStackSize);
+
+	delete m_pPlacement;
 }
 
 CLStatus CLThread::Run(void *pContext)
@@ -28,7 +45,7 @@ CLStatus CLThread::Run(void *pContext)
 	
 	m_pContext = pContext;
 
-	int r = pthread_create(&m_ThreadID, 0, StartFunctionOfThread, this);
+	int r = CreateThread();
 	if(r != 0)
 	{
 		CLLogger::WriteLogMsg("In CLThread::Run(), pthread_create error", r);
@@ -60,6 +77,31 @@ CLStatus CLThread::Run(void *pContext)
 	return CLStatus(0, 0);
 }
 
+int CLThread::CreateThread()
+{
+	if(m_pPlacement == 0)
+		return pthread_create(&m_ThreadID, 0, StartFunctionOfThread, this);
+
+	pthread_attr_t attr;
+	int r = pthread_attr_init(&attr);
+	if(r != 0)
+		return r;
+
+	//߳˳ʱCLThread޷ͷԼʹõջֻΪɵȴ̷߳ջ
+	CLStatus s = m_pPlacement->SetThreadAttributes(&attr, m_bWaitForDeath, &m_pStack, &m_nStackSize);
+	if(!s.IsSuccess())
+	{
+		pthread_attr_destroy(&attr);
+		return (s.m_clErrorCode != 0) ? (int)s.m_clErrorCode : EINVAL;
+	}
+
+	r = pthread_create(&m_ThreadID, &attr, StartFunctionOfThread, this);
+
+	pthread_attr_destroy(&attr);
+
+	return r;
+}
+
 void* CLThread::StartFunctionOfThread(void *pThis)
 {
 	CLThread *pThreadThis = (CLThread *)pThis;
@@ -67,6 +109,13 @@ void* CLThread::StartFunctionOfThread(void *pThis)
 	void *pContext = pThreadThis->m_pContext;
 	pThreadThis->m_pContext = NULL;
 
+	if(pThreadThis->m_pPlacement != 0)
+	{
+		CLStatus s2 = pThreadThis->m_pPlacement->ApplyToCurrentThread();
+		if(!s2.IsSuccess())
+			CLLogger::WriteLogMsg("In CLThread::StartFunctionOfThread(), m_pPlacement->ApplyToCurrentThread error", 0);
+	}
+
 	CLStatus s = pThreadThis->m_EventForWaitingForNewThread.Set();
 	if(!s.IsSuccess())
 	{
@@ -0,0 +1,24 @@
+#include "CLThreadCommunicationByLockFreeRing.h"
+#include "CLMessageQueueByLockFreeRing.h"
+#include "CLMessage.h"
+
+CLThreadCommunicationByLockFreeRing::CLThreadCommunicationByLockFreeRing(CLMessageQueueByLockFreeRing *pMsgQueue)
+{
+	if(pMsgQueue == 0)
+		throw "In CLThreadCommunicationByLockFreeRing::CLThreadCommunicationByLockFreeRing(), pMsgQueue error";
+
+	m_pMsgQueue = pMsgQueue;
+}
+
+CLThreadCommunicationByLockFreeRing::~CLThreadCommunicationByLockFreeRing()
+{
+	delete m_pMsgQueue;
+}
+
+CLStatus CLThreadCommunicationByLockFreeRing::PostExecutiveMessage(CLMessage *pMessage)
+{
+	if(pMessage == 0)
+		return CLStatus(-1, 0);
+
+	return m_pMsgQueue->PushMessage(pMessage);
+}
@@ -3,12 +3,15 @@
 #include "CLThread.h"
 #include "CLExecutiveFunctionForMsgLoop.h"
 #include "CLMsgLoopManagerForSTLqueue.h"
+#include "CLMsgLoopManagerForLockFreeRing.h"
 #include "CLLogger.h"
 #include "CLThreadInitialFinishedNotifier.h"
 #include "CLEvent.h"
 #include "CLMsgLoopManagerForPipeQueue.h"
+#include "CLMsgLoopManagerForShmQueue.h"
+#include "CLMsgLoopManagerForEpoll.h"
 
-CLThreadForMsgLoop::CLThreadForMsgLoop(CLMessageObserver *pMsgObserver, const char *pstrThreadName, bool bWaitForDeath, int ExecutiveType)
+CLThreadForMsgLoop::CLThreadForMsgLoop(CLMessageObserver *pMsgObserver, const char *pstrThreadName, bool bWaitForDeath, int ExecutiveType, unsigned long nQueueCapacity, int OverflowPolicy, const CLThreadPlacement *pPlacement)
 {
 	if(pMsgObserver == 0)
 		throw "In CLThreadForMsgLoop::CLThreadForMsgLoop(), pMsgObserver error";
@@ -19,20 +22,34 @@ CLThreadForMsgLoop::CLThreadForMsgLoop(CLMessageObserver *pMsgObserver, const ch
 	m_bWaitForDeath = bWaitForDeath;
 
 	m_pPipeQueue = NULL;
+	m_pShmQueue = NULL;
 
 	if(ExecutiveType == EXECUTIVE_IN_PROCESS_USE_STL_QUEUE)
 	{
-		m_pThread = new CLThread(new CLExecutiveFunctionForMsgLoop(new CLMsgLoopManagerForSTLqueue(pMsgObserver, pstrThreadName)), bWaitForDeath);
+		m_pThread = new CLThread(new CLExecutiveFunctionForMsgLoop(new CLMsgLoopManagerForSTLqueue(pMsgObserver, pstrThreadName, nQueueCapacity, OverflowPolicy)), bWaitForDeath, pPlacement);
 	}
 	else if(ExecutiveType == EXECUTIVE_IN_PROCESS_USE_PIPE_QUEUE)
 	{
 		m_pPipeQueue = new CLMsgLoopManagerForPipeQueue(pMsgObserver, pstrThreadName, PIPE_QUEUE_IN_PROCESS);
-		m_pThread = new CLThread(new CLExecutiveFunctionForMsgLoop(m_pPipeQueue), bWaitForDeath);
+		m_pThread = new CLThread(new CLExecutiveFunctionForMsgLoop(m_pPipeQueue), bWaitForDeath, pPlacement);
 	}
 	else if(ExecutiveType == EXECUTIVE_BETWEEN_PROCESS_USE_PIPE_QUEUE)
 	{
 		m_pPipeQueue = new CLMsgLoopManagerForPipeQueue(pMsgObserver, pstrThreadName, PIPE_QUEUE_BETWEEN_PROCESS);
-		m_pThread = new CLThread(new CLExecutiveFunctionForMsgLoop(m_pPipeQueue), bWaitForDeath);
+		m_pThread = new CLThread(new CLExecutiveFunctionForMsgLoop(m_pPipeQueue), bWaitForDeath, pPlacement);
+	}
+	else if(ExecutiveType == EXECUTIVE_IN_PROCESS_USE_LOCK_FREE_RING)
+	{
+		m_pThread = new CLThread(new CLExecutiveFunctionForMsgLoop(new CLMsgLoopManagerForLockFreeRing(pMsgObserver, pstrThreadName)), bWaitForDeath, pPlacement);
+	}
+	else if(ExecutiveType == EXECUTIVE_BETWEEN_PROCESS_USE_SHM_QUEUE)
+	{
+		m_pShmQueue = new CLMsgLoopManagerForShmQueue(pMsgObserver, pstrThreadName);
+		m_pThread = new CLThread(new CLExecutiveFunctionForMsgLoop(m_pShmQueue), bWaitForDeath, pPlacement);
+	}
+	else if(ExecutiveType == EXECUTIVE_IN_PROCESS_USE_EPOLL)
+	{
+		m_pThread = new CLThread(new CLExecutiveFunctionForMsgLoop(new CLMsgLoopManagerForEpoll(pMsgObserver, pstrThreadName)), bWaitForDeath, pPlacement);
 	}
 	else
 		throw "In CLThreadForMsgLoop::CLThreadForMsgLoop(), ExecutiveType Error";
@@ -84,5 +101,19 @@ CLStatus CLThreadForMsgLoop::RegisterDeserializer(unsigned long lMsgID, CLMessag
 	if(m_pPipeQueue != NULL)
 		return m_pPipeQueue->RegisterDeserializer(lMsgID, pDeserializer);
 
+	if(m_pShmQueue != NULL)
+		return m_pShmQueue->RegisterDeserializer(lMsgID, pDeserializer);
+
+	return CLStatus(-1, 0);
+}
+
+CLStatus CLThreadForMsgLoop::RegisterDeserializer(unsigned long lMsgID, CLZeroCopyMessageDeserializer *pDeserializer)
+{
+	if(m_pPipeQueue != NULL)
+		return m_pPipeQueue->RegisterDeserializer(lMsgID, pDeserializer);
+
+	if(m_pShmQueue != NULL)
+		return m_pShmQueue->RegisterDeserializer(lMsgID, pDeserializer);
+
 	return CLStatus(-1, 0);
-}
\ No newline at end of file
+}
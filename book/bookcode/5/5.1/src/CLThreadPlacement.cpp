@@ -0,0 +1,316 @@
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include "CLThreadPlacement.h"
+#include "CLLogger.h"
+
+//<numaif.h>еĶͬlibnumaͷļ
+#define NUMA_MPOL_PREFERRED 1
+#define NUMA_MPOL_MF_MOVE (1 << 1)
+#define MAX_NUMBER_OF_NUMA_NODES 64
+
+#define PATH_OF_NUMA_NODES "/sys/devices/system/node"
+
+static __thread int t_nNUMANode = -1;
+
+CLThreadPlacement::CLThreadPlacement()
+{
+	CPU_ZERO(&m_CPUSet);
+	m_bUseCPUSet = false;
+	m_nNUMANode = -1;
+	m_nStackSize = 0;
+	m_bHugePageStack = false;
+}
+
+CLThreadPlacement::~CLThreadPlacement()
+{
+}
+
+CLStatus CLThreadPlacement::AddCPU(int nCPU)
+{
+	if((nCPU < 0) || (nCPU >= CPU_SETSIZE))
+		return CLStatus(-1, 0);
+
+	CPU_SET(nCPU, &m_CPUSet);
+	m_bUseCPUSet = true;
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLThreadPlacement::SetNUMANode(int nNode)
+{
+	if((nNode < 0) || (nNode >= MAX_NUMBER_OF_NUMA_NODES))
+		return CLStatus(-1, 0);
+
+	cpu_set_t CPUSet;
+	CLStatus s = GetCPUsOfNUMANode(nNode, &CPUSet);
+	if(!s.IsSuccess())
+	{
+		CLLogger::WriteLogMsg("In CLThreadPlacement::SetNUMANode(), GetCPUsOfNUMANode error", 0);
+		return CLStatus(-1, 0);
+	}
+
+	m_nNUMANode = nNode;
+
+	//ѾָCPUʱԭеCPU
+	if(!m_bUseCPUSet)
+	{
+		m_CPUSet = CPUSet;
+		m_bUseCPUSet = true;
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLThreadPlacement::SetStackSize(size_t nStackSize)
+{
+	if((nStackSize != 0) && (nStackSize < (size_t)PTHREAD_STACK_MIN))
+		return CLStatus(-1, 0);
+
+	m_nStackSize = nStackSize;
+
+	return CLStatus(0, 0);
+}
+
+void CLThreadPlacement::UseHugePageStack(bool bHugePageStack)
+{
+	m_bHugePageStack = bHugePageStack;
+}
+
+int CLThreadPlacement::GetNUMANode()
+{
+	return m_nNUMANode;
+}
+
+bool CLThreadPlacement::IsHugePageStackUsed()
+{
+	return m_bHugePageStack;
+}
+
+CLStatus CLThreadPlacement::SetThreadAttributes(pthread_attr_t *pAttr, bool bCanAllocateStack, void **ppStack, size_t *pnStackSize)
+{
+	*ppStack = 0;
+	*pnStackSize = 0;
+
+	if(m_bUseCPUSet)
+	{
+		int r = pthread_attr_setaffinity_np(pAttr, sizeof(m_CPUSet), &m_CPUSet);
+		if(r != 0)
+		{
+			CLLogger::WriteLogMsg("In CLThreadPlacement::SetThreadAttributes(), pthread_attr_setaffinity_np error", r);
+			return CLStatus(-1, r);
+		}
+	}
+
+	size_t nStackSize = m_nStackSize;
+
+	if(m_bHugePageStack && (!bCanAllocateStack))
+		CLLogger::WriteLogMsg("In CLThreadPlacement::SetThreadAttributes(), huge page stack needs bWaitForDeath", 0);
+
+	if(m_bHugePageStack && bCanAllocateStack)
+	{
+		if(nStackSize == 0)
+			nStackSize = SIZE_OF_HUGE_PAGE;
+
+		nStackSize = (nStackSize + SIZE_OF_HUGE_PAGE - 1) / SIZE_OF_HUGE_PAGE * SIZE_OF_HUGE_PAGE;
+
+		void *pStack = AllocateHugePageStack(nStackSize);
+		if(pStack == 0)
+			return CLStatus(-1, 0);
+
+		int r = pthread_attr_setstack(pAttr, pStack, nStackSize);
+		if(r != 0)
+		{
+			CLLogger::WriteLogMsg("In CLThreadPlacement::SetThreadAttributes(), pthread_attr_setstack error", r);
+			FreeStack(pStack, nStackSize);
+			return CLStatus(-1, r);
+		}
+
+		*ppStack = pStack;
+		*pnStackSize = nStackSize;
+
+		return CLStatus(0, 0);
+	}
+
+	if(nStackSize != 0)
+	{
+		int r = pthread_attr_setstacksize(pAttr, nStackSize);
+		if(r != 0)
+		{
+			CLLogger::WriteLogMsg("In CLThreadPlacement::SetThreadAttributes(), pthread_attr_setstacksize error", r);
+			return CLStatus(-1, r);
+		}
+	}
+
+	return CLStatus(0, 0);
+}
+
+CLStatus CLThreadPlacement::ApplyToCurrentThread()
+{
+	if(m_nNUMANode == -1)
+		return CLStatus(0, 0);
+
+	unsigned long nNodeMask = 1UL << m_nNUMANode;
+
+	//ȶǿƣڵڴ治ʱԿɴڵ
+	if(syscall(SYS_set_mempolicy, NUMA_MPOL_PREFERRED, &nNodeMask, MAX_NUMBER_OF_NUMA_NODES + 1) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLThreadPlacement::ApplyToCurrentThread(), set_mempolicy error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	t_nNUMANode = m_nNUMANode;
+
+	return CLStatus(0, 0);
+}
+
+int CLThreadPlacement::GetNumberOfNUMANodes()
+{
+	int nNodes = 0;
+
+	for(int i = 0; i < MAX_NUMBER_OF_NUMA_NODES; i++)
+	{
+		char path[64];
+		snprintf(path, sizeof(path), PATH_OF_NUMA_NODES "/node%d", i);
+
+		if(access(path, F_OK) == 0)
+			nNodes = i + 1;
+	}
+
+	//ûNUMAֵ֧ںϲڸĿ¼Ϊֻнڵ0
+	return (nNodes == 0) ? 1 : nNodes;
+}
+
+CLStatus CLThreadPlacement::GetCPUsOfNUMANode(int nNode, cpu_set_t *pCPUSet)
+{
+	if((nNode < 0) || (pCPUSet == 0))
+		return CLStatus(-1, 0);
+
+	CPU_ZERO(pCPUSet);
+
+	char path[64];
+	snprintf(path, sizeof(path), PATH_OF_NUMA_NODES "/node%d/cpulist", nNode);
+
+	FILE *fp = fopen(path, "r");
+	if(fp == 0)
+	{
+		if(nNode != 0)
+			return CLStatus(-1, errno);
+
+		//ûNUMA֧ʱڵ0ȫCPU
+		return (sched_getaffinity(0, sizeof(cpu_set_t), pCPUSet) == -1) ? CLStatus(-1, errno) : CLStatus(0, 0);
+	}
+
+	//cpulistĸʽ"0-3,8-11"
+	int nFirst, nLast;
+	int c;
+	while(fscanf(fp, "%d", &nFirst) == 1)
+	{
+		nLast = nFirst;
+
+		c = fgetc(fp);
+		if(c == '-')
+		{
+			if(fscanf(fp, "%d", &nLast) != 1)
+				break;
+
+			c = fgetc(fp);
+		}
+
+		for(int i = nFirst; (i <= nLast) && (i < CPU_SETSIZE); i++)
+			CPU_SET(i, pCPUSet);
+
+		if(c != ',')
+			break;
+	}
+
+	fclose(fp);
+
+	if(CPU_COUNT(pCPUSet) == 0)
+		return CLStatus(-1, 0);
+
+	return CLStatus(0, 0);
+}
+
+int CLThreadPlacement::GetNUMANodeOfCPU(int nCPU)
+{
+	int nNodes = GetNumberOfNUMANodes();
+
+	for(int i = 0; i < nNodes; i++)
+	{
+		cpu_set_t CPUSet;
+		if(GetCPUsOfNUMANode(i, &CPUSet).IsSuccess() && CPU_ISSET(nCPU, &CPUSet))
+			return i;
+	}
+
+	return -1;
+}
+
+int CLThreadPlacement::GetNUMANodeOfCurrentThread()
+{
+	return t_nNUMANode;
+}
+
+CLStatus CLThreadPlacement::BindMemoryToNUMANode(void *p, size_t nSize, int nNode)
+{
+	if((p == 0) || (nSize == 0) || (nNode < 0) || (nNode >= MAX_NUMBER_OF_NUMA_NODES))
+		return CLStatus(-1, 0);
+
+	//mbindҪʼַҳ
+	uintptr_t nPageSize = sysconf(_SC_PAGESIZE);
+	uintptr_t nBegin = (uintptr_t)p & ~(nPageSize - 1);
+	uintptr_t nEnd = ((uintptr_t)p + nSize + nPageSize - 1) & ~(nPageSize - 1);
+
+	unsigned long nNodeMask = 1UL << nNode;
+
+	if(syscall(SYS_mbind, nBegin, nEnd - nBegin, NUMA_MPOL_PREFERRED, &nNodeMask, MAX_NUMBER_OF_NUMA_NODES + 1, NUMA_MPOL_MF_MOVE) == -1)
+	{
+		CLLogger::WriteLogMsg("In CLThreadPlacement::BindMemoryToNUMANode(), mbind error", errno);
+		return CLStatus(-1, errno);
+	}
+
+	return CLStatus(0, 0);
+}
+
+void *CLThreadPlacement::AllocateHugePageStack(size_t nStackSize)
+{
+	void *pStack = mmap(0, nStackSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_STACK, -1, 0);
+	if(pStack != MAP_FAILED)
+		return pStack;
+
+	//ûԤҳӳһҳԱ㰴ҳ룬ٽ͸ҳ
+	size_t nMappedSize = nStackSize + SIZE_OF_HUGE_PAGE;
+	char *pMapped = (char *)mmap(0, nMappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+	if(pMapped == MAP_FAILED)
+	{
+		CLLogger::WriteLogMsg("In CLThreadPlacement::AllocateHugePageStack(), mmap error", errno);
+		return 0;
+	}
+
+	char *pAligned = (char *)(((uintptr_t)pMapped + SIZE_OF_HUGE_PAGE - 1) & ~((uintptr_t)SIZE_OF_HUGE_PAGE - 1));
+
+	if(pAligned != pMapped)
+		munmap(pMapped, pAligned - pMapped);
+
+	size_t nTail = (pMapped + nMappedSize) - (pAligned + nStackSize);
+	if(nTail != 0)
+		munmap(pAligned + nStackSize, nTail);
+
+	if(madvise(pAligned, nStackSize, MADV_HUGEPAGE) == -1)
+		CLLogger::WriteLogMsg("In CLThreadPlacement::AllocateHugePageStack(), madvise error", errno);
+
+	return pAligned;
+}
+
+void CLThreadPlacement::FreeStack(void *pStack, size_t nStackSize)
+{
+	if(pStack == 0)
+		return;
+
+	if(munmap(pStack, nStackSize) == -1)
+		CLLogger::WriteLogMsg("In CLThreadPlacement::FreeStack(), munmap error", errno);
+}
@@ -0,0 +1,12 @@
+#include "CLTimerMessage.h"
+
+CLTimerMessage::CLTimerMessage(unsigned long lMsgID, unsigned long nTimerID, void *pContext, unsigned long nExpirations) : CLPooledMessage(lMsgID)
+{
+	m_nTimerID = nTimerID;
+	m_pContext = pContext;
+	m_nExpirations = nExpirations;
+}
+
+CLTimerMessage::~CLTimerMessage()
+{
+}
@@ -0,0 +1,309 @@
+#include <time.h>
+#include <string.h>
+#include "CLTimingWheel.h"
+
+CLTimingWheel::CLTimingWheel(unsigned long long nNow)
+{
+	m_nFreeTimer = -1;
+
+	for(int i = 0; i < NUMBER_OF_TIMING_WHEEL_LISTS; i++)
+		m_Heads[i] = -1;
+
+	m_nExpiredTail = -1;
+	memset(m_Bitmap, 0, sizeof(m_Bitmap));
+
+	m_nCurrent = nNow;
+	m_nTimersInWheel = 0;
+	m_nTimers = 0;
+}
+
+CLTimingWheel::~CLTimingWheel()
+{
+}
+
+unsigned long CLTimingWheel::AddTimer(unsigned long long nNow, unsigned long lDelayMs, unsigned long lIntervalMs, unsigned long lMsgID, void *pContext, int nTarget)
+{
+	if(m_nTimers >= MAX_NUMBER_OF_TIMERS)
+		return 0;
+
+	//ʱΪʱm_nCurrentܾãֱǰʱ
+	if((m_nTimersInWheel == 0) && (m_nCurrent < nNow))
+		m_nCurrent = nNow;
+
+	int nIndex = m_nFreeTimer;
+	if(nIndex != -1)
+		m_nFreeTimer = m_Timers[nIndex].Next;
+	else
+	{
+		SLTimingWheelTimer timer;
+		memset(&timer, 0, sizeof(timer));
+		timer.List = -1;
+
+		nIndex = (int)m_Timers.size();
+		m_Timers.push_back(timer);
+	}
+
+	SLTimingWheelTimer *pTimer = &m_Timers[nIndex];
+
+	unsigned long nReused = ((pTimer->nTimerID >> BITS_OF_TIMER_INDEX) + 1) << BITS_OF_TIMER_INDEX;
+	if(nReused == 0)
+		nReused = 1UL << BITS_OF_TIMER_INDEX;
+
+	pTimer->nTimerID = nReused | (unsigned long)nIndex;
+	pTimer->nExpire = nNow + lDelayMs;
+	pTimer->lIntervalMs = lIntervalMs;
+	pTimer->lMsgID = lMsgID;
+	pTimer->pContext = pContext;
+	pTimer->nTarget = nTarget;
+
+	Insert(nIndex);
+
+	m_nTimersInWheel++;
+	m_nTimers++;
+
+	return pTimer->nTimerID;
+}
+
+bool CLTimingWheel::CancelTimer(unsigned long nTimerID)
+{
+	unsigned long nIndex = nTimerID & (MAX_NUMBER_OF_TIMERS - 1);
+	if(nIndex >= m_Timers.size())
+		return false;
+
+	SLTimingWheelTimer *pTimer = &m_Timers[nIndex];
+	if((pTimer->nTimerID != nTimerID) || (pTimer->List == -1))
+		return false;
+
+	if(pTimer->List != EXPIRED_LIST_OF_TIMING_WHEEL)
+		m_nTimersInWheel--;
+
+	UnlinkTimer((int)nIndex);
+	FreeTimer((int)nIndex);
+
+	m_nTimers--;
+
+	return true;
+}
+
+void CLTimingWheel::Advance(unsigned long long nNow)
+{
+	while(m_nCurrent <= nNow)
+	{
+		if(m_nTimersInWheel == 0)
+		{
+			m_nCurrent = nNow + 1;
+			break;
+		}
+
+		int nSlot = (int)(m_nCurrent & MASK_OF_TIMING_WHEEL_SLOTS);
+		if(nSlot == 0)
+			Cascade(1);
+
+		int nIndex = m_Heads[nSlot];
+		m_Heads[nSlot] = -1;
+		m_Bitmap[nSlot / 64] &= ~(1ULL << (nSlot % 64));
+
+		while(nIndex != -1)
+		{
+			int nNext = m_Timers[nIndex].Next;
+
+			LinkTimer(nIndex, EXPIRED_LIST_OF_TIMING_WHEEL);
+			m_nTimersInWheel--;
+
+			nIndex = nNext;
+		}
+
+		m_nCurrent++;
+	}
+}
+
+bool CLTimingWheel::PopExpiredTimer(SLExpiredTimer *pExpiredTimer)
+{
+	int nIndex = m_Heads[EXPIRED_LIST_OF_TIMING_WHEEL];
+	if((nIndex == -1) || (pExpiredTimer == 0))
+		return false;
+
+	UnlinkTimer(nIndex);
+
+	SLTimingWheelTimer *pTimer = &m_Timers[nIndex];
+
+	pExpiredTimer->nTimerID = pTimer->nTimerID;
+	pExpiredTimer->lMsgID = pTimer->lMsgID;
+	pExpiredTimer->pContext = pTimer->pContext;
+	pExpiredTimer->nTarget = pTimer->nTarget;
+	pExpiredTimer->nExpirations = 1;
+
+	if(pTimer->lIntervalMs == 0)
+	{
+		FreeTimer(nIndex);
+		m_nTimers--;
+		return true;
+	}
+
+	//ϢѭæʱѴڣϲΪһͶ
+	unsigned long long nPassed = 0;
+	if(m_nCurrent > pTimer->nExpire)
+		nPassed = (m_nCurrent - 1 - pTimer->nExpire) / pTimer->lIntervalMs;
+
+	pExpiredTimer->nExpirations = (unsigned long)(nPassed + 1);
+	pTimer->nExpire += (nPassed + 1) * pTimer->lIntervalMs;
+
+	Insert(nIndex);
+	m_nTimersInWheel++;
+
+	return true;
+}
+
+long CLTimingWheel::GetTimeout(unsigned long long nNow)
+{
+	if(m_Heads[EXPIRED_LIST_OF_TIMING_WHEEL] != -1)
+		return 0;
+
+	if(m_nTimersInWheel == 0)
+		return -1;
+
+	if(m_nCurrent <= nNow)
+		return 0;
+
+	//0תһȦʱҪϲƶʱ
+	int nSlot = (int)(m_nCurrent & MASK_OF_TIMING_WHEEL_SLOTS);
+	if(nSlot == 0)
+		return (long)(m_nCurrent - nNow);
+
+	unsigned long long nBase = m_nCurrent - nSlot;
+	unsigned long long nNext = nBase + NUMBER_OF_TIMING_WHEEL_SLOTS;
+
+	for(int nWord = nSlot / 64; nWord < WORDS_OF_TIMING_WHEEL_BITMAP; nWord++)
+	{
+		unsigned long long bits = m_Bitmap[nWord];
+		if(nWord == nSlot / 64)
+			bits &= ~0ULL << (nSlot % 64);
+
+		if(bits != 0)
+		{
+			nNext = nBase + nWord * 64 + __builtin_ctzll(bits);
+			break;
+		}
+	}
+
+	return (long)(nNext - nNow);
+}
+
+unsigned int CLTimingWheel::GetNumberOfTimers()
+{
+	return m_nTimers;
+}
+
+unsigned long long CLTimingWheel::GetCurrentTime()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (unsigned long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+void CLTimingWheel::Insert(int nIndex)
+{
+	SLTimingWheelTimer *pTimer = &m_Timers[nIndex];
+
+	if(pTimer->nExpire < m_nCurrent)
+	{
+		LinkTimer(nIndex, (int)(m_nCurrent & MASK_OF_TIMING_WHEEL_SLOTS));
+		return;
+	}
+
+	unsigned long long nDelay = pTimer->nExpire - m_nCurrent;
+	if(nDelay > MAX_DELAY_OF_TIMING_WHEEL)
+	{
+		nDelay = MAX_DELAY_OF_TIMING_WHEEL;
+		pTimer->nExpire = m_nCurrent + nDelay;
+	}
+
+	int nLevel = 0;
+	while((nLevel < NUMBER_OF_TIMING_WHEEL_LEVELS - 1) && (nDelay >= (1ULL << (BITS_OF_TIMING_WHEEL_SLOTS * (nLevel + 1)))))
+		nLevel++;
+
+	int nSlot = (int)((pTimer->nExpire >> (BITS_OF_TIMING_WHEEL_SLOTS * nLevel)) & MASK_OF_TIMING_WHEEL_SLOTS);
+
+	LinkTimer(nIndex, nLevel * NUMBER_OF_TIMING_WHEEL_SLOTS + nSlot);
+}
+
+void CLTimingWheel::LinkTimer(int nIndex, int List)
+{
+	SLTimingWheelTimer *pTimer = &m_Timers[nIndex];
+	pTimer->List = List;
+
+	//ѵֵڵȺ˳뵽ͷ
+	if(List == EXPIRED_LIST_OF_TIMING_WHEEL)
+	{
+		pTimer->Prev = m_nExpiredTail;
+		pTimer->Next = -1;
+
+		if(m_nExpiredTail == -1)
+			m_Heads[List] = nIndex;
+		else
+			m_Timers[m_nExpiredTail].Next = nIndex;
+
+		m_nExpiredTail = nIndex;
+		return;
+	}
+
+	pTimer->Prev = -1;
+	pTimer->Next = m_Heads[List];
+
+	if(m_Heads[List] != -1)
+		m_Timers[m_Heads[List]].Prev = nIndex;
+
+	m_Heads[List] = nIndex;
+
+	if(List < NUMBER_OF_TIMING_WHEEL_SLOTS)
+		m_Bitmap[List / 64] |= 1ULL << (List % 64);
+}
+
+void CLTimingWheel::UnlinkTimer(int nIndex)
+{
+	SLTimingWheelTimer *pTimer = &m_Timers[nIndex];
+	int List = pTimer->List;
+
+	if(pTimer->Prev == -1)
+		m_Heads[List] = pTimer->Next;
+	else
+		m_Timers[pTimer->Prev].Next = pTimer->Next;
+
+	if(pTimer->Next != -1)
+		m_Timers[pTimer->Next].Prev = pTimer->Prev;
+	else if(List == EXPIRED_LIST_OF_TIMING_WHEEL)
+		m_nExpiredTail = pTimer->Prev;
+
+	if((List < NUMBER_OF_TIMING_WHEEL_SLOTS) && (m_Heads[List] == -1))
+		m_Bitmap[List / 64] &= ~(1ULL << (List % 64));
+
+	pTimer->List = -1;
+}
+
+void CLTimingWheel::Cascade(int nLevel)
+{
+	int nSlot = (int)((m_nCurrent >> (BITS_OF_TIMING_WHEEL_SLOTS * nLevel)) & MASK_OF_TIMING_WHEEL_SLOTS);
+
+	//ϲҲתһȦʱȽϲĶʱ
+	if((nSlot == 0) && (nLevel < NUMBER_OF_TIMING_WHEEL_LEVELS - 1))
+		Cascade(nLevel + 1);
+
+	int List = nLevel * NUMBER_OF_TIMING_WHEEL_SLOTS + nSlot;
+	int nIndex = m_Heads[List];
+	m_Heads[List] = -1;
+
+	while(nIndex != -1)
+	{
+		int nNext = m_Timers[nIndex].Next;
+		Insert(nIndex);
+		nIndex = nNext;
+	}
+}
+
+void CLTimingWheel::FreeTimer(int nIndex)
+{
+	m_Timers[nIndex].List = -1;
+	m_Timers[nIndex].Next = m_nFreeTimer;
+	m_nFreeTimer = nIndex;
+}
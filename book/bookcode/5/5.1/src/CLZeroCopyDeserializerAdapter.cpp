@@ -0,0 +1,20 @@
+#include "CLZeroCopyDeserializerAdapter.h"
+#include "CLMessageDeserializer.h"
+
+CLZeroCopyDeserializerAdapter::CLZeroCopyDeserializerAdapter(CLMessageDeserializer *pDeserializer)
+{
+	if(pDeserializer == 0)
+		throw "In CLZeroCopyDeserializerAdapter::CLZeroCopyDeserializerAdapter(), pDeserializer error";
+
+	m_pDeserializer = pDeserializer;
+}
+
+CLZeroCopyDeserializerAdapter::~CLZeroCopyDeserializerAdapter()
+{
+	delete m_pDeserializer;
+}
+
+CLMessage *CLZeroCopyDeserializerAdapter::Deserialize(const char *pBuffer, unsigned int)
+{
+	return m_pDeserializer->Deserialize((char *)pBuffer);
+}
@@ -0,0 +1,9 @@
+#include "CLZeroCopyMessageDeserializer.h"
+
+CLZeroCopyMessageDeserializer::CLZeroCopyMessageDeserializer()
+{
+}
+
+CLZeroCopyMessageDeserializer::~CLZeroCopyMessageDeserializer()
+{
+}
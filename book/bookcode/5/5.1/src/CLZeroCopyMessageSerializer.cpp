@@ -0,0 +1,9 @@
+#include "CLZeroCopyMessageSerializer.h"
+
+CLZeroCopyMessageSerializer::CLZeroCopyMessageSerializer()
+{
+}
+
+CLZeroCopyMessageSerializer::~CLZeroCopyMessageSerializer()
+{
+}
@@ -0,0 +1,76 @@
+#include "CLZeroCopySerializerAdapter.h"
+#include "CLMessageSerializer.h"
+#include "CLSerializeCursor.h"
+
+//GetSerializedLengthĽ߳̽ŶͬһϢõSerializeʹԭлֻһ
+struct SLSerializedMessageCache
+{
+	CLZeroCopySerializerAdapter *pAdapter;
+	CLMessage *pMsg;
+	char *pBuffer;
+	unsigned int nLength;
+};
+
+static __thread SLSerializedMessageCache t_Cache = {0, 0, 0, 0};
+
+static void ClearCache()
+{
+	if(t_Cache.pBuffer != 0)
+		delete [] t_Cache.pBuffer;
+
+	t_Cache.pAdapter = 0;
+	t_Cache.pMsg = 0;
+	t_Cache.pBuffer = 0;
+	t_Cache.nLength = 0;
+}
+
+CLZeroCopySerializerAdapter::CLZeroCopySerializerAdapter(CLMessageSerializer *pSerializer)
+{
+	if(pSerializer == 0)
+		throw "In CLZeroCopySerializerAdapter::CLZeroCopySerializerAdapter(), pSerializer error";
+
+	m_pSerializer = pSerializer;
+}
+
+CLZeroCopySerializerAdapter::~CLZeroCopySerializerAdapter()
+{
+	if(t_Cache.pAdapter == this)
+		ClearCache();
+
+	delete m_pSerializer;
+}
+
+unsigned int CLZeroCopySerializerAdapter::GetSerializedLength(CLMessage *pMsg)
+{
+	ClearCache();
+
+	unsigned int length = 0;
+	char *pBuffer = m_pSerializer->Serialize(pMsg, &length, 0);
+	if(pBuffer == 0)
+		return 0;
+
+	t_Cache.pAdapter = this;
+	t_Cache.pMsg = pMsg;
+	t_Cache.pBuffer = pBuffer;
+	t_Cache.nLength = length;
+
+	return length;
+}
+
+CLStatus CLZeroCopySerializerAdapter::Serialize(CLMessage *pMsg, CLSerializeCursor *pCursor)
+{
+	if(pCursor == 0)
+		return CLStatus(-1, 0);
+
+	if((t_Cache.pAdapter != this) || (t_Cache.pMsg != pMsg))
+	{
+		if(GetSerializedLength(pMsg) == 0)
+			return CLStatus(-1, 0);
+	}
+
+	CLStatus s = pCursor->Write(t_Cache.pBuffer, t_Cache.nLength);
+
+	ClearCache();
+
+	return s;
+}
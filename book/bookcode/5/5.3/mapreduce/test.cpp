@@ -0,0 +1,112 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <ctype.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "LibExecutive.h"
+
+using namespace std;
+
+#define MAX_WORD_LENGTH 256
+
+/*
+../test/wordcount.cppͳƹͬĸΪһʣתΪСд
+CLMapReduceJobmmapӳ䣬ӳִ屾غϲٰɢֵطԼִ
+*/
+class CLWordCountMapper : public CLMapReduceMapper
+{
+public:
+	CLWordCountMapper()
+	{
+		for(int i = 0; i < 256; i++)
+			m_Lower[i] = isalpha(i) ? (char)tolower(i) : 0;
+	}
+
+	virtual CLStatus Map(const char *pData, unsigned long nLength, CLMapReduceEmitter *pEmitter)
+	{
+		char word[MAX_WORD_LENGTH];
+		unsigned long i = 0;
+
+		while(i < nLength)
+		{
+			while((i < nLength) && (m_Lower[(unsigned char)pData[i]] == 0))
+				i++;
+
+			unsigned int n = 0;
+			string long_word;
+
+			while((i < nLength) && (m_Lower[(unsigned char)pData[i]] != 0))
+			{
+				if(n < MAX_WORD_LENGTH)
+					word[n] = m_Lower[(unsigned char)pData[i]];
+				else
+				{
+					if(n == MAX_WORD_LENGTH)
+						long_word.assign(word, MAX_WORD_LENGTH);
+
+					long_word += m_Lower[(unsigned char)pData[i]];
+				}
+
+				n++;
+				i++;
+			}
+
+			if(n == 0)
+				break;
+
+			if(n <= MAX_WORD_LENGTH)
+				pEmitter->Emit(word, n, 1);
+			else
+				pEmitter->Emit(long_word.data(), n, 1);
+		}
+
+		return CLStatus(0, 0);
+	}
+
+private:
+	char m_Lower[256];
+};
+
+int main(int argc, char **argv)
+{
+	if(argc < 2)
+	{
+		cout << "usage:./a.out [dirname1] [dirname2] ... " << endl;
+		exit(-1);
+	}
+
+	if(!CLLibExecutiveInitializer::Initialize().IsSuccess())
+	{
+		cout << "Initialize error" << endl;
+		return 0;
+	}
+
+	{
+		//ӳԼִCPUͬ
+		long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		unsigned int executives = (cpus > 0) ? (unsigned int)cpus : 1;
+
+		vector<CLMapReduceMapper*> mappers;
+		for(unsigned int i = 0; i < executives; i++)
+			mappers.push_back(new CLWordCountMapper);
+
+		CLMapReduceJob job(mappers, executives, "wordcount");
+
+		for(int i = 1; i < argc; i++)
+		{
+			if(!job.AddInputDirectory(argv[i]).IsSuccess())
+				cout << "can't open dir " << argv[i] << endl;
+		}
+
+		if(job.Run("./result").IsSuccess())
+			cout << "work done, " << job.GetNumberOfKeys() << " words, " << job.GetInputLength() << " bytes" << endl;
+		else
+			cout << "Run error" << endl;
+	}
+
+	if(!CLLibExecutiveInitializer::Destroy().IsSuccess())
+		cout << "Destroy error" << endl;
+
+	return 0;
+}
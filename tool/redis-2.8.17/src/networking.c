@@ -30,8 +30,17 @@
 #include "redis.h"
 #include <sys/uio.h>
 #include <math.h>
+#include <pthread.h>
+#include <sched.h>
 
 static void setProtocolError(redisClient *c, int pos);
+static int writeClientOutput(redisClient *c);
+static void finishClientWrite(redisClient *c);
+
+/* Set while processEventsWhileBlocked() runs: queries are then read and
+ * replies written by the main thread as soon as the events fire, since
+ * beforeSleep() is not called. */
+static int processing_events_while_blocked = 0;
 
 /* To evaluate the output buffer size of a client we need to get size of
  * allocated objects, however we can't used zmalloc_size() directly on sds
@@ -85,6 +94,7 @@ redisClient *createClient(int fd) {
     c->multibulklen = 0;
     c->bulklen = -1;
     c->sentlen = 0;
+    c->io_sent_objects = 0;
     c->flags = 0;
     c->ctime = c->lastinteraction = server.unixtime;
     c->authenticated = 0;
@@ -133,9 +143,26 @@ int prepareClientToWrite(redisClient *c) {
     if (c->fd <= 0) return REDIS_ERR; /* Fake client */
     if (c->bufpos == 0 && listLength(c->reply) == 0 &&
         (c->replstate == REDIS_REPL_NONE ||
-         c->replstate == REDIS_REPL_ONLINE) &&
-        aeCreateFileEvent(server.el, c->fd, AE_WRITABLE,
-        sendReplyToClient, c) == AE_ERR) return REDIS_ERR;
+         c->replstate == REDIS_REPL_ONLINE))
+    {
+        /* With I/O threads enabled the write of normal clients is not
+         * done by the event loop: the client is queued and its output
+         * sent, possibly by an I/O thread, in beforeSleep(). Clients
+         * whose query is being parsed by an I/O thread are queued later
+         * by the main thread, see handleClientsWithPendingReadsUsingThreads(). */
+        if (server.io_threads_num > 1 &&
+            !(c->flags & (REDIS_SLAVE|REDIS_MASTER)))
+        {
+            if (!(c->flags & (REDIS_PENDING_WRITE|REDIS_PENDING_READ))) {
+                c->flags |= REDIS_PENDING_WRITE;
+                listAddNodeTail(server.clients_pending_write,c);
+            }
+        } else if (aeCreateFileEvent(server.el, c->fd, AE_WRITABLE,
+                   sendReplyToClient, c) == AE_ERR)
+        {
+            return REDIS_ERR;
+        }
+    }
     return REDIS_OK;
 }
 
@@ -713,6 +740,18 @@ void freeClient(redisClient *c) {
         listDelNode(server.unblocked_clients,ln);
     }
 
+    /* Remove the client from the I/O threads queues. */
+    if (c->flags & REDIS_PENDING_WRITE) {
+        ln = listSearchKey(server.clients_pending_write,c);
+        redisAssert(ln != NULL);
+        listDelNode(server.clients_pending_write,ln);
+    }
+    if (c->flags & REDIS_PENDING_READ) {
+        ln = listSearchKey(server.clients_pending_read,c);
+        redisAssert(ln != NULL);
+        listDelNode(server.clients_pending_read,ln);
+    }
+
     /* Master/slave cleanup Case 1:
      * we lost the connection with a slave. */
     if (c->flags & REDIS_SLAVE) {
@@ -756,9 +795,19 @@ void freeClient(redisClient *c) {
  * a context where calling freeClient() is not possible, because the client
  * should be valid for the continuation of the flow of the program. */
 void freeClientAsync(redisClient *c) {
+    /* The I/O threads may call this function while parsing a query. */
+    static pthread_mutex_t async_free_queue_mutex = PTHREAD_MUTEX_INITIALIZER;
+
     if (c->flags & REDIS_CLOSE_ASAP) return;
+    if (server.io_threads_num == 1) {
+        c->flags |= REDIS_CLOSE_ASAP;
+        listAddNodeTail(server.clients_to_close,c);
+        return;
+    }
+    pthread_mutex_lock(&async_free_queue_mutex);
     c->flags |= REDIS_CLOSE_ASAP;
     listAddNodeTail(server.clients_to_close,c);
+    pthread_mutex_unlock(&async_free_queue_mutex);
 }
 
 void freeClientsInAsyncFreeQueue(void) {
@@ -772,17 +821,24 @@ void freeClientsInAsyncFreeQueue(void) {
     }
 }
 
-void sendReplyToClient(aeEventLoop *el, int fd, void *privdata, int mask) {
-    redisClient *c = privdata;
+/* Write as much of the client output buffers as the socket accepts.
+ *
+ * The reply objects that get fully sent are not released here, they are
+ * only counted in c->io_sent_objects and finishClientWrite() releases them
+ * later: object reference counts are not atomic and replies often point to
+ * shared objects, so this way the function is safe to call from an I/O
+ * thread as long as the main thread does not touch the client meanwhile.
+ *
+ * On write errors the client is flagged with REDIS_IO_ERROR and REDIS_ERR
+ * is returned. */
+static int writeClientOutput(redisClient *c) {
     int nwritten = 0, totwritten = 0, objlen;
-    size_t objmem;
+    listNode *ln = listFirst(c->reply);
     robj *o;
-    REDIS_NOTUSED(el);
-    REDIS_NOTUSED(mask);
 
-    while(c->bufpos > 0 || listLength(c->reply)) {
+    while(c->bufpos > 0 || ln) {
         if (c->bufpos > 0) {
-            nwritten = write(fd,c->buf+c->sentlen,c->bufpos-c->sentlen);
+            nwritten = write(c->fd,c->buf+c->sentlen,c->bufpos-c->sentlen);
             if (nwritten <= 0) break;
             c->sentlen += nwritten;
             totwritten += nwritten;
@@ -794,25 +850,25 @@ void sendReplyToClient(aeEventLoop *el, int fd, void *privdata, int mask) {
                 c->sentlen = 0;
             }
         } else {
-            o = listNodeValue(listFirst(c->reply));
+            o = listNodeValue(ln);
             objlen = sdslen(o->ptr);
-            objmem = zmalloc_size_sds(o->ptr);
 
             if (objlen == 0) {
-                listDelNode(c->reply,listFirst(c->reply));
+                c->io_sent_objects++;
+                ln = listNextNode(ln);
                 continue;
             }
 
-            nwritten = write(fd, ((char*)o->ptr)+c->sentlen,objlen-c->sentlen);
+            nwritten = write(c->fd, ((char*)o->ptr)+c->sentlen,objlen-c->sentlen);
             if (nwritten <= 0) break;
             c->sentlen += nwritten;
             totwritten += nwritten;
 
             /* If we fully sent the object on head go to the next one */
             if (c->sentlen == objlen) {
-                listDelNode(c->reply,listFirst(c->reply));
+                c->io_sent_objects++;
+                ln = listNextNode(ln);
                 c->sentlen = 0;
-                c->reply_bytes -= objmem;
             }
         }
         /* Note that we avoid to send more than REDIS_MAX_WRITE_PER_EVENT
@@ -827,15 +883,11 @@ void sendReplyToClient(aeEventLoop *el, int fd, void *privdata, int mask) {
             (server.maxmemory == 0 ||
              zmalloc_used_memory() < server.maxmemory)) break;
     }
-    if (nwritten == -1) {
-        if (errno == EAGAIN) {
-            nwritten = 0;
-        } else {
-            redisLog(REDIS_VERBOSE,
-                "Error writing to client: %s", strerror(errno));
-            freeClient(c);
-            return;
-        }
+    if (nwritten == -1 && errno != EAGAIN) {
+        redisLog(REDIS_VERBOSE,
+            "Error writing to client: %s", strerror(errno));
+        c->flags |= REDIS_IO_ERROR;
+        return REDIS_ERR;
     }
     if (totwritten > 0) {
         /* For clients representing masters we don't count sending data
@@ -844,13 +896,66 @@ void sendReplyToClient(aeEventLoop *el, int fd, void *privdata, int mask) {
          * We just rely on data / pings received for timeout detection. */
         if (!(c->flags & REDIS_MASTER)) c->lastinteraction = server.unixtime;
     }
+    return REDIS_OK;
+}
+
+/* Complete a writeClientOutput() call from the main thread: release the
+ * reply objects that were fully sent, then free the client on errors or
+ * once the whole reply of a REDIS_CLOSE_AFTER_REPLY client is sent, or
+ * install / remove the write handler depending on what is left to send. */
+static void finishClientWrite(redisClient *c) {
+    while (c->io_sent_objects) {
+        listNode *ln = listFirst(c->reply);
+        robj *o = listNodeValue(ln);
+
+        if (sdslen(o->ptr)) c->reply_bytes -= zmalloc_size_sds(o->ptr);
+        listDelNode(c->reply,ln);
+        c->io_sent_objects--;
+    }
+    if (c->flags & REDIS_IO_ERROR) {
+        freeClient(c);
+        return;
+    }
     if (c->bufpos == 0 && listLength(c->reply) == 0) {
         c->sentlen = 0;
-        aeDeleteFileEvent(server.el,c->fd,AE_WRITABLE);
+        if (aeGetFileEvents(server.el,c->fd) & AE_WRITABLE)
+            aeDeleteFileEvent(server.el,c->fd,AE_WRITABLE);
 
         /* Close connection after entire reply has been sent. */
         if (c->flags & REDIS_CLOSE_AFTER_REPLY) freeClient(c);
+    } else if (!(aeGetFileEvents(server.el,c->fd) & AE_WRITABLE)) {
+        /* A deferred write could not send everything: let the event loop
+         * deliver the rest as the socket becomes writable. */
+        if (aeCreateFileEvent(server.el,c->fd,AE_WRITABLE,
+            sendReplyToClient,c) == AE_ERR) freeClientAsync(c);
+    }
+}
+
+void sendReplyToClient(aeEventLoop *el, int fd, void *privdata, int mask) {
+    redisClient *c = privdata;
+    REDIS_NOTUSED(el);
+    REDIS_NOTUSED(fd);
+    REDIS_NOTUSED(mask);
+
+    writeClientOutput(c);
+    finishClientWrite(c);
+}
+
+/* Write the replies of the clients queued by prepareClientToWrite() from
+ * the main thread. Returns the number of clients processed. */
+int handleClientsWithPendingWrites(void) {
+    int processed = listLength(server.clients_pending_write);
+
+    while (listLength(server.clients_pending_write)) {
+        listNode *ln = listFirst(server.clients_pending_write);
+        redisClient *c = listNodeValue(ln);
+
+        c->flags &= ~REDIS_PENDING_WRITE;
+        listDelNode(server.clients_pending_write,ln);
+        writeClientOutput(c);
+        finishClientWrite(c);
     }
+    return processed;
 }
 
 /* resetClient prepare the client to process the next command */
@@ -1105,6 +1210,12 @@ void processInputBuffer(redisClient *c) {
         if (c->argc == 0) {
             resetClient(c);
         } else {
+            /* In an I/O thread we only parse: the main thread executes
+             * the command and then parses the rest of the buffer. */
+            if (c->flags & REDIS_PENDING_READ) {
+                c->flags |= REDIS_PENDING_COMMAND;
+                break;
+            }
             /* Only reset the client when the command was executed. */
             if (processCommand(c) == REDIS_OK)
                 resetClient(c);
@@ -1112,14 +1223,14 @@ void processInputBuffer(redisClient *c) {
     }
 }
 
-void readQueryFromClient(aeEventLoop *el, int fd, void *privdata, int mask) {
-    redisClient *c = (redisClient*) privdata;
+/* Read from the client socket into the query buffer. Returns the number of
+ * bytes read (0 if the read would block), or -1 if the connection was closed,
+ * the read failed or the query buffer grew over the limit, in which case the
+ * caller must free the client. Safe to call from an I/O thread. */
+static int readClientQuery(redisClient *c) {
     int nread, readlen;
     size_t qblen;
-    REDIS_NOTUSED(el);
-    REDIS_NOTUSED(mask);
 
-    server.current_client = c;
     readlen = REDIS_IOBUF_LEN;
     /* If this is a multi bulk request, and we are processing a bulk reply
      * that is large enough, try to maximize the probability that the query
@@ -1138,28 +1249,21 @@ void readQueryFromClient(aeEventLoop *el, int fd, void *privdata, int mask) {
     qblen = sdslen(c->querybuf);
     if (c->querybuf_peak < qblen) c->querybuf_peak = qblen;
     c->querybuf = sdsMakeRoomFor(c->querybuf, readlen);
-    nread = read(fd, c->querybuf+qblen, readlen);
+    nread = read(c->fd, c->querybuf+qblen, readlen);
     if (nread == -1) {
         if (errno == EAGAIN) {
-            nread = 0;
+            return 0;
         } else {
             redisLog(REDIS_VERBOSE, "Reading from client: %s",strerror(errno));
-            freeClient(c);
-            return;
+            return -1;
         }
     } else if (nread == 0) {
         redisLog(REDIS_VERBOSE, "Client closed connection");
-        freeClient(c);
-        return;
-    }
-    if (nread) {
-        sdsIncrLen(c->querybuf,nread);
-        c->lastinteraction = server.unixtime;
-        if (c->flags & REDIS_MASTER) c->reploff += nread;
-    } else {
-        server.current_client = NULL;
-        return;
+        return -1;
     }
+    sdsIncrLen(c->querybuf,nread);
+    c->lastinteraction = server.unixtime;
+    if (c->flags & REDIS_MASTER) c->reploff += nread;
     if (sdslen(c->querybuf) > server.client_max_querybuf_len) {
         sds ci = catClientInfoString(sdsempty(),c), bytes = sdsempty();
 
@@ -1167,10 +1271,48 @@ void readQueryFromClient(aeEventLoop *el, int fd, void *privdata, int mask) {
         redisLog(REDIS_WARNING,"Closing client that reached max query buffer length: %s (qbuf initial bytes: %s)", ci, bytes);
         sdsfree(ci);
         sdsfree(bytes);
+        return -1;
+    }
+    return nread;
+}
+
+/* When the I/O threads are active, queue the client so that its query is
+ * read and parsed by the threads in beforeSleep(), instead of reading it
+ * now. The queue keeps the order of the events, so that the commands are
+ * executed in the same order as without threads. Returns 1 if the read was
+ * postponed. */
+static int postponeClientRead(redisClient *c) {
+    /* Already queued: this happens while processing events when blocked. */
+    if (c->flags & REDIS_PENDING_READ) return 1;
+
+    if (server.io_threads_active &&
+        server.io_threads_do_reads &&
+        !processing_events_while_blocked &&
+        !(c->flags & (REDIS_MASTER|REDIS_SLAVE|REDIS_BLOCKED)))
+    {
+        c->flags |= REDIS_PENDING_READ;
+        listAddNodeTail(server.clients_pending_read,c);
+        return 1;
+    }
+    return 0;
+}
+
+void readQueryFromClient(aeEventLoop *el, int fd, void *privdata, int mask) {
+    redisClient *c = (redisClient*) privdata;
+    int nread;
+    REDIS_NOTUSED(el);
+    REDIS_NOTUSED(fd);
+    REDIS_NOTUSED(mask);
+
+    if (postponeClientRead(c)) return;
+
+    server.current_client = c;
+    nread = readClientQuery(c);
+    if (nread == -1) {
         freeClient(c);
         return;
     }
-    processInputBuffer(c);
+    if (nread) processInputBuffer(c);
     server.current_client = NULL;
 }
 
@@ -1643,10 +1785,288 @@ void flushSlavesOutputBuffers(void) {
 int processEventsWhileBlocked(void) {
     int iterations = 4; /* See the function top-comment. */
     int count = 0;
+
+    processing_events_while_blocked++;
     while (iterations--) {
         int events = aeProcessEvents(server.el, AE_FILE_EVENTS|AE_DONT_WAIT);
+        /* beforeSleep() is not called here: send the replies that were
+         * deferred with I/O threads enabled. */
+        events += handleClientsWithPendingWrites();
         if (!events) break;
         count += events;
     }
+    processing_events_while_blocked--;
+    return count;
+}
+
+/* ==========================================================================
+ * Threaded I/O
+ *
+ * With io-threads greater than one, the main thread still executes all the
+ * commands, but the socket reads together with the protocol parsing, and
+ * the reply writes, are fanned out to a pool of I/O threads. Every event
+ * loop iteration the readable clients are queued in clients_pending_read
+ * and the clients with new replies in clients_pending_write; beforeSleep()
+ * splits each queue among the threads (the main thread takes a share too)
+ * and busy waits until they are done, so that clients are never accessed
+ * by two threads at the same time. When there are few clients to serve the
+ * threads are parked on their mutex and the main thread does all the I/O.
+ * ========================================================================== */
+
+#define IO_THREADS_OP_READ 0
+#define IO_THREADS_OP_WRITE 1
+
+static pthread_t io_threads[REDIS_IO_THREADS_MAX_NUM];
+static pthread_mutex_t io_threads_mutex[REDIS_IO_THREADS_MAX_NUM];
+static volatile unsigned long io_threads_pending[REDIS_IO_THREADS_MAX_NUM];
+static volatile int io_threads_op;
+/* Clients assigned to each thread, io_threads_list[0] is the main thread. */
+static list *io_threads_list[REDIS_IO_THREADS_MAX_NUM];
+
+static unsigned long getIOPendingCount(int i) {
+    unsigned long count = io_threads_pending[i];
+    __sync_synchronize();
     return count;
 }
+
+static void setIOPendingCount(int i, unsigned long count) {
+    __sync_synchronize();
+    io_threads_pending[i] = count;
+}
+
+static void emptyIOThreadList(list *l) {
+    while (listLength(l)) listDelNode(l,listFirst(l));
+}
+
+/* Read and parse the query of a client queued by postponeClientRead(). The
+ * parsing is skipped when the client still has reply objects to send, since
+ * a protocol error reply could then need to duplicate a shared object. */
+static void readClientQueryInThread(redisClient *c) {
+    int nread = readClientQuery(c);
+
+    if (nread == -1)
+        c->flags |= REDIS_IO_ERROR;
+    else if (nread > 0 && listLength(c->reply) == 0)
+        processInputBuffer(c);
+}
+
+static void *IOThreadMain(void *myid) {
+    long id = (long)myid;
+    listIter li;
+    listNode *ln;
+
+    while(1) {
+        int j;
+
+        /* Spin for a while waiting for work, then park on the mutex: the
+         * main thread holds it while the threads are stopped. The spin
+         * yields the CPU from time to time, otherwise with less cores than
+         * threads the idle threads starve the main thread. */
+        for (j = 0; j < 1000000; j++) {
+            if (getIOPendingCount(id) != 0) break;
+            if ((j & 63) == 63) sched_yield();
+        }
+        if (getIOPendingCount(id) == 0) {
+            pthread_mutex_lock(&io_threads_mutex[id]);
+            pthread_mutex_unlock(&io_threads_mutex[id]);
+            continue;
+        }
+
+        listRewind(io_threads_list[id],&li);
+        while((ln = listNext(&li))) {
+            redisClient *c = listNodeValue(ln);
+
+            if (io_threads_op == IO_THREADS_OP_WRITE)
+                writeClientOutput(c);
+            else
+                readClientQueryInThread(c);
+        }
+        emptyIOThreadList(io_threads_list[id]);
+        setIOPendingCount(id,0);
+    }
+    return NULL;
+}
+
+/* Create the I/O threads, initially parked. Called once at startup, after
+ * the configuration is loaded. */
+void initThreadedIO(void) {
+    int i;
+
+    server.io_threads_active = 0;
+    if (server.io_threads_num == 1) return;
+
+    for (i = 0; i < server.io_threads_num; i++) {
+        io_threads_list[i] = listCreate();
+        if (i == 0) continue; /* Thread 0 is the main thread. */
+
+        pthread_mutex_init(&io_threads_mutex[i],NULL);
+        setIOPendingCount(i,0);
+        pthread_mutex_lock(&io_threads_mutex[i]);
+        if (pthread_create(&io_threads[i],NULL,IOThreadMain,
+                           (void*)(long)i) != 0)
+        {
+            redisLog(REDIS_WARNING,"Fatal: Can't initialize I/O threads.");
+            exit(1);
+        }
+    }
+    redisLog(REDIS_NOTICE,"Threaded I/O enabled with %d threads.",
+        server.io_threads_num);
+#ifdef _SC_NPROCESSORS_ONLN
+    if (server.io_threads_num > sysconf(_SC_NPROCESSORS_ONLN)) {
+        redisLog(REDIS_WARNING,"WARNING: io-threads is set to %d but only "
+            "%ld CPUs are online: the I/O threads will compete with the "
+            "main thread instead of offloading it.",
+            server.io_threads_num, sysconf(_SC_NPROCESSORS_ONLN));
+    }
+#endif
+}
+
+static void startThreadedIO(void) {
+    int i;
+
+    for (i = 1; i < server.io_threads_num; i++)
+        pthread_mutex_unlock(&io_threads_mutex[i]);
+    server.io_threads_active = 1;
+}
+
+static void stopThreadedIO(void) {
+    int i;
+
+    /* Serve the reads that were already postponed before parking. */
+    handleClientsWithPendingReadsUsingThreads();
+    for (i = 1; i < server.io_threads_num; i++)
+        pthread_mutex_lock(&io_threads_mutex[i]);
+    server.io_threads_active = 0;
+}
+
+/* Waking the threads is not worth it with few clients to serve: stop them
+ * when there are less than two pending writes per thread. Returns 1 if the
+ * I/O must be done by the main thread alone. */
+static int stopThreadedIOIfNeeded(void) {
+    int pending = listLength(server.clients_pending_write);
+
+    if (server.io_threads_num == 1) return 1;
+    if (pending < server.io_threads_num*2) {
+        if (server.io_threads_active) stopThreadedIO();
+        return 1;
+    }
+    return 0;
+}
+
+/* Split the clients of 'l' among the I/O threads, run 'op' on them and
+ * wait for all the threads to finish. The main thread takes the first
+ * share. */
+static void runIOThreadsOp(list *l, int op) {
+    listIter li;
+    listNode *ln;
+    int item_id = 0, j;
+
+    listRewind(l,&li);
+    while((ln = listNext(&li))) {
+        redisClient *c = listNodeValue(ln);
+        int target_id = item_id % server.io_threads_num;
+
+        listAddNodeTail(io_threads_list[target_id],c);
+        item_id++;
+    }
+
+    io_threads_op = op;
+    for (j = 1; j < server.io_threads_num; j++) {
+        int count = listLength(io_threads_list[j]);
+        setIOPendingCount(j,count);
+    }
+
+    listRewind(io_threads_list[0],&li);
+    while((ln = listNext(&li))) {
+        redisClient *c = listNodeValue(ln);
+
+        if (op == IO_THREADS_OP_WRITE)
+            writeClientOutput(c);
+        else
+            readClientQueryInThread(c);
+    }
+    emptyIOThreadList(io_threads_list[0]);
+
+    /* Yielding while waiting lets the I/O threads run when there are less
+     * cores than threads. */
+    while(1) {
+        unsigned long pending = 0;
+
+        for (j = 1; j < server.io_threads_num; j++)
+            pending += getIOPendingCount(j);
+        if (pending == 0) break;
+        sched_yield();
+    }
+}
+
+/* Send the replies of the clients in clients_pending_write, using the I/O
+ * threads when there are enough of them. Called by beforeSleep(). Returns
+ * the number of clients processed. */
+int handleClientsWithPendingWritesUsingThreads(void) {
+    int processed = listLength(server.clients_pending_write);
+
+    if (processed == 0) return 0;
+    if (stopThreadedIOIfNeeded()) return handleClientsWithPendingWrites();
+    if (!server.io_threads_active) startThreadedIO();
+
+    runIOThreadsOp(server.clients_pending_write,IO_THREADS_OP_WRITE);
+
+    /* Back in the main thread: release the sent objects, free the clients
+     * with errors, install the write handler where output is left. */
+    while (listLength(server.clients_pending_write)) {
+        listNode *ln = listFirst(server.clients_pending_write);
+        redisClient *c = listNodeValue(ln);
+
+        c->flags &= ~REDIS_PENDING_WRITE;
+        listDelNode(server.clients_pending_write,ln);
+        finishClientWrite(c);
+    }
+    server.stat_io_writes_processed += processed;
+    return processed;
+}
+
+/* Read and parse the queries of the clients in clients_pending_read with
+ * the I/O threads, then execute the parsed commands. Called by
+ * beforeSleep(). Returns the number of clients processed. */
+int handleClientsWithPendingReadsUsingThreads(void) {
+    int processed = listLength(server.clients_pending_read);
+
+    if (!server.io_threads_active || processed == 0) return 0;
+
+    runIOThreadsOp(server.clients_pending_read,IO_THREADS_OP_READ);
+
+    /* The clients are popped one at a time since executing a command may
+     * free other clients of the list (CLIENT KILL). */
+    while (listLength(server.clients_pending_read)) {
+        listNode *ln = listFirst(server.clients_pending_read);
+        redisClient *c = listNodeValue(ln);
+
+        c->flags &= ~REDIS_PENDING_READ;
+        listDelNode(server.clients_pending_read,ln);
+        if (c->flags & REDIS_IO_ERROR) {
+            freeClient(c);
+            continue;
+        }
+
+        server.current_client = c;
+        if (c->flags & REDIS_PENDING_COMMAND) {
+            c->flags &= ~REDIS_PENDING_COMMAND;
+            if (processCommand(c) == REDIS_OK) resetClient(c);
+        }
+        /* Parse and execute what is left in the query buffer. */
+        processInputBuffer(c);
+        server.current_client = NULL;
+
+        /* Replies added by the thread (protocol errors) did not queue the
+         * client for writing. */
+        if ((c->bufpos || listLength(c->reply)) &&
+            !(c->flags & REDIS_PENDING_WRITE) &&
+            !(aeGetFileEvents(server.el,c->fd) & AE_WRITABLE))
+        {
+            c->flags |= REDIS_PENDING_WRITE;
+            listAddNodeTail(server.clients_pending_write,c);
+        }
+    }
+    server.stat_io_reads_processed += processed;
+    return processed;
+}
@@ -130,6 +130,9 @@ typedef long long mstime_t; /* millisecond time type. */
 #define REDIS_BINDADDR_MAX 16
 #define REDIS_MIN_RESERVED_FDS 32
 #define REDIS_DEFAULT_LATENCY_MONITOR_THRESHOLD 0
+#define REDIS_DEFAULT_IO_THREADS_NUM 1      /* Single threaded by default */
+#define REDIS_DEFAULT_IO_THREADS_DO_READS 1
+#define REDIS_IO_THREADS_MAX_NUM 128
 
 #define ACTIVE_EXPIRE_CYCLE_LOOKUPS_PER_LOOP 20 /* Loopkups per loop. */
 #define ACTIVE_EXPIRE_CYCLE_FAST_DURATION 1000 /* Microseconds */
@@ -242,6 +245,14 @@ typedef long long mstime_t; /* millisecond time type. */
 #define REDIS_PRE_PSYNC (1<<16)   /* Instance don't understand PSYNC. */
 #define REDIS_READONLY (1<<17)    /* Cluster client is in read-only state. */
 #define REDIS_PUBSUB (1<<18)      /* Client is in Pub/Sub mode. */
+#define REDIS_PENDING_WRITE (1<<19) /* Client has output to send but the write
+                                       is deferred to beforeSleep(). */
+#define REDIS_PENDING_READ (1<<20)  /* The read and parsing of the query are
+                                       deferred to the I/O threads. */
+#define REDIS_PENDING_COMMAND (1<<21) /* An I/O thread parsed a command that
+                                         the main thread must execute. */
+#define REDIS_IO_ERROR (1<<22)    /* An I/O thread got a read/write error,
+                                     the main thread frees the client. */
 
 /* Client request types */
 #define REDIS_REQ_INLINE 1
@@ -479,6 +490,8 @@ typedef struct redisClient {
     unsigned long reply_bytes; /* Tot bytes of objects in reply list */
     int sentlen;            /* Amount of bytes already sent in the current
                                buffer or object being sent. */
+    unsigned long io_sent_objects; /* Reply objects fully sent but not yet
+                                      released, see writeClientOutput(). */
     time_t ctime;           /* Client creation time */
     time_t lastinteraction; /* time of the last interaction, used for timeout */
     time_t obuf_soft_limit_reached_time;
@@ -622,6 +635,12 @@ struct redisServer {
     redisClient *current_client; /* Current client, only used on crash report */
     char neterr[ANET_ERR_LEN];   /* Error buffer for anet.c */
     uint64_t next_client_id;    /* Next client unique ID. Incremental. */
+    /* Threaded I/O */
+    int io_threads_num;         /* Number of I/O threads, main one included */
+    int io_threads_do_reads;    /* Read and parse queries in I/O threads too */
+    int io_threads_active;      /* I/O threads are running (not parked) */
+    list *clients_pending_write; /* Clients with replies to write */
+    list *clients_pending_read;  /* Clients with queries to read */
     /* RDB / AOF loading information */
     int loading;                /* We are loading data from disk if true */
     off_t loading_total_bytes;
@@ -646,6 +665,8 @@ struct redisServer {
     long long stat_sync_full;       /* Number of full resyncs with slaves. */
     long long stat_sync_partial_ok; /* Number of accepted PSYNC requests. */
     long long stat_sync_partial_err;/* Number of unaccepted PSYNC requests. */
+    long long stat_io_reads_processed;  /* Reads handed to I/O threads. */
+    long long stat_io_writes_processed; /* Writes handed to I/O threads. */
     list *slowlog;                  /* SLOWLOG list of commands */
     long long slowlog_entry_id;     /* SLOWLOG current entry ID */
     long long slowlog_log_slower_than; /* SLOWLOG time limit (to get logged) */
@@ -965,6 +986,10 @@ char *getClientTypeName(int class);
 void flushSlavesOutputBuffers(void);
 void disconnectSlaves(void);
 int processEventsWhileBlocked(void);
+void initThreadedIO(void);
+int handleClientsWithPendingWrites(void);
+int handleClientsWithPendingWritesUsingThreads(void);
+int handleClientsWithPendingReadsUsingThreads(void);
 
 #ifdef __GNUC__
 void addReplyErrorFormat(redisClient *c, const char *fmt, ...)
@@ -1,18 +1,32 @@
 // coming from libevhtp-htparse.c
 // unix1986@qq.com
 // Format: [mon-day hour:min:sec] "source_file_name":[line_no] func_name: user_content
+// With __DBG_LOG_TRACE__ also defined, __dbg_log records into the binary
+// trace rings of uvs_trace.h under category UVS_TRACE_DBG_LOG_CATEGORY
+// instead of printing; enable it with UVS_TRACE_CATEGORIES and render the
+// dump with uvs_trace_decode. %s arguments are then recorded as addresses.
 #ifndef __COM_GITHUB_UNIVERSE_UTIL_DBG_LOG_H__
 #define __COM_GITHUB_UNIVERSE_UTIL_DBG_LOG_H__
 
 #include <stdio.h>
 #include <time.h>
+#if defined(__DBG_LOG__) && defined(__DBG_LOG_TRACE__)
+#include "uvs_trace.h"
+#endif
 
 namespace github{
 namespace unix1986{
 namespace universe{
 namespace util{
 
-#ifdef __DBG_LOG__
+#if defined(__DBG_LOG__) && defined(__DBG_LOG_TRACE__)
+#define UVS_TRACE_DBG_LOG_CATEGORY 0
+#define dbglog_debug_strlen(x)     strlen(x)
+
+// Interface
+#define __dbg_log(fmt, ...) UVS_TRACE(UVS_TRACE_DBG_LOG_CATEGORY, fmt, ## __VA_ARGS__)
+
+#elif defined(__DBG_LOG__)
 #define __QUOTE(x)                  # x
 #define  _QUOTE(x)                  __QUOTE(x)
 #define dbglog_debug_strlen(x)     strlen(x)
@@ -22,7 +36,7 @@ namespace util{
         time_t      t  = time(NULL);                                                                                 \
         struct tm * dm = localtime(&t);                                                                              \
                                                                                                                      \
-        fprintf(stdout, "[%02d-%02d %02d:%02d:%02d] "_QUOTE(__FILE__)":[" _QUOTE(__LINE__) "] %-s: "                 \
+        fprintf(stdout, "[%02d-%02d %02d:%02d:%02d] " _QUOTE(__FILE__)":[" _QUOTE(__LINE__) "] %-s: "                \
         fmt "\n", dm->tm_mon + 1, dm->tm_mday, dm->tm_hour, dm->tm_min, dm->tm_sec, __func__, ## __VA_ARGS__);       \
         fflush(stdout);                                                                                              \
 } while (0)
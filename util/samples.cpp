@@ -8,5 +8,9 @@ int main(int argc, char *argv[])
     printf("msec: %llu\n", UvsTime::GetTimeMs());
     printf("usec: %llu\n", UvsTime::GetTimeUs());
     printf("nsec: %llu\n", UvsTime::GetTimeNs());
+    printf("monotonic nsec: %llu (tsc: %d)\n", UvsTime::MonotonicNs(), UvsTime::IsTscUsable());
+    UvsTime::StartTicker();
+    printf("cached msec: %llu\n", UvsTime::CachedTimeMs());
+    UvsTime::StopTicker();
     return 0;
 }
@@ -1,47 +1,321 @@
 #ifndef __COM_GITHUB_UNIX1986_UNIVERSE_UTIL_UVS_TIME_H__
 #define __COM_GITHUB_UNIX1986_UNIVERSE_UTIL_UVS_TIME_H__
 #include <stdint.h>
+#include <stdio.h>
 #include <time.h>
 #include <sys/time.h>
 #include <string.h>
+#include <pthread.h>
+
+// Header only. Link with -pthread (and -lrt on glibc older than 2.17)
+// when the ticker thread or clock_gettime is used.
+//
+// Sources, from cheapest to most precise:
+//   Cached*        value refreshed by the optional ticker thread, stale by
+//                  up to one tick, a plain memory load
+//   *CoarseNs      CLOCK_*_COARSE, jiffy resolution, no hardware read
+//   TscNs          calibrated invariant TSC, rdtsc plus a multiply
+//   MonotonicNs    TscNs when the TSC is usable, CLOCK_MONOTONIC otherwise
+//   RealtimeNs     CLOCK_REALTIME, may jump when the wall clock is set
+// Use the monotonic variants for intervals and deadlines, the realtime
+// ones only for timestamps that must match the wall clock.
 
 namespace github{
 namespace unix1986{
 namespace universe{
 namespace util{
 
+namespace detail{
+
+struct UvsTscState {
+    // 0 not calibrated yet, 1 usable, -1 unusable (fall back to clock_gettime)
+    volatile int state;
+    uint64_t base_tsc;
+    uint64_t base_ns;
+    // ns = base_ns + ((tsc - base_tsc) * mult) >> kTscShift
+    uint64_t mult;
+    pthread_mutex_t mutex;
+};
+
+struct UvsTickerState {
+    volatile uint64_t monotonic_ns;
+    volatile uint64_t realtime_ns;
+    volatile int running;
+    volatile int stop;
+    uint64_t interval_us;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+};
+
+inline UvsTscState &TscState() {
+    static UvsTscState s = {0, 0, 0, 0, PTHREAD_MUTEX_INITIALIZER};
+    return s;
+}
+
+inline UvsTickerState &TickerState() {
+    static UvsTickerState s = {0, 0, 0, 0, 0, pthread_t(), PTHREAD_MUTEX_INITIALIZER};
+    return s;
+}
+
+inline uint64_t ReadClock(clockid_t id) {
+    struct timespec now;
+    clock_gettime(id, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+} // detail
+
 class UvsTime{
 public:
+    static const int kTscShift = 24;
+    static const uint64_t kDefaultCalibrationMs = 20;
+    static const uint64_t kDefaultTickUs = 1000;
+
     // elapsed seconds
     static uint64_t GetTimeS() {
         return static_cast<uint64_t>(time(NULL));
     }
     // elapsed milliseconds
     static uint64_t GetTimeMs() {
-        struct timeval now;
-        gettimeofday(&now, NULL);
-        return static_cast<uint64_t>(now.tv_sec * 1000 + now.tv_usec / 1000);
+        return RealtimeNs() / 1000000;
     }
     // elapsed microseconds
     static uint64_t GetTimeUs() {
-        struct timeval now;
-        gettimeofday(&now, NULL);
-        return static_cast<uint64_t>(now.tv_sec * 1000 * 1000 + now.tv_usec);
+        return RealtimeNs() / 1000;
     }
-    // elapsed nanoseconds, may not work
+    // elapsed nanoseconds
     static uint64_t GetTimeNs() {
-        struct timespec now;
-        #ifdef __POSIX_TIMERS
-        if (__POSIX_TIMERS > 0) {
-            clock_gettime(CLOCK_REALTIME, &now);
+        return RealtimeNs();
+    }
+
+    // wall clock, nanoseconds since the epoch
+    static uint64_t RealtimeNs() {
+        return detail::ReadClock(CLOCK_REALTIME);
+    }
+    static uint64_t RealtimeCoarseNs() {
+        #ifdef CLOCK_REALTIME_COARSE
+        return detail::ReadClock(CLOCK_REALTIME_COARSE);
+        #else
+        return detail::ReadClock(CLOCK_REALTIME);
+        #endif
+    }
+
+    // monotonic clock, nanoseconds since an unspecified point, never jumps
+    static uint64_t MonotonicNs() {
+        detail::UvsTscState &s = detail::TscState();
+        if (__builtin_expect(s.state > 0, 1)) {
+            return TscToNs(ReadTsc());
         }
+        if (s.state == 0 && Calibrate(kDefaultCalibrationMs)) {
+            return TscToNs(ReadTsc());
+        }
+        return detail::ReadClock(CLOCK_MONOTONIC);
+    }
+    static uint64_t MonotonicCoarseNs() {
+        #ifdef CLOCK_MONOTONIC_COARSE
+        return detail::ReadClock(CLOCK_MONOTONIC_COARSE);
         #else
-        memset(&now, 0, sizeof(now));
+        return detail::ReadClock(CLOCK_MONOTONIC);
         #endif
-        return static_cast<uint64_t>(now.tv_sec * 1000 * 1000 * 1000 + now.tv_nsec);
     }
+    // plain clock_gettime(CLOCK_MONOTONIC), bypassing the TSC path
+    static uint64_t MonotonicSyscallNs() {
+        return detail::ReadClock(CLOCK_MONOTONIC);
+    }
+
+    // TSC based time on the CLOCK_MONOTONIC scale; 0 when the TSC is unusable
+    static uint64_t TscNs() {
+        if (!IsTscUsable()) {
+            return 0;
+        }
+        return TscToNs(ReadTsc());
+    }
+    static bool IsTscUsable() {
+        detail::UvsTscState &s = detail::TscState();
+        if (s.state == 0) {
+            Calibrate(kDefaultCalibrationMs);
+        }
+        return s.state > 0;
+    }
+
+    // Measures the TSC rate against CLOCK_MONOTONIC over calibration_ms.
+    // Runs once, lazily on first use of MonotonicNs/TscNs; call it at start
+    // up to keep the calibration sleep out of the hot path. The TSC is only
+    // used when the CPU reports an invariant TSC and the kernel itself uses
+    // it as clocksource, so VMs with unstable TSCs fall back to the vDSO.
+    // The rate is fixed afterwards: NTP slewing of CLOCK_MONOTONIC is not
+    // followed, which amounts to a few ppm of drift.
+    static bool Calibrate(uint64_t calibration_ms) {
+        detail::UvsTscState &s = detail::TscState();
+        pthread_mutex_lock(&s.mutex);
+        if (s.state == 0) {
+            s.state = DoCalibrate(calibration_ms) ? 1 : -1;
+        }
+        pthread_mutex_unlock(&s.mutex);
+        return s.state > 0;
+    }
+
+    // Cached clocks: a single load of a value written by the ticker thread,
+    // stale by up to one tick. Without a running ticker they read the
+    // coarse clocks, which have the same staleness class.
+    static uint64_t CachedMonotonicNs() {
+        detail::UvsTickerState &t = detail::TickerState();
+        if (__builtin_expect(t.running, 1)) {
+            return t.monotonic_ns;
+        }
+        return MonotonicCoarseNs();
+    }
+    static uint64_t CachedRealtimeNs() {
+        detail::UvsTickerState &t = detail::TickerState();
+        if (__builtin_expect(t.running, 1)) {
+            return t.realtime_ns;
+        }
+        return RealtimeCoarseNs();
+    }
+    static uint64_t CachedTimeMs() {
+        return CachedRealtimeNs() / 1000000;
+    }
+
+    // Starts the ticker thread refreshing the cached clocks every
+    // interval_us. Idempotent; returns false if the thread can't be created.
+    static bool StartTicker(uint64_t interval_us = kDefaultTickUs) {
+        detail::UvsTickerState &t = detail::TickerState();
+        pthread_mutex_lock(&t.mutex);
+        bool ok = true;
+        if (!t.running) {
+            t.interval_us = interval_us > 0 ? interval_us : 1;
+            t.stop = 0;
+            Tick();
+            if (pthread_create(&t.thread, NULL, TickerMain, NULL) == 0) {
+                __sync_synchronize();
+                t.running = 1;
+            } else {
+                ok = false;
+            }
+        }
+        pthread_mutex_unlock(&t.mutex);
+        return ok;
+    }
+    static void StopTicker() {
+        detail::UvsTickerState &t = detail::TickerState();
+        pthread_mutex_lock(&t.mutex);
+        if (t.running) {
+            t.running = 0;
+            t.stop = 1;
+            pthread_join(t.thread, NULL);
+        }
+        pthread_mutex_unlock(&t.mutex);
+    }
+    static bool IsTickerRunning() {
+        return detail::TickerState().running != 0;
+    }
+
 private:
-    
+    static uint64_t ReadTsc() {
+        #if defined(__x86_64__)
+        uint32_t lo, hi;
+        __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+        return (static_cast<uint64_t>(hi) << 32) | lo;
+        #else
+        return 0;
+        #endif
+    }
+
+    static uint64_t TscToNs(uint64_t tsc) {
+        const detail::UvsTscState &s = detail::TscState();
+        #if defined(__x86_64__)
+        // another core may read a few cycles behind the calibration sample
+        if (tsc <= s.base_tsc) {
+            return s.base_ns;
+        }
+        // 128-bit product: no overflow however long the process runs
+        unsigned __int128 delta = tsc - s.base_tsc;
+        return s.base_ns + static_cast<uint64_t>((delta * s.mult) >> kTscShift);
+        #else
+        return s.base_ns;
+        #endif
+    }
+
+    static bool HasInvariantTsc() {
+        #if defined(__x86_64__)
+        uint32_t eax, ebx, ecx, edx;
+        __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(0x80000000U), "c"(0));
+        if (eax < 0x80000007U) {
+            return false;
+        }
+        __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(0x80000007U), "c"(0));
+        return (edx & (1U << 8)) != 0;
+        #else
+        return false;
+        #endif
+    }
+
+    static bool KernelUsesTsc() {
+        FILE *fp = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+        if (fp == NULL) {
+            return false;
+        }
+        char name[32] = {0};
+        bool tsc = fgets(name, sizeof(name), fp) != NULL && strncmp(name, "tsc", 3) == 0;
+        fclose(fp);
+        return tsc;
+    }
+
+    // Samples (tsc, CLOCK_MONOTONIC) pairs taken back to back; the pair
+    // with the shortest bracketing window bounds the read skew.
+    static void SamplePair(uint64_t *tsc, uint64_t *ns) {
+        uint64_t best = ~0ULL;
+        for (int i = 0; i < 5; ++i) {
+            uint64_t t0 = ReadTsc();
+            uint64_t n = detail::ReadClock(CLOCK_MONOTONIC);
+            uint64_t t1 = ReadTsc();
+            if (t1 - t0 < best) {
+                best = t1 - t0;
+                *tsc = t0 + (t1 - t0) / 2;
+                *ns = n;
+            }
+        }
+    }
+
+    static bool DoCalibrate(uint64_t calibration_ms) {
+        if (!HasInvariantTsc() || !KernelUsesTsc()) {
+            return false;
+        }
+        detail::UvsTscState &s = detail::TscState();
+        uint64_t tsc0 = 0, ns0 = 0, tsc1 = 0, ns1 = 0;
+        SamplePair(&tsc0, &ns0);
+        struct timespec ts;
+        ts.tv_sec = calibration_ms / 1000;
+        ts.tv_nsec = (calibration_ms % 1000) * 1000000;
+        nanosleep(&ts, NULL);
+        SamplePair(&tsc1, &ns1);
+        if (tsc1 <= tsc0 || ns1 <= ns0) {
+            return false;
+        }
+        s.mult = static_cast<uint64_t>(((ns1 - ns0) << kTscShift) / (tsc1 - tsc0));
+        s.base_tsc = tsc1;
+        s.base_ns = ns1;
+        __sync_synchronize();
+        return s.mult != 0;
+    }
+
+    static void Tick() {
+        detail::UvsTickerState &t = detail::TickerState();
+        t.monotonic_ns = MonotonicNs();
+        t.realtime_ns = RealtimeNs();
+    }
+
+    static void *TickerMain(void *) {
+        detail::UvsTickerState &t = detail::TickerState();
+        struct timespec ts;
+        ts.tv_sec = t.interval_us / 1000000;
+        ts.tv_nsec = (t.interval_us % 1000000) * 1000;
+        while (!t.stop) {
+            nanosleep(&ts, NULL);
+            Tick();
+        }
+        return NULL;
+    }
 };
 
 }}}} // github::unix1986::universe:util
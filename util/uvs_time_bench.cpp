@@ -0,0 +1,85 @@
+// ns/call of every UvsTime source
+// g++ -O2 -o uvs_time_bench uvs_time_bench.cpp -pthread
+#include <stdio.h>
+#include <stdlib.h>
+#include "uvs_time.h"
+
+using namespace github::unix1986::universe::util;
+
+typedef uint64_t (*TimeSource)();
+
+static uint64_t Gettimeofday() {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000 + now.tv_usec;
+}
+
+static void Bench(const char *name, TimeSource source, uint64_t calls) {
+    // warm up: calibration, vDSO page, ticker state
+    uint64_t sink = source();
+    uint64_t begin = UvsTime::MonotonicSyscallNs();
+    for (uint64_t i = 0; i < calls; ++i) {
+        sink += source();
+    }
+    uint64_t elapsed = UvsTime::MonotonicSyscallNs() - begin;
+    printf("source=%-22s calls=%llu ns_per_call=%.2f (sink %llu)\n", name,
+           (unsigned long long)calls, (double)elapsed / calls, (unsigned long long)(sink & 1));
+}
+
+// largest backwards step seen between consecutive reads, should be 0
+static void CheckMonotonic(const char *name, TimeSource source, uint64_t calls) {
+    uint64_t prev = source();
+    uint64_t backwards = 0;
+    for (uint64_t i = 0; i < calls; ++i) {
+        uint64_t now = source();
+        if (now < prev && prev - now > backwards) {
+            backwards = prev - now;
+        }
+        prev = now;
+    }
+    printf("check=%-23s calls=%llu max_backwards_ns=%llu\n", name,
+           (unsigned long long)calls, (unsigned long long)backwards);
+}
+
+int main(int argc, char *argv[]) {
+    uint64_t calls = argc > 1 ? strtoull(argv[1], NULL, 10) : 20000000ULL;
+
+    bool tsc = UvsTime::Calibrate(UvsTime::kDefaultCalibrationMs);
+    printf("tsc_usable=%d\n", tsc ? 1 : 0);
+
+    Bench("gettimeofday", Gettimeofday, calls);
+    Bench("GetTimeUs", UvsTime::GetTimeUs, calls);
+    Bench("RealtimeNs", UvsTime::RealtimeNs, calls);
+    Bench("RealtimeCoarseNs", UvsTime::RealtimeCoarseNs, calls);
+    Bench("MonotonicSyscallNs", UvsTime::MonotonicSyscallNs, calls);
+    Bench("MonotonicCoarseNs", UvsTime::MonotonicCoarseNs, calls);
+    if (tsc) {
+        Bench("TscNs", UvsTime::TscNs, calls);
+    }
+    Bench("MonotonicNs", UvsTime::MonotonicNs, calls);
+
+    UvsTime::StartTicker(1000);
+    Bench("CachedMonotonicNs", UvsTime::CachedMonotonicNs, calls);
+    Bench("CachedRealtimeNs", UvsTime::CachedRealtimeNs, calls);
+
+    // staleness of the cached value against a precise read
+    uint64_t worst = 0;
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t cached = UvsTime::CachedMonotonicNs();
+        uint64_t now = UvsTime::MonotonicNs();
+        if (now > cached && now - cached > worst) {
+            worst = now - cached;
+        }
+    }
+    printf("cached_staleness_max_us=%.1f\n", worst / 1000.0);
+    UvsTime::StopTicker();
+
+    CheckMonotonic("MonotonicNs", UvsTime::MonotonicNs, calls / 4);
+
+    // TSC derived time against CLOCK_MONOTONIC after the calibration
+    if (tsc) {
+        int64_t diff = (int64_t)(UvsTime::TscNs() - UvsTime::MonotonicSyscallNs());
+        printf("tsc_minus_monotonic_ns=%lld\n", (long long)diff);
+    }
+    return 0;
+}
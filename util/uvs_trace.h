@@ -0,0 +1,412 @@
+// Binary trace points recorded into per-thread ring buffers.
+//
+//   UVS_TRACE(category, "fmt %d %f", a, b);
+//
+// Each trace point owns a static site holding the format string, __FILE__,
+// __LINE__ and __func__; the site gets an id the first time it fires and
+// only the id, a timestamp and up to UVS_TRACE_MAX_ARGS raw 64-bit
+// arguments are written per event. Nothing is formatted on the hot path:
+// UvsTrace::Dump writes the site table and the rings to a file, and
+// uvs_trace_decode renders them in the __dbg_log text format.
+//
+// Categories 0..63 are switched at run time with UvsTrace::SetCategoryMask,
+// EnableCategory/DisableCategory, or the UVS_TRACE_CATEGORIES environment
+// variable ("all" or a comma separated list such as "0,3,7") read on first
+// use. A disabled trace point costs one load and a branch. When
+// UVS_TRACE_DUMP names a file, the rings are dumped there at exit().
+//
+// Rings are single writer, owned by the recording thread, and overwrite
+// their oldest events when full, so a dump holds the most recent
+// UVS_TRACE_RING_EVENTS events (environment, default 16384) per thread.
+// The ring of an exited thread stays registered, and is still dumped,
+// until a new thread needs a ring: it is then reused and its events are
+// discarded, so memory is bounded by the peak number of tracing threads.
+//
+// Arguments are stored by value: integers, pointers and floating point
+// numbers. For %s only the pointer is recorded and the decoder prints the
+// address, since the string may be gone by the time it is decoded.
+#ifndef __COM_GITHUB_UNIX1986_UNIVERSE_UTIL_UVS_TRACE_H__
+#define __COM_GITHUB_UNIX1986_UNIVERSE_UTIL_UVS_TRACE_H__
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <vector>
+#include "uvs_time.h"
+
+#define UVS_TRACE_MAX_ARGS 5
+#define UVS_TRACE_DEFAULT_RING_EVENTS 16384
+#define UVS_TRACE_FILE_MAGIC 0x31435254535655ULL  // "UVSTRC1"
+
+#define UVS_TRACE(category, fmt, ...) do {                                                                         \
+        static ::github::unix1986::universe::util::UvsTraceSite __uvs_trace_site =                                 \
+            {0, (category), __LINE__, fmt, __FILE__, __func__};                                                    \
+        if (::github::unix1986::universe::util::UvsTrace::IsEnabled(category)) {                                   \
+            ::github::unix1986::universe::util::UvsTrace::Record(&__uvs_trace_site, ## __VA_ARGS__);               \
+        }                                                                                                          \
+} while (0)
+
+namespace github{
+namespace unix1986{
+namespace universe{
+namespace util{
+
+struct UvsTraceSite {
+    volatile uint32_t id;
+    uint32_t category;
+    uint32_t line;
+    const char *fmt;
+    const char *file;
+    const char *func;
+};
+
+// 64 bytes, one cache line. seq is written last and equals the event's
+// position in the ring, so a reader racing with the writer can detect
+// and drop a slot that was being overwritten.
+struct UvsTraceEvent {
+    uint64_t timestamp_ns;
+    uint64_t seq;
+    uint32_t site_id;
+    uint32_t nargs;
+    uint64_t args[UVS_TRACE_MAX_ARGS];
+};
+
+struct UvsTraceRing {
+    UvsTraceEvent *events;
+    uint64_t mask;
+    volatile uint64_t head;
+    uint32_t tid;
+};
+
+// Dump file layout, all integers little endian as written by the host:
+//   UvsTraceFileHeader
+//   nsites x { uint32 id, category, line, fmt_len, file_len, func_len; fmt; file; func }
+//   nrings x { uint32 tid, uint32 reserved, uint64 nevents; nevents x UvsTraceEvent }
+struct UvsTraceFileHeader {
+    uint64_t magic;
+    uint32_t event_size;
+    uint32_t max_args;
+    // realtime_ns - monotonic_ns at dump time, to print wall clock times
+    int64_t realtime_offset_ns;
+    uint32_t nsites;
+    uint32_t nrings;
+};
+
+namespace detail{
+
+struct UvsTraceState {
+    volatile uint64_t mask;
+    volatile int initialized;
+    uint64_t ring_events;
+    pthread_mutex_t mutex;
+    std::vector<UvsTraceSite*> *sites;
+    std::vector<UvsTraceRing*> *rings;
+    // rings of exited threads, reused by CreateRing
+    std::vector<UvsTraceRing*> *free_rings;
+    // its destructor hands the ring of an exiting thread to free_rings
+    pthread_key_t ring_key;
+};
+
+inline UvsTraceState &TraceState() {
+    static UvsTraceState s = {0, 0, 0, PTHREAD_MUTEX_INITIALIZER, 0, 0, 0, pthread_key_t()};
+    return s;
+}
+
+inline UvsTraceRing *&ThreadRing() {
+    static __thread UvsTraceRing *ring = 0;
+    return ring;
+}
+
+inline uint64_t TraceArg(int v) { return static_cast<uint64_t>(static_cast<int64_t>(v)); }
+inline uint64_t TraceArg(long v) { return static_cast<uint64_t>(static_cast<int64_t>(v)); }
+inline uint64_t TraceArg(long long v) { return static_cast<uint64_t>(v); }
+inline uint64_t TraceArg(unsigned int v) { return v; }
+inline uint64_t TraceArg(unsigned long v) { return v; }
+inline uint64_t TraceArg(unsigned long long v) { return v; }
+inline uint64_t TraceArg(char v) { return static_cast<uint64_t>(static_cast<int64_t>(v)); }
+inline uint64_t TraceArg(short v) { return static_cast<uint64_t>(static_cast<int64_t>(v)); }
+inline uint64_t TraceArg(unsigned short v) { return v; }
+inline uint64_t TraceArg(bool v) { return v ? 1 : 0; }
+inline uint64_t TraceArg(double v) { uint64_t u; memcpy(&u, &v, sizeof(u)); return u; }
+inline uint64_t TraceArg(float v) { return TraceArg(static_cast<double>(v)); }
+inline uint64_t TraceArg(const void *v) { return reinterpret_cast<uintptr_t>(v); }
+
+} // detail
+
+class UvsTrace{
+public:
+    static bool IsEnabled(uint32_t category) {
+        detail::UvsTraceState &s = detail::TraceState();
+        if (__builtin_expect(!s.initialized, 0)) {
+            Initialize();
+        }
+        return category < 64 && (s.mask & (1ULL << category)) != 0;
+    }
+    static void SetCategoryMask(uint64_t mask) {
+        Initialize();
+        detail::TraceState().mask = mask;
+    }
+    static uint64_t GetCategoryMask() {
+        Initialize();
+        return detail::TraceState().mask;
+    }
+    static void EnableCategory(uint32_t category) {
+        Initialize();
+        if (category < 64) {
+            __sync_fetch_and_or(&detail::TraceState().mask, 1ULL << category);
+        }
+    }
+    static void DisableCategory(uint32_t category) {
+        Initialize();
+        if (category < 64) {
+            __sync_fetch_and_and(&detail::TraceState().mask, ~(1ULL << category));
+        }
+    }
+
+    static void Record(UvsTraceSite *site) {
+        Commit(site, 0, 0);
+    }
+    template <class A1>
+    static void Record(UvsTraceSite *site, A1 a1) {
+        uint64_t a[1] = {detail::TraceArg(a1)};
+        Commit(site, a, 1);
+    }
+    template <class A1, class A2>
+    static void Record(UvsTraceSite *site, A1 a1, A2 a2) {
+        uint64_t a[2] = {detail::TraceArg(a1), detail::TraceArg(a2)};
+        Commit(site, a, 2);
+    }
+    template <class A1, class A2, class A3>
+    static void Record(UvsTraceSite *site, A1 a1, A2 a2, A3 a3) {
+        uint64_t a[3] = {detail::TraceArg(a1), detail::TraceArg(a2), detail::TraceArg(a3)};
+        Commit(site, a, 3);
+    }
+    template <class A1, class A2, class A3, class A4>
+    static void Record(UvsTraceSite *site, A1 a1, A2 a2, A3 a3, A4 a4) {
+        uint64_t a[4] = {detail::TraceArg(a1), detail::TraceArg(a2), detail::TraceArg(a3), detail::TraceArg(a4)};
+        Commit(site, a, 4);
+    }
+    template <class A1, class A2, class A3, class A4, class A5>
+    static void Record(UvsTraceSite *site, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) {
+        uint64_t a[5] = {detail::TraceArg(a1), detail::TraceArg(a2), detail::TraceArg(a3), detail::TraceArg(a4),
+                         detail::TraceArg(a5)};
+        Commit(site, a, 5);
+    }
+
+    // Writes every registered site and the current content of every ring
+    // to path. Safe while other threads keep recording: slots overwritten
+    // during the copy are dropped. Returns false on I/O errors.
+    static bool Dump(const char *path) {
+        detail::UvsTraceState &s = detail::TraceState();
+        FILE *fp = fopen(path, "wb");
+        if (fp == NULL) {
+            return false;
+        }
+        pthread_mutex_lock(&s.mutex);
+        std::vector<UvsTraceSite*> sites = s.sites ? *s.sites : std::vector<UvsTraceSite*>();
+        std::vector<UvsTraceRing*> rings = s.rings ? *s.rings : std::vector<UvsTraceRing*>();
+        pthread_mutex_unlock(&s.mutex);
+
+        UvsTraceFileHeader header;
+        memset(&header, 0, sizeof(header));
+        header.magic = UVS_TRACE_FILE_MAGIC;
+        header.event_size = sizeof(UvsTraceEvent);
+        header.max_args = UVS_TRACE_MAX_ARGS;
+        header.realtime_offset_ns = static_cast<int64_t>(UvsTime::RealtimeNs() - UvsTime::MonotonicNs());
+        header.nsites = sites.size();
+        header.nrings = rings.size();
+        bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+
+        for (size_t i = 0; ok && i < sites.size(); ++i) {
+            const UvsTraceSite *site = sites[i];
+            uint32_t meta[6] = {site->id, site->category, site->line, static_cast<uint32_t>(strlen(site->fmt)),
+                                static_cast<uint32_t>(strlen(site->file)), static_cast<uint32_t>(strlen(site->func))};
+            ok = fwrite(meta, sizeof(meta), 1, fp) == 1
+                && fwrite(site->fmt, 1, meta[3], fp) == meta[3]
+                && fwrite(site->file, 1, meta[4], fp) == meta[4]
+                && fwrite(site->func, 1, meta[5], fp) == meta[5];
+        }
+
+        for (size_t i = 0; ok && i < rings.size(); ++i) {
+            std::vector<UvsTraceEvent> events;
+            CopyRing(rings[i], &events);
+            uint32_t tid[2] = {rings[i]->tid, 0};
+            uint64_t n = events.size();
+            ok = fwrite(tid, sizeof(tid), 1, fp) == 1 && fwrite(&n, sizeof(n), 1, fp) == 1
+                && (n == 0 || fwrite(&events[0], sizeof(UvsTraceEvent), n, fp) == n);
+        }
+
+        return fclose(fp) == 0 && ok;
+    }
+
+private:
+    static void Initialize() {
+        detail::UvsTraceState &s = detail::TraceState();
+        if (s.initialized) {
+            return;
+        }
+        pthread_mutex_lock(&s.mutex);
+        if (!s.initialized) {
+            s.sites = new std::vector<UvsTraceSite*>;
+            s.rings = new std::vector<UvsTraceRing*>;
+            s.free_rings = new std::vector<UvsTraceRing*>;
+            pthread_key_create(&s.ring_key, ReleaseRing);
+            s.mask = ParseCategories(getenv("UVS_TRACE_CATEGORIES"));
+            s.ring_events = RoundUpPowerOfTwo(ParseNumber(getenv("UVS_TRACE_RING_EVENTS"), UVS_TRACE_DEFAULT_RING_EVENTS));
+            if (getenv("UVS_TRACE_DUMP") != NULL) {
+                atexit(DumpAtExit);
+            }
+            __sync_synchronize();
+            s.initialized = 1;
+        }
+        pthread_mutex_unlock(&s.mutex);
+    }
+
+    static void DumpAtExit() {
+        const char *path = getenv("UVS_TRACE_DUMP");
+        if (path != NULL && !Dump(path)) {
+            fprintf(stderr, "uvs_trace: dump to %s failed\n", path);
+        }
+    }
+
+    static void Commit(UvsTraceSite *site, const uint64_t *args, uint32_t nargs) {
+        UvsTraceRing *ring = detail::ThreadRing();
+        if (__builtin_expect(ring == 0, 0)) {
+            ring = CreateRing();
+            if (ring == 0) {
+                return;
+            }
+        }
+        if (__builtin_expect(site->id == 0, 0)) {
+            RegisterSite(site);
+        }
+        uint64_t head = ring->head;
+        UvsTraceEvent *e = &ring->events[head & ring->mask];
+        // invalidate first: a reader must not pair the old seq with new data
+        e->seq = ~0ULL;
+        __asm__ __volatile__("" ::: "memory");
+        e->timestamp_ns = UvsTime::MonotonicNs();
+        e->site_id = site->id;
+        e->nargs = nargs;
+        for (uint32_t i = 0; i < nargs; ++i) {
+            e->args[i] = args[i];
+        }
+        // x86 keeps stores in order; the barriers only stop the compiler
+        __asm__ __volatile__("" ::: "memory");
+        e->seq = head;
+        __asm__ __volatile__("" ::: "memory");
+        ring->head = head + 1;
+    }
+
+    static void RegisterSite(UvsTraceSite *site) {
+        detail::UvsTraceState &s = detail::TraceState();
+        pthread_mutex_lock(&s.mutex);
+        if (site->id == 0) {
+            s.sites->push_back(site);
+            site->id = s.sites->size();
+        }
+        pthread_mutex_unlock(&s.mutex);
+    }
+
+    static UvsTraceRing *CreateRing() {
+        detail::UvsTraceState &s = detail::TraceState();
+        uint32_t tid = static_cast<uint32_t>(syscall(SYS_gettid));
+        UvsTraceRing *ring = 0;
+        pthread_mutex_lock(&s.mutex);
+        if (!s.free_rings->empty()) {
+            // slots left by the previous owner fall outside [0, head) and
+            // are never copied
+            ring = s.free_rings->back();
+            s.free_rings->pop_back();
+            ring->head = 0;
+            ring->tid = tid;
+        }
+        pthread_mutex_unlock(&s.mutex);
+        if (ring == 0) {
+            ring = new UvsTraceRing;
+            ring->events = static_cast<UvsTraceEvent*>(calloc(s.ring_events, sizeof(UvsTraceEvent)));
+            if (ring->events == NULL) {
+                delete ring;
+                return 0;
+            }
+            ring->mask = s.ring_events - 1;
+            ring->head = 0;
+            ring->tid = tid;
+            pthread_mutex_lock(&s.mutex);
+            s.rings->push_back(ring);
+            pthread_mutex_unlock(&s.mutex);
+        }
+        pthread_setspecific(s.ring_key, ring);
+        detail::ThreadRing() = ring;
+        return ring;
+    }
+
+    // pthread_key destructor, runs when a thread that recorded exits
+    static void ReleaseRing(void *ring) {
+        detail::UvsTraceState &s = detail::TraceState();
+        pthread_mutex_lock(&s.mutex);
+        s.free_rings->push_back(static_cast<UvsTraceRing*>(ring));
+        pthread_mutex_unlock(&s.mutex);
+    }
+
+    static void CopyRing(const UvsTraceRing *ring, std::vector<UvsTraceEvent> *events) {
+        uint64_t head = ring->head;
+        uint64_t capacity = ring->mask + 1;
+        uint64_t begin = head > capacity ? head - capacity : 0;
+        events->reserve(head - begin);
+        for (uint64_t i = begin; i < head; ++i) {
+            UvsTraceEvent e = ring->events[i & ring->mask];
+            __asm__ __volatile__("" ::: "memory");
+            // slot reused by a newer event while we copied it
+            if (e.seq != i || ring->events[i & ring->mask].seq != i) {
+                continue;
+            }
+            events->push_back(e);
+        }
+    }
+
+    static uint64_t ParseCategories(const char *str) {
+        if (str == NULL) {
+            return 0;
+        }
+        if (strcmp(str, "all") == 0) {
+            return ~0ULL;
+        }
+        uint64_t mask = 0;
+        while (*str != '\0') {
+            char *end;
+            unsigned long category = strtoul(str, &end, 10);
+            if (end == str) {
+                ++str;
+                continue;
+            }
+            if (category < 64) {
+                mask |= 1ULL << category;
+            }
+            str = end;
+        }
+        return mask;
+    }
+
+    static uint64_t ParseNumber(const char *str, uint64_t default_value) {
+        if (str == NULL) {
+            return default_value;
+        }
+        uint64_t n = strtoull(str, NULL, 10);
+        return n > 0 ? n : default_value;
+    }
+
+    static uint64_t RoundUpPowerOfTwo(uint64_t n) {
+        uint64_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+};
+
+}}}} // github::unix1986::universe::util
+#endif //__COM_GITHUB_UNIX1986_UNIVERSE_UTIL_UVS_TRACE_H__
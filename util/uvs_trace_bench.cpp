@@ -0,0 +1,88 @@
+// ns/event of UVS_TRACE against the printf based __dbg_log
+// g++ -O2 -o uvs_trace_bench uvs_trace_bench.cpp -pthread
+// ./uvs_trace_bench [events] [threads]; writes uvs_trace_bench.bin
+#include <stdio.h>
+#include <stdlib.h>
+#define __DBG_LOG__
+#include "dbg_log.h"
+#include "uvs_trace.h"
+
+using namespace github::unix1986::universe::util;
+
+static uint64_t g_events = 2000000;
+
+static void Report(const char *name, uint64_t begin, uint64_t events) {
+    uint64_t elapsed = UvsTime::MonotonicSyscallNs() - begin;
+    fprintf(stderr, "case=%-18s events=%llu ns_per_event=%.2f\n", name,
+            (unsigned long long)events, (double)elapsed / events);
+}
+
+static void *Worker(void *arg) {
+    long id = (long)arg;
+    for (uint64_t i = 0; i < g_events; ++i) {
+        UVS_TRACE(2, "worker %ld event %llu", id, (unsigned long long)i);
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1) {
+        g_events = strtoull(argv[1], NULL, 10);
+    }
+    int threads = argc > 2 ? atoi(argv[2]) : 4;
+    UvsTime::Calibrate(UvsTime::kDefaultCalibrationMs);
+
+    UvsTrace::SetCategoryMask(0);
+    uint64_t begin = UvsTime::MonotonicSyscallNs();
+    for (uint64_t i = 0; i < g_events; ++i) {
+        UVS_TRACE(1, "disabled %llu", (unsigned long long)i);
+    }
+    Report("disabled", begin, g_events);
+
+    UvsTrace::EnableCategory(1);
+    begin = UvsTime::MonotonicSyscallNs();
+    for (uint64_t i = 0; i < g_events; ++i) {
+        UVS_TRACE(1, "no args");
+    }
+    Report("enabled_0_args", begin, g_events);
+
+    begin = UvsTime::MonotonicSyscallNs();
+    for (uint64_t i = 0; i < g_events; ++i) {
+        UVS_TRACE(1, "fd=%d len=%zu", (int)(i & 1023), (size_t)i);
+    }
+    Report("enabled_2_args", begin, g_events);
+
+    begin = UvsTime::MonotonicSyscallNs();
+    for (uint64_t i = 0; i < g_events; ++i) {
+        UVS_TRACE(1, "a=%d b=%u c=%llx d=%.3f p=%p", (int)i, (unsigned)i, (unsigned long long)i, i * 0.5, &i);
+    }
+    Report("enabled_5_args", begin, g_events);
+
+    UvsTrace::EnableCategory(2);
+    pthread_t tids[64];
+    threads = threads > 64 ? 64 : threads;
+    begin = UvsTime::MonotonicSyscallNs();
+    for (int i = 0; i < threads; ++i) {
+        pthread_create(&tids[i], NULL, Worker, (void*)(long)i);
+    }
+    for (int i = 0; i < threads; ++i) {
+        pthread_join(tids[i], NULL);
+    }
+    Report("threads_2_args", begin, g_events * threads);
+
+    // the old tracing, stdout sent to /dev/null so only formatting and the
+    // flush are measured
+    uint64_t printf_events = g_events / 10;
+    if (freopen("/dev/null", "w", stdout) != NULL) {
+        begin = UvsTime::MonotonicSyscallNs();
+        for (uint64_t i = 0; i < printf_events; ++i) {
+            __dbg_log("fd=%d len=%zu", (int)(i & 1023), (size_t)i);
+        }
+        Report("dbg_log_2_args", begin, printf_events);
+    }
+
+    begin = UvsTime::MonotonicSyscallNs();
+    bool ok = UvsTrace::Dump("uvs_trace_bench.bin");
+    fprintf(stderr, "dump=%s ms=%.2f\n", ok ? "ok" : "failed", (UvsTime::MonotonicSyscallNs() - begin) / 1e6);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,236 @@
+// Renders a UvsTrace::Dump file as text, one line per event, oldest first
+// across all threads, in the __dbg_log format plus microseconds and tid:
+//   [mon-day hour:min:sec.usec] [tid] "source_file_name":[line_no] func_name: user_content
+// g++ -O2 -o uvs_trace_decode uvs_trace_decode.cpp -pthread
+// usage: uvs_trace_decode trace.bin [category ...]
+#include <stdio.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include "uvs_trace.h"
+
+using namespace github::unix1986::universe::util;
+
+struct Site {
+    uint32_t category;
+    uint32_t line;
+    std::string fmt;
+    std::string file;
+    std::string func;
+};
+
+struct Event {
+    uint32_t tid;
+    UvsTraceEvent e;
+};
+
+static bool EventLess(const Event &a, const Event &b) {
+    if (a.e.timestamp_ns != b.e.timestamp_ns) {
+        return a.e.timestamp_ns < b.e.timestamp_ns;
+    }
+    return a.tid < b.tid || (a.tid == b.tid && a.e.seq < b.e.seq);
+}
+
+static bool ReadString(FILE *fp, uint32_t len, std::string *out) {
+    out->resize(len);
+    return len == 0 || fread(&(*out)[0], 1, len, fp) == len;
+}
+
+static void Append(std::string *out, const char *spec, ...) __attribute__((format(printf, 2, 3)));
+static void Append(std::string *out, const char *spec, ...) {
+    char buf[512];
+    va_list ap;
+    va_start(ap, spec);
+    vsnprintf(buf, sizeof(buf), spec, ap);
+    va_end(ap);
+    out->append(buf);
+}
+
+// printf with the recorded raw arguments: every conversion is re-issued
+// with the argument reinterpreted according to its conversion and length
+// modifier, since the values were widened to 64 bits when recorded.
+static std::string Format(const std::string &fmt, const UvsTraceEvent &e) {
+    std::string out;
+    uint32_t next = 0;
+    for (size_t i = 0; i < fmt.size(); ++i) {
+        if (fmt[i] != '%') {
+            out += fmt[i];
+            continue;
+        }
+        if (i + 1 < fmt.size() && fmt[i + 1] == '%') {
+            out += '%';
+            ++i;
+            continue;
+        }
+        size_t start = i;
+        std::string spec = "%";
+        size_t j = i + 1;
+        while (j < fmt.size() && strchr("-+ #0", fmt[j]) != NULL) {
+            spec += fmt[j++];
+        }
+        while (j < fmt.size() && (isdigit(fmt[j]) || fmt[j] == '.' || fmt[j] == '*')) {
+            if (fmt[j] == '*') {
+                // width or precision passed as an argument
+                char num[24];
+                snprintf(num, sizeof(num), "%d", next < e.nargs ? (int)e.args[next] : 0);
+                ++next;
+                spec += num;
+            } else {
+                spec += fmt[j];
+            }
+            ++j;
+        }
+        std::string length;
+        while (j < fmt.size() && strchr("hlLqjzt", fmt[j]) != NULL) {
+            length += fmt[j++];
+        }
+        if (j >= fmt.size()) {
+            out += fmt.substr(start);
+            break;
+        }
+        char conv = fmt[j];
+        i = j;
+        if (next >= e.nargs) {
+            out += "<missing>";
+            continue;
+        }
+        uint64_t v = e.args[next++];
+        switch (conv) {
+        case 'd': case 'i': {
+            long long n = (long long)v;
+            if (length == "hh") {
+                n = (signed char)v;
+            } else if (length == "h") {
+                n = (short)v;
+            } else if (length.empty()) {
+                n = (int)v;
+            }
+            Append(&out, (spec + "ll" + conv).c_str(), n);
+            break;
+        }
+        case 'u': case 'o': case 'x': case 'X': {
+            unsigned long long n = v;
+            if (length == "hh") {
+                n = (unsigned char)v;
+            } else if (length == "h") {
+                n = (unsigned short)v;
+            } else if (length.empty()) {
+                n = (unsigned int)v;
+            }
+            Append(&out, (spec + "ll" + conv).c_str(), n);
+            break;
+        }
+        case 'c':
+            Append(&out, (spec + conv).c_str(), (int)(unsigned char)v);
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+            double d;
+            memcpy(&d, &v, sizeof(d));
+            Append(&out, (spec + conv).c_str(), d);
+            break;
+        }
+        case 'p':
+            Append(&out, (spec + conv).c_str(), (void*)(uintptr_t)v);
+            break;
+        case 's':
+            // only the address was recorded
+            Append(&out, "<str@0x%llx>", (unsigned long long)v);
+            break;
+        default:
+            out += fmt.substr(start, j - start + 1);
+            break;
+        }
+    }
+    return out;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s trace.bin [category ...]\n", argv[0]);
+        return 1;
+    }
+    uint64_t mask = ~0ULL;
+    if (argc > 2) {
+        mask = 0;
+        for (int i = 2; i < argc; ++i) {
+            unsigned long category = strtoul(argv[i], NULL, 10);
+            if (category < 64) {
+                mask |= 1ULL << category;
+            }
+        }
+    }
+
+    FILE *fp = fopen(argv[1], "rb");
+    if (fp == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    UvsTraceFileHeader header;
+    if (fread(&header, sizeof(header), 1, fp) != 1 || header.magic != UVS_TRACE_FILE_MAGIC
+        || header.event_size != sizeof(UvsTraceEvent) || header.max_args != UVS_TRACE_MAX_ARGS) {
+        fprintf(stderr, "%s: not a trace file of this version\n", argv[1]);
+        return 1;
+    }
+
+    std::map<uint32_t, Site> sites;
+    for (uint32_t i = 0; i < header.nsites; ++i) {
+        uint32_t meta[6];
+        Site site;
+        if (fread(meta, sizeof(meta), 1, fp) != 1 || !ReadString(fp, meta[3], &site.fmt)
+            || !ReadString(fp, meta[4], &site.file) || !ReadString(fp, meta[5], &site.func)) {
+            fprintf(stderr, "%s: truncated site table\n", argv[1]);
+            return 1;
+        }
+        site.category = meta[1];
+        site.line = meta[2];
+        sites[meta[0]] = site;
+    }
+
+    std::vector<Event> events;
+    for (uint32_t i = 0; i < header.nrings; ++i) {
+        uint32_t tid[2];
+        uint64_t n;
+        if (fread(tid, sizeof(tid), 1, fp) != 1 || fread(&n, sizeof(n), 1, fp) != 1) {
+            fprintf(stderr, "%s: truncated ring header\n", argv[1]);
+            return 1;
+        }
+        for (uint64_t k = 0; k < n; ++k) {
+            Event ev;
+            ev.tid = tid[0];
+            if (fread(&ev.e, sizeof(ev.e), 1, fp) != 1) {
+                fprintf(stderr, "%s: truncated ring\n", argv[1]);
+                return 1;
+            }
+            events.push_back(ev);
+        }
+    }
+    fclose(fp);
+    std::stable_sort(events.begin(), events.end(), EventLess);
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        const UvsTraceEvent &e = events[i].e;
+        std::map<uint32_t, Site>::const_iterator it = sites.find(e.site_id);
+        if (it == sites.end()) {
+            printf("<unknown site %u>\n", e.site_id);
+            continue;
+        }
+        const Site &site = it->second;
+        if (site.category >= 64 || (mask & (1ULL << site.category)) == 0) {
+            continue;
+        }
+        uint64_t wall_ns = e.timestamp_ns + header.realtime_offset_ns;
+        time_t t = wall_ns / 1000000000ULL;
+        struct tm dm;
+        localtime_r(&t, &dm);
+        printf("[%02d-%02d %02d:%02d:%02d.%06u] [%u] \"%s\":[%u] %-s: %s\n", dm.tm_mon + 1, dm.tm_mday,
+               dm.tm_hour, dm.tm_min, dm.tm_sec, (unsigned)(wall_ns % 1000000000ULL / 1000), events[i].tid,
+               site.file.c_str(), site.line, site.func.c_str(), Format(site.fmt, e).c_str());
+    }
+    return 0;
+}